@@ -0,0 +1,277 @@
+#include "alloc_counter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <cxxabi.h>
+#include <execinfo.h>
+#define HEXUKI_HAVE_BACKTRACE 1
+#endif
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+}
+#endif
+
+namespace hexuki {
+namespace bench {
+
+namespace {
+
+constexpr int MAX_SITES = 32;
+constexpr int MAX_FRAMES = 24;
+constexpr int SKIP_FRAMES = 2;  // recordSite() and noteAllocation()
+
+struct RawSite {
+    uint64_t hash;
+    uint64_t count;
+    uint64_t bytes;
+    int depth;
+    void* frames[MAX_FRAMES];
+};
+
+// Plain globals only: these are used before main() and after exit()
+std::atomic<bool> counting(false);
+std::atomic<bool> recording(false);
+std::atomic<uint64_t> allocations(0);
+std::atomic<uint64_t> allocatedBytes(0);
+
+std::atomic_flag siteLock = ATOMIC_FLAG_INIT;
+RawSite sites[MAX_SITES];
+int siteCount = 0;
+
+// Inside a hook on this thread: allocations made by the hook itself (or by
+// malloc under operator new) are not counted again
+thread_local int hookDepth = 0;
+
+struct HookGuard {
+    HookGuard() { hookDepth++; }
+    ~HookGuard() { hookDepth--; }
+};
+
+__attribute__((noinline)) void recordSite(size_t size) {
+#ifdef HEXUKI_HAVE_BACKTRACE
+    void* frames[MAX_FRAMES + SKIP_FRAMES];
+    int depth = backtrace(frames, MAX_FRAMES + SKIP_FRAMES) - SKIP_FRAMES;
+    if (depth < 0) depth = 0;
+#else
+    void* frames[SKIP_FRAMES] = {};
+    int depth = 0;
+#endif
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < depth; i++) {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(frames[SKIP_FRAMES + i])) * 0x100000001b3ULL;
+    }
+
+    while (siteLock.test_and_set(std::memory_order_acquire)) {}
+    int index = 0;
+    while (index < siteCount && sites[index].hash != hash) index++;
+    if (index == siteCount && siteCount < MAX_SITES) {
+        RawSite& site = sites[siteCount++];
+        site.hash = hash;
+        site.count = 0;
+        site.bytes = 0;
+        site.depth = depth;
+        std::memcpy(site.frames, frames + SKIP_FRAMES, depth * sizeof(void*));
+    }
+    if (index < siteCount) {
+        sites[index].count++;
+        sites[index].bytes += size;
+    }
+    siteLock.clear(std::memory_order_release);
+}
+
+__attribute__((noinline)) void noteAllocation(size_t size) {
+    if (!counting.load(std::memory_order_relaxed) || hookDepth > 0) return;
+    HookGuard guard;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (recording.load(std::memory_order_relaxed)) recordSite(size);
+}
+
+void* countedNew(size_t size) {
+    noteAllocation(size);
+    HookGuard guard;  // malloc below is this same allocation
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* countedAlignedNew(size_t size, std::align_val_t alignment) {
+    noteAllocation(size);
+    HookGuard guard;
+    size_t align = static_cast<size_t>(alignment);
+    void* pointer = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+// "binary(mangled+0x1f) [0x...]" -> "demangled+0x1f (binary)"
+std::string describeFrame(const char* symbol) {
+    std::string text = symbol;
+#ifdef HEXUKI_HAVE_BACKTRACE
+    size_t open = text.find('(');
+    size_t plus = text.find('+', open);
+    size_t close = text.find(')', open);
+    if (open == std::string::npos || plus == std::string::npos || close == std::string::npos || plus == open + 1) {
+        return text;
+    }
+    std::string mangled = text.substr(open + 1, plus - open - 1);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    std::string name = status == 0 && demangled ? demangled : mangled;
+    std::free(demangled);
+    return name + text.substr(plus, close - plus) + " (" + text.substr(0, open) + ")";
+#else
+    return text;
+#endif
+}
+
+} // namespace
+
+void beginAllocationCount(bool recordSites) {
+#ifdef HEXUKI_HAVE_BACKTRACE
+    if (recordSites) {
+        // The first backtrace() loads the unwinder, which allocates
+        void* frames[1];
+        backtrace(frames, 1);
+    }
+#endif
+    while (siteLock.test_and_set(std::memory_order_acquire)) {}
+    siteCount = 0;
+    siteLock.clear(std::memory_order_release);
+    allocations.store(0, std::memory_order_relaxed);
+    allocatedBytes.store(0, std::memory_order_relaxed);
+    recording.store(recordSites, std::memory_order_relaxed);
+    counting.store(true, std::memory_order_seq_cst);
+}
+
+AllocationStats endAllocationCount() {
+    counting.store(false, std::memory_order_seq_cst);
+    AllocationStats stats;
+    stats.count = allocations.load(std::memory_order_relaxed);
+    stats.bytes = allocatedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool mallocHooked() {
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<AllocationSite> allocationSites() {
+    RawSite copies[MAX_SITES];
+    while (siteLock.test_and_set(std::memory_order_acquire)) {}
+    int count = siteCount;
+    std::copy(sites, sites + count, copies);
+    siteLock.clear(std::memory_order_release);
+
+    std::vector<AllocationSite> result;
+    for (int i = 0; i < count; i++) {
+        AllocationSite site;
+        site.count = copies[i].count;
+        site.bytes = copies[i].bytes;
+#ifdef HEXUKI_HAVE_BACKTRACE
+        if (char** symbols = backtrace_symbols(copies[i].frames, copies[i].depth)) {
+            for (int f = 0; f < copies[i].depth; f++) site.frames.push_back(describeFrame(symbols[f]));
+            std::free(symbols);
+        }
+#endif
+        result.push_back(site);
+    }
+    std::stable_sort(result.begin(), result.end(),
+                     [](const AllocationSite& a, const AllocationSite& b) { return a.count > b.count; });
+    return result;
+}
+
+void printAllocationReport(std::ostream& out, const AllocationStats& stats, size_t maxSites) {
+    out << stats.count << " allocation(s), " << stats.bytes << " bytes\n";
+    std::vector<AllocationSite> found = allocationSites();
+    uint64_t shown = 0;
+    for (size_t i = 0; i < found.size() && i < maxSites; i++) {
+        out << "  " << found[i].count << " allocation(s), " << found[i].bytes << " bytes at:\n";
+        for (const std::string& frame : found[i].frames) out << "      " << frame << "\n";
+        shown += found[i].count;
+    }
+    if (stats.count > shown && !found.empty()) {
+        out << "  (" << (stats.count - shown) << " more at other sites)\n";
+    }
+}
+
+} // namespace bench
+} // namespace hexuki
+
+// ============================================================================
+// Hooks
+// ============================================================================
+
+void* operator new(size_t size) {
+    return hexuki::bench::countedNew(size);
+}
+
+void* operator new[](size_t size) {
+    return hexuki::bench::countedNew(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return hexuki::bench::countedAlignedNew(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return hexuki::bench::countedAlignedNew(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+#if defined(__GLIBC__)
+// Interpose the C allocator; glibc keeps the real one under __libc_*
+extern "C" {
+
+void* malloc(size_t size) {
+    hexuki::bench::noteAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    hexuki::bench::noteAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    hexuki::bench::noteAllocation(size);
+    return __libc_realloc(pointer, size);
+}
+
+}
+#endif
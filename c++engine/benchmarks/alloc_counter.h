@@ -0,0 +1,58 @@
+#ifndef HEXUKI_ALLOC_COUNTER_H
+#define HEXUKI_ALLOC_COUNTER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hexuki {
+namespace bench {
+
+/**
+ * Heap allocation counting (verifies that hot paths do not allocate)
+ *
+ * Linking this file replaces the global operator new for the whole program
+ * and, on glibc, interposes malloc/calloc/realloc too, so allocations made
+ * inside the C and C++ runtimes are seen as well. While counting is on, every
+ * allocation on any thread is counted; with sites on, its call stack is also
+ * recorded (slow: use only where none are expected). Off, the hooks cost one
+ * relaxed load per allocation.
+ *
+ * Call stacks are symbolized with backtrace_symbols(), which names only
+ * exported functions: link the program with -rdynamic (ENABLE_EXPORTS) for
+ * readable reports, or feed the offsets to addr2line.
+ */
+
+struct AllocationStats {
+    uint64_t count = 0;  // Allocations (new, malloc, calloc, realloc)
+    uint64_t bytes = 0;  // Bytes requested
+};
+
+// One distinct call stack that allocated while counting
+struct AllocationSite {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    std::vector<std::string> frames;  // Innermost first, from the allocator entry point
+};
+
+// Reset the counts and count from now on; recordSites also keeps call stacks
+void beginAllocationCount(bool recordSites = false);
+
+// Stop counting; the allocations since beginAllocationCount()
+AllocationStats endAllocationCount();
+
+// Whether malloc itself is hooked (glibc), not just operator new
+bool mallocHooked();
+
+// Call stacks recorded by the last count, most allocations first (up to 32
+// distinct stacks; further ones are counted but not kept)
+std::vector<AllocationSite> allocationSites();
+
+// "N allocations (B bytes)" and the top maxSites call stacks
+void printAllocationReport(std::ostream& out, const AllocationStats& stats, size_t maxSites = 8);
+
+} // namespace bench
+} // namespace hexuki
+
+#endif // HEXUKI_ALLOC_COUNTER_H
@@ -0,0 +1,67 @@
+#include "bench_corpus.h"
+
+namespace hexuki {
+namespace bench {
+
+static const char* const OPENING[] = {
+    "startpos",
+    "h6:4,h9:1|p1:1,2,3,5,6,7,8,9|p2:1,2,3,4,5,6,7,8,9|turn:2",
+    "h9:1,h14:6,h16:9|p1:1,2,3,4,5,7,8,9|p2:1,2,3,4,5,6,7,8|turn:1",
+    "h4:8,h7:3,h9:1|p1:1,2,3,4,5,6,7,9|p2:1,2,4,5,6,7,8,9|turn:1",
+    "h2:5,h4:2,h7:3,h9:1|p1:1,2,4,6,7,8,9|p2:1,3,4,5,6,7,8,9|turn:2",
+    "h9:1,h11:9,h13:2,h16:6|p1:1,3,4,5,6,7,8|p2:1,2,3,4,5,7,8,9|turn:2",
+    "h3:8,h5:3,h6:3,h7:7,h9:1|p1:1,2,4,5,6,7,9|p2:1,2,4,5,6,8,9|turn:1",
+    "h4:5,h7:3,h9:1,h11:5,h16:4|p1:1,2,4,6,7,8,9|p2:1,2,3,6,7,8,9|turn:1",
+};
+
+static const char* const MIDGAME[] = {
+    "h0:6,h1:4,h6:3,h9:1,h10:8,h12:5,h14:4,h17:8|p1:1,2,3,7,9|p2:1,2,5,6,7,9|turn:2",
+    "h0:7,h1:1,h2:8,h5:1,h6:9,h7:4,h9:1,h11:3|p1:2,5,6,8,9|p2:2,3,4,5,6,7|turn:2",
+    "h2:5,h4:6,h5:5,h9:1,h10:3,h11:9,h12:1,h15:7,h17:6|p1:2,3,4,8,9|p2:1,2,4,7,8|turn:1",
+    "h1:4,h4:6,h5:8,h7:9,h9:1,h10:1,h11:3,h12:6,h17:2|p1:2,4,5,7,9|p2:1,3,5,7,8|turn:1",
+    "h2:3,h6:7,h7:5,h8:6,h9:1,h11:5,h12:8,h14:6,h16:7,h18:9|p1:1,2,4,9|p2:1,2,3,4,8|turn:2",
+    "h4:4,h9:1,h10:9,h11:7,h12:3,h14:1,h15:2,h16:5,h17:7,h18:6|p1:2,5,8,9|p2:1,3,4,6,8|turn:2",
+    "h1:6,h5:4,h6:7,h7:2,h8:5,h9:1,h12:1,h13:9,h14:2,h16:9,h18:5|p1:3,4,7,8|p2:1,3,6,8|turn:1",
+    "h6:2,h8:1,h9:1,h10:9,h11:8,h12:9,h13:2,h14:6,h16:1,h17:3,h18:6|p1:3,4,5,7|p2:4,5,7,8|turn:1",
+};
+
+static const char* const ENDGAME[] = {
+    "h1:1,h2:5,h4:7,h5:5,h7:1,h9:1,h10:6,h11:3,h12:4,h13:6,h14:2,h16:8,h18:7|p1:3,8,9|p2:2,4,9|turn:1",
+    "h0:3,h1:4,h2:6,h3:1,h4:7,h7:8,h8:7,h9:1,h10:5,h12:6,h13:9,h14:4,h16:5|p1:2,8,9|p2:1,2,3|turn:1",
+    "h0:2,h2:3,h4:8,h6:9,h7:7,h8:5,h9:1,h10:8,h11:1,h13:6,h14:7,h15:3,h17:4,h18:6|p1:1,2|p2:4,5,9|turn:2",
+    "h0:8,h1:5,h2:6,h3:6,h4:5,h5:2,h6:3,h7:2,h8:8,h9:1,h11:1,h13:9,h14:3,h16:1|p1:4,7|p2:4,7,9|turn:2",
+    "h0:5,h2:6,h3:4,h4:9,h6:4,h7:6,h8:3,h9:1,h10:9,h11:2,h12:1,h13:7,h15:3,h16:7,h17:5|p1:1,8|p2:2,8|turn:1",
+    "h0:2,h1:7,h2:1,h3:5,h5:4,h6:6,h7:8,h8:2,h9:1,h10:8,h11:7,h12:9,h14:3,h15:1,h17:9|p1:4,6|p2:3,5|turn:1",
+    "h0:9,h2:1,h3:1,h5:2,h6:5,h8:7,h9:1,h10:7,h11:4,h12:3,h13:9,h14:6,h15:8,h16:3,h17:4,h18:8|p1:5|p2:2,6|turn:2",
+    "h0:5,h2:9,h3:3,h4:7,h5:1,h6:4,h7:5,h8:9,h9:1,h10:7,h11:2,h12:6,h13:6,h15:4,h16:2,h17:3|p1:8|p2:1,8|turn:2",
+};
+
+const char* phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::OPENING: return "opening";
+        case Phase::MIDGAME: return "midgame";
+        case Phase::ENDGAME: return "endgame";
+    }
+    return "";
+}
+
+template <size_t N>
+static std::vector<HexukiBitboard> load(const char* const (&positions)[N]) {
+    std::vector<HexukiBitboard> boards(N);
+    for (size_t i = 0; i < N; i++) {
+        if (std::string(positions[i]) != "startpos") boards[i].loadPosition(positions[i]);
+    }
+    return boards;
+}
+
+std::vector<HexukiBitboard> corpus(Phase phase) {
+    switch (phase) {
+        case Phase::OPENING: return load(OPENING);
+        case Phase::MIDGAME: return load(MIDGAME);
+        case Phase::ENDGAME: return load(ENDGAME);
+    }
+    return {};
+}
+
+} // namespace bench
+} // namespace hexuki
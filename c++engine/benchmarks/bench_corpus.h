@@ -0,0 +1,31 @@
+#ifndef HEXUKI_BENCH_CORPUS_H
+#define HEXUKI_BENCH_CORPUS_H
+
+#include "core/bitboard.h"
+#include <string>
+#include <vector>
+
+namespace hexuki {
+namespace bench {
+
+/**
+ * Benchmark positions by game phase
+ *
+ * Fixed savePosition() strings (from seeded random games), so numbers stay
+ * comparable across changes to move generation or move order:
+ *   opening: 0-4 moves played (14-18 empty hexes, ~50-70 moves)
+ *   midgame: 7-10 moves played (8-11 empty hexes)
+ *   endgame: 12-15 moves played (3-6 empty hexes)
+ */
+enum class Phase { OPENING, MIDGAME, ENDGAME };
+
+constexpr Phase ALL_PHASES[] = {Phase::OPENING, Phase::MIDGAME, Phase::ENDGAME};
+
+const char* phaseName(Phase phase);  // "opening", "midgame", "endgame"
+
+std::vector<HexukiBitboard> corpus(Phase phase);
+
+} // namespace bench
+} // namespace hexuki
+
+#endif // HEXUKI_BENCH_CORPUS_H
@@ -0,0 +1,318 @@
+#include "bench_harness.h"
+#include "core/board_kernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace hexuki {
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Iteration counts stop growing here even if a body does no measurable work
+static constexpr uint64_t MAX_ITERATIONS = uint64_t(1) << 40;
+
+double percentile(const std::vector<double>& sorted, double pct) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(pct / 100.0 * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+static std::string jsonQuote(const std::string& s) {
+    std::string quoted = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// ============================================================================
+// Running
+// ============================================================================
+
+BenchRunner::BenchRunner(const BenchOptions& options) : options(options) {
+    if (options.counters) counters = std::make_unique<PerfCounters>();
+}
+
+void BenchRunner::add(Benchmark benchmark) {
+    benchmarks.push_back(std::move(benchmark));
+}
+
+// One sample: setup (untimed), then `iterations` of the body, counted if asked
+double BenchRunner::timeSample(const Benchmark& benchmark, uint64_t iterations, Work& work, bool count,
+                               AllocationStats* allocs, bool recordSites) {
+    if (benchmark.setup) benchmark.setup();
+    count = count && counters && counters->available();
+    if (allocs) beginAllocationCount(recordSites);
+    if (count) counters->start();
+    Clock::time_point start = Clock::now();
+    work = benchmark.run(iterations);
+    Clock::time_point end = Clock::now();
+    if (count) counters->stop();
+    if (allocs) *allocs = endAllocationCount();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+BenchResult BenchRunner::run(const Benchmark& benchmark) {
+    BenchResult result;
+    result.name = benchmark.name;
+
+    // Calibrate: grow the iteration count until one sample is long enough
+    double minSampleNs = options.minSampleMs * 1e6;
+    uint64_t iterations = benchmark.iterations > 0 ? benchmark.iterations : 1;
+    Work work;
+    while (benchmark.iterations == 0) {
+        double ns = timeSample(benchmark, iterations, work, false);
+        if (ns >= minSampleNs || iterations >= MAX_ITERATIONS) break;
+        double scale = ns > 0.0 ? minSampleNs * 1.2 / ns : 10.0;
+        iterations = static_cast<uint64_t>(iterations * std::min(10.0, std::max(2.0, scale)));
+    }
+
+    for (int i = 0; i < options.warmup; i++) {
+        timeSample(benchmark, iterations, work, false);
+    }
+
+    uint64_t nodes = 0;
+    double counted[PerfCounters::NUM_COUNTERS] = {};
+    AllocationStats allocated;
+    for (int i = 0; i < std::max(1, options.repetitions); i++) {
+        AllocationStats sampleAllocs;
+        double ns = timeSample(benchmark, iterations, work, true, options.allocs ? &sampleAllocs : nullptr);
+        result.samples.push_back(ns / std::max<uint64_t>(work.ops, 1));
+        result.opsPerSample = work.ops;
+        nodes += work.nodes;
+        allocated.count += sampleAllocs.count;
+        allocated.bytes += sampleAllocs.bytes;
+        if (counters) {
+            for (int c = 0; c < PerfCounters::NUM_COUNTERS; c++) {
+                counted[c] += counters->value(static_cast<PerfCounters::Counter>(c));
+            }
+        }
+    }
+
+    std::vector<double>& samples = result.samples;
+    std::sort(samples.begin(), samples.end());
+    result.iterations = iterations;
+    result.min = samples.front();
+    result.max = samples.back();
+    result.p50 = percentile(samples, 50);
+    result.p90 = percentile(samples, 90);
+    result.p99 = percentile(samples, 99);
+
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    result.mean = sum / samples.size();
+    double squares = 0.0;
+    for (double s : samples) squares += (s - result.mean) * (s - result.mean);
+    result.stddev = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+
+    uint64_t ops = result.opsPerSample * samples.size();
+    result.nodesPerOp = ops > 0 ? static_cast<double>(nodes) / ops : 0.0;
+
+    for (int c = 0; counters && c < PerfCounters::NUM_COUNTERS; c++) {
+        PerfCounters::Counter counter = static_cast<PerfCounters::Counter>(c);
+        if (!counters->isOpen(counter)) continue;
+        CounterRatio ratio;
+        ratio.counter = counter;
+        ratio.perOp = ops > 0 ? counted[c] / ops : 0.0;
+        ratio.perNode = nodes > 0 ? counted[c] / nodes : 0.0;
+        result.counters.push_back(ratio);
+    }
+    if (counted[PerfCounters::CYCLES] > 0.0) {
+        result.ipc = counted[PerfCounters::INSTRUCTIONS] / counted[PerfCounters::CYCLES];
+    }
+
+    if (options.allocs) {
+        result.allocsCounted = true;
+        result.allocsPerOp = ops > 0 ? static_cast<double>(allocated.count) / ops : 0.0;
+        result.allocBytesPerOp = ops > 0 ? static_cast<double>(allocated.bytes) / ops : 0.0;
+        if (benchmark.allocationFree && allocated.count > 0) {
+            // One more sample, with call stacks, for the report
+            AllocationStats sampleAllocs;
+            timeSample(benchmark, iterations, work, false, &sampleAllocs, true);
+            std::ostringstream report;
+            printAllocationReport(report, sampleAllocs);
+            result.allocationReport = report.str();
+        }
+    }
+    return result;
+}
+
+std::vector<BenchResult> BenchRunner::runAll(std::ostream& log) {
+    std::vector<BenchResult> results;
+    if (counters && !counters->available()) {
+        log << "Hardware counters unavailable, timing only: " << counters->getError() << "\n\n";
+    } else if (counters && !counters->getError().empty()) {
+        log << "Some hardware counters unavailable: " << counters->getError() << "\n\n";
+    }
+    printHeader(log);
+    for (const Benchmark& benchmark : benchmarks) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) continue;
+        results.push_back(run(benchmark));
+        printRow(log, results.back());
+        if (!results.back().allocationReport.empty()) {
+            log << "    ALLOCATES in a hot path (one sample): " << results.back().allocationReport << std::flush;
+        }
+    }
+    return results;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+// Three significant figures in ns, us or ms
+static std::string formatNs(double ns) {
+    const char* unit = " ns";
+    if (ns >= 1e6) {
+        ns /= 1e6;
+        unit = " ms";
+    } else if (ns >= 1e4) {
+        ns /= 1e3;
+        unit = " us";
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(ns < 10.0 ? 2 : ns < 100.0 ? 1 : 0) << ns << unit;
+    return oss.str();
+}
+
+// Counter ratios: three decimals below 1, two below 100, none above
+static std::string formatCount(double value) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(value < 1.0 ? 3 : value < 100.0 ? 2 : 0) << value;
+    return oss.str();
+}
+
+void BenchRunner::printHeader(std::ostream& log) {
+    log << std::left << std::setw(32) << "benchmark"
+        << std::right << std::setw(12) << "p50/op" << std::setw(12) << "p90/op"
+        << std::setw(12) << "p99/op" << std::setw(9) << "cv%" << std::setw(14) << "ops/s"
+        << "  nodes/s\n";
+    log << std::string(100, '-') << "\n";
+}
+
+void BenchRunner::printRow(std::ostream& log, const BenchResult& result) {
+    double cv = result.mean > 0.0 ? 100.0 * result.stddev / result.mean : 0.0;
+    log << std::left << std::setw(32) << result.name
+        << std::right << std::setw(12) << formatNs(result.p50) << std::setw(12) << formatNs(result.p90)
+        << std::setw(12) << formatNs(result.p99)
+        << std::setw(9) << std::fixed << std::setprecision(1) << cv << std::defaultfloat
+        << std::setw(14) << static_cast<uint64_t>(result.opsPerSec());
+    if (result.nodesPerOp > 0.0) log << "  " << static_cast<uint64_t>(result.nodesPerSec());
+    log << "\n";
+
+    if (!result.counters.empty()) {
+        log << "    per op:  ";
+        for (const CounterRatio& ratio : result.counters) {
+            log << " " << PerfCounters::name(ratio.counter) << " " << formatCount(ratio.perOp);
+        }
+        if (result.ipc > 0.0) log << "  ipc " << formatCount(result.ipc);
+        log << "\n";
+        if (result.nodesPerOp > 0.0) {
+            log << "    per node:";
+            for (const CounterRatio& ratio : result.counters) {
+                log << " " << PerfCounters::name(ratio.counter) << " " << formatCount(ratio.perNode);
+            }
+            log << "\n";
+        }
+    }
+    if (result.allocsCounted && result.allocsPerOp > 0.0) {
+        log << "    allocs:   " << formatCount(result.allocsPerOp) << " per op, "
+            << formatCount(result.allocBytesPerOp) << " bytes per op\n";
+    } else if (result.allocsCounted) {
+        log << "    allocs:   none\n";
+    }
+    log << std::flush;
+}
+
+static std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+static std::string utcNow() {
+    std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+void BenchRunner::writeJson(std::ostream& out, const std::string& suite, const std::vector<BenchResult>& results,
+                            const std::vector<std::pair<std::string, std::string>>& context) const {
+    out << std::setprecision(6);
+    out << "{\n  \"suite\": " << jsonQuote(suite) << ",\n  \"context\": {\n";
+    out << "    \"date\": " << jsonQuote(utcNow()) << ",\n";
+    out << "    \"compiler\": " << jsonQuote(compilerName()) << ",\n";
+    out << "    \"simd\": " << jsonQuote(kernels::simdName()) << ",\n";
+#ifdef NDEBUG
+    out << "    \"assertions\": false,\n";
+#else
+    out << "    \"assertions\": true,\n";
+#endif
+    out << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"repetitions\": " << options.repetitions << ",\n";
+    out << "    \"warmup\": " << options.warmup << ",\n";
+    out << "    \"min_sample_ms\": " << options.minSampleMs;
+    if (counters) {
+        std::string open;
+        for (int c = 0; c < PerfCounters::NUM_COUNTERS; c++) {
+            PerfCounters::Counter counter = static_cast<PerfCounters::Counter>(c);
+            if (counters->isOpen(counter)) open += std::string(open.empty() ? "" : ",") + PerfCounters::name(counter);
+        }
+        out << ",\n    \"counters\": " << jsonQuote(open);
+        if (!counters->getError().empty()) out << ",\n    \"counters_error\": " << jsonQuote(counters->getError());
+    }
+    if (options.allocs) out << ",\n    \"allocs\": true";
+    for (const auto& field : context) {
+        out << ",\n    " << jsonQuote(field.first) << ": " << jsonQuote(field.second);
+    }
+    out << "\n  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << (i ? "," : "") << "\n    {\"name\": " << jsonQuote(r.name)
+            << ", \"iterations\": " << r.iterations
+            << ", \"ops_per_sample\": " << r.opsPerSample
+            << ", \"ns_per_op\": {\"min\": " << r.min << ", \"p50\": " << r.p50 << ", \"p90\": " << r.p90
+            << ", \"p99\": " << r.p99 << ", \"max\": " << r.max << ", \"mean\": " << r.mean
+            << ", \"stddev\": " << r.stddev << "}"
+            << ", \"ops_per_sec\": " << r.opsPerSec();
+        if (r.nodesPerOp > 0.0) {
+            out << ", \"nodes_per_op\": " << r.nodesPerOp << ", \"nodes_per_sec\": " << r.nodesPerSec();
+        }
+        if (!r.counters.empty()) {
+            out << ", \"counters\": {";
+            for (size_t c = 0; c < r.counters.size(); c++) {
+                out << (c ? ", " : "") << jsonQuote(PerfCounters::name(r.counters[c].counter))
+                    << ": {\"per_op\": " << r.counters[c].perOp;
+                if (r.nodesPerOp > 0.0) out << ", \"per_node\": " << r.counters[c].perNode;
+                out << "}";
+            }
+            if (r.ipc > 0.0) out << ", \"ipc\": " << r.ipc;
+            out << "}";
+        }
+        if (r.allocsCounted) {
+            out << ", \"allocs_per_op\": " << r.allocsPerOp << ", \"alloc_bytes_per_op\": " << r.allocBytesPerOp;
+        }
+        out << ", \"samples\": [";
+        for (size_t s = 0; s < r.samples.size(); s++) out << (s ? ", " : "") << r.samples[s];
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace bench
+} // namespace hexuki
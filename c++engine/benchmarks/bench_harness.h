@@ -0,0 +1,156 @@
+#ifndef HEXUKI_BENCH_HARNESS_H
+#define HEXUKI_BENCH_HARNESS_H
+
+#include "alloc_counter.h"
+#include "perf_counters.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hexuki {
+namespace bench {
+
+/**
+ * Microbenchmark harness
+ *
+ * A benchmark body runs a requested number of iterations and reports how
+ * many operations it timed. The runner calibrates the iteration count so one
+ * sample lasts at least minSampleMs (steady_clock resolution stops
+ * mattering), runs warmup samples untimed, then the timed repetitions, and
+ * reports nanoseconds per operation as percentiles over the samples.
+ * Benchmarks whose work changes with repetition (searches filling a table)
+ * set a fixed iteration count instead and reset their state in setup.
+ *
+ * With counters on, hardware counters (perf_counters.h) are read around the
+ * body of every timed sample and reported per operation and, for searches,
+ * per node. Without them (not Linux, no permission) the runner says so once
+ * and reports times only.
+ *
+ * With allocs on, heap allocations (alloc_counter.h) are counted over the
+ * timed samples and reported per operation. A benchmark marked
+ * allocationFree that allocates fails: the runner records one more sample
+ * with call stacks and keeps the report in its result.
+ */
+
+// Keep a value (and the work producing it) from being optimized away
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// What one call to a benchmark body did
+struct Work {
+    uint64_t ops = 0;    // Operations timed: ns/op is per these
+    uint64_t nodes = 0;  // Search nodes (searches only), reported as nodes/s
+};
+
+struct Benchmark {
+    std::string name;                             // "group/case", e.g. "movegen/midgame"
+    std::function<Work(uint64_t iterations)> run;
+    std::function<void()> setup;                  // Before every sample, untimed (optional)
+    uint64_t iterations = 0;                      // Per sample; 0 = calibrate to minSampleMs
+    bool allocationFree = false;                  // Hot path: must not allocate once warmed up
+
+    Benchmark() = default;
+    Benchmark(std::string name, std::function<Work(uint64_t)> run, std::function<void()> setup = nullptr)
+        : name(std::move(name)), run(std::move(run)), setup(std::move(setup)) {}
+};
+
+/**
+ * Runner options
+ */
+struct BenchOptions {
+    int repetitions = 20;       // Timed samples per benchmark
+    int warmup = 3;             // Untimed samples after calibration
+    double minSampleMs = 20.0;  // Shortest sample; the iteration count is scaled up to it
+    std::string filter;         // Run only benchmarks whose name contains this
+    bool counters = false;      // Read hardware counters around each timed sample
+    bool allocs = false;        // Count heap allocations in each timed sample
+
+    BenchOptions() = default;
+};
+
+// A hardware counter over all timed samples
+struct CounterRatio {
+    PerfCounters::Counter counter;
+    double perOp = 0.0;
+    double perNode = 0.0;  // Searches only
+};
+
+/**
+ * One benchmark's numbers (ns per operation over the timed samples)
+ */
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;     // Per sample
+    uint64_t opsPerSample = 0;
+    std::vector<double> samples; // ns/op, sorted
+    double min = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double nodesPerOp = 0.0;     // Searches only
+    std::vector<CounterRatio> counters;  // Open counters (none without BenchOptions::counters)
+    double ipc = 0.0;            // Instructions per cycle, if both were counted
+    bool allocsCounted = false;  // BenchOptions::allocs
+    double allocsPerOp = 0.0;
+    double allocBytesPerOp = 0.0;
+    std::string allocationReport;  // Allocation sites, if an allocationFree benchmark allocated
+
+    double opsPerSec() const { return p50 > 0.0 ? 1e9 / p50 : 0.0; }
+    double nodesPerSec() const { return p50 > 0.0 ? nodesPerOp * 1e9 / p50 : 0.0; }
+};
+
+// Nearest-rank percentile (0-100) of sorted values
+double percentile(const std::vector<double>& sorted, double pct);
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options = BenchOptions());
+
+    void add(Benchmark benchmark);
+    const std::vector<Benchmark>& getBenchmarks() const { return benchmarks; }
+
+    // Run every benchmark matching the filter, printing a table row per
+    // benchmark to `log` as it finishes
+    std::vector<BenchResult> runAll(std::ostream& log);
+
+    // Calibrate, warm up and time one benchmark
+    BenchResult run(const Benchmark& benchmark);
+
+    // {"suite":..., "context":{...}, "benchmarks":[...]}; context adds
+    // compiler, SIMD kernels, hardware threads, date and the options
+    void writeJson(std::ostream& out, const std::string& suite, const std::vector<BenchResult>& results,
+                   const std::vector<std::pair<std::string, std::string>>& context = {}) const;
+
+    static void printHeader(std::ostream& log);
+    static void printRow(std::ostream& log, const BenchResult& result);
+
+    // Null unless options.counters
+    const PerfCounters* getCounters() const { return counters.get(); }
+
+private:
+    BenchOptions options;
+    std::vector<Benchmark> benchmarks;
+    std::unique_ptr<PerfCounters> counters;
+
+    double timeSample(const Benchmark& benchmark, uint64_t iterations, Work& work, bool count,
+                      AllocationStats* allocs = nullptr, bool recordSites = false);
+};
+
+} // namespace bench
+} // namespace hexuki
+
+#endif // HEXUKI_BENCH_HARNESS_H
@@ -0,0 +1,385 @@
+/**
+ * bench_micro - microbenchmarks for board, transposition table and search primitives
+ *
+ * Usage:
+ *   bench_micro [options]
+ *
+ * Options:
+ *   --filter TEXT     Run only benchmarks whose name contains TEXT
+ *   --reps N          Timed samples per benchmark (default 20)
+ *   --warmup N        Untimed samples before timing (default 3)
+ *   --min-time MS     Shortest sample; iteration counts are scaled up to it (default 20)
+ *   --quick           --reps 5 --warmup 1 --min-time 5 (smoke runs)
+ *   --tt-sizes LIST   Table sizes in MB for the TT benchmarks (default 1,16,256)
+ *   --counters        Hardware counters per operation/node (Linux perf_event_open;
+ *                     timing only where they are unavailable)
+ *   --allocs          Heap allocations per operation; fails (exit 1, with call
+ *                     stacks) if a hot-path benchmark allocates
+ *   --json FILE       Also write the results as JSON ('-' = stdout, table to stderr)
+ *   --list            Print the benchmark names and exit
+ *
+ * Board primitives run over the opening, midgame and endgame positions of
+ * bench_corpus.cpp; their ns/op is per position (per move for make_unmake,
+ * per candidate move for is_valid_move). Searches run one pass over a phase's
+ * positions per sample, minimax from a cleared table, so every sample does
+ * the same work; they also report nodes (MCTS: simulations) per second.
+ *
+ * Hot-path benchmarks (everything search runs per node or per rollout step)
+ * are marked allocation-free; tests/test_zero_alloc.cpp checks the same
+ * paths on every ctest run.
+ */
+
+#include "bench_corpus.h"
+#include "bench_harness.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include "core/bitboard.h"
+#include "core/board_kernels.h"
+#include "core/zobrist.h"
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+using namespace hexuki::bench;
+
+static void printUsage() {
+    std::cerr << "Usage: bench_micro [--filter TEXT] [--reps N] [--warmup N] [--min-time MS] [--quick]"
+              << " [--tt-sizes 1,16,256] [--counters] [--allocs] [--json FILE] [--list]\n";
+}
+
+// A benchmark of something search does per node: --allocs fails if it allocates
+static void addHotPath(BenchRunner& runner, Benchmark benchmark) {
+    benchmark.allocationFree = true;
+    runner.add(std::move(benchmark));
+}
+
+// ============================================================================
+// Board primitives
+// ============================================================================
+
+static void addBoardBenchmarks(BenchRunner& runner, Phase phase) {
+    std::string suffix = std::string("/") + phaseName(phase);
+    auto boards = std::make_shared<std::vector<HexukiBitboard>>(corpus(phase));
+    size_t n = boards->size();
+
+    runner.add({"movegen" + suffix, [boards, n](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            std::vector<Move> moves = (*boards)[i % n].getValidMoves();
+            doNotOptimize(moves.data());
+        }
+        return Work{iterations};
+    }});
+
+    addHotPath(runner, {"legal_mask" + suffix, [boards, n](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            doNotOptimize((*boards)[i % n].getLegalHexMask());
+        }
+        return Work{iterations};
+    }});
+
+    // Every (hex, tile value) pair, legal or not
+    addHotPath(runner, {"is_valid_move" + suffix, [boards, n](uint64_t iterations) {
+        uint64_t checks = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const HexukiBitboard& board = (*boards)[i % n];
+            for (int hex = 0; hex < NUM_HEXES; hex++) {
+                for (int tile = 1; tile <= 9; tile++) {
+                    doNotOptimize(board.isValidMove(Move(hex, tile)));
+                }
+            }
+            checks += NUM_HEXES * 9;
+        }
+        return Work{checks};
+    }});
+
+    // Every legal move of the position, made and unmade in place
+    auto working = std::make_shared<std::vector<HexukiBitboard>>(*boards);
+    auto moveLists = std::make_shared<std::vector<std::vector<Move>>>();
+    for (const HexukiBitboard& board : *boards) moveLists->push_back(board.getValidMoves());
+    addHotPath(runner, {"make_unmake" + suffix, [working, moveLists, n](uint64_t iterations) {
+        uint64_t moves = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            HexukiBitboard& board = (*working)[i % n];
+            for (const Move& move : (*moveLists)[i % n]) {
+                board.makeMove(move);
+                doNotOptimize(board.getHash());
+                board.unmakeMove(move);
+            }
+            moves += (*moveLists)[i % n].size();
+        }
+        return Work{moves};
+    }});
+
+    addHotPath(runner, {"score" + suffix, [boards, n](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            int p1 = 0;
+            int p2 = 0;
+            (*boards)[i % n].getScores(p1, p2);
+            doNotOptimize(p1 - p2);
+        }
+        return Work{iterations};
+    }});
+
+    addHotPath(runner, {"evaluate" + suffix, [boards, n](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            doNotOptimize(minimax::evaluate((*boards)[i % n]));
+        }
+        return Work{iterations};
+    }});
+
+    // Full recomputation (makeMove updates the hash incrementally)
+    runner.add({"hash" + suffix, [boards, n](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            doNotOptimize(Zobrist::hash((*boards)[i % n]));
+        }
+        return Work{iterations};
+    }});
+
+    // Uniformly random moves to the end of the game, drawn from the legal
+    // hex mask as MCTS rollouts do, on a board copied into in place (as
+    // MCTS::step does, so the tile lists are not reallocated)
+    auto rng = std::make_shared<std::mt19937>(1);
+    auto rolloutBoard = std::make_shared<HexukiBitboard>();
+    addHotPath(runner, {"rollout" + suffix, [boards, n, rng, rolloutBoard](uint64_t iterations) {
+        HexukiBitboard& board = *rolloutBoard;
+        for (uint64_t i = 0; i < iterations; i++) {
+            board = (*boards)[i % n];
+            while (!board.isGameOver()) {
+                uint32_t legal = board.getLegalHexMask();
+                int tiles[NUM_TILES_PER_PLAYER];
+                int tileCount = board.getUniqueTiles(tiles);
+                int moveCount = kernels::popCount(legal) * tileCount;
+                if (moveCount == 0) break;
+                int index = static_cast<int>((static_cast<uint64_t>((*rng)()) * moveCount) >> 32);
+                board.makeMove(Move(kernels::nthSetBit(legal, index / tileCount), tiles[index % tileCount]));
+            }
+            int p1 = 0;
+            int p2 = 0;
+            board.getScores(p1, p2);
+            doNotOptimize(p1 - p2);
+        }
+        return Work{iterations};
+    }});
+}
+
+// ============================================================================
+// Transposition table
+// ============================================================================
+
+// A table filled with `keys`, allocated on first use so filtered-out sizes
+// cost nothing
+struct TableFixture {
+    size_t sizeMB;
+    std::unique_ptr<minimax::TranspositionTable> table;
+    std::vector<uint64_t> keys;    // Stored
+    std::vector<uint64_t> absent;  // Never stored
+
+    explicit TableFixture(size_t sizeMB) : sizeMB(sizeMB) {}
+
+    minimax::TranspositionTable& get() {
+        if (!table) {
+            table = std::make_unique<minimax::TranspositionTable>(sizeMB);
+            // Half the slots, at most 1M keys: beyond the caches for large tables
+            size_t count = std::min<size_t>(size_t(1) << 20, table->getSize() / 2);
+            std::mt19937_64 rng(sizeMB);
+            keys.resize(count);
+            absent.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                keys[i] = rng();
+                absent[i] = rng();
+            }
+            fill();
+        }
+        return *table;
+    }
+
+    void fill() {
+        for (size_t i = 0; i < keys.size(); i++) {
+            table->store(keys[i], minimax::TTEntry(static_cast<int>(i & 1023), 4, minimax::TTEntry::EXACT,
+                                                   Move(static_cast<int>(i % NUM_HEXES), 5)));
+        }
+    }
+};
+
+static void addTableBenchmarks(BenchRunner& runner, size_t sizeMB) {
+    std::string suffix = "/" + std::to_string(sizeMB) + "MB";
+    auto fixture = std::make_shared<TableFixture>(sizeMB);
+
+    addHotPath(runner, {"tt_store" + suffix, [fixture](uint64_t iterations) {
+        minimax::TranspositionTable& tt = fixture->get();
+        const std::vector<uint64_t>& keys = fixture->keys;
+        minimax::TTEntry entry(17, 6, minimax::TTEntry::LOWER_BOUND, Move(3, 7));
+        for (uint64_t i = 0; i < iterations; i++) {
+            tt.store(keys[i % keys.size()], entry);
+        }
+        return Work{iterations};
+    }});
+
+    addHotPath(runner, {"tt_probe_hit" + suffix, [fixture](uint64_t iterations) {
+        minimax::TranspositionTable& tt = fixture->get();
+        const std::vector<uint64_t>& keys = fixture->keys;
+        minimax::TTEntry entry;
+        for (uint64_t i = 0; i < iterations; i++) {
+            doNotOptimize(tt.probe(keys[i % keys.size()], entry));
+        }
+        doNotOptimize(entry.score);
+        return Work{iterations};
+    }});
+
+    addHotPath(runner, {"tt_probe_miss" + suffix, [fixture](uint64_t iterations) {
+        minimax::TranspositionTable& tt = fixture->get();
+        const std::vector<uint64_t>& absent = fixture->absent;
+        minimax::TTEntry entry;
+        for (uint64_t i = 0; i < iterations; i++) {
+            doNotOptimize(tt.probe(absent[i % absent.size()], entry));
+        }
+        return Work{iterations};
+    }});
+}
+
+// ============================================================================
+// Searches
+// ============================================================================
+
+// Fixed-depth minimax over every position of the phase, from a cleared table
+static void addMinimaxBenchmark(BenchRunner& runner, Phase phase, int depth) {
+    auto boards = std::make_shared<std::vector<HexukiBitboard>>(corpus(phase));
+    auto tt = std::make_shared<std::unique_ptr<minimax::TranspositionTable>>();
+
+    Benchmark benchmark;
+    benchmark.name = "minimax_d" + std::to_string(depth) + "/" + phaseName(phase);
+    benchmark.iterations = 1;
+    benchmark.setup = [tt]() {
+        if (!*tt) *tt = std::make_unique<minimax::TranspositionTable>(16);
+        (*tt)->clear();
+    };
+    benchmark.run = [boards, tt, depth](uint64_t iterations) {
+        minimax::SearchConfig config;
+        config.maxDepth = depth;
+        config.timeLimitMs = 1 << 30;
+        Work work;
+        for (uint64_t pass = 0; pass < iterations; pass++) {
+            for (const HexukiBitboard& board : *boards) {
+                minimax::SearchTask task(board, config, tt->get());
+                while (!task.step(1 << 20)) {}
+                work.nodes += task.getResult().nodesSearched;
+                work.ops++;
+            }
+        }
+        return work;
+    };
+    runner.add(benchmark);
+}
+
+// Seeded fixed-simulation MCTS over every position of the phase
+static void addMctsBenchmark(BenchRunner& runner, Phase phase, int sims) {
+    auto boards = std::make_shared<std::vector<HexukiBitboard>>(corpus(phase));
+    auto engine = std::make_shared<mcts::MCTS>();
+
+    Benchmark benchmark("mcts_" + std::to_string(sims) + "/" + phaseName(phase), [boards, engine, sims](uint64_t iterations) {
+        mcts::MCTSConfig config;
+        config.numSimulations = sims;
+        config.useTimeLimit = false;
+        config.seed = 1;
+        Work work;
+        for (uint64_t pass = 0; pass < iterations; pass++) {
+            for (const HexukiBitboard& board : *boards) {
+                HexukiBitboard copy = board;
+                work.nodes += engine->findBestMove(copy, config).simulations;
+                work.ops++;
+            }
+        }
+        return work;
+    });
+    benchmark.iterations = 1;
+    runner.add(benchmark);
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    std::vector<size_t> tableSizes = {1, 16, 256};
+    std::string jsonPath;
+    bool list = false;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--filter" && hasValue) {
+                options.filter = argv[++i];
+            } else if (arg == "--reps" && hasValue) {
+                options.repetitions = std::stoi(argv[++i]);
+            } else if (arg == "--warmup" && hasValue) {
+                options.warmup = std::stoi(argv[++i]);
+            } else if (arg == "--min-time" && hasValue) {
+                options.minSampleMs = std::stod(argv[++i]);
+            } else if (arg == "--quick") {
+                options.repetitions = 5;
+                options.warmup = 1;
+                options.minSampleMs = 5.0;
+            } else if (arg == "--tt-sizes" && hasValue) {
+                tableSizes.clear();
+                std::istringstream sizes(argv[++i]);
+                std::string size;
+                while (std::getline(sizes, size, ',')) tableSizes.push_back(std::stoul(size));
+            } else if (arg == "--counters") {
+                options.counters = true;
+            } else if (arg == "--allocs") {
+                options.allocs = true;
+            } else if (arg == "--json" && hasValue) {
+                jsonPath = argv[++i];
+            } else if (arg == "--list") {
+                list = true;
+            } else {
+                printUsage();
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage();
+        return 1;
+    }
+
+    BenchRunner runner(options);
+    for (Phase phase : ALL_PHASES) addBoardBenchmarks(runner, phase);
+    for (size_t sizeMB : tableSizes) addTableBenchmarks(runner, sizeMB);
+    addMinimaxBenchmark(runner, Phase::OPENING, 3);
+    addMinimaxBenchmark(runner, Phase::MIDGAME, 4);
+    addMinimaxBenchmark(runner, Phase::ENDGAME, 6);  // To the end of the game
+    for (Phase phase : ALL_PHASES) addMctsBenchmark(runner, phase, 1000);
+
+    if (list) {
+        for (const Benchmark& benchmark : runner.getBenchmarks()) std::cout << benchmark.name << "\n";
+        return 0;
+    }
+
+    // With JSON on stdout the table goes to stderr
+    std::ostream& log = jsonPath == "-" ? std::cerr : std::cout;
+    log << "Kernels: " << kernels::simdName() << " | Reps: " << options.repetitions
+        << " | Warmup: " << options.warmup << " | Min sample: " << options.minSampleMs << " ms\n\n";
+    std::vector<BenchResult> results = runner.runAll(log);
+
+    if (jsonPath == "-") {
+        runner.writeJson(std::cout, "bench_micro", results);
+    } else if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "Cannot open output file: " << jsonPath << "\n";
+            return 1;
+        }
+        runner.writeJson(file, "bench_micro", results);
+    }
+
+    for (const BenchResult& result : results) {
+        if (!result.allocationReport.empty()) {
+            std::cerr << "Hot path allocates: " << result.name << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
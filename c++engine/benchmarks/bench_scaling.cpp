@@ -0,0 +1,481 @@
+/**
+ * bench_scaling - thread-scaling curve of every parallel mode
+ *
+ * Usage:
+ *   bench_scaling [options]
+ *
+ * Options:
+ *   --modes LIST      Modes to run (default minimax,mcts,selfplay,perft,batch)
+ *   --threads LIST    Thread counts (default 1, 2, 4, ... up to the hardware
+ *                     threads, plus the hardware thread count itself)
+ *   --max-threads N   Default list up to N instead of the hardware threads
+ *   --reps N          Timed runs per thread count, after one warmup run; the
+ *                     median time counts (default 3)
+ *   --quick           Smaller workloads, --reps 1 (smoke runs)
+ *   --json FILE       Also write the results as JSON ('-' = stdout, tables to stderr)
+ *
+ * Every mode runs the same fixed workload at each thread count:
+ *   minimax   parallel root split (SearchConfig::numThreads) to a fixed depth
+ *             over the midgame corpus
+ *   mcts      root-parallel trees (MCTSConfig::numThreads) sharing a fixed
+ *             simulation budget over the opening corpus
+ *   selfplay  seeded MCTS-vs-MCTS games, one game per task
+ *   perft     leaf count to a fixed depth, one task per root move
+ *   batch     tools::BatchAnalyzer (hexuki_analyze) over the whole corpus
+ *
+ * For each thread count the table shows the median wall time, throughput,
+ * speedup and efficiency (speedup / threads) against one thread. Search
+ * modes also show the time to solution per position, the node overhead
+ * (minimax nodes searched versus one thread: split tables and lost pruning)
+ * and how many answers agree with the single-thread run (minimax: exact
+ * scores, which must all agree; MCTS: best moves). Self-play and perft are
+ * deterministic, so their answers must agree too.
+ *
+ * "N threads" means N threads working: the pool gets N - 1 workers and the
+ * thread waiting for the work runs tasks as well.
+ */
+
+#include "bench_corpus.h"
+#include "bench_harness.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include "core/bitboard.h"
+#include "core/board_kernels.h"
+#include "core/thread_pool.h"
+#include "tools/batch_analysis.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hexuki;
+using namespace hexuki::bench;
+
+using Clock = std::chrono::steady_clock;
+
+static void printUsage() {
+    std::cerr << "Usage: bench_scaling [--modes minimax,mcts,selfplay,perft,batch] [--threads 1,2,4]"
+              << " [--max-threads N] [--reps N] [--quick] [--json FILE]\n";
+}
+
+// What one run of a mode did
+struct Sample {
+    double work = 0.0;                 // Units of the mode's throughput
+    uint64_t nodes = 0;                // Minimax nodes (node overhead)
+    std::vector<std::string> answers;  // Compared with the single-thread run
+};
+
+struct Mode {
+    std::string name;
+    std::string workload;  // Description for the table title
+    std::string unit;      // Throughput unit ("nodes", "sims", ...)
+    size_t positions = 0;  // Search modes: time to solution is per position
+    bool exact = false;    // Answers must match the single-thread run
+    std::function<Sample(int threads, ThreadPool& pool)> run;
+};
+
+struct ScalingRow {
+    int threads = 0;
+    double ms = 0.0;        // Median wall time
+    double throughput = 0.0;
+    double speedup = 0.0;
+    double efficiency = 0.0;
+    double nodeOverhead = 0.0;  // 0: not a minimax mode
+    size_t agree = 0;
+    size_t answers = 0;
+};
+
+// ============================================================================
+// Modes
+// ============================================================================
+
+static Mode minimaxMode(int depth) {
+    auto boards = std::make_shared<std::vector<HexukiBitboard>>(corpus(Phase::MIDGAME));
+    Mode mode;
+    mode.name = "minimax";
+    mode.workload = std::to_string(boards->size()) + " midgame positions to depth " + std::to_string(depth);
+    mode.unit = "nodes";
+    mode.positions = boards->size();
+    mode.exact = true;
+    mode.run = [boards, depth](int threads, ThreadPool&) {
+        minimax::SearchConfig config;
+        config.maxDepth = depth;
+        config.timeLimitMs = INT_MAX;
+        config.ttSizeMB = 64;
+        config.numThreads = threads;
+        Sample sample;
+        for (const HexukiBitboard& position : *boards) {
+            HexukiBitboard board = position;
+            minimax::SearchResult result = minimax::findBestMove(board, config);
+            sample.nodes += static_cast<uint64_t>(result.nodesSearched);
+            sample.answers.push_back(std::to_string(result.score));
+        }
+        sample.work = static_cast<double>(sample.nodes);
+        return sample;
+    };
+    return mode;
+}
+
+static Mode mctsMode(int sims) {
+    auto boards = std::make_shared<std::vector<HexukiBitboard>>(corpus(Phase::OPENING));
+    auto engine = std::make_shared<mcts::MCTS>();
+    Mode mode;
+    mode.name = "mcts";
+    mode.workload = std::to_string(boards->size()) + " opening positions, " + std::to_string(sims) +
+                    " simulations each";
+    mode.unit = "sims";
+    mode.positions = boards->size();
+    mode.run = [boards, engine, sims](int threads, ThreadPool&) {
+        mcts::MCTSConfig config;
+        config.numSimulations = sims;
+        config.useTimeLimit = false;
+        config.seed = 1;
+        config.numThreads = threads;
+        Sample sample;
+        for (const HexukiBitboard& position : *boards) {
+            HexukiBitboard board = position;
+            mcts::MCTSResult result = engine->findBestMove(board, config);
+            sample.work += result.simulations;
+            sample.answers.push_back(result.bestMove.toString());
+        }
+        return sample;
+    };
+    return mode;
+}
+
+// One MCTS engine per thread that runs tasks (as BatchAnalyzer keeps them)
+static std::vector<std::unique_ptr<mcts::MCTS>> enginesFor(const ThreadPool& pool) {
+    std::vector<std::unique_ptr<mcts::MCTS>> engines;
+    for (int i = 0; i <= pool.size(); i++) engines.push_back(std::make_unique<mcts::MCTS>());
+    return engines;
+}
+
+static Mode selfPlayMode(int games, int simsPerMove) {
+    auto openings = std::make_shared<std::vector<HexukiBitboard>>(corpus(Phase::OPENING));
+    Mode mode;
+    mode.name = "selfplay";
+    mode.workload = std::to_string(games) + " games, " + std::to_string(simsPerMove) + " simulations per move";
+    mode.unit = "games";
+    mode.exact = true;
+    mode.run = [openings, games, simsPerMove](int, ThreadPool& pool) {
+        std::vector<std::unique_ptr<mcts::MCTS>> engines = enginesFor(pool);
+        std::vector<std::string> results(static_cast<size_t>(games));
+        parallelFor(0, results.size(), 1, [&](size_t game) {
+            mcts::MCTS& engine = *engines[pool.currentWorkerIndex() + 1];
+            HexukiBitboard board = (*openings)[game % openings->size()];
+            mcts::MCTSConfig config;
+            config.numSimulations = simsPerMove;
+            config.useTimeLimit = false;
+            for (int ply = 0; !board.isGameOver(); ply++) {
+                config.seed = static_cast<uint32_t>(1 + game * 100 + ply);
+                mcts::MCTSResult result = engine.findBestMove(board, config);
+                if (!result.bestMove.isValid()) break;
+                board.makeMove(result.bestMove);
+            }
+            int p1 = 0;
+            int p2 = 0;
+            board.getScores(p1, p2);
+            results[game] = std::to_string(p1) + "-" + std::to_string(p2);
+        }, pool);
+
+        Sample sample;
+        sample.work = games;
+        sample.answers = results;
+        return sample;
+    };
+    return mode;
+}
+
+static uint64_t perft(HexukiBitboard& board, int depth) {
+    if (depth == 0) return 1;
+    Move moves[MAX_LEGAL_MOVES];
+    int count = board.getValidMoves(moves);
+    if (depth == 1) return static_cast<uint64_t>(count);
+    uint64_t leaves = 0;
+    for (int i = 0; i < count; i++) {
+        board.makeMove(moves[i]);
+        leaves += perft(board, depth - 1);
+        board.unmakeMove(moves[i]);
+    }
+    return leaves;
+}
+
+static Mode perftMode(int depth) {
+    // Every opening position: a few hundred root moves to split evenly
+    auto roots = std::make_shared<std::vector<HexukiBitboard>>(corpus(Phase::OPENING));
+    Mode mode;
+    mode.name = "perft";
+    mode.workload = std::to_string(roots->size()) + " opening positions to depth " + std::to_string(depth);
+    mode.unit = "leaves";
+    mode.exact = true;
+    mode.run = [roots, depth](int, ThreadPool& pool) {
+        std::vector<std::pair<size_t, Move>> tasks;
+        for (size_t r = 0; r < roots->size(); r++) {
+            for (const Move& move : (*roots)[r].getValidMoves()) tasks.push_back({r, move});
+        }
+        std::vector<uint64_t> leaves(tasks.size());
+        parallelFor(0, tasks.size(), 1, [&](size_t i) {
+            HexukiBitboard board = (*roots)[tasks[i].first];
+            board.makeMove(tasks[i].second);
+            leaves[i] = perft(board, depth - 1);
+        }, pool);
+
+        Sample sample;
+        std::vector<uint64_t> perRoot(roots->size(), 0);
+        for (size_t i = 0; i < tasks.size(); i++) perRoot[tasks[i].first] += leaves[i];
+        for (uint64_t count : perRoot) {
+            sample.work += static_cast<double>(count);
+            sample.answers.push_back(std::to_string(count));
+        }
+        return sample;
+    };
+    return mode;
+}
+
+static Mode batchMode(int depth, int copies) {
+    std::ostringstream input;
+    size_t count = 0;
+    for (int copy = 0; copy < copies; copy++) {
+        for (Phase phase : ALL_PHASES) {
+            for (const HexukiBitboard& board : corpus(phase)) {
+                input << board.savePosition() << "\n";
+                count++;
+            }
+        }
+    }
+    auto text = std::make_shared<std::string>(input.str());
+    Mode mode;
+    mode.name = "batch";
+    mode.workload = std::to_string(count) + " positions, minimax depth " + std::to_string(depth);
+    mode.unit = "positions";
+    mode.run = [text, depth](int, ThreadPool& pool) {
+        tools::AnalysisConfig config;
+        config.engine = tools::AnalysisEngine::MINIMAX;
+        config.depth = depth;
+        config.ttSizeMB = 64;
+        config.verbose = false;
+        tools::BatchAnalyzer analyzer(config, pool);
+        std::istringstream in(*text);
+        tools::PositionReader reader(in, tools::PositionFormat::TEXT);
+        std::ostringstream out;
+        tools::AnalysisStats stats = analyzer.run(reader, out);
+
+        Sample sample;
+        sample.work = static_cast<double>(stats.analyzed);
+        sample.nodes = stats.nodes;
+        return sample;
+    };
+    return mode;
+}
+
+// ============================================================================
+// Running
+// ============================================================================
+
+static std::vector<ScalingRow> runMode(const Mode& mode, const std::vector<int>& threadCounts, int reps,
+                                       std::ostream& log, bool& mismatch) {
+    log << mode.name << ": " << mode.workload << "\n";
+    log << std::right << std::setw(7) << "threads" << std::setw(12) << "time" << std::setw(12)
+        << (mode.positions > 0 ? "per pos" : "") << std::setw(16) << (mode.unit + "/s") << std::setw(9)
+        << "speedup" << std::setw(12) << "efficiency" << std::setw(9) << (mode.name == "minimax" ? "nodes" : "")
+        << std::setw(9) << "agree" << "\n";
+
+    std::vector<ScalingRow> rows;
+    std::vector<std::string> baseline;
+    double baseMs = 0.0;
+    uint64_t baseNodes = 0;
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads > 1 ? threads - 1 : ThreadPool::NO_WORKERS);
+        std::vector<double> times;
+        Sample sample = mode.run(threads, pool);  // Warmup: tables leased and faulted in, trees grown
+        for (int rep = 0; rep < std::max(1, reps); rep++) {
+            Clock::time_point start = Clock::now();
+            sample = mode.run(threads, pool);
+            times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+
+        ScalingRow row;
+        row.threads = threads;
+        row.ms = percentile(times, 50);
+        row.throughput = row.ms > 0.0 ? sample.work * 1000.0 / row.ms : 0.0;
+        if (rows.empty()) {
+            baseline = sample.answers;
+            baseMs = row.ms;
+            baseNodes = sample.nodes;
+        }
+        row.speedup = row.ms > 0.0 ? baseMs / row.ms : 0.0;
+        row.efficiency = row.speedup / threads;
+        if (mode.name == "minimax" && baseNodes > 0) {
+            row.nodeOverhead = static_cast<double>(sample.nodes) / baseNodes;
+        }
+        row.answers = sample.answers.size();
+        for (size_t i = 0; i < sample.answers.size() && i < baseline.size(); i++) {
+            row.agree += sample.answers[i] == baseline[i] ? 1 : 0;
+        }
+        if (mode.exact && row.agree != row.answers) mismatch = true;
+        rows.push_back(row);
+
+        std::ostringstream perPos;
+        if (mode.positions > 0) perPos << std::fixed << std::setprecision(1) << row.ms / mode.positions << " ms";
+        std::ostringstream time;
+        time << std::fixed << std::setprecision(1) << row.ms << " ms";
+        log << std::setw(7) << threads << std::setw(12) << time.str() << std::setw(12) << perPos.str()
+            << std::setw(16) << static_cast<uint64_t>(row.throughput) << std::fixed << std::setprecision(2)
+            << std::setw(9) << row.speedup << std::setw(11) << std::setprecision(0) << row.efficiency * 100.0
+            << "%" << std::setprecision(2);
+        if (row.nodeOverhead > 0.0) {
+            log << std::setw(9) << row.nodeOverhead;
+        } else {
+            log << std::setw(9) << "";
+        }
+        std::string agree = row.answers > 0 ? std::to_string(row.agree) + "/" + std::to_string(row.answers) : "";
+        log << std::setw(9) << agree << std::defaultfloat << (mode.exact && row.agree != row.answers ? "  MISMATCH" : "")
+            << "\n" << std::flush;
+    }
+    log << "\n";
+    return rows;
+}
+
+static std::vector<int> defaultThreadCounts(int maxThreads) {
+    std::vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+static std::string jsonQuote(const std::string& s) {
+    return "\"" + s + "\"";  // Mode names and units only
+}
+
+static void writeJson(std::ostream& out, const std::vector<Mode>& modes,
+                      const std::vector<std::vector<ScalingRow>>& results, int reps) {
+    out << std::setprecision(6);
+    out << "{\n  \"suite\": \"bench_scaling\",\n  \"context\": {\n";
+    out << "    \"simd\": " << jsonQuote(kernels::simdName()) << ",\n";
+    out << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"repetitions\": " << reps << "\n  },\n  \"modes\": [";
+    for (size_t m = 0; m < modes.size(); m++) {
+        out << (m ? "," : "") << "\n    {\"mode\": " << jsonQuote(modes[m].name)
+            << ", \"workload\": " << jsonQuote(modes[m].workload) << ", \"unit\": " << jsonQuote(modes[m].unit)
+            << ", \"runs\": [";
+        for (size_t r = 0; r < results[m].size(); r++) {
+            const ScalingRow& row = results[m][r];
+            out << (r ? ", " : "") << "\n      {\"threads\": " << row.threads << ", \"ms\": " << row.ms
+                << ", \"throughput\": " << row.throughput << ", \"speedup\": " << row.speedup
+                << ", \"efficiency\": " << row.efficiency;
+            if (modes[m].positions > 0) out << ", \"ms_per_position\": " << row.ms / modes[m].positions;
+            if (row.nodeOverhead > 0.0) out << ", \"node_overhead\": " << row.nodeOverhead;
+            if (row.answers > 0) out << ", \"agree\": " << row.agree << ", \"answers\": " << row.answers;
+            out << "}";
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string modeList = "minimax,mcts,selfplay,perft,batch";
+    std::vector<int> threadCounts;
+    int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int reps = 3;
+    bool quick = false;
+    std::string jsonPath;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--modes" && hasValue) {
+                modeList = argv[++i];
+            } else if (arg == "--threads" && hasValue) {
+                std::istringstream counts(argv[++i]);
+                std::string count;
+                while (std::getline(counts, count, ',')) threadCounts.push_back(std::stoi(count));
+            } else if (arg == "--max-threads" && hasValue) {
+                maxThreads = std::stoi(argv[++i]);
+            } else if (arg == "--reps" && hasValue) {
+                reps = std::stoi(argv[++i]);
+            } else if (arg == "--quick") {
+                quick = true;
+                reps = 1;
+            } else if (arg == "--json" && hasValue) {
+                jsonPath = argv[++i];
+            } else {
+                printUsage();
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage();
+        return 1;
+    }
+    if (threadCounts.empty()) threadCounts = defaultThreadCounts(std::max(1, maxThreads));
+    for (int threads : threadCounts) {
+        if (threads < 1) {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Minimax and MCTS split their work on the global pool: give it room for
+    // the largest count (their numThreads bounds how much of it they use)
+    int mostThreads = *std::max_element(threadCounts.begin(), threadCounts.end());
+    ThreadPool::configureGlobal(mostThreads > 1 ? mostThreads - 1 : ThreadPool::NO_WORKERS);
+
+    std::vector<Mode> modes;
+    std::istringstream names(modeList);
+    std::string name;
+    while (std::getline(names, name, ',')) {
+        if (name == "minimax") {
+            modes.push_back(minimaxMode(quick ? 4 : 6));
+        } else if (name == "mcts") {
+            modes.push_back(mctsMode(quick ? 2000 : 20000));
+        } else if (name == "selfplay") {
+            modes.push_back(selfPlayMode(quick ? 4 : 16, quick ? 100 : 500));
+        } else if (name == "perft") {
+            modes.push_back(perftMode(quick ? 3 : 4));
+        } else if (name == "batch") {
+            modes.push_back(batchMode(quick ? 3 : 5, quick ? 1 : 4));
+        } else {
+            std::cerr << "Unknown mode: " << name << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    // With JSON on stdout the tables go to stderr
+    std::ostream& log = jsonPath == "-" ? std::cerr : std::cout;
+    log << "Kernels: " << kernels::simdName() << " | Hardware threads: " << std::thread::hardware_concurrency()
+        << " | Reps: " << reps << "\n\n";
+
+    bool mismatch = false;
+    std::vector<std::vector<ScalingRow>> results;
+    for (const Mode& mode : modes) results.push_back(runMode(mode, threadCounts, reps, log, mismatch));
+
+    if (jsonPath == "-") {
+        writeJson(std::cout, modes, results, reps);
+    } else if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "Cannot open output file: " << jsonPath << "\n";
+            return 1;
+        }
+        writeJson(file, modes, results, reps);
+    }
+
+    if (mismatch) {
+        std::cerr << "Results differ between thread counts (see MISMATCH above)\n";
+        return 1;
+    }
+    return 0;
+}
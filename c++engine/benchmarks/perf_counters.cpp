@@ -0,0 +1,120 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hexuki {
+namespace bench {
+
+const char* PerfCounters::name(Counter counter) {
+    switch (counter) {
+        case CYCLES:        return "cycles";
+        case INSTRUCTIONS:  return "instructions";
+        case CACHE_MISSES:  return "cache_misses";
+        case BRANCH_MISSES: return "branch_misses";
+        case DTLB_MISSES:   return "dtlb_misses";
+        default:            return "";
+    }
+}
+
+#ifdef __linux__
+
+static int openCounter(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;  // User space only: allowed at perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+PerfCounters::PerfCounters() {
+    static const struct {
+        uint32_t type;
+        uint64_t config;
+    } events[NUM_COUNTERS] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    };
+
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        values[i] = 0.0;
+        fds[i] = openCounter(events[i].type, events[i].config);
+        if (fds[i] < 0 && error.empty()) {
+            error = std::string("perf_event_open(") + name(static_cast<Counter>(i)) + "): " + std::strerror(errno);
+            if (errno == EACCES || errno == EPERM) error += " (see /proc/sys/kernel/perf_event_paranoid)";
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void PerfCounters::stop() {
+    for (int fd : fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        values[i] = 0.0;
+        uint64_t data[3];  // value, time enabled, time running
+        if (fds[i] < 0 || read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        // Scale up a multiplexed counter to the whole region
+        values[i] = data[2] > 0 ? static_cast<double>(data[0]) * data[1] / data[2] : 0.0;
+    }
+}
+
+#else
+
+PerfCounters::PerfCounters() : error("hardware counters need Linux perf_event_open") {
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        fds[i] = -1;
+        values[i] = 0.0;
+    }
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+void PerfCounters::stop() {}
+
+#endif
+
+bool PerfCounters::available() const {
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+bool PerfCounters::isOpen(Counter counter) const {
+    return fds[counter] >= 0;
+}
+
+} // namespace bench
+} // namespace hexuki
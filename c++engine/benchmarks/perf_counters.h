@@ -0,0 +1,55 @@
+#ifndef HEXUKI_PERF_COUNTERS_H
+#define HEXUKI_PERF_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+namespace hexuki {
+namespace bench {
+
+/**
+ * Hardware performance counters around a code region (Linux perf_event_open)
+ *
+ * Counts user-space cycles, instructions, last-level cache misses, branch
+ * misses and dTLB load misses of the calling thread between start() and
+ * stop(). Each counter is opened on its own, so one the CPU or kernel does
+ * not support (dTLB events on many VMs) is skipped without losing the
+ * others. Counts are scaled by enabled/running time when the kernel
+ * multiplexes them.
+ *
+ * Counters are unavailable on other platforms, in most containers, and
+ * where kernel.perf_event_paranoid forbids user-space counting; then
+ * available() is false, getError() says why, and start()/stop() do nothing.
+ */
+class PerfCounters {
+public:
+    enum Counter { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, DTLB_MISSES, NUM_COUNTERS };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;                   // At least one counter opened
+    bool isOpen(Counter counter) const;
+    const std::string& getError() const { return error; }  // Why counters are missing
+
+    void start();  // Reset and enable
+    void stop();   // Disable and read
+
+    // Count of the last start()/stop() region (0 if the counter is not open)
+    double value(Counter counter) const { return values[counter]; }
+
+    static const char* name(Counter counter);  // "cycles", "instructions", ...
+
+private:
+    int fds[NUM_COUNTERS];
+    double values[NUM_COUNTERS];
+    std::string error;
+};
+
+} // namespace bench
+} // namespace hexuki
+
+#endif // HEXUKI_PERF_COUNTERS_H
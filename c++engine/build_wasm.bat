@@ -27,31 +27,25 @@ echo.
 REM Create wasm output directory
 if not exist "wasm" mkdir wasm
 
-REM Compile all source files to WebAssembly
-emcc ^
-  -O3 ^
-  -std=c++17 ^
-  -I include ^
-  src/core/bitboard.cpp ^
-  src/core/move.cpp ^
-  src/core/zobrist.cpp ^
-  src/ai/mcts.cpp ^
-  src/ai/mcts_node.cpp ^
-  src/ai/minimax.cpp ^
-  src/wasm_interface.cpp ^
-  -s WASM=1 ^
-  -s ALLOW_MEMORY_GROWTH=1 ^
-  -s MODULARIZE=1 ^
-  -s EXPORT_NAME="'HexukiWasm'" ^
-  -s ENVIRONMENT=web ^
-  -s ASSERTIONS=0 ^
-  -s DISABLE_EXCEPTION_CATCHING=1 ^
-  -s NO_FILESYSTEM=1 ^
-  -s AGGRESSIVE_VARIABLE_ELIMINATION=1 ^
-  --closure 1 ^
-  -flto ^
-  -lembind ^
-  -o wasm/hexuki.js
+REM Sources and flags shared by all builds
+set SOURCES=src/core/bitboard.cpp src/core/board_kernels.cpp src/core/move.cpp src/core/zobrist.cpp src/core/large_pages.cpp src/core/thread_pool.cpp src/ai/mcts.cpp src/ai/mcts_node.cpp src/ai/minimax.cpp src/api/engine_instance.cpp src/api/result_layout.cpp src/api/batch_ops.cpp src/wasm_interface.cpp
+set FLAGS=-O3 -std=c++17 -I include -s WASM=1 -s ALLOW_MEMORY_GROWTH=1 -s MODULARIZE=1 -s EXPORT_NAME="'HexukiWasm'" -s ENVIRONMENT=web,node -s EXPORTED_RUNTIME_METHODS="['UTF8ToString','HEAP32','HEAPF64']" -s ASSERTIONS=0 -s DISABLE_EXCEPTION_CATCHING=1 -s NO_FILESYSTEM=1 -s AGGRESSIVE_VARIABLE_ELIMINATION=1 --closure 1 -flto -lembind
+
+REM Baseline build: scalar kernels, runs in every browser
+echo Building scalar module (wasm/hexuki.js)...
+emcc %FLAGS% -DHEXUKI_NO_SIMD %SOURCES% -o wasm/hexuki.js
+if %ERRORLEVEL% NEQ 0 goto :failed
+
+REM SIMD128 build: vectorized board kernels for browsers with WASM SIMD
+echo Building SIMD128 module (wasm/hexuki_simd.js)...
+emcc %FLAGS% -msimd128 %SOURCES% -o wasm/hexuki_simd.js
+if %ERRORLEVEL% NEQ 0 goto :failed
+
+REM Multithreaded build: SIMD128 + pthreads (web workers on SharedArrayBuffer)
+REM for parallel MCTS/minimax. Needs a cross-origin isolated page; the pool
+REM size matches HEXUKI_WASM_MAX_THREADS - 1 (the calling thread searches too).
+echo Building multithreaded module (wasm/hexuki_mt.js)...
+emcc %FLAGS% -msimd128 -pthread -s ENVIRONMENT=web,worker,node -s PTHREAD_POOL_SIZE=3 -DHEXUKI_WASM_MAX_THREADS=4 %SOURCES% -o wasm/hexuki_mt.js
 
 if %ERRORLEVEL% EQU 0 (
     echo.
@@ -59,17 +53,25 @@ if %ERRORLEVEL% EQU 0 (
     echo Build successful!
     echo ============================================
     echo Output files:
-    echo   wasm/hexuki.js   - JavaScript glue code
-    echo   wasm/hexuki.wasm - WebAssembly binary
+    echo   wasm/hexuki.js        - JavaScript glue code (scalar)
+    echo   wasm/hexuki.wasm      - WebAssembly binary (scalar)
+    echo   wasm/hexuki_simd.js   - JavaScript glue code (SIMD128)
+    echo   wasm/hexuki_simd.wasm - WebAssembly binary (SIMD128)
+    echo   wasm/hexuki_mt.js     - JavaScript glue code (SIMD128 + threads)
+    echo   wasm/hexuki_mt.wasm   - WebAssembly binary (SIMD128 + threads)
     echo.
     echo Next steps:
     echo 1. Copy wasm/* to your web server directory
     echo 2. Load hexuki.js in your HTML
     echo 3. Call HexukiWasm() to initialize
-) else (
-    echo.
-    echo ============================================
-    echo Build failed!
-    echo ============================================
-    exit /b 1
+    echo 4. Optional: node tests/wasm/simd_parity.js
+    echo 5. Optional: node tests/wasm/threads_parity.js
+    exit /b 0
 )
+
+:failed
+echo.
+echo ============================================
+echo Build failed!
+echo ============================================
+exit /b 1
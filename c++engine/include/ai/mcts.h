@@ -5,8 +5,11 @@
 #include "core/move.h"
 #include "ai/mcts_node.h"
 #include "ai/minimax.h"
-#include <random>
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
 
 namespace hexuki {
 namespace mcts {
@@ -25,6 +28,16 @@ struct MCTSConfig {
     bool useMinimaxRollouts = false;  // Use minimax for endgame evaluation
     int minimaxThreshold = 7;         // Switch to minimax at this many empty hexes
 
+    // Root parallelization (findBestMove only): numThreads independent trees
+    // share the simulation budget on the global thread pool and their root
+    // statistics are merged. The result depends on numThreads, not on how
+    // many workers the pool actually has.
+    int numThreads = 1;
+
+    // Random seed (0 = random). With a seed and a simulation count the
+    // search is reproducible; tree i of a parallel search uses seed + i.
+    uint32_t seed = 0;
+
     MCTSConfig() = default;
 };
 
@@ -83,15 +96,48 @@ public:
     MCTSResult findBestMove(HexukiBitboard& board, int simulations);
     MCTSResult findBestMoveWithTime(HexukiBitboard& board, int timeLimitMs);
 
+    /**
+     * Resumable search: findBestMove() split into begin/step/result so a
+     * scheduler can interleave many searches on a few threads
+     *
+     * beginSearch() copies the board and resets the tree; step() runs up to
+     * maxSimulations more and returns true once the configured limit
+     * (simulations or time since beginSearch) is reached; getResult() can be
+     * read at any point. These always search a single tree (numThreads is
+     * ignored). endSearch() returns the rollout table to the pool once the
+     * search is done or abandoned; the tree and getResult() stay valid.
+     */
+    void beginSearch(const HexukiBitboard& board, const MCTSConfig& config = MCTSConfig());
+    bool step(int maxSimulations);
+    MCTSResult getResult() const;
+    void endSearch();
+
 private:
+    NodeArena nodes;   // Owns every node of the current tree
     MCTSNode* root;
     std::mt19937 rng;  // Random number generator for simulations
     int rootPlayer;    // Player to move at root (1 or 2)
-    const MCTSConfig* currentConfig;  // Current search configuration
+    MCTSConfig currentConfig;  // Current search configuration
+
+    // Resumable search state
+    HexukiBitboard rootBoard;
+    HexukiBitboard simBoard;  // Working copy of rootBoard for each simulation
+    int simulations;
+    std::chrono::steady_clock::time_point startTime;
 
     // Shared minimax transposition table for rollout evaluation
-    // Reused across all simulations for speed (cache hit rate improves over time)
-    minimax::TranspositionTable* sharedMinimaxTT;
+    // Reused across all simulations for speed (cache hit rate improves over time).
+    // Leased from the global TablePool for each search with minimax rollouts
+    // and returned by endSearch(); the pool keeps it for the next search.
+    static constexpr size_t ROLLOUT_TT_MB = 128;
+    minimax::TableLease rolloutTT;
+
+    // Extra trees for root-parallel searches, kept between searches
+    std::vector<std::unique_ptr<MCTS>> helpers;
+
+    MCTSResult findBestMoveParallel(HexukiBitboard& board, const MCTSConfig& config);
+    void searchTree(const HexukiBitboard& board, const MCTSConfig& config,
+                    std::chrono::steady_clock::time_point start);
 
     // MCTS phases
     MCTSNode* select(MCTSNode* node, HexukiBitboard& board);
@@ -108,9 +154,6 @@ private:
     // Helper: evaluate terminal position (final score)
     double evaluateTerminal(const HexukiBitboard& board) const;
 
-    // Helper: select random move for simulation
-    Move selectRandomMove(const std::vector<Move>& moves);
-
     // Cleanup
     void resetTree();
 };
@@ -1,6 +1,7 @@
 #ifndef HEXUKI_MCTS_NODE_H
 #define HEXUKI_MCTS_NODE_H
 
+#include "core/large_pages.h"
 #include "core/move.h"
 #include <vector>
 #include <memory>
@@ -8,6 +9,8 @@
 namespace hexuki {
 namespace mcts {
 
+class NodeArena;
+
 /**
  * MCTS Tree Node
  *
@@ -19,9 +22,6 @@ public:
     // Constructor
     MCTSNode(MCTSNode* parent = nullptr, const Move& move = Move());
 
-    // Destructor (cleanup children)
-    ~MCTSNode();
-
     // Tree structure
     MCTSNode* parent;
     std::vector<MCTSNode*> children;
@@ -48,8 +48,8 @@ public:
     // Select best child using UCT
     MCTSNode* selectBestChild(double explorationConstant) const;
 
-    // Add a child node for a given move
-    MCTSNode* addChild(const Move& move);
+    // Add a child node for a given move (allocated from the tree's arena)
+    MCTSNode* addChild(const Move& move, NodeArena& arena);
 
     // Get average score (wins per visit)
     double getAverageScore() const {
@@ -58,9 +58,47 @@ public:
 
     // Update statistics after simulation
     void update(double score);
+};
+
+/**
+ * Node storage for one search tree
+ *
+ * Nodes are bump-allocated from large-page chunks instead of individually
+ * with new, so a big tree sits in a few 2MB pages and freeing it is one pass
+ * over the chunks. Chunks are kept across reset() for the next search, and
+ * charged to the TablePool budget until the arena is destroyed.
+ */
+class NodeArena {
+public:
+#ifdef __EMSCRIPTEN__
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 2 * 1024 * 1024;   // Small budgets: grow a page at a time
+#else
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 16 * 1024 * 1024;
+#endif
+
+    explicit NodeArena(size_t chunkBytes = DEFAULT_CHUNK_BYTES, const LargePageConfig& pages = largePageDefaults());
+    ~NodeArena();
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    MCTSNode* create(MCTSNode* parent = nullptr, const Move& move = Move());
+
+    // Destroy every node
+    void reset();
+
+    size_t getNodeCount() const { return count; }
+    size_t getReservedBytes() const { return reservedBytes; }  // Mapped by the chunks
+
+private:
+    std::vector<LargePageBuffer> chunks;
+    size_t chunkBytes;
+    size_t nodesPerChunk;
+    size_t count;
+    size_t reservedBytes;
+    LargePageConfig pages;
 
-    // Delete all children (for memory cleanup)
-    void deleteChildren();
+    MCTSNode* slot(size_t index) const;
 };
 
 } // namespace mcts
@@ -2,9 +2,13 @@
 #define HEXUKI_MINIMAX_H
 
 #include "core/bitboard.h"
+#include "core/large_pages.h"
 #include "core/move.h"
-#include <unordered_map>
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace hexuki {
 namespace minimax {
@@ -28,24 +32,153 @@ struct TTEntry {
 
 /**
  * Transposition Table (hash table for board positions)
+ *
+ * Fixed-size, power-of-two array of 16-byte slots indexed by the low hash bits.
+ * Each slot holds (hash ^ data, data) so it can be shared between search threads
+ * without locks: a torn write from another thread simply fails the key check and
+ * reads as a miss (lockless hashing, Hyatt/Mann).
  */
 class TranspositionTable {
 public:
-    TranspositionTable(size_t sizeMB = 128);  // Default: 128MB table
+    // Default: 128MB table, backed by large pages where available
+    TranspositionTable(size_t sizeMB = 128, const LargePageConfig& pages = largePageDefaults());
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
 
     void store(uint64_t hash, const TTEntry& entry);
     bool probe(uint64_t hash, TTEntry& entry) const;
     void clear();
 
-    size_t getSize() const { return table.size(); }
-    size_t getHits() const { return hits; }
-    size_t getMisses() const { return misses; }
+    size_t getSize() const { return numSlots; }  // Capacity in entries
+    size_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    size_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+    const LargePageBuffer& getMemory() const { return memory; }  // Backing and allocation timing
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key;   // hash ^ data
+        std::atomic<uint64_t> data;  // Packed TTEntry (0 = empty)
+    };
+
+    LargePageBuffer memory;
+    Slot* slots;
+    size_t numSlots;
+    uint64_t mask;
+    std::atomic<bool> dirty;  // Anything stored since last clear()
+
+    // Approximate counters: relaxed load+store (no lock prefix) so concurrent
+    // searches don't serialize on them. May drop a few counts under contention.
+    mutable std::atomic<size_t> hits;
+    mutable std::atomic<size_t> misses;
+
+    static uint64_t pack(const TTEntry& entry);
+    static TTEntry unpack(uint64_t data);
+};
+
+/**
+ * Budgeted pool of transposition tables
+ *
+ * The tables the engines allocate for themselves (minimax searches, MCTS
+ * minimax rollouts) come from here instead of new. Nothing is allocated
+ * until a search needs a table, a released table is kept and handed
+ * (cleared) to the next search asking for the same size, and all tables -
+ * in use or pooled - stay within one memory budget, counted in the bytes
+ * actually mapped: a request that does not fit gets a smaller table (pooled
+ * tables are freed first), and once not even MIN_TABLE_MB fits it shares a
+ * table already in use (tables are safe to share between searches). Only
+ * when there is nothing to share does a MIN_TABLE_MB table go over budget.
+ * Table sizes are powers of two MB, at least MIN_TABLE_MB. Other engine
+ * memory (MCTS node chunks) is charged to the same budget; tables a caller
+ * constructs itself (shared tables passed to SearchTask, the labeller's)
+ * are not counted.
+ */
+class TablePool;
+
+// A table on loan from a TablePool; returned when the last lease holding it
+// is destroyed or reset
+class TableLease {
+public:
+    TableLease() = default;
+    TableLease(TableLease&& other) noexcept;
+    TableLease& operator=(TableLease&& other) noexcept;
+
+    TranspositionTable* get() const { return table.get(); }
+    TranspositionTable& operator*() const { return *table; }
+    TranspositionTable* operator->() const { return table.get(); }
+    explicit operator bool() const { return table != nullptr; }
+
+    size_t getSizeMB() const { return sizeMB; }
+    bool isShared() const { return shared; }  // Budget exhausted: another search's table
+    void reset();
+
+private:
+    friend class TablePool;
+    std::shared_ptr<TranspositionTable> table;  // Deleter returns it to the pool
+    size_t sizeMB = 0;
+    bool shared = false;
+};
+
+class TablePool {
+public:
+    static constexpr size_t MIN_TABLE_MB = 2;  // One large page: smaller tables map 2MB anyway
+#ifdef __EMSCRIPTEN__
+    static constexpr size_t DEFAULT_BUDGET_MB = 64;    // Browser tabs, mobile
+#else
+    static constexpr size_t DEFAULT_BUDGET_MB = 1024;
+#endif
+
+    explicit TablePool(size_t budgetMB = DEFAULT_BUDGET_MB);
+    ~TablePool();
+
+    TablePool(const TablePool&) = delete;
+    TablePool& operator=(const TablePool&) = delete;
+
+    // A cleared table of up to sizeMB (less if the budget is short, shared
+    // and not cleared if it is exhausted)
+    TableLease acquire(size_t sizeMB);
+
+    // Frees pooled tables that no longer fit; leased tables shrink the
+    // budget left for new ones but are not taken back. At least MIN_TABLE_MB.
+    void setBudgetMB(size_t budgetMB);
+    size_t getBudgetMB() const;
+    size_t getAllocatedMB() const;  // Tables leased + pooled
+    size_t getLeasedMB() const;
+
+    // Engine memory outside the tables: never refused, but tables shrink
+    // (and pooled ones are freed) to keep the total within the budget
+    void charge(size_t bytes);
+    void uncharge(size_t bytes);
+    size_t getChargedMB() const;
+
+    // Free every pooled (not leased) table
+    void trim();
+
+    // Process-wide pool used by the engines
+    static TablePool& global();
 
 private:
-    std::unordered_map<uint64_t, TTEntry> table;
-    size_t maxSize;
-    mutable size_t hits;
-    mutable size_t misses;
+    struct Pooled {
+        size_t sizeMB;
+        std::unique_ptr<TranspositionTable> table;
+    };
+    struct Leased {
+        size_t sizeMB;
+        std::weak_ptr<TranspositionTable> table;
+    };
+
+    mutable std::mutex mutex;
+    size_t budgetBytes;
+    size_t allocatedBytes;  // Tables leased + pooled
+    size_t leasedBytes;
+    size_t chargedBytes;
+    std::vector<Pooled> pooled;
+    std::vector<Leased> leased;  // Candidates for sharing
+
+    static size_t tableBytes(size_t sizeMB);
+    bool shareLeased(TableLease& lease);
+    void release(size_t sizeMB, std::unique_ptr<TranspositionTable> table);
+    void freePooledUntil(size_t allocatedLimitBytes, std::vector<Pooled>& freed);
 };
 
 /**
@@ -76,9 +209,17 @@ struct SearchConfig {
     bool useIterativeDeepening = true;  // Start shallow, go deeper
     bool useMoveOrdering = true;    // Order moves to improve pruning
     bool useTranspositionTable = true;  // Cache positions
-    size_t ttSizeMB = 128;          // Transposition table size
+    size_t ttSizeMB = 128;          // Transposition table size (up to, see TablePool)
     bool verbose = false;           // Print search info
 
+    // Root split (findBestMove only): the root moves are divided between
+    // numThreads tasks on the global thread pool, each with its own table of
+    // up to ttSizeMB / numThreads. Root moves get exact scores, so the score is
+    // the same as a single-threaded search and the best move is the first
+    // best-scoring root move in generation order. Results depend on
+    // numThreads, not on how many workers the pool actually has.
+    int numThreads = 1;
+
     SearchConfig() = default;
 };
 
@@ -86,7 +227,7 @@ struct SearchConfig {
  * Main minimax search function with alpha-beta pruning
  *
  * @param board Current game state
- * @param config Search configuration
+ * @param config Search configuration (numThreads > 1: parallel root split)
  * @return Search result with best move and statistics
  */
 SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config = SearchConfig());
@@ -207,6 +348,7 @@ int quiescence(
  * Uses killer move and history heuristics for fast ordering
  */
 void orderMoves(std::vector<Move>& moves, const TTEntry* ttEntry, const KillerMoves& killers, const HistoryTable& history, int ply);
+void orderMoves(Move* moves, int count, const TTEntry* ttEntry, const KillerMoves& killers, const HistoryTable& history, int ply);
 
 /**
  * Simple evaluation function
@@ -214,6 +356,95 @@ void orderMoves(std::vector<Move>& moves, const TTEntry* ttEntry, const KillerMo
  */
 int evaluate(const HexukiBitboard& board);
 
+/**
+ * Resumable search (the driver behind findBestMove)
+ *
+ * Same iterative-deepening alpha-beta as alphaBeta(), but the recursion is
+ * kept on an explicit stack so the search can stop after any node and resume
+ * later. Many analyses can then share a few threads (see SearchScheduler):
+ * suspending costs nothing but returning from step().
+ *
+ * The time limit counts from the first step(). getResult() always holds the
+ * last completed depth; a depth interrupted by the time limit or stop() is
+ * discarded, as in findBestMove.
+ */
+class SearchTask {
+public:
+    // sharedTT: table to search with (may be shared between tasks);
+    // nullptr leases a table of up to config.ttSizeMB from TablePool::global()
+    SearchTask(const HexukiBitboard& board, const SearchConfig& config = SearchConfig(),
+               TranspositionTable* sharedTT = nullptr);
+
+    SearchTask(const SearchTask&) = delete;
+    SearchTask& operator=(const SearchTask&) = delete;
+
+    // Search at most maxNodes more nodes; returns true once the search is finished
+    bool step(int maxNodes);
+
+    // Finish now, keeping the last completed depth
+    void stop();
+
+    bool isDone() const { return done; }
+    const SearchResult& getResult() const { return result; }
+    int getCurrentDepth() const { return passDepth; }
+
+private:
+    // One alphaBeta() activation
+    struct Frame {
+        int depth;
+        int alpha;
+        int beta;
+        int ply;
+        uint64_t hash;
+        Move moves[MAX_LEGAL_MOVES];
+        int moveCount;
+        int next;                // Move being searched
+        int bestScore;
+        Move bestMove;
+        TTEntry::Flag flag;
+    };
+
+    HexukiBitboard board;
+    SearchConfig config;
+    TableLease ownTT;
+    TranspositionTable* tt;
+    KillerMoves killers;
+    HistoryTable history;
+
+    std::vector<Frame> stack;
+    int stackSize;
+
+    // Root state for the current depth ("pass")
+    std::vector<Move> rootMoves;
+    size_t rootIndex;
+    int rootAlpha;
+    int passDepth;
+    int passNodes;
+    int stepNodes;
+    int childPly;
+    Move passBestMove;
+    int passBestScore;
+
+    // Trace span starts (core/trace.h; 0 when not tracing)
+    uint64_t passTraceStart;
+    uint64_t rootMoveTraceStart;
+
+    bool started;
+    bool done;
+    int nextTimeCheck;
+    std::chrono::steady_clock::time_point startTime;
+    SearchResult result;
+
+    void startPass(int depth);
+    void finishRootMove(int score);
+    void finishPass();
+    void abortPass();
+    void finish();
+    bool timeExpired() const;
+    bool enter(int depth, int alpha, int beta, int ply, int& value);
+    void childReturned(Frame& frame, int score);
+};
+
 } // namespace minimax
 } // namespace hexuki
 
@@ -0,0 +1,109 @@
+#ifndef HEXUKI_SEARCH_SCHEDULER_H
+#define HEXUKI_SEARCH_SCHEDULER_H
+
+#include "core/thread_pool.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace hexuki {
+
+/**
+ * Per-task scheduling options
+ */
+struct ScheduledTaskOptions {
+    int priority = 1;         // Relative share of work (>= 1)
+    uint64_t budget = 0;      // Total work units before stopping (0 = unlimited)
+    int sliceUnits = 4096;    // Work units per slice before yielding
+
+    ScheduledTaskOptions() = default;
+};
+
+/**
+ * Time-slicing scheduler for resumable searches
+ *
+ * Interleaves many searches (minimax::SearchTask, mcts::MCTS::step) on at
+ * most maxRunning pool threads. Each task is a step function that does up
+ * to N units of work (nodes or simulations) and returns true when finished:
+ *
+ *   auto task = std::make_shared<minimax::SearchTask>(board, config, &sharedTT);
+ *   scheduler.submit([task](int units) { return task->step(units); }, options,
+ *                    [task](uint64_t id, SearchScheduler::Outcome) { report(task->getResult()); });
+ *
+ * Scheduling is stride-based: a task is charged units / priority for every
+ * slice, and the least-charged ready task runs next. A priority-3 task thus
+ * gets three times the work of a priority-1 task, and nothing starves.
+ * Suspended tasks hold no thread, so thousands can be queued cheaply.
+ */
+class SearchScheduler {
+public:
+    using StepFunction = std::function<bool(int maxUnits)>;
+
+    enum class Outcome {
+        FINISHED,          // Step function reported completion
+        BUDGET_EXHAUSTED,  // Per-task work budget used up
+        CANCELLED,         // cancel() or scheduler destroyed
+        FAILED             // Step function threw
+    };
+
+    using DoneCallback = std::function<void(uint64_t id, Outcome outcome)>;
+
+    using TaskOptions = ScheduledTaskOptions;
+
+    // maxRunning = 0: one slice per pool worker
+    explicit SearchScheduler(int maxRunning = 0, ThreadPool& pool = ThreadPool::global());
+    ~SearchScheduler();  // Cancels queued tasks and waits for running slices
+
+    SearchScheduler(const SearchScheduler&) = delete;
+    SearchScheduler& operator=(const SearchScheduler&) = delete;
+
+    // onDone runs on a pool thread (or in cancel()/the destructor) exactly once
+    uint64_t submit(StepFunction step, const TaskOptions& options = TaskOptions(),
+                    DoneCallback onDone = nullptr);
+
+    // Returns false if the task already finished. A running task stops at the
+    // end of its current slice.
+    bool cancel(uint64_t id);
+
+    // Block until every submitted task has finished
+    void waitIdle();
+
+    size_t getTaskCount() const;
+    uint64_t getSlicesRun() const;
+
+private:
+    struct Task {
+        uint64_t id;
+        StepFunction step;
+        DoneCallback onDone;
+        TaskOptions options;
+        uint64_t used;      // Work units consumed
+        double pass;        // Virtual time charged so far
+        bool running;
+        bool cancelled;
+    };
+
+    ThreadPool& pool;
+    int maxRunning;
+
+    mutable std::mutex mutex;
+    std::condition_variable idle;
+    std::map<uint64_t, std::shared_ptr<Task>> tasks;
+    std::set<std::pair<double, uint64_t>> ready;  // (pass, id), least charged first
+    double virtualTime;   // Pass of the most recently dispatched task
+    int running;
+    uint64_t nextId;
+    uint64_t slicesRun;
+
+    void dispatch(std::unique_lock<std::mutex>& lock);
+    void runSlice(const std::shared_ptr<Task>& task);
+};
+
+} // namespace hexuki
+
+#endif // HEXUKI_SEARCH_SCHEDULER_H
@@ -0,0 +1,203 @@
+#ifndef HEXUKI_ANALYSIS_SERVER_H
+#define HEXUKI_ANALYSIS_SERVER_H
+
+#include "core/bitboard.h"
+#include "ai/minimax.h"
+#include "ai/search_scheduler.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hexuki {
+namespace api {
+
+/**
+ * Analysis server configuration
+ */
+struct ServerConfig {
+    std::string socketPath;         // Unix domain socket path; empty = localhost TCP
+    int port = 0;                   // TCP port on 127.0.0.1 (0 = any free port)
+    int maxRunning = 0;             // Concurrent search slices (0 = one per pool worker)
+    size_t hashMB = 256;            // Minimax table shared by every request
+    int maxBatch = 64;              // moves/eval requests answered per batch task
+    int defaultDeadlineMs = 10000;  // Deadline when a request gives none
+    int maxDeadlineMs = 600000;
+
+    ServerConfig() = default;
+};
+
+/**
+ * Monitoring counters (the "stats" request returns these as JSON)
+ *
+ * Latencies are measured from receipt of the request line to its response;
+ * queue time is receipt to first slice (searches) or to its batch (moves,
+ * eval). Percentiles cover the last LATENCY_WINDOW responses.
+ */
+struct ServerStats {
+    uint64_t received = 0;        // Request lines accepted
+    uint64_t completed = 0;       // Responses sent, errors included
+    uint64_t errors = 0;          // Malformed or failed requests
+    uint64_t deadlineHits = 0;    // Searches cut short by their deadline
+    uint64_t batches = 0;         // Batch tasks run
+    uint64_t batchedRequests = 0; // moves/eval requests answered in batches
+    size_t inFlight = 0;          // Received, not yet answered (queue depth)
+    size_t maxInFlight = 0;
+    size_t scheduledTasks = 0;    // Searches and batches on the scheduler
+    size_t batchPending = 0;      // moves/eval requests waiting for a batch
+    size_t connections = 0;       // Open client connections
+
+    double latencyP50Ms = 0.0;
+    double latencyP90Ms = 0.0;
+    double latencyP99Ms = 0.0;
+    double latencyMaxMs = 0.0;
+    double queueP50Ms = 0.0;
+    double queueP99Ms = 0.0;
+};
+
+/**
+ * Long-lived local analysis service (hexuki_engine serve)
+ *
+ * Clients connect over a Unix domain socket or localhost TCP and send one
+ * request per line; each request gets exactly one JSON line back, tagged
+ * with the request's id. Requests on a connection may be pipelined and are
+ * answered as they finish, not in order.
+ *
+ *   <id> moves <pos>                    legal moves and scores
+ *   <id> eval <pos>                     static evaluation (side to move)
+ *   <id> analyze <pos> [engine minimax|mcts] [depth N] [sims N] [seed N] [deadline MS]
+ *   <id> solve <pos> [deadline MS]      minimax to the end of the game
+ *   <id> stats                          ServerStats
+ *
+ * <pos> is "startpos" or a savePosition() string. Deadlines count from
+ * receipt of the line, queueing included; a search that hits its deadline
+ * answers with its last completed depth ("complete":false), or with status
+ * "deadline" if it has none.
+ *
+ * Searches are resumable (minimax::SearchTask, MCTS::step) and time-sliced
+ * on a SearchScheduler over the global thread pool, so one long solve does
+ * not hold up short requests. All minimax searches share one transposition
+ * table, which stays warm across requests and clients. moves/eval requests
+ * are too small to schedule one by one: they are queued and answered up to
+ * maxBatch at a time by a single scheduler slice.
+ *
+ * handleRequest() is the transport-independent entry point; start() adds the
+ * socket listener. Sockets need POSIX (start() throws on Windows).
+ */
+class AnalysisServer {
+public:
+    using Reply = std::function<void(const std::string& line)>;
+
+    explicit AnalysisServer(const ServerConfig& config = ServerConfig());
+    ~AnalysisServer();  // stop(), then cancels outstanding requests
+
+    AnalysisServer(const AnalysisServer&) = delete;
+    AnalysisServer& operator=(const AnalysisServer&) = delete;
+
+    // Bind and listen, serving connections on a background thread
+    void start();
+
+    // Close the listener and all connections (pending responses are dropped)
+    void stop();
+
+    // Socket path, or "127.0.0.1:<port>" with the port actually bound
+    std::string getEndpoint() const;
+    int getPort() const { return boundPort; }
+
+    // Handle one request line; reply runs exactly once, possibly on another
+    // thread and possibly before this returns
+    void handleRequest(const std::string& line, Reply reply);
+
+    // Block until every received request has been answered
+    void waitIdle();
+
+    ServerStats getStats() const;
+
+    static constexpr size_t LATENCY_WINDOW = 4096;
+    static constexpr size_t MAX_LINE_BYTES = 64 * 1024;
+
+private:
+    enum class Kind { MOVES, EVAL, ANALYZE, SOLVE, STATS };
+
+    struct Request;
+    struct Connection;
+
+    ServerConfig config;
+    minimax::TableLease table;
+    std::unique_ptr<SearchScheduler> scheduler;
+
+    // Batched moves/eval requests
+    mutable std::mutex batchMutex;
+    std::vector<std::shared_ptr<Request>> batchQueue;
+    bool batchScheduled = false;
+    bool batchesClosed = false;     // Shutting down: no new batch tasks
+
+    // Monitoring
+    mutable std::mutex statsMutex;
+    std::condition_variable idle;
+    ServerStats counters;
+    std::vector<double> latencies;  // Ring buffers of the last LATENCY_WINDOW
+    std::vector<double> queueTimes;
+    size_t latencyNext = 0;
+
+    // Transport
+    std::atomic<bool> running;
+    int listenFd = -1;
+    int wakeFds[2] = {-1, -1};
+    int boundPort = 0;
+    std::thread ioThread;
+    mutable std::mutex connectionsMutex;
+    std::vector<std::shared_ptr<Connection>> connections;
+
+    std::shared_ptr<Request> parse(const std::string& line, std::chrono::steady_clock::time_point received);
+    void submitSearch(const std::shared_ptr<Request>& request);
+    void finishSearch(Request& request, SearchScheduler::Outcome outcome);
+    void enqueueBatch(const std::shared_ptr<Request>& request);
+    void submitBatch();
+    void runBatch();
+    void cancelBatches();
+
+    void markStarted(Request& request);
+    void complete(Request& request, const std::string& status, const std::string& fields);
+    std::string statsJson() const;
+
+    void ioLoop();
+    void closeAll();
+};
+
+/**
+ * Blocking client for AnalysisServer (tests, scripts, benchmarks)
+ */
+class AnalysisClient {
+public:
+    AnalysisClient() = default;
+    ~AnalysisClient();
+
+    AnalysisClient(const AnalysisClient&) = delete;
+    AnalysisClient& operator=(const AnalysisClient&) = delete;
+
+    void connectUnix(const std::string& path);
+    void connectTcp(int port);  // 127.0.0.1
+    void close();
+
+    void send(const std::string& line);
+    std::string receive();  // Next response line; throws if the server closed
+
+    // send() + receive(): only meaningful without other requests in flight
+    std::string request(const std::string& line);
+
+private:
+    int fd = -1;
+    std::string inbox;
+};
+
+} // namespace api
+} // namespace hexuki
+
+#endif // HEXUKI_ANALYSIS_SERVER_H
@@ -0,0 +1,71 @@
+#ifndef HEXUKI_BATCH_OPS_H
+#define HEXUKI_BATCH_OPS_H
+
+#include "core/bitboard.h"
+#include "core/move.h"
+#include "api/result_layout.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hexuki {
+namespace api {
+
+/**
+ * Rule operations over many positions at once, for the JS engine shim
+ * (hexuki_game_engine_wasm.js)
+ *
+ * The training pages are written against hexuki_game_engine_v2.js. Its rules
+ * are the engine's plus the anti-symmetry rule, which the engine no longer
+ * enforces: from the second move on, a move may not leave the board mirrored
+ * across the center column (every mirror pair empty or holding equal values).
+ * These functions apply that rule and keep the JS move order (hex by hex,
+ * tiles in hand order, duplicates included), so their results match the JS
+ * engine move for move.
+ *
+ * Positions and results are flat Int32 records (layouts in result_layout.h),
+ * so a whole batch crosses the WASM boundary in one call.
+ */
+
+// Position record <-> board. The JS moveCount has no bitboard equivalent
+// and is read from the record separately.
+HexukiBitboard unpackPosition(const int32_t* record);
+void packPosition(const HexukiBitboard& board, int moveCount, int32_t* record);
+
+// Field ranges only (hex values 0-9, player 1/2, tile counts and values);
+// unpackPosition() assumes a valid record
+bool isValidPositionRecord(const int32_t* record);
+
+// The same checks for a HexukiBitboard::savePosition() string (hex ids
+// 0-18, tile values 1-9, at most 9 tiles per hand, turn 1/2, no unknown
+// sections). loadPosition() trusts its input: validate strings from files,
+// sockets and other processes with this first.
+bool isValidPositionString(const std::string& position);
+
+// True if the board is mirrored across the center column
+bool isBoardMirrored(const HexukiBitboard& board);
+
+// Legal moves under the JS engine's rules, in its order
+void getV2ValidMoves(const HexukiBitboard& board, int moveCount, std::vector<Move>& moves);
+
+// The JS engine ends the game after 18 moves
+constexpr int V2_GAME_MOVES = 18;
+
+// Each writes one result per position into `out` (overwritten):
+//   batchValidMoves: move count, then that many (hexId, tileValue) pairs
+//   batchScores:     p1 score, p2 score
+//   batchPlayouts:   one PLAYOUT_STRIDE record
+// Records that fail isValidPositionRecord() get an empty result: no moves,
+// zero scores, a playout of no moves.
+void batchValidMoves(const int32_t* positions, int count, std::vector<int32_t>& out);
+void batchScores(const int32_t* positions, int count, std::vector<int32_t>& out);
+
+// Uniformly random legal moves until the JS engine would end the game or no
+// move is left. Position i uses seed + i, so results do not depend on how the
+// batch is split between threads.
+void batchPlayouts(const int32_t* positions, int count, uint32_t seed, std::vector<int32_t>& out);
+
+} // namespace api
+} // namespace hexuki
+
+#endif // HEXUKI_BATCH_OPS_H
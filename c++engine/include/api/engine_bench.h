@@ -0,0 +1,72 @@
+#ifndef HEXUKI_ENGINE_BENCH_H
+#define HEXUKI_ENGINE_BENCH_H
+
+#include "core/move.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hexuki {
+namespace api {
+
+/**
+ * hexuki_engine bench: fixed searches with a node-count signature
+ *
+ * Every bench position is searched by single-threaded minimax to a fixed
+ * depth (iterative deepening, from a cleared table of hashMB) and by
+ * seeded MCTS for a fixed number of simulations. With no time limits or
+ * threads involved, node counts and best moves depend only on the search
+ * code, so the signature (a hash of every node count, score, best move and
+ * visit count) is the same on every machine and build of the same search:
+ * a change that leaves it unchanged is search-neutral. Nodes per second
+ * (minimax nodes over minimax time) is the throughput number for comparing
+ * builds and machines.
+ */
+struct BenchConfig {
+    int depth = 5;        // Minimax depth (endgames end sooner)
+    int sims = 5000;      // MCTS simulations per position
+    uint32_t seed = 1;    // MCTS seed for every position
+    size_t hashMB = 16;   // Minimax table, cleared before each position
+
+    BenchConfig() = default;
+};
+
+struct BenchPositionResult {
+    std::string position;    // savePosition() / "startpos"
+    Move minimaxMove;
+    int score = 0;
+    int depth = 0;
+    uint64_t nodes = 0;
+    double minimaxMs = 0.0;
+    Move mctsMove;
+    int visits = 0;          // Visits of the MCTS best move
+    int sims = 0;
+    double mctsMs = 0.0;
+};
+
+struct BenchReport {
+    std::vector<BenchPositionResult> positions;
+    uint64_t nodes = 0;      // Minimax, all positions
+    uint64_t sims = 0;       // MCTS, all positions
+    uint64_t signature = 0;
+    double minimaxMs = 0.0;
+    double mctsMs = 0.0;
+
+    double nodesPerSecond() const { return minimaxMs > 0.0 ? nodes * 1000.0 / minimaxMs : 0.0; }
+    double simsPerSecond() const { return mctsMs > 0.0 ? sims * 1000.0 / mctsMs : 0.0; }
+};
+
+// The fixed positions (changing them changes every signature)
+const std::vector<std::string>& benchPositions();
+
+// Run the bench; with a log, one line per position as it finishes
+BenchReport runBench(const BenchConfig& config = BenchConfig(), std::ostream* log = nullptr);
+
+// The summary printed by hexuki_engine bench
+void printBenchReport(const BenchReport& report, const BenchConfig& config, std::ostream& out);
+
+} // namespace api
+} // namespace hexuki
+
+#endif // HEXUKI_ENGINE_BENCH_H
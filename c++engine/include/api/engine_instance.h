@@ -0,0 +1,149 @@
+#ifndef HEXUKI_ENGINE_INSTANCE_H
+#define HEXUKI_ENGINE_INSTANCE_H
+
+#include "core/bitboard.h"
+#include "core/move.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include "api/result_layout.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hexuki {
+namespace api {
+
+enum class SearchEngine {
+    NONE = 0,
+    MCTS = 1,
+    MINIMAX = 2
+};
+
+/**
+ * One independent game + engine, as seen by the embedding APIs (WASM, C ABI)
+ *
+ * Owns a board, the moves played on it (so any number can be undone) and an
+ * MCTS engine that is only created when first used.
+ *
+ * Besides the blocking run*() searches, an instance can hold one incremental
+ * search: begin*Search() snapshots the position, stepSearch() advances it by
+ * a time or work budget and returns, peek*() reads the current best move and
+ * finishSearch() ends it. This lets a single-threaded host (the browser main
+ * thread) interleave a long think with rendering. Changing the position or
+ * starting a blocking search abandons the incremental search.
+ */
+class EngineInstance {
+public:
+    EngineInstance();
+
+    const HexukiBitboard& getBoard() const { return board; }
+
+    // Both clear the move history: undo stops at the new starting point
+    void reset();
+    void loadPosition(const std::string& position);
+
+    bool makeMove(const Move& move);  // false (and no change) if illegal
+    bool undoMove();                  // false if there is nothing to undo
+
+    const std::vector<Move>& getHistory() const { return history; }
+
+    mcts::MCTS& getMCTS();
+
+    // Searches run on the current position and leave it unchanged
+    mcts::MCTSResult runMCTS(const mcts::MCTSConfig& config);
+    minimax::SearchResult runMinimax(int depth, int timeLimitMs);
+
+    // Applied to run*(): parallel trees / root split tasks (see numThreads in
+    // MCTSConfig and SearchConfig) and the MCTS seed (0 = random)
+    void setSearchThreads(int threads) { searchThreads = threads < 1 ? 1 : threads; }
+    int getSearchThreads() const { return searchThreads; }
+    void setSearchSeed(uint32_t seed) { searchSeed = seed; }
+
+    // Incremental search. Limits in the configs (time, simulations, depth)
+    // still apply; the time limit counts from begin*Search().
+    void beginMCTSSearch(const mcts::MCTSConfig& config);
+    void beginMinimaxSearch(const minimax::SearchConfig& config);
+
+    // Runs until budgetMs has elapsed or about maxWork simulations/nodes have
+    // been spent (<= 0: no limit of that kind; both <= 0: one small chunk).
+    // Returns true once the search is finished (or none is active).
+    bool stepSearch(double budgetMs, int maxWork);
+
+    SearchEngine getSearchEngine() const { return searchEngine; }
+    bool isSearchDone() const { return searchDone; }
+
+    // Best so far; for minimax this is the last completed depth
+    mcts::MCTSResult peekMCTS() const;
+    minimax::SearchResult peekMinimax() const;
+
+    // Stop now. Results stay readable through peek*() until the next search.
+    void finishSearch();
+
+    // Packed results (layouts in result_layout.h), written into buffers
+    // owned by the instance. Each call overwrites the previous contents of
+    // its buffer; the data stays valid until then.
+    const std::vector<int32_t>& packValidMoves();
+    const std::vector<double>& packResult(const mcts::MCTSResult& result);
+    const std::vector<double>& packResult(const minimax::SearchResult& result);
+    const std::vector<double>& packSearchState();  // Incremental search, as peek*()
+
+    const std::vector<int32_t>& getMoveBuffer() const { return moveBuffer; }
+    const std::vector<double>& getResultBuffer() const { return resultBuffer; }
+
+private:
+    // Work per step() call inside stepSearch(): small enough to check the
+    // clock often, large enough to keep the call overhead negligible
+    static constexpr int MCTS_STEP_CHUNK = 16;
+    static constexpr int MINIMAX_STEP_CHUNK = 2048;
+
+    HexukiBitboard board;
+    std::vector<Move> history;
+    std::unique_ptr<mcts::MCTS> mctsEngine;
+    int searchThreads = 1;
+    uint32_t searchSeed = 0;
+
+    SearchEngine searchEngine = SearchEngine::NONE;
+    bool searchDone = true;
+    std::unique_ptr<minimax::SearchTask> minimaxTask;
+    minimax::SearchResult minimaxFinal;
+
+    std::vector<int32_t> moveBuffer;
+    std::vector<double> resultBuffer;
+
+    void abandonSearch();
+};
+
+using InstanceHandle = int32_t;
+constexpr InstanceHandle INVALID_HANDLE = 0;
+
+/**
+ * Handle table for EngineInstances
+ *
+ * Handles are small positive integers so they pass through JS and C as
+ * plain numbers. They are never reused, so a stale handle fails cleanly
+ * instead of reaching another caller's instance.
+ */
+class InstanceRegistry {
+public:
+    InstanceHandle create();
+    bool destroy(InstanceHandle handle);
+
+    // nullptr for unknown handles. The pointer stays valid until destroy().
+    EngineInstance* get(InstanceHandle handle) const;
+
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<InstanceHandle, std::unique_ptr<EngineInstance>> instances;
+    InstanceHandle nextHandle = 1;
+};
+
+} // namespace api
+} // namespace hexuki
+
+#endif // HEXUKI_ENGINE_INSTANCE_H
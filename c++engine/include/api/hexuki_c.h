@@ -0,0 +1,122 @@
+#ifndef HEXUKI_C_H
+#define HEXUKI_C_H
+
+/**
+ * libhexuki - stable C ABI to the engine (target hexuki_shared)
+ *
+ * For hosts that cannot use the C++ headers: Python (ctypes, see
+ * hexuki_native.py in the repository root), other languages' FFIs, tools
+ * built with other compilers. Only C types cross the boundary:
+ *
+ * - Boards are opaque handles (one api::EngineInstance each).
+ * - Batch calls take arrays of packed positions (HEXUKI_POSITION_STRIDE
+ *   int32 values each, layout in api/result_layout.h, same records the WASM
+ *   batch calls use) and write into caller-allocated arrays, so a whole array
+ *   of positions crosses the boundary in one call.
+ * - Functions return HEXUKI_OK or a negative error code; no C++ exception
+ *   leaves the library. hexuki_last_error() describes the last failure on
+ *   the calling thread.
+ *
+ * ABI rules: functions and constants are only ever added. A change that
+ * breaks existing callers bumps HEXUKI_ABI_VERSION (and the library
+ * SOVERSION); callers should check hexuki_abi_version() at load time.
+ *
+ * Rules: the batch move generation, scoring and playout calls follow
+ * hexuki_game_engine_v2.js (anti-symmetry rule, 18-move games), like the
+ * JS engine shim. Searches use the engine's own rules.
+ */
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(HEXUKI_BUILDING_SHARED)
+#    define HEXUKI_API __declspec(dllexport)
+#  else
+#    define HEXUKI_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define HEXUKI_API __attribute__((visibility("default")))
+#else
+#  define HEXUKI_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HEXUKI_ABI_VERSION 1
+
+/* Return codes */
+#define HEXUKI_OK 0
+#define HEXUKI_ERROR_INVALID_ARGUMENT (-1)  /* Null pointer, bad count or malformed position */
+#define HEXUKI_ERROR_ILLEGAL_MOVE (-2)
+#define HEXUKI_ERROR_BUFFER_TOO_SMALL (-3)
+#define HEXUKI_ERROR_INTERNAL (-4)
+
+/* Record sizes (int32 values unless noted) */
+#define HEXUKI_POSITION_STRIDE 41       /* Packed position */
+#define HEXUKI_MAX_VALID_MOVES 171      /* 19 hexes x 9 tiles */
+#define HEXUKI_MOVES_STRIDE 343         /* Move count, then MAX_VALID_MOVES (hexId, tileValue) pairs */
+#define HEXUKI_SCORES_STRIDE 2          /* p1 score, p2 score */
+#define HEXUKI_PLAYOUT_STRIDE 41        /* p1 score, p2 score, move count, 19 (hexId, tileValue) pairs */
+#define HEXUKI_SEARCH_STRIDE 11         /* doubles: the SearchField header of result_layout.h */
+
+typedef struct hexuki_board hexuki_board;
+
+HEXUKI_API int hexuki_abi_version(void);
+
+/* Message for the last error on this thread ("" if none) */
+HEXUKI_API const char* hexuki_last_error(void);
+
+/* ------------------------------------------------------------------------
+ * Boards
+ * ------------------------------------------------------------------------ */
+
+/* Starting position. NULL if out of memory. */
+HEXUKI_API hexuki_board* hexuki_board_create(void);
+HEXUKI_API void hexuki_board_destroy(hexuki_board* board);
+
+/* Position string, e.g. "h9:1,h7:5|p1:1,2,3,4,6,7,8,9|p2:1,2,3,4,5,6,7,8,9|turn:2".
+ * HEXUKI_ERROR_INVALID_ARGUMENT (board unchanged) if malformed or out of range. */
+HEXUKI_API int hexuki_board_load(hexuki_board* board, const char* position);
+
+/* Writes the position string (NUL terminated) if it fits in capacity bytes;
+ * returns the length without the NUL, or HEXUKI_ERROR_BUFFER_TOO_SMALL */
+HEXUKI_API int hexuki_board_save(const hexuki_board* board, char* out, int capacity);
+
+HEXUKI_API int hexuki_board_make_move(hexuki_board* board, int hex_id, int tile_value);
+HEXUKI_API int hexuki_board_undo_move(hexuki_board* board);
+
+/* One packed position (HEXUKI_POSITION_STRIDE values); the move count is the
+ * number of moves made since the board was created, reset or loaded */
+HEXUKI_API int hexuki_board_pack(const hexuki_board* board, int32_t* record);
+
+/* Packed start position, for filling position arrays */
+HEXUKI_API int hexuki_position_init(int32_t* record);
+
+/* ------------------------------------------------------------------------
+ * Batches: count positions in, count fixed-size records out
+ * ------------------------------------------------------------------------ */
+
+/* count * HEXUKI_MOVES_STRIDE values */
+HEXUKI_API int hexuki_batch_valid_moves(const int32_t* positions, int count, int32_t* out);
+
+/* count * HEXUKI_SCORES_STRIDE values */
+HEXUKI_API int hexuki_batch_scores(const int32_t* positions, int count, int32_t* out);
+
+/* count * HEXUKI_PLAYOUT_STRIDE values. Uniformly random moves to the end of
+ * the game; position i uses seed + i, so results are reproducible. */
+HEXUKI_API int hexuki_batch_playouts(const int32_t* positions, int count, uint32_t seed, int32_t* out);
+
+/* count * HEXUKI_SEARCH_STRIDE doubles, one search per position (positions
+ * are searched in parallel). MCTS position i uses seed + i (0 = random). */
+HEXUKI_API int hexuki_batch_minimax(const int32_t* positions, int count, int depth, int time_limit_ms,
+                                    double* out);
+HEXUKI_API int hexuki_batch_mcts(const int32_t* positions, int count, int simulations, uint32_t seed,
+                                 double* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEXUKI_C_H */
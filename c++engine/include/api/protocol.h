@@ -0,0 +1,120 @@
+#ifndef HEXUKI_PROTOCOL_H
+#define HEXUKI_PROTOCOL_H
+
+#include "core/bitboard.h"
+#include "core/move.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include <atomic>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hexuki {
+namespace api {
+
+/**
+ * Line protocol for a long-lived engine process (hexuki_engine), UCI style
+ *
+ * Commands (one per line, unknown ones are reported and ignored):
+ *   uci                                   -> id ..., option ..., uciok
+ *   isready                               -> readyok (also while searching)
+ *   setoption name <Hash|Threads|Engine|Seed> value <v>
+ *   ucinewgame                            clear the table and search state
+ *   position startpos|fen <savePosition> [moves h6t5 h7t4 ...]
+ *   go [depth N] [nodes N] [sims N] [movetime MS] [infinite]
+ *                                         -> info ... lines, then bestmove
+ *   stop                                  end the search now (-> bestmove)
+ *   d                                     -> position <savePosition>, legal <moves>
+ *   quit
+ *
+ * Searches run on a background thread so stop/isready are answered while
+ * they run. The minimax table (Hash) is leased once and kept across
+ * searches and positions: entries are keyed by the full position hash, so
+ * later searches start warm. Single-threaded searches are incremental and
+ * stream info lines (minimax: each completed depth; MCTS: every
+ * INFO_INTERVAL_MS). With Threads > 1, go runs the root-parallel searches
+ * instead; those report once, at the end, cannot be stopped (stop says so
+ * and waits for them) and give minimax a table per thread from the pool in
+ * place of the warm one. go infinite and go nodes need the incremental
+ * search, so with Threads > 1 they run single-threaded and say so.
+ *
+ * Output goes to one stream under a lock, one flushed line at a time.
+ */
+class ProtocolEngine {
+public:
+    explicit ProtocolEngine(std::ostream& out);
+    ~ProtocolEngine();  // Stops a running search
+
+    ProtocolEngine(const ProtocolEngine&) = delete;
+    ProtocolEngine& operator=(const ProtocolEngine&) = delete;
+
+    // Handle one command line; returns false after quit
+    bool handleLine(const std::string& line);
+
+    // Read commands until quit or end of input (then waits for the search)
+    void run(std::istream& in);
+
+    // Block until the current search (if any) has printed bestmove
+    void waitForSearch();
+
+    static constexpr int INFO_INTERVAL_MS = 250;
+    static constexpr int MAX_HASH_MB = 4096;
+    static constexpr int MAX_THREADS = 64;
+
+private:
+    enum class EngineType { MINIMAX, MCTS };
+
+    struct Limits {
+        int depth = 0;         // 0 = engine default
+        long long nodes = 0;   // Minimax nodes; 0 = no limit
+        int sims = 0;          // MCTS simulations; 0 = engine default
+        int movetimeMs = 0;    // 0 = engine default
+        bool infinite = false;
+    };
+
+    std::ostream& out;
+    std::mutex outMutex;
+
+    // Options
+    size_t hashMB = 128;
+    int threads = 1;
+    EngineType engineType = EngineType::MINIMAX;
+    uint32_t seed = 0;
+
+    HexukiBitboard board;
+    minimax::TableLease table;   // Warm minimax table, kept across searches
+    std::unique_ptr<mcts::MCTS> mctsEngine;
+
+    std::thread searchThread;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> parallelRunning;  // searchParallel ignores stopRequested
+
+    void send(const std::string& line);
+
+    void cmdUci();
+    void cmdSetOption(const std::vector<std::string>& args);
+    void cmdPosition(const std::vector<std::string>& args);
+    void cmdGo(const std::vector<std::string>& args);
+    void cmdDisplay();
+    void stopSearch();
+
+    minimax::TranspositionTable& warmTable();
+
+    // Search thread bodies; each ends with a bestmove line
+    void searchMinimax(HexukiBitboard root, Limits limits);
+    void searchMCTS(HexukiBitboard root, Limits limits);
+    void searchParallel(HexukiBitboard root, Limits limits);
+
+    void sendMinimaxInfo(const minimax::SearchResult& result, double timeMs);
+    void sendMCTSInfo(const mcts::MCTSResult& result, double timeMs);
+};
+
+} // namespace api
+} // namespace hexuki
+
+#endif // HEXUKI_PROTOCOL_H
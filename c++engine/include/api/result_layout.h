@@ -0,0 +1,97 @@
+#ifndef HEXUKI_RESULT_LAYOUT_H
+#define HEXUKI_RESULT_LAYOUT_H
+
+#include "core/move.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include <cstdint>
+#include <vector>
+
+namespace hexuki {
+namespace api {
+
+/**
+ * Binary result layouts shared with JavaScript
+ *
+ * Results are packed into flat arrays that JS reads in place through typed
+ * array views on WASM memory (no string building, no JSON.parse). The
+ * layouts are part of the JS contract: append fields, never reorder them.
+ *
+ * Moves (Int32Array): MOVE_STRIDE values per move
+ *   [hexId, tileValue, hexId, tileValue, ...]
+ *
+ * Search result (Float64Array): SEARCH_HEADER_SIZE values, then
+ * topMoveCount records of TOP_MOVE_STRIDE values. Integers are stored
+ * exactly (doubles hold any int32). Fields that do not apply to the engine
+ * are 0.
+ */
+constexpr int MOVE_STRIDE = 2;
+
+enum SearchField : int {
+    FIELD_ENGINE = 0,      // SearchEngine: 0 none, 1 MCTS, 2 minimax
+    FIELD_DONE,            // 1 if the search has finished
+    FIELD_HEX,             // Best move
+    FIELD_TILE,
+    FIELD_TIME_MS,
+    FIELD_WORK,            // Simulations (MCTS) or nodes searched (minimax)
+    FIELD_VISITS,          // MCTS: visits of the best move
+    FIELD_WIN_RATE,        // MCTS: win rate of the best move (0..1)
+    FIELD_SCORE,           // Minimax: score for the side to move
+    FIELD_DEPTH,           // Minimax: last completed depth
+    FIELD_TOP_MOVE_COUNT,  // MCTS: number of top-move records that follow
+    SEARCH_HEADER_SIZE
+};
+
+enum TopMoveField : int {
+    TOP_HEX = 0,
+    TOP_TILE,
+    TOP_VISITS,
+    TOP_WIN_RATE,
+    TOP_MOVE_STRIDE
+};
+
+/**
+ * Batched rule calls (batch_ops.h), Int32Array
+ *
+ * Position record (input), POSITION_STRIDE values: the state of one
+ * hexuki_game_engine_v2.js game. Hands hold up to NUM_TILES_PER_PLAYER tiles
+ * in hand order; unused entries are ignored.
+ *
+ * Playout record (output), PLAYOUT_STRIDE values: final scores and the
+ * moves played, MOVE_STRIDE values each, padded to MAX_PLAYOUT_MOVES.
+ */
+enum PositionField : int {
+    POS_HEX_VALUES = 0,                                  // NUM_HEXES values, 0 = empty
+    POS_PLAYER = NUM_HEXES,                              // Player to move (1 or 2)
+    POS_MOVE_COUNT,                                      // Moves made so far (JS moveCount)
+    POS_P1_TILE_COUNT,
+    POS_P1_TILES,
+    POS_P2_TILE_COUNT = POS_P1_TILES + NUM_TILES_PER_PLAYER,
+    POS_P2_TILES,
+    POSITION_STRIDE = POS_P2_TILES + NUM_TILES_PER_PLAYER
+};
+
+constexpr int MAX_PLAYOUT_MOVES = NUM_HEXES;
+
+// Upper bound on the moves of one position, for fixed-size move records (C ABI)
+constexpr int MAX_VALID_MOVES = MAX_LEGAL_MOVES;
+
+enum PlayoutField : int {
+    PLAYOUT_P1_SCORE = 0,
+    PLAYOUT_P2_SCORE,
+    PLAYOUT_MOVE_COUNT,  // Moves played by the playout
+    PLAYOUT_MOVES,
+    PLAYOUT_STRIDE = PLAYOUT_MOVES + MAX_PLAYOUT_MOVES * MOVE_STRIDE
+};
+
+// Each function overwrites `out`; capacity is kept, so repeated packing
+// into the same vector does not allocate once it has grown
+void packMoves(const std::vector<Move>& moves, std::vector<int32_t>& out);
+void packMCTSResult(const mcts::MCTSResult& result, bool done, std::vector<double>& out);
+void packMinimaxResult(const minimax::SearchResult& result, bool done, std::vector<double>& out);
+void packEmptyResult(std::vector<double>& out);
+
+} // namespace api
+} // namespace hexuki
+
+#endif // HEXUKI_RESULT_LAYOUT_H
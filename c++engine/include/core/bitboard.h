@@ -45,9 +45,13 @@ public:
 
     // Scoring (REAL chain-based multiplication)
     int getScore(int player) const;
+    void getScores(int& p1Score, int& p2Score) const;  // Both at once (one kernel call)
 
     // Move operations
     std::vector<Move> getValidMoves() const;
+    int getValidMoves(Move* moves) const;  // Same moves into moves[MAX_LEGAL_MOVES], no allocation; returns the count
+    uint32_t getLegalHexMask() const;  // Bit per hex where a tile may be placed
+    int getUniqueTiles(int* tiles) const;  // Distinct tile values of the player to move (up to 9), in hand order
     bool isValidMove(const Move& move) const;
     void makeMove(const Move& move);
     void unmakeMove(const Move& move);  // Undo move (for minimax)
@@ -57,9 +61,9 @@ public:
     uint64_t getHash() const { return zobristHash; }  // For transposition table
 
     // Puzzle setup (for loading partial positions)
-    void setHexValue(int hexId, int tileValue);  // Place a tile on a hex
+    void setHexValue(int hexId, int tileValue);  // Place a tile on a hex (ignored if out of range)
     void removeHexValue(int hexId);              // Remove a tile from a hex
-    void setAvailableTiles(int player, const std::vector<int>& tiles);  // Set player's available tiles
+    void setAvailableTiles(int player, const std::vector<int>& tiles);  // Set player's available tiles (ignored if out of range)
     void setCurrentPlayer(int player) { currentPlayer = player; }
     void clearBoard();  // Clear all tiles (but keep metadata)
 
@@ -0,0 +1,57 @@
+#ifndef HEXUKI_BOARD_KERNELS_H
+#define HEXUKI_BOARD_KERNELS_H
+
+#include "utils/constants.h"
+#include <cstdint>
+
+// SIMD path, chosen at build time: WASM SIMD128 (emcc -msimd128) or SSE4.1
+// on native x86. Define HEXUKI_NO_SIMD to force the scalar kernels (the
+// baseline WASM build for browsers without SIMD).
+#if !defined(HEXUKI_NO_SIMD) && (defined(__wasm_simd128__) || defined(__SSE4_1__))
+#define HEXUKI_SIMD 1
+#endif
+
+namespace hexuki {
+namespace kernels {
+
+/**
+ * Hot board kernels: move legality and scoring on the raw board state
+ *
+ * These are the inner loops of move generation, evaluation and MCTS
+ * rollouts. Each kernel has a portable scalar version (namespace scalar,
+ * always compiled so tests can check parity) and, when HEXUKI_SIMD is set,
+ * a vectorized version; the unqualified functions use whichever was built.
+ * Both give identical results.
+ */
+
+constexpr uint32_t ALL_HEXES_MASK = (1u << NUM_HEXES) - 1;
+
+// Empty hexes next to at least one occupied hex
+uint32_t frontierMask(uint32_t occupied);
+
+// Frontier hexes that also satisfy the chain length constraint: exactly the
+// hexes for which HexukiBitboard::isMoveLegal() is true
+uint32_t legalHexMask(uint32_t occupied);
+
+// Chain scores of both players (product of tile values along each of the
+// player's five diagonals, summed). A value of 0 is an empty hex.
+void chainScores(const uint8_t hexValues[NUM_HEXES], int& p1Score, int& p2Score);
+
+// Rollout helpers: number of set bits, and index of the n-th (0-based) set
+// bit (mask must have more than n bits set)
+int popCount(uint32_t mask);
+int nthSetBit(uint32_t mask, int n);
+
+// "wasm-simd128", "sse4.1" or "scalar"
+const char* simdName();
+
+namespace scalar {
+uint32_t frontierMask(uint32_t occupied);
+uint32_t legalHexMask(uint32_t occupied);
+void chainScores(const uint8_t hexValues[NUM_HEXES], int& p1Score, int& p2Score);
+} // namespace scalar
+
+} // namespace kernels
+} // namespace hexuki
+
+#endif // HEXUKI_BOARD_KERNELS_H
@@ -0,0 +1,129 @@
+#ifndef HEXUKI_THREAD_POOL_H
+#define HEXUKI_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Web workers prestarted by the pthreads WASM build (PTHREAD_POOL_SIZE);
+// the global pool uses at most this many threads including the caller
+#ifndef HEXUKI_WASM_MAX_THREADS
+#define HEXUKI_WASM_MAX_THREADS 4
+#endif
+
+namespace hexuki {
+
+/**
+ * Work-stealing thread pool shared by every parallel engine feature
+ *
+ * Each worker owns a deque: it pushes and pops its own tasks at the back
+ * (LIFO, cache-warm), idle workers steal from the front of others (FIFO,
+ * oldest = largest work first). Tasks submitted from non-pool threads go
+ * through a shared injection queue.
+ *
+ * Use ThreadPool::global() rather than creating pools or raw std::threads,
+ * so concurrent features share one set of workers instead of oversubscribing.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // No workers: tasks run on the threads that wait for them (single-thread baselines)
+    static constexpr int NO_WORKERS = -1;
+
+    // numThreads = 0: hardware concurrency - 1 (the thread waiting on a TaskGroup works too).
+    // WASM builds without pthreads always get 0 workers: tasks then run on
+    // the thread that waits for them, so parallel code needs no other path.
+    explicit ThreadPool(int numThreads = 0, bool pinThreads = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+
+    // Run one queued task on the calling thread; false if none was available
+    bool tryRunOne();
+
+    int size() const { return static_cast<int>(workers.size()); }
+
+    // Index of the calling pool worker, or -1 for threads outside this pool
+    int currentWorkerIndex() const;
+
+    // Process-wide pool. configureGlobal() only takes effect before first use
+    // of global(); returns false if the pool already exists.
+    static ThreadPool& global();
+    static bool configureGlobal(int numThreads, bool pinThreads = false);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    WorkerQueue injectQueue;
+
+    std::atomic<size_t> queuedTasks;
+    std::atomic<bool> stopping;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    void workerLoop(int index, bool pin);
+    bool popTask(int index, Task& task);
+};
+
+/**
+ * Group of tasks that can be joined and cancelled together
+ *
+ * wait() runs queued pool tasks on the calling thread while it waits, so
+ * groups can be nested inside pool tasks without deadlock. The first
+ * exception thrown by a task is rethrown from wait().
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global());
+    ~TaskGroup();  // Waits for outstanding tasks (exceptions are dropped)
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> task);
+
+    // Block until at most maxPending tasks remain; wait() (maxPending = 0)
+    // also rethrows the first task exception
+    void wait(size_t maxPending);
+    void wait();
+
+    // Tasks that have not started yet are skipped; running tasks may poll isCancelled()
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    size_t pending() const { return pendingTasks.load(std::memory_order_acquire); }
+
+private:
+    ThreadPool& pool;
+    std::atomic<size_t> pendingTasks;
+    std::atomic<bool> cancelled;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr firstError;
+};
+
+/**
+ * Run body(i) for i in [begin, end) on the pool, in chunks of grain indices
+ */
+void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t)>& body,
+                 ThreadPool& pool = ThreadPool::global());
+
+} // namespace hexuki
+
+#endif // HEXUKI_THREAD_POOL_H
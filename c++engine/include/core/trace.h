@@ -0,0 +1,121 @@
+#ifndef HEXUKI_TRACE_H
+#define HEXUKI_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace hexuki {
+namespace trace {
+
+/**
+ * Low-overhead tracing to Chrome / Perfetto trace JSON
+ *
+ * The engine marks spans (search iterations, root moves, rollouts, table
+ * allocation, pool tasks, games) with the HEXUKI_TRACE_* macros below.
+ * They compile to nothing unless HEXUKI_TRACE is defined (cmake
+ * -DHEXUKI_TRACE=ON), so default builds pay nothing. In a tracing build an
+ * event costs a relaxed load of the enabled flag while tracing is off, and
+ * two clock reads plus one slot write while it is on.
+ *
+ * Every thread writes to its own ring buffer (no locks, no allocation after
+ * the thread's first event); when a buffer is full the oldest events are
+ * overwritten and counted as dropped. writeChromeJson() merges all threads,
+ * including ones that have exited, into a file that chrome://tracing and
+ * ui.perfetto.dev open directly: one track per thread, so stalls and load
+ * imbalance between pool workers show up as gaps.
+ *
+ * Setting HEXUKI_TRACE_FILE in the environment starts tracing at startup
+ * and writes the trace to that path at exit. Write the trace once the
+ * traced work has finished (or after stop()): a buffer that is still being
+ * written can contribute a torn event.
+ *
+ * Event names and argument names must be string literals (only the pointers
+ * are stored).
+ */
+
+// Nanoseconds since the trace epoch (first use in the process), never 0
+uint64_t now();
+
+namespace detail {
+extern std::atomic<bool> enabled;
+}
+
+void start();
+void stop();
+inline bool isEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+// Events per thread buffer (rounded up to a power of two), for threads
+// that have not recorded anything yet. Default 1 << 16.
+void setBufferCapacity(size_t events);
+
+// Track name of the calling thread ("pool worker 3"); default "thread N"
+void setThreadName(const std::string& name);
+
+// A span from startNs (now()) to now, and a point event. Ignored while
+// tracing is off; complete() also ignores startNs 0 (started while off).
+void complete(const char* name, uint64_t startNs, const char* argName = nullptr, int64_t arg = 0);
+void instant(const char* name, const char* argName = nullptr, int64_t arg = 0);
+
+// {"traceEvents":[...]} with every buffered event; returns the event count
+size_t writeChromeJson(std::ostream& out);
+bool writeChromeJson(const std::string& path);
+
+// Drop every buffered event
+void clear();
+
+// Events lost to full buffers since the last clear()
+uint64_t droppedEvents();
+
+// A span over the enclosing scope
+class Scope {
+public:
+    explicit Scope(const char* name, const char* argName = nullptr, int64_t arg = 0)
+        : name(name), argName(argName), arg(arg), active(isEnabled()), startNs(active ? now() : 0) {}
+    ~Scope() {
+        if (active) complete(name, startNs, argName, arg);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name;
+    const char* argName;
+    int64_t arg;
+    bool active;
+    uint64_t startNs;
+};
+
+// Compact move argument: hexId * 10 + tileValue (h6t5 -> 65)
+inline int64_t moveArg(int hexId, int tileValue) {
+    return hexId * 10 + tileValue;
+}
+
+} // namespace trace
+} // namespace hexuki
+
+#define HEXUKI_TRACE_CONCAT2(a, b) a##b
+#define HEXUKI_TRACE_CONCAT(a, b) HEXUKI_TRACE_CONCAT2(a, b)
+
+#ifdef HEXUKI_TRACE
+// HEXUKI_TRACE_SCOPE(name [, argName, arg]): span over the enclosing scope
+#define HEXUKI_TRACE_SCOPE(...) ::hexuki::trace::Scope HEXUKI_TRACE_CONCAT(hexukiTraceScope, __LINE__)(__VA_ARGS__)
+// Spans that start and end in different calls: keep HEXUKI_TRACE_NOW(),
+// then HEXUKI_TRACE_COMPLETE(name, start [, argName, arg])
+#define HEXUKI_TRACE_NOW() (::hexuki::trace::isEnabled() ? ::hexuki::trace::now() : 0)
+#define HEXUKI_TRACE_COMPLETE(...) ::hexuki::trace::complete(__VA_ARGS__)
+#define HEXUKI_TRACE_INSTANT(...) \
+    do { if (::hexuki::trace::isEnabled()) ::hexuki::trace::instant(__VA_ARGS__); } while (0)
+#define HEXUKI_TRACE_THREAD_NAME(name) ::hexuki::trace::setThreadName(name)
+#else
+#define HEXUKI_TRACE_SCOPE(...) ((void)0)
+#define HEXUKI_TRACE_NOW() uint64_t(0)
+#define HEXUKI_TRACE_COMPLETE(...) ((void)0)
+#define HEXUKI_TRACE_INSTANT(...) ((void)0)
+#define HEXUKI_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // HEXUKI_TRACE_H
@@ -9,6 +9,94 @@ namespace hexuki {
 // Forward declaration
 class HexukiBitboard;
 
+/**
+ * Compile-time 64-bit Mersenne Twister (same sequence as std::mt19937_64)
+ */
+class ConstexprMt19937_64 {
+public:
+    constexpr explicit ConstexprMt19937_64(uint64_t seed) : state(), index(N) {
+        state[0] = seed;
+        for (int i = 1; i < N; i++) {
+            state[i] = 6364136223846793005ULL * (state[i - 1] ^ (state[i - 1] >> 62)) + static_cast<uint64_t>(i);
+        }
+    }
+
+    constexpr uint64_t next() {
+        if (index >= N) {
+            twist();
+        }
+        uint64_t x = state[index++];
+        x ^= (x >> 29) & 0x5555555555555555ULL;
+        x ^= (x << 17) & 0x71D67FFFEDA60000ULL;
+        x ^= (x << 37) & 0xFFF7EEE000000000ULL;
+        x ^= x >> 43;
+        return x;
+    }
+
+private:
+    static constexpr int N = 312;
+    static constexpr int M = 156;
+
+    uint64_t state[N];
+    int index;
+
+    constexpr void twist() {
+        for (int i = 0; i < N; i++) {
+            uint64_t x = (state[i] & 0xFFFFFFFF80000000ULL) | (state[(i + 1) % N] & 0x7FFFFFFFULL);
+            uint64_t xA = x >> 1;
+            if (x & 1) {
+                xA ^= 0xB5026F5AA96619E9ULL;
+            }
+            state[i] = state[(i + M) % N] ^ xA;
+        }
+        index = 0;
+    }
+};
+
+/**
+ * Zobrist key tables
+ */
+struct ZobristKeys {
+    // Sized for MAX_TILE_VALUE to handle any tile values (e.g., if using tiles 2,4,6,8... up to 18)
+    uint64_t tile[NUM_HEXES][MAX_TILE_VALUE + 1];  // [hexId][tileValue]
+    uint64_t player[2];                             // [player-1]
+
+    // Tile count keys for available tiles (supports duplicates)
+    // tileCount[player][tileValue][count] = key for having 'count' of 'tileValue' for 'player'
+    // player: 0 = P1, 1 = P2
+    // count: 0-9 (max 9 of any tile value)
+    uint64_t tileCount[2][MAX_TILE_VALUE + 1][10];
+};
+
+/**
+ * Generate the key tables from a fixed seed (same hashes across runs and
+ * builds; matches the values the old runtime initialization produced)
+ */
+constexpr ZobristKeys generateZobristKeys() {
+    ZobristKeys keys{};
+    ConstexprMt19937_64 rng(0x1234567890ABCDEF);
+
+    // Only generate for valid tile values from TILE_VALUES array
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+            keys.tile[hexId][TILE_VALUES[i]] = rng.next();
+        }
+    }
+
+    for (int player = 0; player < 2; player++) {
+        keys.player[player] = rng.next();
+    }
+
+    for (int player = 0; player < 2; player++) {
+        for (int tileVal = 1; tileVal <= MAX_TILE_VALUE; tileVal++) {
+            for (int count = 0; count <= 9; count++) {
+                keys.tileCount[player][tileVal][count] = rng.next();
+            }
+        }
+    }
+    return keys;
+}
+
 /**
  * Zobrist hashing for game positions
  *
@@ -16,35 +104,30 @@ class HexukiBitboard;
  * - Each position gets a unique 64-bit hash
  * - Same position = same hash (deterministic)
  * - Fast incremental updates (XOR operations)
+ *
+ * The keys are compile-time constants, so lookups are plain loads with no
+ * initialization check and boards can be hashed from any thread.
  */
 class Zobrist {
 public:
-    // Initialize random hash tables (call once at program start)
-    static void initialize();
+    // No-op: the tables are constexpr. Kept so existing callers still build.
+    static void initialize() {}
 
     // Get hash for a tile placement
-    static uint64_t getTileHash(int hexId, int tileValue);
+    static constexpr uint64_t getTileHash(int hexId, int tileValue) {
+        return keys.tile[hexId][tileValue];  // Direct indexing by tile value
+    }
 
     // Get hash for player-to-move
-    static uint64_t getPlayerHash(int player);
+    static constexpr uint64_t getPlayerHash(int player) {
+        return keys.player[player - 1];  // player is 1-2, array is 0-1
+    }
 
     // Calculate full hash for a board state
     static uint64_t hash(const HexukiBitboard& board);
 
 private:
-    // Hash tables (initialized with random numbers)
-    // Sized for MAX_TILE_VALUE to handle any tile values (e.g., if using tiles 2,4,6,8... up to 18)
-    static uint64_t tileHashes[NUM_HEXES][MAX_TILE_VALUE + 1];  // [hexId][tileValue]
-    static uint64_t playerHashes[2];                             // [player-1]
-
-    // Tile count hashes for available tiles (supports duplicates)
-    // tileCountHashes[player][tileValue][count] = hash for having 'count' of 'tileValue' for 'player'
-    // player: 0 = P1, 1 = P2
-    // tileValue: 1-9
-    // count: 0-9 (max 9 of any tile value)
-    static uint64_t tileCountHashes[2][MAX_TILE_VALUE + 1][10];
-
-    static bool initialized;
+    static constexpr ZobristKeys keys = generateZobristKeys();
 };
 
 } // namespace hexuki
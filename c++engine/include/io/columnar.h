@@ -0,0 +1,93 @@
+#ifndef HEXUKI_COLUMNAR_H
+#define HEXUKI_COLUMNAR_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace hexuki {
+namespace io {
+
+/**
+ * Column element types (numpy dtype in parentheses)
+ */
+enum class ColumnType : uint8_t {
+    U8,   // uint8  ("u1")
+    I8,   // int8   ("i1")
+    U32,  // uint32 ("<u4")
+    I32   // int32  ("<i4")
+};
+
+size_t columnTypeSize(ColumnType type);
+const char* columnTypeName(ColumnType type);  // numpy dtype string
+
+struct ColumnSpec {
+    std::string name;
+    ColumnType type;
+};
+
+/**
+ * In-memory batch of rows stored column by column
+ */
+class ColumnBatch {
+public:
+    explicit ColumnBatch(const std::vector<ColumnSpec>& schema);
+
+    template <typename T>
+    void set(size_t column, T value) {
+        // Values are appended in column order; the row is complete once every column is set
+        std::vector<uint8_t>& bytes = data[column];
+        size_t width = columnTypeSize(schema[column].type);
+        size_t offset = bytes.size();
+        bytes.resize(offset + width);
+        switch (schema[column].type) {
+            case ColumnType::U8:  { uint8_t v = static_cast<uint8_t>(value);   std::memcpy(&bytes[offset], &v, 1); break; }
+            case ColumnType::I8:  { int8_t v = static_cast<int8_t>(value);     std::memcpy(&bytes[offset], &v, 1); break; }
+            case ColumnType::U32: { uint32_t v = static_cast<uint32_t>(value); std::memcpy(&bytes[offset], &v, 4); break; }
+            case ColumnType::I32: { int32_t v = static_cast<int32_t>(value);   std::memcpy(&bytes[offset], &v, 4); break; }
+        }
+    }
+
+    size_t numRows() const;
+    size_t numColumns() const { return schema.size(); }
+    const std::vector<ColumnSpec>& getSchema() const { return schema; }
+    const std::vector<uint8_t>& columnData(size_t column) const { return data[column]; }
+    void clear();
+
+private:
+    std::vector<ColumnSpec> schema;
+    std::vector<std::vector<uint8_t>> data;
+};
+
+/**
+ * Columnar output: a directory with one raw little-endian file per column
+ * (<name>.bin) plus schema.json listing names, numpy dtypes and row count.
+ *
+ * Python: np.memmap(dir + "/" + name + ".bin", dtype=dtype, mode="r")
+ */
+class ColumnarWriter {
+public:
+    ColumnarWriter(const std::string& dir, const std::vector<ColumnSpec>& schema);  // Throws on I/O failure
+    ~ColumnarWriter();  // Calls close()
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    void write(const ColumnBatch& batch);
+    void close();  // Flush columns and write schema.json
+
+    uint64_t getRows() const { return rows; }
+
+private:
+    std::string dir;
+    std::vector<ColumnSpec> schema;
+    std::vector<std::FILE*> files;
+    uint64_t rows;
+};
+
+} // namespace io
+} // namespace hexuki
+
+#endif // HEXUKI_COLUMNAR_H
@@ -0,0 +1,189 @@
+#ifndef HEXUKI_GAME_ARCHIVE_H
+#define HEXUKI_GAME_ARCHIVE_H
+
+#include "core/move.h"
+#include "io/mapped_file.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace hexuki {
+namespace io {
+
+// ============================================================================
+// Record Format
+// ============================================================================
+
+constexpr int ARCHIVE_MAX_MOVES = NUM_HEXES;      // 19: puzzles may start with an empty center
+constexpr uint8_t ARCHIVE_NO_MOVE = 0xFF;
+constexpr int ARCHIVE_MOVE_CODES = NUM_HEXES * NUM_TILES_PER_PLAYER;  // 171
+constexpr char ARCHIVE_MAGIC[8] = {'H', 'X', 'A', 'R', 'C', 'H', '0', '1'};
+constexpr uint32_t ARCHIVE_VERSION = 1;
+constexpr const char* ARCHIVE_SEGMENT_EXT = ".hxa";
+
+// Who produced the game (record metadata)
+enum class GameSource : uint8_t {
+    UNKNOWN = 0,
+    SELF_PLAY_MCTS = 1,
+    SELF_PLAY_MINIMAX = 2,
+    RANDOM = 3,
+    HYBRID = 4,  // Random opening + minimax endgame (MINIMAX_TRAINING_STRATEGY.md)
+    HUMAN = 5,
+    IMPORTED = 6
+};
+
+/**
+ * One archived game (32 bytes, fixed size)
+ *
+ * Moves are packed one byte each: hexId * NUM_TILES_PER_PLAYER + tile index
+ * into TILE_VALUES (19 * 9 = 171 codes), ARCHIVE_NO_MOVE past numMoves.
+ * Games start from the standard initial position.
+ */
+struct ArchiveRecord {
+    uint8_t numMoves;                     // Moves played (0-19)
+    int8_t result;                        // +1 = P1 win, 0 = draw, -1 = P2 win
+    GameSource source;                    // Producer
+    uint8_t flags;                        // Producer-defined
+    int32_t p1Score;                      // Final scores
+    int32_t p2Score;
+    uint8_t moves[ARCHIVE_MAX_MOVES];     // Packed moves
+    uint8_t reserved;                     // Zero
+
+    static uint8_t packMove(const Move& move);
+    static Move unpackMove(uint8_t code);
+
+    Move getMove(int ply) const { return unpackMove(moves[ply]); }
+    std::vector<Move> getMoves() const;
+
+    // numMoves and every played move code are in range. Records come straight
+    // from mapped files, so check this before replaying one; it does not
+    // check that the moves are legal.
+    bool isValid() const;
+
+    // Build from a finished game (replays it to compute scores and result)
+    static ArchiveRecord fromGame(const std::vector<Move>& moves, GameSource source = GameSource::UNKNOWN,
+                                  uint8_t flags = 0);
+};
+
+static_assert(sizeof(ArchiveRecord) == 32, "ArchiveRecord must stay 32 bytes (on-disk format)");
+
+/**
+ * Segment file header (64 bytes, followed by records)
+ */
+struct ArchiveSegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint8_t reserved[48];
+};
+
+static_assert(sizeof(ArchiveSegmentHeader) == 64, "ArchiveSegmentHeader must stay 64 bytes");
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+/**
+ * Append-only writer for one segment of an archive
+ *
+ * An archive is a directory of segment files. Each writer owns its own
+ * segment (<dir>/<writerName>.hxa), so concurrent writers - threads or
+ * processes - never share a file and need no locking. Reopening an existing
+ * segment appends to it; a torn trailing record from a crash is truncated.
+ */
+class ArchiveWriter {
+public:
+    ArchiveWriter(const std::string& archiveDir, const std::string& writerName);  // Throws on I/O failure
+    ~ArchiveWriter();
+
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    void append(const ArchiveRecord& record);
+    void flush();  // Make appended records visible to new readers
+
+    uint64_t getCount() const { return count; }  // Records in this segment
+    const std::string& getPath() const { return path; }
+
+private:
+    std::string path;
+    std::FILE* file;
+    uint64_t count;
+};
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+/**
+ * Read-only, memory-mapped view of all segments in an archive
+ *
+ * Records are read in place from the mapping (no copies). Global record ids
+ * number records segment by segment in segment-name order.
+ */
+class GameArchive {
+public:
+    struct Segment {
+        std::string path;
+        const ArchiveRecord* records;
+        uint64_t count;
+        uint64_t firstId;  // Global id of records[0]
+    };
+
+    explicit GameArchive(const std::string& archiveDir);  // Throws on I/O or format errors
+
+    uint64_t size() const { return totalRecords; }
+    const ArchiveRecord& operator[](uint64_t id) const;  // Random access by global id
+    const std::vector<Segment>& getSegments() const { return segments; }
+
+private:
+    std::vector<MappedFile> files;
+    std::vector<Segment> segments;
+    uint64_t totalRecords;
+};
+
+// ============================================================================
+// Index
+// ============================================================================
+
+/**
+ * Opening-prefix / result index over an archive
+ *
+ * Sorted (prefix key, record id) arrays, one per result, where the key holds
+ * the first PREFIX_MOVES packed moves. Any prefix of up to PREFIX_MOVES moves
+ * is an O(log n) range lookup.
+ */
+class ArchiveIndex {
+public:
+    static constexpr int PREFIX_MOVES = 6;
+    static constexpr int ANY_RESULT = 2;
+
+    explicit ArchiveIndex(const GameArchive& archive);
+
+    // Ids of games starting with prefix (at most PREFIX_MOVES moves), optionally
+    // filtered by result (+1, 0, -1 or ANY_RESULT), in increasing id order
+    std::vector<uint64_t> find(const std::vector<Move>& prefix, int result = ANY_RESULT) const;
+
+    // Count only (no id list)
+    uint64_t count(const std::vector<Move>& prefix, int result = ANY_RESULT) const;
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint64_t id;
+        bool operator<(const Entry& other) const {
+            return key < other.key || (key == other.key && id < other.id);
+        }
+    };
+
+    std::vector<Entry> byResult[3];  // [result + 1]
+
+    static uint64_t makeKey(const ArchiveRecord& record);
+    static bool prefixRange(const std::vector<Move>& prefix, uint64_t& lo, uint64_t& hi);
+};
+
+} // namespace io
+} // namespace hexuki
+
+#endif // HEXUKI_GAME_ARCHIVE_H
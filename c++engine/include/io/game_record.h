@@ -0,0 +1,63 @@
+#ifndef HEXUKI_GAME_RECORD_H
+#define HEXUKI_GAME_RECORD_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "core/move.h"
+
+namespace hexuki {
+namespace io {
+
+/**
+ * A single game record: starting position plus the moves played from it
+ *
+ * startPosition is in HexukiBitboard::savePosition() format; empty means the
+ * standard initial board.
+ */
+struct GameRecord {
+    std::string startPosition;
+    std::vector<Move> moves;
+};
+
+/**
+ * Parse one line of a game record file
+ *
+ * Tolerant of the formats our tools already produce:
+ *   h6t5 h7t4 h2t1                      (C++ notation, space or comma separated)
+ *   ["t5h6","t4h7","t1h2"]              (JavaScript trainer notation / JSON arrays)
+ *   h4:3,h9:1|p1:...|turn:2 ; h6t5 ...  (savePosition string, optional moves after ';')
+ *
+ * Returns false for blank lines, comments ('#') and lines with no moves or position.
+ */
+bool parseGameRecord(const std::string& line, GameRecord& record);
+
+/**
+ * Streams game records from a text stream, one per line
+ */
+class GameRecordReader {
+public:
+    explicit GameRecordReader(std::istream& in) : in(in), lineNumber(0) {}
+
+    // Read next record; returns false at end of stream
+    bool next(GameRecord& record);
+
+    size_t getLineNumber() const { return lineNumber; }
+
+private:
+    std::istream& in;
+    size_t lineNumber;
+};
+
+/**
+ * Drop a partial last line left by an interrupted run of a line-oriented
+ * output file (labels, analysis results), so appended lines start on a
+ * fresh line. Returns the size kept; a missing file keeps 0.
+ */
+std::uintmax_t truncatePartialLine(const std::string& path);
+
+} // namespace io
+} // namespace hexuki
+
+#endif // HEXUKI_GAME_RECORD_H
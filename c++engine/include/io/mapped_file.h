@@ -0,0 +1,40 @@
+#ifndef HEXUKI_MAPPED_FILE_H
+#define HEXUKI_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace hexuki {
+namespace io {
+
+/**
+ * Read-only memory-mapped file (POSIX mmap / Win32 file mapping)
+ *
+ * The mapping is private to this object and released on destruction.
+ * Empty files map to a null pointer with size 0.
+ */
+class MappedFile {
+public:
+    MappedFile() : mappedData(nullptr), mappedSize(0) {}
+    explicit MappedFile(const std::string& path);  // Throws std::runtime_error on failure
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const unsigned char* data() const { return mappedData; }
+    size_t size() const { return mappedSize; }
+
+private:
+    const unsigned char* mappedData;
+    size_t mappedSize;
+
+    void unmap();
+};
+
+} // namespace io
+} // namespace hexuki
+
+#endif // HEXUKI_MAPPED_FILE_H
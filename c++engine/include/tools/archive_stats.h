@@ -0,0 +1,112 @@
+#ifndef HEXUKI_ARCHIVE_STATS_H
+#define HEXUKI_ARCHIVE_STATS_H
+
+#include "core/thread_pool.h"
+#include "io/game_archive.h"
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace hexuki {
+namespace tools {
+
+/**
+ * Statistics aggregation configuration
+ */
+struct StatsConfig {
+    int prefixDepth = 4;          // Track W/D/L for every opening prefix up to this many moves
+    int scoreBucket = 10;         // Score histogram bucket width (points)
+    uint64_t chunkRecords = 1 << 16;  // Records per work chunk
+
+    StatsConfig() = default;
+};
+
+/**
+ * Win/draw/loss counts (P1 perspective)
+ */
+struct ResultCounts {
+    uint64_t p1Wins = 0;
+    uint64_t draws = 0;
+    uint64_t p2Wins = 0;
+
+    uint64_t games() const { return p1Wins + draws + p2Wins; }
+    void add(int result) {
+        if (result > 0) p1Wins++;
+        else if (result < 0) p2Wins++;
+        else draws++;
+    }
+    void merge(const ResultCounts& other) {
+        p1Wins += other.p1Wins;
+        draws += other.draws;
+        p2Wins += other.p2Wins;
+    }
+};
+
+/**
+ * Mergeable partial aggregate over any subset of archive records
+ *
+ * Each scan thread fills its own ArchiveStats; merge() combines them, so
+ * results are identical for any chunking or thread count.
+ */
+class ArchiveStats {
+public:
+    explicit ArchiveStats(const StatsConfig& config = StatsConfig());
+
+    void add(const io::ArchiveRecord& record);
+    void merge(const ArchiveStats& other);
+
+    // Totals
+    const ResultCounts& getTotals() const { return totals; }
+    uint64_t getGames() const { return totals.games(); }
+
+    // Per-prefix results; key = ArchiveIndex-style packed prefix (see prefixKey)
+    const std::unordered_map<uint64_t, ResultCounts>& getPrefixes() const { return prefixes; }
+    static uint64_t prefixKey(const io::ArchiveRecord& record, int length);
+    static std::vector<Move> keyToMoves(uint64_t key);
+
+    // Move frequency by ply: moveCounts[ply][packed move code]
+    uint64_t getMoveCount(int ply, uint8_t code) const { return moveCounts[ply][code]; }
+
+    // Score histograms keyed by bucket start (P1 score, P2 score, P1 - P2 margin)
+    const std::unordered_map<int, uint64_t>& getP1Scores() const { return p1Scores; }
+    const std::unordered_map<int, uint64_t>& getP2Scores() const { return p2Scores; }
+    const std::unordered_map<int, uint64_t>& getMargins() const { return margins; }
+
+    // Diversity
+    uint64_t getDistinctGames() const { return distinctGames.size(); }
+    uint64_t getDistinctPrefixes(int length) const;
+    double getPrefixEntropy(int length) const;  // Shannon entropy (bits) of the prefix distribution
+
+    // Reports (CSV with header rows)
+    void writePrefixCsv(std::ostream& out) const;
+    void writeMoveCsv(std::ostream& out) const;
+    void writeScoreCsv(std::ostream& out) const;
+    void writeSummaryCsv(std::ostream& out) const;
+
+private:
+    static constexpr int NUM_MOVE_CODES = NUM_HEXES * NUM_TILES_PER_PLAYER;
+
+    StatsConfig config;
+    ResultCounts totals;
+    std::unordered_map<uint64_t, ResultCounts> prefixes;
+    uint64_t moveCounts[io::ARCHIVE_MAX_MOVES][NUM_MOVE_CODES];
+    std::unordered_map<int, uint64_t> p1Scores;
+    std::unordered_map<int, uint64_t> p2Scores;
+    std::unordered_map<int, uint64_t> margins;
+    std::unordered_set<uint64_t> distinctGames;  // Move-sequence hashes
+
+    int bucketOf(int score) const;
+};
+
+/**
+ * Scan an archive in parallel chunks on the pool and return the merged aggregate
+ */
+ArchiveStats aggregateArchive(const io::GameArchive& archive, const StatsConfig& config = StatsConfig(),
+                              ThreadPool& pool = ThreadPool::global());
+
+} // namespace tools
+} // namespace hexuki
+
+#endif // HEXUKI_ARCHIVE_STATS_H
@@ -0,0 +1,177 @@
+#ifndef HEXUKI_BATCH_ANALYSIS_H
+#define HEXUKI_BATCH_ANALYSIS_H
+
+#include "core/bitboard.h"
+#include "core/move.h"
+#include "core/thread_pool.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace hexuki {
+namespace tools {
+
+enum class AnalysisEngine { MINIMAX, MCTS, SOLVE };
+
+enum class PositionFormat {
+    TEXT,    // One savePosition() string (or "startpos") per line; '#' comments
+    JSON,    // Puzzle editor levels: one object, an array of them, or one per line
+    PACKED   // Raw POSITION_STRIDE int32 records (api/result_layout.h, hexuki_native.Positions)
+};
+
+enum class OutputFormat { JSONL, CSV };
+
+/**
+ * Batch analysis configuration
+ */
+struct AnalysisConfig {
+    AnalysisEngine engine = AnalysisEngine::MINIMAX;
+    int depth = 8;                  // Minimax depth
+    int sims = 10000;               // MCTS simulations
+    int movetimeMs = 0;             // Per-position time limit (0 = none: depth/sims only)
+    uint32_t seed = 1;              // MCTS: position i uses seed + i (0 = random)
+    size_t ttSizeMB = 256;          // Minimax/solve table shared by all workers
+    OutputFormat output = OutputFormat::JSONL;
+    bool ordered = true;            // Emit in input order (else as completed)
+    int progressIntervalMs = 2000;  // Progress report and output flush interval
+    bool verbose = true;            // Print progress to stderr
+
+    AnalysisConfig() = default;
+};
+
+/**
+ * One input position
+ *
+ * index is the record's ordinal in the input, counting unreadable records,
+ * so output lines can always be matched back to input records.
+ */
+struct PositionRecord {
+    size_t index = 0;
+    HexukiBitboard board;
+    std::string error;  // Non-empty: the record could not be read
+};
+
+/**
+ * Streaming position reader for the three input formats
+ */
+class PositionReader {
+public:
+    PositionReader(std::istream& in, PositionFormat format);
+
+    // Next record (unreadable ones included, with error set); false at the end
+    bool next(PositionRecord& record);
+
+    // TEXT for anything but *.json and *.bin / *.pos
+    static PositionFormat formatForPath(const std::string& path);
+
+private:
+    std::istream& in;
+    PositionFormat format;
+    size_t nextIndex = 0;
+
+    // JSON: top-level objects of the whole input, read on first use
+    std::vector<std::string> objects;
+    size_t nextObject = 0;
+    bool objectsLoaded = false;
+
+    void loadObjects();
+};
+
+// Position of one puzzle editor level (board/p1Tiles/p2Tiles/startingPlayer,
+// as the editor's import reads it; "position" only if those are missing)
+HexukiBitboard parseLevel(const std::string& json);
+
+/**
+ * Result for one position
+ */
+struct PositionAnalysis {
+    size_t index = 0;
+    std::string position;         // savePosition() of the input
+    std::string error;            // Set for unreadable records
+    Move bestMove;                // Invalid for finished games
+    int score = 0;                // Minimax score / solve: exact final score difference (side to move)
+    int depth = 0;                // Minimax depth reached
+    int nodes = 0;                // Minimax/solve nodes
+    double winRate = 0.0;         // MCTS
+    int visits = 0;               // MCTS visits of the best move
+    int sims = 0;                 // MCTS simulations run
+    std::vector<Move> bestMoves;  // Solve: every move achieving score
+    double timeMs = 0.0;
+};
+
+/**
+ * Analyze one position. Minimax and solve need tt (may be shared between
+ * threads); MCTS needs engine, whose tree memory is reused. The other may
+ * be null.
+ */
+PositionAnalysis analyzePosition(const PositionRecord& record, const AnalysisConfig& config,
+                                 minimax::TranspositionTable* tt, mcts::MCTS* engine);
+
+/**
+ * Output lines
+ *
+ * JSONL: {"index":0,"position":"...","bestmove":"h6t5","score":3,"depth":8,...}
+ * CSV:   header line, then one row per position; the columns depend on the
+ *        engine and end with "error"
+ */
+std::string formatAnalysis(const PositionAnalysis& analysis, const AnalysisConfig& config);
+std::string csvHeader(const AnalysisConfig& config);
+
+// Index of an output line written by formatAnalysis (false for the CSV
+// header and truncated JSON lines; a partial CSV row is not detectable, so
+// cut a partial last line off before resuming)
+bool parseAnalysisIndex(const std::string& line, size_t& index);
+
+/**
+ * Batch analysis statistics
+ */
+struct AnalysisStats {
+    size_t read = 0;      // Input records
+    size_t skipped = 0;   // Already in the output (resume)
+    size_t analyzed = 0;  // Lines written, errors included
+    size_t errors = 0;    // Unreadable records
+    uint64_t nodes = 0;   // Minimax/solve nodes
+    uint64_t sims = 0;    // MCTS simulations
+    double timeMs = 0.0;
+};
+
+/**
+ * Parallel batch analyzer
+ *
+ * Reads positions as a stream, analyzes them as tasks on the thread pool
+ * (bounded in flight, so inputs of any size run in constant memory) and
+ * writes one line per record. Minimax and solve share one transposition
+ * table, so node counts, and fixed-depth minimax results, can depend on
+ * the thread count and on earlier positions; solve values and seeded MCTS
+ * results do not.
+ *
+ * Ordered output holds finished results until every earlier record has been
+ * written. Output is flushed every progressIntervalMs: an interrupted run
+ * resumes by loadExisting() on its output file, which skips the records
+ * already written, and appending to the same file.
+ */
+class BatchAnalyzer {
+public:
+    explicit BatchAnalyzer(const AnalysisConfig& config = AnalysisConfig(), ThreadPool& pool = ThreadPool::global());
+
+    // Mark the records in an existing output as done; returns how many were loaded
+    size_t loadExisting(std::istream& output);
+
+    // writeHeader: CSV header first (a new output file)
+    AnalysisStats run(PositionReader& reader, std::ostream& out, bool writeHeader = true);
+
+private:
+    AnalysisConfig config;
+    ThreadPool& pool;
+    std::unordered_set<size_t> done;
+};
+
+} // namespace tools
+} // namespace hexuki
+
+#endif // HEXUKI_BATCH_ANALYSIS_H
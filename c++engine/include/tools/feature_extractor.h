@@ -0,0 +1,61 @@
+#ifndef HEXUKI_FEATURE_EXTRACTOR_H
+#define HEXUKI_FEATURE_EXTRACTOR_H
+
+#include "core/bitboard.h"
+#include "core/thread_pool.h"
+#include "io/columnar.h"
+#include "io/game_archive.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hexuki {
+namespace tools {
+
+/**
+ * Feature extraction configuration
+ */
+struct FeatureConfig {
+    uint64_t chunkGames = 4096;   // Games per work chunk (and per write batch)
+
+    FeatureConfig() = default;
+};
+
+/**
+ * Per-ply feature schema (one row per move played)
+ *
+ * Position features describe the board BEFORE the move; *_delta columns are
+ * the score change the move causes. Columns:
+ *   game, ply, player, hex, tile, result, final_margin
+ *   p1_chain{0-4}_filled, p1_chain{0-4}_product, p2_chain{0-4}_filled, p2_chain{0-4}_product
+ *   empty, frontier, legal_hexes, legal_moves
+ *   p1_tile{v}, p2_tile{v}   (inventory count of each tile value)
+ *   p1_score, p2_score, p1_delta, p2_delta
+ */
+const std::vector<io::ColumnSpec>& featureSchema();
+
+/**
+ * Replay one archived game on board (which must be at the initial position)
+ * and append one feature row per move. The board is restored with unmakeMove,
+ * so the same board is reused for every game.
+ *
+ * Records are checked first (move codes in range, every move legal in turn);
+ * a malformed record appends nothing and returns false.
+ */
+bool extractGameFeatures(HexukiBitboard& board, const io::ArchiveRecord& record, uint32_t gameId,
+                         io::ColumnBatch& batch);
+
+/**
+ * Extract features for every game in the archive, in parallel chunks,
+ * written in archive order. Returns the number of rows written; malformed
+ * records are skipped and counted in skippedGames when given.
+ */
+uint64_t extractArchiveFeatures(const io::GameArchive& archive, const std::string& outDir,
+                                const FeatureConfig& config = FeatureConfig(),
+                                ThreadPool& pool = ThreadPool::global(),
+                                uint64_t* skippedGames = nullptr);
+
+} // namespace tools
+} // namespace hexuki
+
+#endif // HEXUKI_FEATURE_EXTRACTOR_H
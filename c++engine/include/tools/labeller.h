@@ -0,0 +1,101 @@
+#ifndef HEXUKI_LABELLER_H
+#define HEXUKI_LABELLER_H
+
+#include "core/bitboard.h"
+#include "core/move.h"
+#include "ai/minimax.h"
+#include "core/thread_pool.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace hexuki {
+namespace tools {
+
+/**
+ * Exact-label pipeline configuration
+ */
+struct LabelConfig {
+    int minEmpty = 1;               // Skip positions with fewer empty hexes
+    int maxEmpty = 8;               // Skip positions with more empty hexes (too slow to solve)
+    size_t ttSizeMB = 256;          // Transposition table shared by all solver threads
+    int progressIntervalMs = 2000;  // Progress report interval
+    bool verbose = true;            // Print progress to stderr
+
+    LabelConfig() = default;
+};
+
+/**
+ * Exact game-theoretic label for one position
+ */
+struct PositionLabel {
+    uint64_t hash;                // Zobrist hash (dedup key)
+    std::string position;         // savePosition() string
+    int value;                    // Final score difference with perfect play (side to move's perspective)
+    std::vector<Move> bestMoves;  // Every move that achieves value
+    int nodes;                    // Nodes searched to prove it
+
+    PositionLabel() : hash(0), value(0), nodes(0) {}
+};
+
+/**
+ * Pipeline statistics
+ */
+struct LabelStats {
+    size_t gamesRead = 0;      // Game records consumed
+    size_t positionsSeen = 0;  // Positions within [minEmpty, maxEmpty]
+    size_t duplicates = 0;     // Skipped: already seen or already labelled
+    size_t labelled = 0;       // New labels written
+    uint64_t nodes = 0;        // Total nodes searched
+    double timeMs = 0.0;
+};
+
+/**
+ * Solve a position to the end of the game
+ *
+ * Every root move is searched with window (best - 1, +INF), so ties with the
+ * best score come back exact and the full best-move set is recovered.
+ * The table may be shared with other threads.
+ */
+PositionLabel solveExact(HexukiBitboard& board, minimax::TranspositionTable& tt);
+
+/**
+ * Label file lines (tab separated):
+ *   hash<TAB>position<TAB>value<TAB>best moves (space separated)<TAB>nodes
+ */
+std::string formatLabel(const PositionLabel& label);
+bool parseLabel(const std::string& line, PositionLabel& label);
+
+/**
+ * Streaming labeller
+ *
+ * Replays game records, deduplicates positions by hash, solves each new one
+ * exactly as tasks on a thread pool, all sharing one transposition table, and
+ * appends labels to the output as they complete.
+ *
+ * Resumable: loadExisting() reads a previous output file so its positions are
+ * skipped, and new labels can be appended to the same file.
+ */
+class Labeller {
+public:
+    explicit Labeller(const LabelConfig& config = LabelConfig(), ThreadPool& pool = ThreadPool::global());
+
+    // Mark positions in an existing label file as done; returns how many were loaded
+    size_t loadExisting(std::istream& labels);
+
+    // Label every new position reachable in the game records
+    LabelStats run(std::istream& games, std::ostream& out);
+
+private:
+    LabelConfig config;
+    ThreadPool& pool;
+    std::unordered_set<uint64_t> seen;
+};
+
+} // namespace tools
+} // namespace hexuki
+
+#endif // HEXUKI_LABELLER_H
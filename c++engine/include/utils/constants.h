@@ -16,6 +16,7 @@ constexpr int NUM_TILES_PER_PLAYER = 9;  // ALWAYS 9 tiles per player (game rule
 constexpr int CENTER_HEX = 9;            // Center hex (starts with value 1)
 constexpr int STARTING_TILE = 1;         // Value of starting tile at center
 constexpr int MAX_MOVES = 18;            // All non-center hexes
+constexpr int MAX_LEGAL_MOVES = NUM_HEXES * NUM_TILES_PER_PLAYER;  // Moves in one position, at most
 
 // ============================================================================
 // TILE VALUES (configurable for testing variants)
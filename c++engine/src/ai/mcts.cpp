@@ -1,8 +1,12 @@
 #include "ai/mcts.h"
 #include "ai/minimax.h"
+#include "core/board_kernels.h"
+#include "core/thread_pool.h"
+#include "core/trace.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace hexuki {
 namespace mcts {
@@ -14,25 +18,25 @@ namespace mcts {
 MCTS::MCTS()
     : root(nullptr)
     , rng(std::random_device{}())
-    , currentConfig(nullptr)
-    , sharedMinimaxTT(nullptr) {
-    // Create shared transposition table for minimax rollouts (128MB)
-    sharedMinimaxTT = new minimax::TranspositionTable(128);
+    , rootPlayer(PLAYER_1)
+    , simulations(0) {
+    // No tables here: constructing an engine must stay cheap (WASM startup)
 }
 
 MCTS::~MCTS() {
     resetTree();
-    if (sharedMinimaxTT) {
-        delete sharedMinimaxTT;
-        sharedMinimaxTT = nullptr;
-    }
 }
 
 void MCTS::resetTree() {
-    if (root != nullptr) {
-        delete root;
-        root = nullptr;
-    }
+    nodes.reset();
+    root = nullptr;
+}
+
+// Uniform index in [0, n) from one 32-bit draw (multiply-shift). Unlike
+// std::uniform_int_distribution this is the same on every standard library,
+// so seeded searches match between native and WASM builds.
+static size_t randomIndex(std::mt19937& rng, size_t n) {
+    return static_cast<size_t>((static_cast<uint64_t>(rng()) * n) >> 32);
 }
 
 // ============================================================================
@@ -40,44 +44,77 @@ void MCTS::resetTree() {
 // ============================================================================
 
 MCTSResult MCTS::findBestMove(HexukiBitboard& board, const MCTSConfig& config) {
-    auto startTime = std::chrono::steady_clock::now();
+    HEXUKI_TRACE_SCOPE("mcts.search", "threads", config.numThreads);
+    if (config.numThreads > 1) {
+        return findBestMoveParallel(board, config);
+    }
+    beginSearch(board, config);
+    while (!step(std::numeric_limits<int>::max())) {
+    }
+    MCTSResult result = getResult();
+    endSearch();
+    return result;
+}
+
+void MCTS::beginSearch(const HexukiBitboard& board, const MCTSConfig& config) {
+    startTime = std::chrono::steady_clock::now();
+    currentConfig = config;
+    rootBoard = board;
+    simulations = 0;
+    if (config.seed != 0) {
+        rng.seed(config.seed);
+    }
 
     // Store root player so we can evaluate from their perspective
     rootPlayer = board.getCurrentPlayer();
 
     // Initialize root node
     resetTree();
-    root = new MCTSNode();
+    root = nodes.create();
     root->playerToMove = rootPlayer;  // Root player makes the first move
     root->untriedMoves = board.getValidMoves();
 
     // Clear shared transposition table for fresh search
     // (cache will build up during simulations and speed up later ones)
-    if (sharedMinimaxTT) {
-        sharedMinimaxTT->clear();
+    if (config.useMinimaxRollouts) {
+        if (!rolloutTT) {
+            rolloutTT = minimax::TablePool::global().acquire(ROLLOUT_TT_MB);  // Already clear
+        } else if (!rolloutTT.isShared()) {
+            rolloutTT->clear();  // A shared table is still in use elsewhere
+        }
     }
+}
 
-    MCTSResult result;
-    result.simulations = 0;
+void MCTS::endSearch() {
+    // Back to the pool, so the next search of any kind can lease it
+    rolloutTT.reset();
+}
 
-    // Main MCTS loop
-    while (true) {
+bool MCTS::step(int maxSimulations) {
+    HEXUKI_TRACE_SCOPE("mcts.step", "max_sims", maxSimulations);
+    const MCTSConfig& config = currentConfig;
+    if (config.useMinimaxRollouts && !rolloutTT) {
+        rolloutTT = minimax::TablePool::global().acquire(ROLLOUT_TT_MB);  // Stepped again after endSearch()
+    }
+
+    for (int i = 0; i < maxSimulations; i++) {
         // Check time limit
         if (config.useTimeLimit) {
             auto now = std::chrono::steady_clock::now();
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
             if (elapsed >= config.timeLimitMs) {
-                break;
+                return true;
             }
         } else {
             // Check simulation count
-            if (result.simulations >= config.numSimulations) {
-                break;
+            if (simulations >= config.numSimulations) {
+                return true;
             }
         }
 
-        // Make a copy of the board for this simulation
-        HexukiBitboard simBoard = board;
+        // Copy the board for this simulation (assigned into the same
+        // board each time, so its tile lists are not reallocated)
+        simBoard = rootBoard;
 
         // 1. SELECTION: Traverse tree using UCT
         MCTSNode* node = select(root, simBoard);
@@ -93,21 +130,31 @@ MCTSResult MCTS::findBestMove(HexukiBitboard& board, const MCTSConfig& config) {
         // 4. BACKPROPAGATION: Update all ancestors
         backpropagate(node, score);
 
-        result.simulations++;
+        simulations++;
 
         // Print progress
-        if (config.verbose && result.simulations % 1000 == 0) {
+        if (config.verbose && simulations % 1000 == 0) {
             auto now = std::chrono::steady_clock::now();
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-            std::cout << "Simulations: " << result.simulations
+            std::cout << "Simulations: " << simulations
                       << " | Time: " << elapsed << "ms"
                       << " | Root visits: " << root->visits << std::endl;
         }
     }
+    return false;
+}
+
+MCTSResult MCTS::getResult() const {
+    MCTSResult result;
+    result.simulations = simulations;
 
     auto endTime = std::chrono::steady_clock::now();
     result.timeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
 
+    if (root == nullptr) {
+        return result;
+    }
+
     // Select best move (most visited child)
     if (root->children.empty()) {
         // No children expanded - just return first untried move
@@ -152,6 +199,106 @@ MCTSResult MCTS::findBestMove(HexukiBitboard& board, const MCTSConfig& config) {
     return result;
 }
 
+// ============================================================================
+// Root Parallel Search
+// ============================================================================
+
+/**
+ * Root parallelization: numThreads independent trees (this one plus helpers)
+ * each run a share of the simulations with their own seed, then the visit
+ * counts and scores of equal root moves are summed. The trees share nothing,
+ * so the merged result does not depend on scheduling: with a seed and a
+ * simulation count it is reproducible for any pool size, including a pool
+ * without workers (everything then runs on this thread).
+ */
+// One tree of a parallel search. A time limit counts from the parallel
+// search's start, not the tree's: with fewer workers than trees the trees
+// run one after another, and must still finish within one time limit.
+void MCTS::searchTree(const HexukiBitboard& board, const MCTSConfig& config,
+                      std::chrono::steady_clock::time_point start) {
+    beginSearch(board, config);
+    startTime = start;
+    while (!step(std::numeric_limits<int>::max())) {
+    }
+    endSearch();
+}
+
+MCTSResult MCTS::findBestMoveParallel(HexukiBitboard& board, const MCTSConfig& config) {
+    auto begin = std::chrono::steady_clock::now();
+    const int trees = config.numThreads;
+    while (static_cast<int>(helpers.size()) < trees - 1) {
+        helpers.push_back(std::make_unique<MCTS>());
+    }
+
+    std::vector<MCTSConfig> configs(trees, config);
+    for (int i = 0; i < trees; i++) {
+        configs[i].numThreads = 1;
+        configs[i].numSimulations = config.numSimulations / trees + (i < config.numSimulations % trees ? 1 : 0);
+        if (config.seed != 0) {
+            configs[i].seed = config.seed + static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<MCTS*> engines = {this};
+    {
+        TaskGroup group;
+        for (int i = 1; i < trees; i++) {
+            MCTS* helper = helpers[i - 1].get();
+            engines.push_back(helper);
+            group.run([helper, &board, &configs, i, begin]() { helper->searchTree(board, configs[i], begin); });
+        }
+        searchTree(board, configs[0], begin);
+        group.wait();
+    }
+
+    // Merge root children by move, in first-seen order (tree 0 first)
+    struct MergedMove {
+        Move move;
+        int visits;
+        double totalScore;  // From the opponent's perspective, as in the nodes
+    };
+    std::vector<MergedMove> merged;
+    MCTSResult result;
+    for (MCTS* engine : engines) {
+        result.simulations += engine->simulations;
+        for (MCTSNode* child : engine->root->children) {
+            auto it = std::find_if(merged.begin(), merged.end(),
+                                   [child](const MergedMove& m) { return m.move == child->move; });
+            if (it == merged.end()) {
+                merged.push_back({child->move, child->visits, child->totalScore});
+            } else {
+                it->visits += child->visits;
+                it->totalScore += child->totalScore;
+            }
+        }
+    }
+    result.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    if (merged.empty()) {
+        if (!root->untriedMoves.empty()) {
+            result.bestMove = root->untriedMoves[0];
+        }
+        return result;
+    }
+
+    // Most visited wins; stable sort keeps ties in first-seen order
+    std::stable_sort(merged.begin(), merged.end(),
+                     [](const MergedMove& a, const MergedMove& b) { return a.visits > b.visits; });
+
+    result.bestMove = merged[0].move;
+    result.visits = merged[0].visits;
+    result.winRate = 1.0 - merged[0].totalScore / merged[0].visits;
+
+    for (size_t i = 0; i < std::min(size_t(10), merged.size()); i++) {
+        MCTSResult::MoveStats stats;
+        stats.move = merged[i].move;
+        stats.visits = merged[i].visits;
+        stats.winRate = 1.0 - merged[i].totalScore / merged[i].visits;
+        result.topMoves.push_back(stats);
+    }
+    return result;
+}
+
 // Simple interfaces
 MCTSResult MCTS::findBestMove(HexukiBitboard& board, int simulations) {
     MCTSConfig config;
@@ -199,8 +346,7 @@ MCTSNode* MCTS::expand(MCTSNode* node, HexukiBitboard& board) {
     }
 
     // Pick a random untried move
-    std::uniform_int_distribution<size_t> dist(0, node->untriedMoves.size() - 1);
-    size_t idx = dist(rng);
+    size_t idx = randomIndex(rng, node->untriedMoves.size());
     Move move = node->untriedMoves[idx];
 
     // Remove from untried moves
@@ -210,7 +356,7 @@ MCTSNode* MCTS::expand(MCTSNode* node, HexukiBitboard& board) {
     board.makeMove(move);
 
     // Create child node
-    MCTSNode* child = node->addChild(move);
+    MCTSNode* child = node->addChild(move, nodes);
     child->playerToMove = board.getCurrentPlayer();  // After move, it's opponent's turn
 
     // Initialize child's untried moves
@@ -227,6 +373,7 @@ MCTSNode* MCTS::expand(MCTSNode* node, HexukiBitboard& board) {
  * Returns score from Player 1's perspective
  */
 double MCTS::simulate(HexukiBitboard& board, const MCTSConfig& config) {
+    HEXUKI_TRACE_SCOPE("mcts.rollout");
     // Phase 1: Random rollout until threshold (if minimax enabled)
     while (!isTerminal(board)) {
         // Check if we should switch to minimax evaluation
@@ -256,7 +403,7 @@ double MCTS::simulate(HexukiBitboard& board, const MCTSConfig& config) {
                     searchDepth,
                     -1000000,  // alpha
                     1000000,   // beta
-                    *sharedMinimaxTT,  // SHARED TT across all simulations!
+                    *rolloutTT,  // SHARED TT across all simulations!
                     nodesSearched,
                     std::chrono::steady_clock::now(),
                     30000,  // timeout
@@ -287,12 +434,17 @@ double MCTS::simulate(HexukiBitboard& board, const MCTSConfig& config) {
             }
         }
 
-        // Continue random rollout
-        std::vector<Move> moves = board.getValidMoves();
-        if (moves.empty()) break;
-
-        Move move = selectRandomMove(moves);
-        board.makeMove(move);
+        // Continue random rollout. Draws an index into the getValidMoves()
+        // order (hex-major, then tile) straight from the legal hex mask,
+        // without building the move list.
+        uint32_t legal = board.getLegalHexMask();
+        int tiles[NUM_TILES_PER_PLAYER];
+        int tileCount = board.getUniqueTiles(tiles);
+        int moveCount = kernels::popCount(legal) * tileCount;
+        if (moveCount == 0) break;
+
+        int index = static_cast<int>(randomIndex(rng, moveCount));
+        board.makeMove(Move(kernels::nthSetBit(legal, index / tileCount), tiles[index % tileCount]));
     }
 
     // Game ended during random rollout - return final score from P1's perspective
@@ -332,8 +484,8 @@ bool MCTS::isTerminal(const HexukiBitboard& board) const {
 double MCTS::evaluateTerminal(const HexukiBitboard& board) const {
     // ALWAYS return from Player 1's perspective
     // 1.0 = P1 wins, 0.0 = P2 wins, 0.5 = draw
-    int p1Score = board.getScore(PLAYER_1);
-    int p2Score = board.getScore(PLAYER_2);
+    int p1Score, p2Score;
+    board.getScores(p1Score, p2Score);
 
     if (p1Score > p2Score) {
         return 1.0;  // P1 wins
@@ -344,10 +496,5 @@ double MCTS::evaluateTerminal(const HexukiBitboard& board) const {
     }
 }
 
-Move MCTS::selectRandomMove(const std::vector<Move>& moves) {
-    std::uniform_int_distribution<size_t> dist(0, moves.size() - 1);
-    return moves[dist(rng)];
-}
-
 } // namespace mcts
 } // namespace hexuki
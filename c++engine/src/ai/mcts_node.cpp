@@ -1,7 +1,9 @@
 #include "ai/mcts_node.h"
+#include "ai/minimax.h"
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <new>
 
 namespace hexuki {
 namespace mcts {
@@ -14,17 +16,6 @@ MCTSNode::MCTSNode(MCTSNode* parent, const Move& move)
     , totalScore(0.0) {
 }
 
-MCTSNode::~MCTSNode() {
-    deleteChildren();
-}
-
-void MCTSNode::deleteChildren() {
-    for (MCTSNode* child : children) {
-        delete child;
-    }
-    children.clear();
-}
-
 double MCTSNode::getUCTValue(double explorationConstant) const {
     if (visits == 0) {
         return std::numeric_limits<double>::infinity();  // Unvisited nodes have infinite UCT
@@ -64,8 +55,8 @@ MCTSNode* MCTSNode::selectBestChild(double explorationConstant) const {
     return bestChild;
 }
 
-MCTSNode* MCTSNode::addChild(const Move& move) {
-    MCTSNode* child = new MCTSNode(this, move);
+MCTSNode* MCTSNode::addChild(const Move& move, NodeArena& arena) {
+    MCTSNode* child = arena.create(this, move);
     children.push_back(child);
     return child;
 }
@@ -75,5 +66,45 @@ void MCTSNode::update(double score) {
     totalScore += score;
 }
 
+// ============================================================================
+// Node Arena
+// ============================================================================
+
+NodeArena::NodeArena(size_t chunkBytes, const LargePageConfig& pages)
+    : chunkBytes(std::max(chunkBytes, sizeof(MCTSNode)))
+    , nodesPerChunk(this->chunkBytes / sizeof(MCTSNode))
+    , count(0)
+    , reservedBytes(0)
+    , pages(pages) {
+}
+
+NodeArena::~NodeArena() {
+    reset();
+    minimax::TablePool::global().uncharge(reservedBytes);
+}
+
+MCTSNode* NodeArena::slot(size_t index) const {
+    char* chunk = static_cast<char*>(chunks[index / nodesPerChunk].data());
+    return reinterpret_cast<MCTSNode*>(chunk + (index % nodesPerChunk) * sizeof(MCTSNode));
+}
+
+MCTSNode* NodeArena::create(MCTSNode* parent, const Move& move) {
+    if (count == chunks.size() * nodesPerChunk) {
+        chunks.emplace_back(chunkBytes, pages);
+        reservedBytes += chunks.back().size();
+        minimax::TablePool::global().charge(chunks.back().size());
+    }
+    MCTSNode* node = new (slot(count)) MCTSNode(parent, move);
+    count++;
+    return node;
+}
+
+void NodeArena::reset() {
+    for (size_t i = 0; i < count; i++) {
+        slot(i)->~MCTSNode();
+    }
+    count = 0;
+}
+
 } // namespace mcts
 } // namespace hexuki
@@ -1,6 +1,10 @@
 #include "ai/minimax.h"
+#include "core/thread_pool.h"
+#include "core/trace.h"
 #include "core/zobrist.h"
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <limits>
 
@@ -16,46 +20,288 @@ constexpr int TIMEOUT_CHECK_INTERVAL = 1000;  // Check time every 1000 nodes
 // Transposition Table Implementation
 // ============================================================================
 
-TranspositionTable::TranspositionTable(size_t sizeMB)
-    : maxSize((sizeMB * 1024 * 1024) / sizeof(TTEntry))
+TranspositionTable::TranspositionTable(size_t sizeMB, const LargePageConfig& pages)
+    : slots(nullptr)
+    , numSlots(1)
+    , mask(0)
+    , dirty(false)
     , hits(0)
     , misses(0) {
-    table.reserve(maxSize);  // Reserve full capacity to avoid rehashing
+    // Round down to a power of two so indexing is a single AND
+    size_t maxSlots = (sizeMB * 1024 * 1024) / sizeof(Slot);
+    while (numSlots * 2 <= maxSlots) {
+        numSlots *= 2;
+    }
+    mask = numSlots - 1;
+
+    // Zeroed OS pages: untouched parts of the table cost no physical memory
+    // (unless prefaulted), and 2MB pages keep random probes off the TLB miss path
+    memory = LargePageBuffer(numSlots * sizeof(Slot), pages);
+    slots = static_cast<Slot*>(memory.data());
+}
+
+uint64_t TranspositionTable::pack(const TTEntry& entry) {
+    // score:32 | depth:8 | flag:8 | hexId:8 | tileValue:8
+    return static_cast<uint64_t>(static_cast<uint32_t>(entry.score))
+         | (static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << 32)
+         | (static_cast<uint64_t>(static_cast<uint8_t>(entry.flag)) << 40)
+         | (static_cast<uint64_t>(static_cast<uint8_t>(entry.bestMove.hexId)) << 48)
+         | (static_cast<uint64_t>(static_cast<uint8_t>(entry.bestMove.tileValue)) << 56);
+}
+
+TTEntry TranspositionTable::unpack(uint64_t data) {
+    return TTEntry(
+        static_cast<int32_t>(static_cast<uint32_t>(data)),
+        static_cast<int8_t>(data >> 32),
+        static_cast<TTEntry::Flag>(static_cast<uint8_t>(data >> 40)),
+        Move(static_cast<int8_t>(data >> 48), static_cast<int8_t>(data >> 56)));
 }
 
 void TranspositionTable::store(uint64_t hash, const TTEntry& entry) {
-    // Always-replace strategy with depth preference for existing entries
-    auto it = table.find(hash);
+    Slot& slot = slots[hash & mask];
+    uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    uint64_t oldKey = slot.key.load(std::memory_order_relaxed);
+
+    // Same position already stored: replace only if new entry is deeper or same depth
+    // Different position (or empty slot): always replace
+    if (oldData != 0 && (oldKey ^ oldData) == hash &&
+        entry.depth < static_cast<int8_t>(oldData >> 32)) {
+        return;
+    }
 
-    if (it != table.end()) {
-        // Entry exists - replace only if new entry is deeper or same depth
-        if (entry.depth >= it->second.depth) {
-            it->second = entry;
-        }
-        // Otherwise keep the deeper entry
-    } else {
-        // Entry doesn't exist - always add it
-        // Let the hash map grow beyond maxSize if needed
-        // This ensures deep search results are always stored
-        table[hash] = entry;
+    uint64_t data = pack(entry);
+    slot.key.store(hash ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+
+    if (!dirty.load(std::memory_order_relaxed)) {
+        dirty.store(true, std::memory_order_relaxed);
     }
 }
 
 bool TranspositionTable::probe(uint64_t hash, TTEntry& entry) const {
-    auto it = table.find(hash);
-    if (it != table.end()) {
-        entry = it->second;
-        hits++;
+    const Slot& slot = slots[hash & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t key = slot.key.load(std::memory_order_relaxed);
+
+    if (data != 0 && (key ^ data) == hash) {
+        entry = unpack(data);
+        hits.store(hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         return true;
     }
-    misses++;
+    misses.store(misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     return false;
 }
 
 void TranspositionTable::clear() {
-    table.clear();
-    hits = 0;
-    misses = 0;
+    // Skip the memset when nothing was stored, so an unused table never
+    // faults in its pages
+    if (dirty.load(std::memory_order_relaxed)) {
+        std::memset(static_cast<void*>(slots), 0, numSlots * sizeof(Slot));
+        dirty.store(false, std::memory_order_relaxed);
+    }
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Table Pool
+// ============================================================================
+
+TableLease::TableLease(TableLease&& other) noexcept
+    : table(std::move(other.table))
+    , sizeMB(other.sizeMB)
+    , shared(other.shared) {
+    other.sizeMB = 0;
+    other.shared = false;
+}
+
+TableLease& TableLease::operator=(TableLease&& other) noexcept {
+    if (this != &other) {
+        reset();
+        table = std::move(other.table);
+        sizeMB = other.sizeMB;
+        shared = other.shared;
+        other.sizeMB = 0;
+        other.shared = false;
+    }
+    return *this;
+}
+
+void TableLease::reset() {
+    table.reset();
+    sizeMB = 0;
+    shared = false;
+}
+
+static constexpr size_t MB = 1024 * 1024;
+
+// Largest power of two <= sizeMB (sizeMB >= 1)
+static size_t floorPowerOfTwo(size_t sizeMB) {
+    size_t size = 1;
+    while (size * 2 <= sizeMB) {
+        size *= 2;
+    }
+    return size;
+}
+
+TablePool::TablePool(size_t budgetMB)
+    : budgetBytes(std::max(budgetMB, MIN_TABLE_MB) * MB)
+    , allocatedBytes(0)
+    , leasedBytes(0)
+    , chargedBytes(0) {
+}
+
+TablePool::~TablePool() {
+}
+
+// Bytes a table of sizeMB maps: its buffer is rounded up to whole large pages
+size_t TablePool::tableBytes(size_t sizeMB) {
+    const size_t page = LargePageBuffer::LARGE_PAGE_SIZE;
+    return (sizeMB * MB + page - 1) / page * page;
+}
+
+// Hand out the largest table still in use (not cleared: it is being searched).
+// Called with the lock held, so no reference but the one handed out is taken:
+// dropping the last one would return the table and take the lock again.
+bool TablePool::shareLeased(TableLease& lease) {
+    std::vector<const Leased*> candidates;
+    for (const auto& candidate : leased) {
+        candidates.push_back(&candidate);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Leased* a, const Leased* b) { return a->sizeMB > b->sizeMB; });
+    for (const Leased* candidate : candidates) {
+        lease.table = candidate->table.lock();
+        if (lease.table) {
+            lease.sizeMB = candidate->sizeMB;
+            lease.shared = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+TableLease TablePool::acquire(size_t sizeMB) {
+    TableLease lease;
+    std::unique_ptr<TranspositionTable> table;
+    std::vector<Pooled> freed;  // Destroyed after the lock is released
+    size_t granted = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t used = leasedBytes + chargedBytes;
+        size_t available = budgetBytes > used ? budgetBytes - used : 0;
+        if (tableBytes(MIN_TABLE_MB) > available && shareLeased(lease)) {
+            return lease;
+        }
+
+        granted = floorPowerOfTwo(std::max(MIN_TABLE_MB, std::min(sizeMB, available / MB)));
+        auto it = std::find_if(pooled.begin(), pooled.end(),
+                               [granted](const Pooled& p) { return p.sizeMB == granted; });
+        if (it != pooled.end()) {
+            table = std::move(it->table);
+            pooled.erase(it);
+        } else {
+            // Make room by dropping pooled tables of other sizes
+            size_t reserved = chargedBytes + tableBytes(granted);
+            freePooledUntil(budgetBytes > reserved ? budgetBytes - reserved : 0, freed);
+            allocatedBytes += tableBytes(granted);
+        }
+        leasedBytes += tableBytes(granted);
+    }
+
+    // Allocate or clear outside the lock: both can take a while for big tables
+    if (table) {
+        HEXUKI_TRACE_SCOPE("tt.clear", "mb", static_cast<int64_t>(granted));
+        table->clear();
+    } else {
+        HEXUKI_TRACE_SCOPE("tt.allocate", "mb", static_cast<int64_t>(granted));
+        table = std::make_unique<TranspositionTable>(granted);
+    }
+
+    // Returned to the pool when the last lease sharing it lets go
+    lease.table = std::shared_ptr<TranspositionTable>(table.release(), [this, granted](TranspositionTable* t) {
+        release(granted, std::unique_ptr<TranspositionTable>(t));
+    });
+    lease.sizeMB = granted;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    leased.erase(std::remove_if(leased.begin(), leased.end(), [](const Leased& l) { return l.table.expired(); }),
+                 leased.end());
+    leased.push_back({granted, lease.table});
+    return lease;
+}
+
+void TablePool::release(size_t sizeMB, std::unique_ptr<TranspositionTable> table) {
+    std::lock_guard<std::mutex> lock(mutex);
+    leasedBytes -= tableBytes(sizeMB);
+    if (allocatedBytes + chargedBytes > budgetBytes) {
+        // Budget was lowered (or charged) while the table was out: don't keep it
+        allocatedBytes -= tableBytes(sizeMB);
+        table.reset();
+        return;
+    }
+    pooled.push_back({sizeMB, std::move(table)});
+}
+
+void TablePool::freePooledUntil(size_t allocatedLimitBytes, std::vector<Pooled>& freed) {
+    // Oldest first
+    while (allocatedBytes > allocatedLimitBytes && !pooled.empty()) {
+        allocatedBytes -= tableBytes(pooled.front().sizeMB);
+        freed.push_back(std::move(pooled.front()));
+        pooled.erase(pooled.begin());
+    }
+}
+
+void TablePool::setBudgetMB(size_t budgetMB) {
+    std::vector<Pooled> freed;
+    HEXUKI_TRACE_INSTANT("tt.budget", "mb", static_cast<int64_t>(budgetMB));
+    std::lock_guard<std::mutex> lock(mutex);
+    budgetBytes = std::max(budgetMB, MIN_TABLE_MB) * MB;
+    freePooledUntil(budgetBytes > chargedBytes ? budgetBytes - chargedBytes : 0, freed);
+}
+
+size_t TablePool::getBudgetMB() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return budgetBytes / MB;
+}
+
+size_t TablePool::getAllocatedMB() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocatedBytes / MB;
+}
+
+size_t TablePool::getLeasedMB() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return leasedBytes / MB;
+}
+
+void TablePool::charge(size_t bytes) {
+    std::vector<Pooled> freed;
+    std::lock_guard<std::mutex> lock(mutex);
+    chargedBytes += bytes;
+    freePooledUntil(budgetBytes > chargedBytes ? budgetBytes - chargedBytes : 0, freed);
+}
+
+void TablePool::uncharge(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    chargedBytes -= std::min(bytes, chargedBytes);
+}
+
+size_t TablePool::getChargedMB() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (chargedBytes + MB - 1) / MB;
+}
+
+void TablePool::trim() {
+    std::vector<Pooled> freed;
+    std::lock_guard<std::mutex> lock(mutex);
+    freePooledUntil(0, freed);
+}
+
+TablePool& TablePool::global() {
+    // Never destroyed: leases held by other statics may be returned during exit
+    static TablePool* pool = new TablePool();
+    return *pool;
 }
 
 // ============================================================================
@@ -64,8 +310,8 @@ void TranspositionTable::clear() {
 
 int evaluate(const HexukiBitboard& board) {
     // Get actual scores for both players
-    int p1Score = board.getScore(PLAYER_1);
-    int p2Score = board.getScore(PLAYER_2);
+    int p1Score, p2Score;
+    board.getScores(p1Score, p2Score);
 
     // Return from current player's perspective (required for negamax)
     // Positive = current player winning, negative = opponent winning
@@ -82,14 +328,19 @@ int evaluate(const HexukiBitboard& board) {
 
 void orderMoves(std::vector<Move>& moves, const TTEntry* ttEntry,
                 const KillerMoves& killers, const HistoryTable& history, int ply) {
+    orderMoves(moves.data(), static_cast<int>(moves.size()), ttEntry, killers, history, ply);
+}
+
+void orderMoves(Move* moves, int count, const TTEntry* ttEntry,
+                const KillerMoves& killers, const HistoryTable& history, int ply) {
     // KILLER MOVE OPTIMIZATION: Use fast heuristics instead of makeMove/evaluate
     // Eliminates 40-60M makeMove calls at depth 10 (2-3x speedup)
     // GUARANTEED SAFE: Same best move, same score, just better move ordering
 
-    std::vector<std::pair<int, size_t>> moveScores;
-    moveScores.reserve(moves.size());
+    // Stack arrays: this runs at every interior node and must not allocate
+    std::pair<int, size_t> moveScores[MAX_LEGAL_MOVES];
 
-    for (size_t i = 0; i < moves.size(); i++) {
+    for (int i = 0; i < count; i++) {
         const Move& move = moves[i];
         int score = 0;
 
@@ -123,20 +374,19 @@ void orderMoves(std::vector<Move>& moves, const TTEntry* ttEntry,
             }
         }
 
-        moveScores.push_back({score, i});
+        moveScores[i] = {score, static_cast<size_t>(i)};
     }
 
     // Sort by score (descending) and reorder moves
-    std::sort(moveScores.begin(), moveScores.end(),
+    std::sort(moveScores, moveScores + count,
               [](const auto& a, const auto& b) { return a.first > b.first; });
 
     // Reorder moves based on sorted scores
-    std::vector<Move> sortedMoves;
-    sortedMoves.reserve(moves.size());
-    for (const auto& pair : moveScores) {
-        sortedMoves.push_back(moves[pair.second]);
+    Move sortedMoves[MAX_LEGAL_MOVES];
+    for (int i = 0; i < count; i++) {
+        sortedMoves[i] = moves[moveScores[i].second];
     }
-    moves = sortedMoves;
+    std::copy(sortedMoves, sortedMoves + count, moves);
 }
 
 // ============================================================================
@@ -199,24 +449,26 @@ int alphaBeta(
         // Using shallow entries for move ordering causes wrong scores at deeper depths
     }
 
-    // Get and order moves
-    std::vector<Move> moves = board.getValidMoves();
+    // Get and order moves (on the stack: no allocation per node)
+    Move moves[MAX_LEGAL_MOVES];
+    int moveCount = board.getValidMoves(moves);
 
-    if (moves.empty()) {
+    if (moveCount == 0) {
         // No moves available - game over
         return evaluate(board);
     }
 
     // BUGFIX: Only use TT entry for move ordering if it's from sufficient depth
     // Passing stale shallow entries was causing non-deterministic scores (265→261→275)
-    orderMoves(moves, ttValid ? &ttEntry : nullptr, killers, history, ply);
+    orderMoves(moves, moveCount, ttValid ? &ttEntry : nullptr, killers, history, ply);
 
     int bestScore = -INF;
     Move bestMove = moves[0];
     TTEntry::Flag flag = TTEntry::UPPER_BOUND;
 
     // Search all moves
-    for (const auto& move : moves) {
+    for (int i = 0; i < moveCount; i++) {
+        const Move& move = moves[i];
         board.makeMove(move);
         int score = -alphaBeta(board, depth - 1, -beta, -alpha, tt, nodesSearched, startTime, timeLimitMs,
                               killers, history, ply + 1);
@@ -277,158 +529,420 @@ int quiescence(
 }
 
 // ============================================================================
-// Main Search Function
+// Resumable Search
 // ============================================================================
 
-SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config) {
-    SearchResult result;
+SearchTask::SearchTask(const HexukiBitboard& board, const SearchConfig& config, TranspositionTable* sharedTT)
+    : board(board)
+    , config(config)
+    , tt(sharedTT)
+    , stackSize(0)
+    , rootIndex(0)
+    , rootAlpha(-INF)
+    , passDepth(0)
+    , passNodes(0)
+    , stepNodes(0)
+    , childPly(1)
+    , passBestScore(-INF)
+    , passTraceStart(0)
+    , rootMoveTraceStart(0)
+    , started(false)
+    , done(false)
+    , nextTimeCheck(0) {
+    // No line is longer than the empty hexes, and the stack is sized by depth
+    int empty = 0;
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (!board.isHexOccupied(hexId)) empty++;
+    }
+    this->config.maxDepth = std::max(1, std::min(config.maxDepth, empty));
+    if (!tt) {
+        ownTT = TablePool::global().acquire(config.ttSizeMB);
+        tt = ownTT.get();
+    }
 
-    auto startTime = std::chrono::steady_clock::now();
+    // Depth only decreases below the root, so maxDepth frames always suffice
+    stack.resize(this->config.maxDepth + 1);
 
-    // Initialize transposition table
-    TranspositionTable tt(config.ttSizeMB);
+    rootMoves = this->board.getValidMoves();
+    if (rootMoves.empty()) {
+        // No legal moves
+        result.score = evaluate(this->board);
+        done = true;
+        return;
+    }
+    result.bestMove = rootMoves[0];
+    result.score = -INF;
+}
 
-    // Initialize killer moves and history heuristic
-    KillerMoves killers;
-    HistoryTable history;
+bool SearchTask::step(int maxNodes) {
+    if (done) {
+        return true;
+    }
+    HEXUKI_TRACE_SCOPE("minimax.step", "max_nodes", maxNodes);
+    if (!started) {
+        started = true;
+        startTime = std::chrono::steady_clock::now();
+
+        // Only one move: still search ahead to get an accurate score, in one pass
+        // at full depth. Otherwise iterative deepening: search 1, 2, ..., maxDepth.
+        bool iterative = config.useIterativeDeepening && rootMoves.size() > 1;
+        childPly = rootMoves.size() > 1 ? 1 : 0;
+        startPass(iterative ? 1 : config.maxDepth);
+    }
 
-    std::vector<Move> moves = board.getValidMoves();
+    stepNodes = 0;
+    while (!done && stepNodes < maxNodes) {
+        // Safe point: every frame below the top has its current move made
+        if (passNodes >= nextTimeCheck) {
+            nextTimeCheck = passNodes + TIMEOUT_CHECK_INTERVAL;
+            if (timeExpired()) {
+                // Don't use a partially searched depth - keep the previous one
+                abortPass();
+                result.timeout = true;
+                finish();
+                break;
+            }
+        }
 
-    if (moves.empty()) {
-        // No legal moves
-        result.bestMove = Move();
-        result.score = evaluate(board);
-        return result;
+        if (stackSize == 0) {
+            if (rootIndex == rootMoves.size()) {
+                finishPass();
+                continue;
+            }
+            const Move& move = rootMoves[rootIndex];
+            rootMoveTraceStart = HEXUKI_TRACE_NOW();
+            board.makeMove(move);
+            int value;
+            if (!enter(passDepth - 1, -INF, -rootAlpha, childPly, value)) {
+                board.unmakeMove(move);
+                finishRootMove(-value);
+            }
+            continue;
+        }
+
+        Frame& frame = stack[stackSize - 1];
+        if (frame.next < frame.moveCount) {
+            const Move& move = frame.moves[frame.next];
+            board.makeMove(move);
+            int value;
+            if (!enter(frame.depth - 1, -frame.beta, -frame.alpha, frame.ply + 1, value)) {
+                board.unmakeMove(move);
+                childReturned(frame, -value);
+            }
+            continue;
+        }
+
+        // All moves searched (or cut off): store and return to the parent
+        tt->store(frame.hash, TTEntry(frame.bestScore, frame.depth, frame.flag, frame.bestMove));
+        int value = frame.bestScore;
+        stackSize--;
+        if (stackSize > 0) {
+            Frame& parent = stack[stackSize - 1];
+            board.unmakeMove(parent.moves[parent.next]);
+            childReturned(parent, -value);
+        } else {
+            board.unmakeMove(rootMoves[rootIndex]);
+            finishRootMove(-value);
+        }
     }
+    return done;
+}
 
-    if (moves.size() == 1) {
-        // Only one move - still need to search ahead to get accurate score!
-        // Don't just return current evaluation - make the move and evaluate the resulting position
-        result.bestMove = moves[0];
+void SearchTask::stop() {
+    if (done) {
+        return;
+    }
+    abortPass();
+    finish();
+}
 
-        // Make the move, search the resulting position, then unmake
-        board.makeMove(moves[0]);
-        int nodesSearched = 0;
-        result.score = -alphaBeta(board, config.maxDepth - 1, -INF, INF, tt, nodesSearched, startTime, config.timeLimitMs, killers, history, 0);
-        board.unmakeMove(moves[0]);
+/**
+ * Entry half of alphaBeta(): count the node, then either produce its value
+ * directly (leaf, TT cutoff, no moves) or push a frame to search its moves
+ */
+bool SearchTask::enter(int depth, int alpha, int beta, int ply, int& value) {
+    passNodes++;
+    stepNodes++;
 
-        result.depth = config.maxDepth;
-        result.nodesSearched = nodesSearched;
+    // Terminal node: game over or depth reached
+    if (depth == 0 || board.isGameOver()) {
+        value = evaluate(board);
+        return false;
+    }
 
-        auto endTime = std::chrono::steady_clock::now();
-        result.timeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    uint64_t hash = board.getHash();
 
-        return result;
+    // Transposition table lookup (only entries from sufficient depth are used,
+    // for the score and for move ordering - see alphaBeta)
+    TTEntry ttEntry;
+    bool ttValid = false;
+    if (tt->probe(hash, ttEntry) && ttEntry.depth >= depth) {
+        ttValid = true;
+
+        if (ttEntry.flag == TTEntry::EXACT) {
+            value = ttEntry.score;
+            return false;
+        } else if (ttEntry.flag == TTEntry::LOWER_BOUND) {
+            alpha = std::max(alpha, ttEntry.score);
+        } else if (ttEntry.flag == TTEntry::UPPER_BOUND) {
+            beta = std::min(beta, ttEntry.score);
+        }
+
+        if (alpha >= beta) {
+            value = ttEntry.score;
+            return false;
+        }
     }
 
-    Move bestMove = moves[0];
-    int bestScore = -INF;
+    Frame& frame = stack[stackSize];
+    frame.moveCount = board.getValidMoves(frame.moves);
+    if (frame.moveCount == 0) {
+        // No moves available - game over
+        value = evaluate(board);
+        return false;
+    }
+    orderMoves(frame.moves, frame.moveCount, ttValid ? &ttEntry : nullptr, killers, history, ply);
+
+    frame.depth = depth;
+    frame.alpha = alpha;
+    frame.beta = beta;
+    frame.ply = ply;
+    frame.hash = hash;
+    frame.next = 0;
+    frame.bestScore = -INF;
+    frame.bestMove = frame.moves[0];
+    frame.flag = TTEntry::UPPER_BOUND;
+    stackSize++;
+    return true;
+}
 
-    if (config.useIterativeDeepening) {
-        // Iterative deepening: search 1, 2, 3, ..., maxDepth
-        for (int depth = 1; depth <= config.maxDepth; depth++) {
-            int nodesSearched = 0;
-            int alpha = -INF;
-            int beta = INF;
+/**
+ * Loop-body half of alphaBeta(): take a child's score, then advance to the
+ * next move or cut off
+ */
+void SearchTask::childReturned(Frame& frame, int score) {
+    if (score > frame.bestScore) {
+        frame.bestScore = score;
+        frame.bestMove = frame.moves[frame.next];
+
+        if (score > frame.alpha) {
+            frame.alpha = score;
+            frame.flag = TTEntry::EXACT;
+        }
+    }
 
-            Move currentBestMove;
-            int currentBestScore = -INF;
+    // Beta cutoff - update killers and history
+    if (frame.alpha >= frame.beta) {
+        frame.flag = TTEntry::LOWER_BOUND;
+        killers.update(frame.ply, frame.bestMove);
+        history.update(frame.bestMove, frame.depth);
+        frame.next = frame.moveCount;
+        return;
+    }
+    frame.next++;
+}
 
-            // Order moves based on previous iteration's best
-            if (depth > 1) {
-                orderMoves(moves, nullptr, killers, history, 0);
-            }
+void SearchTask::startPass(int depth) {
+    passTraceStart = HEXUKI_TRACE_NOW();
+    passDepth = depth;
+    passNodes = 0;
+    nextTimeCheck = TIMEOUT_CHECK_INTERVAL;
+    rootIndex = 0;
+    rootAlpha = -INF;
+    passBestMove = Move();
+    passBestScore = -INF;
+
+    // Order moves based on previous iteration's best
+    bool iterative = config.useIterativeDeepening && rootMoves.size() > 1;
+    bool order = iterative ? depth > 1 : (rootMoves.size() > 1 && config.useMoveOrdering);
+    if (order) {
+        orderMoves(rootMoves, nullptr, killers, history, 0);
+    }
+}
 
-            // Search all moves at current depth
-            bool depthTimedOut = false;
-            long long elapsed = 0;
-            for (const auto& move : moves) {
-                board.makeMove(move);
-                int score = -alphaBeta(board, depth - 1, -beta, -alpha, tt, nodesSearched, startTime, config.timeLimitMs, killers, history, 1);
-                board.unmakeMove(move);
+void SearchTask::finishRootMove(int score) {
+    HEXUKI_TRACE_COMPLETE("minimax.root_move", rootMoveTraceStart, "move",
+                          trace::moveArg(rootMoves[rootIndex].hexId, rootMoves[rootIndex].tileValue));
+    rootIndex++;
+
+    // Check if we timed out during this search
+    if (timeExpired()) {
+        abortPass();
+        result.timeout = true;
+        finish();
+        return;
+    }
 
-                // Check if we timed out during this search
-                auto now = std::chrono::steady_clock::now();
-                elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-                if (elapsed >= config.timeLimitMs) {
-                    depthTimedOut = true;
-                    break;
-                }
+    if (score > passBestScore) {
+        passBestScore = score;
+        passBestMove = rootMoves[rootIndex - 1];
+        if (score > rootAlpha) {
+            rootAlpha = score;
+        }
+    }
+}
 
-                if (score > currentBestScore) {
-                    currentBestScore = score;
-                    currentBestMove = move;
+void SearchTask::finishPass() {
+    // Update best move from this COMPLETED depth
+    result.bestMove = passBestMove;
+    result.score = passBestScore;
+    result.depth = passDepth;
+    result.nodesSearched += passNodes;
+    HEXUKI_TRACE_COMPLETE("minimax.depth", passTraceStart, "depth", passDepth);
+
+    bool iterative = config.useIterativeDeepening && rootMoves.size() > 1;
+    if (iterative && config.verbose) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+        std::cout << "Depth " << passDepth << ": score=" << passBestScore
+                  << " move=" << passBestMove.toString()
+                  << " nodes=" << passNodes
+                  << " time=" << elapsed << "ms" << std::endl;
+    }
 
-                    if (score > alpha) {
-                        alpha = score;
-                    }
-                }
-            }
+    // Stop at full depth or if mate found
+    if (!iterative || passDepth >= config.maxDepth || std::abs(passBestScore) > MATE_SCORE - 100) {
+        finish();
+        return;
+    }
+    startPass(passDepth + 1);
+}
 
-            // If we timed out mid-depth, don't use this depth's results - use previous depth
-            if (depthTimedOut) {
-                result.timeout = true;
-                break;
-            }
+void SearchTask::abortPass() {
+    HEXUKI_TRACE_COMPLETE("minimax.depth_aborted", passTraceStart, "depth", passDepth);
+    passTraceStart = 0;
+    // Unmake the moves leading to the top frame, then the root move
+    for (int i = stackSize - 2; i >= 0; i--) {
+        board.unmakeMove(stack[i].moves[stack[i].next]);
+    }
+    if (stackSize > 0) {
+        board.unmakeMove(rootMoves[rootIndex]);
+    }
+    stackSize = 0;
+}
 
-            // Update best move from this COMPLETED depth
-            bestMove = currentBestMove;
-            bestScore = currentBestScore;
-            result.depth = depth;
-            result.nodesSearched += nodesSearched;
-
-            if (config.verbose) {
-                std::cout << "Depth " << depth << ": score=" << bestScore
-                          << " move=" << bestMove.toString()
-                          << " nodes=" << nodesSearched
-                          << " time=" << elapsed << "ms" << std::endl;
-            }
+void SearchTask::finish() {
+    done = true;
+    if (started) {
+        result.timeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count();
+    }
+    result.ttHits = tt->getHits();
+    result.ttMisses = tt->getMisses();
+}
 
-            // Stop if mate found
-            if (std::abs(bestScore) > MATE_SCORE - 100) {
-                break;
-            }
-        }
-    } else {
-        // Single depth search
-        int nodesSearched = 0;
-        int alpha = -INF;
-        int beta = INF;
+bool SearchTask::timeExpired() const {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return elapsed >= config.timeLimitMs;
+}
 
-        if (config.useMoveOrdering) {
-            orderMoves(moves, nullptr, killers, history, 0);
-        }
+// ============================================================================
+// Parallel Root Search
+// ============================================================================
 
-        for (const auto& move : moves) {
-            board.makeMove(move);
-            int score = -alphaBeta(board, config.maxDepth - 1, -beta, -alpha, tt, nodesSearched, startTime, config.timeLimitMs, killers, history, 1);
-            board.unmakeMove(move);
+/**
+ * Iterative deepening with the root moves split between config.numThreads
+ * tasks. Task t searches root moves t, t + numThreads, ... in order with a
+ * full window and its own table, killers and history, kept across depths.
+ * Nothing is shared between tasks, so every score (and node count) is the
+ * same whichever workers run the tasks, or if the calling thread runs all
+ * of them. A depth interrupted by the time limit is discarded.
+ */
+static SearchResult parallelRootSearch(const HexukiBitboard& board, const SearchConfig& config) {
+    auto startTime = std::chrono::steady_clock::now();
+    SearchResult result;
 
-            if (score > bestScore) {
-                bestScore = score;
-                bestMove = move;
+    std::vector<Move> rootMoves = board.getValidMoves();
+    if (rootMoves.empty()) {
+        result.score = evaluate(board);
+        return result;
+    }
+    result.bestMove = rootMoves[0];
+
+    struct RootWorker {
+        explicit RootWorker(size_t ttSizeMB) : tt(TablePool::global().acquire(ttSizeMB)) {}
+        TableLease tt;
+        KillerMoves killers;
+        HistoryTable history;
+        int nodes = 0;
+    };
+    const int tasks = std::min<int>(config.numThreads, static_cast<int>(rootMoves.size()));
+    const size_t ttSizeMB = std::max<size_t>(1, config.ttSizeMB / config.numThreads);
+    std::vector<std::unique_ptr<RootWorker>> workers;
+    for (int t = 0; t < tasks; t++) {
+        workers.push_back(std::make_unique<RootWorker>(ttSizeMB));
+    }
 
-                if (score > alpha) {
-                    alpha = score;
+    std::vector<int> scores(rootMoves.size());
+    const int maxDepth = std::max(1, config.maxDepth);
+    bool iterative = config.useIterativeDeepening && rootMoves.size() > 1;
+    for (int depth = iterative ? 1 : maxDepth; depth <= maxDepth; depth++) {
+        HEXUKI_TRACE_SCOPE("minimax.depth", "depth", depth);
+        TaskGroup group;
+        for (int t = 0; t < tasks; t++) {
+            group.run([&, t]() {
+                RootWorker& worker = *workers[t];
+                HexukiBitboard workerBoard = board;
+                for (size_t i = t; i < rootMoves.size(); i += tasks) {
+                    HEXUKI_TRACE_SCOPE("minimax.root_move", "move",
+                                       trace::moveArg(rootMoves[i].hexId, rootMoves[i].tileValue));
+                    workerBoard.makeMove(rootMoves[i]);
+                    scores[i] = -alphaBeta(workerBoard, depth - 1, -INF, INF, *worker.tt, worker.nodes,
+                                           startTime, config.timeLimitMs, worker.killers, worker.history, 1);
+                    workerBoard.unmakeMove(rootMoves[i]);
                 }
-            }
+            });
         }
+        group.wait();
 
-        result.nodesSearched = nodesSearched;
-        result.depth = config.maxDepth;
-    }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+        if (elapsed >= config.timeLimitMs) {
+            // Some scores may be timeout values - keep the previous depth
+            result.timeout = true;
+            break;
+        }
 
-    auto endTime = std::chrono::steady_clock::now();
-    result.timeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        size_t best = std::max_element(scores.begin(), scores.end()) - scores.begin();
+        result.bestMove = rootMoves[best];
+        result.score = scores[best];
+        result.depth = depth;
 
-    result.bestMove = bestMove;
-    result.score = bestScore;
-    result.ttHits = tt.getHits();
-    result.ttMisses = tt.getMisses();
+        if (iterative && config.verbose) {
+            std::cout << "Depth " << depth << ": score=" << result.score
+                      << " move=" << result.bestMove.toString()
+                      << " time=" << elapsed << "ms" << std::endl;
+        }
+        if (std::abs(result.score) > MATE_SCORE - 100) {
+            break;
+        }
+    }
 
+    for (const auto& worker : workers) {
+        result.nodesSearched += worker->nodes;
+        result.ttHits += worker->tt->getHits();
+        result.ttMisses += worker->tt->getMisses();
+    }
+    result.timeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
     return result;
 }
 
+// ============================================================================
+// Main Search Function
+// ============================================================================
+
+SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config) {
+    if (config.numThreads > 1) {
+        return parallelRootSearch(board, config);
+    }
+    SearchTask task(board, config);
+    while (!task.step(std::numeric_limits<int>::max())) {
+    }
+    return task.getResult();
+}
+
 // Simple interface
 SearchResult findBestMove(HexukiBitboard& board, int depth, int timeLimitMs) {
     SearchConfig config;
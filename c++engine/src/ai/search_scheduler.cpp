@@ -0,0 +1,193 @@
+#include "ai/search_scheduler.h"
+#include "core/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace hexuki {
+
+SearchScheduler::SearchScheduler(int maxRunning, ThreadPool& pool)
+    : pool(pool)
+    , maxRunning(maxRunning > 0 ? maxRunning : std::max(1, pool.size()))
+    , virtualTime(0.0)
+    , running(0)
+    , nextId(1)
+    , slicesRun(0) {
+}
+
+SearchScheduler::~SearchScheduler() {
+    std::vector<std::shared_ptr<Task>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = tasks.begin(); it != tasks.end();) {
+            if (it->second->running) {
+                it->second->cancelled = true;
+                ++it;
+            } else {
+                dropped.push_back(it->second);
+                it = tasks.erase(it);
+            }
+        }
+        ready.clear();
+    }
+    for (const auto& task : dropped) {
+        if (task->onDone) task->onDone(task->id, Outcome::CANCELLED);
+    }
+    waitIdle();
+}
+
+uint64_t SearchScheduler::submit(StepFunction step, const TaskOptions& options, DoneCallback onDone) {
+    auto task = std::make_shared<Task>();
+    task->step = std::move(step);
+    task->onDone = std::move(onDone);
+    task->options = options;
+    task->options.priority = std::max(1, options.priority);
+    task->options.sliceUnits = std::max(1, options.sliceUnits);
+    task->used = 0;
+    task->running = false;
+    task->cancelled = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    task->id = nextId++;
+    // Start at the current virtual time: new tasks neither starve nor get a
+    // burst of catch-up slices ahead of existing ones
+    task->pass = virtualTime;
+    tasks[task->id] = task;
+    ready.insert({task->pass, task->id});
+    dispatch(lock);
+    return task->id;
+}
+
+bool SearchScheduler::cancel(uint64_t id) {
+    std::shared_ptr<Task> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = tasks.find(id);
+        if (it == tasks.end()) {
+            return false;
+        }
+        if (it->second->running) {
+            // Reported by runSlice() when the current slice ends
+            it->second->cancelled = true;
+            return true;
+        }
+        task = it->second;
+        ready.erase({task->pass, task->id});
+        tasks.erase(it);
+    }
+
+    if (task->onDone) task->onDone(task->id, Outcome::CANCELLED);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tasks.empty() && running == 0) {
+        idle.notify_all();
+    }
+    return true;
+}
+
+void SearchScheduler::waitIdle() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty() && running == 0) {
+                return;
+            }
+        }
+        // Help run slices when called from a thread that would otherwise idle
+        if (pool.tryRunOne()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait_for(lock, std::chrono::milliseconds(1), [&] { return tasks.empty() && running == 0; });
+    }
+}
+
+size_t SearchScheduler::getTaskCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tasks.size();
+}
+
+uint64_t SearchScheduler::getSlicesRun() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slicesRun;
+}
+
+void SearchScheduler::dispatch(std::unique_lock<std::mutex>&) {
+    while (running < maxRunning && !ready.empty()) {
+        auto next = ready.begin();
+        std::shared_ptr<Task> task = tasks[next->second];
+        virtualTime = next->first;
+        ready.erase(next);
+
+        task->running = true;
+        running++;
+        slicesRun++;
+        pool.submit([this, task]() { runSlice(task); });
+    }
+}
+
+void SearchScheduler::runSlice(const std::shared_ptr<Task>& task) {
+    int units = task->options.sliceUnits;
+    bool cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelled = task->cancelled;
+        if (task->options.budget > 0) {
+            units = static_cast<int>(std::min<uint64_t>(units, task->options.budget - task->used));
+        }
+    }
+
+    bool finished = false;
+    bool failed = false;
+    if (!cancelled) {
+        try {
+            HEXUKI_TRACE_SCOPE("scheduler.slice", "task", static_cast<int64_t>(task->id));
+            finished = task->step(units);
+        } catch (...) {
+            failed = true;
+        }
+    }
+
+    bool over = true;
+    Outcome outcome = Outcome::FINISHED;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        task->running = false;
+        task->used += units;
+
+        if (failed) {
+            outcome = Outcome::FAILED;
+        } else if (finished) {
+            outcome = Outcome::FINISHED;
+        } else if (task->cancelled) {
+            outcome = Outcome::CANCELLED;
+        } else if (task->options.budget > 0 && task->used >= task->options.budget) {
+            outcome = Outcome::BUDGET_EXHAUSTED;
+        } else {
+            over = false;
+        }
+
+        if (over) {
+            tasks.erase(task->id);
+        } else {
+            // Charge the slice against the task's share and requeue it
+            task->pass += static_cast<double>(units) / task->options.priority;
+            ready.insert({task->pass, task->id});
+        }
+    }
+
+    // The slot stays occupied until the callback returns, so waitIdle() also
+    // waits for callbacks
+    if (over && task->onDone) {
+        task->onDone(task->id, outcome);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    running--;
+    dispatch(lock);
+    if (tasks.empty() && running == 0) {
+        idle.notify_all();
+    }
+}
+
+} // namespace hexuki
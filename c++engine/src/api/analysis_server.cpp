@@ -0,0 +1,792 @@
+#include "api/analysis_server.h"
+#include "ai/mcts.h"
+#include "api/batch_ops.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // macOS: SO_NOSIGPIPE is set on each socket instead
+#endif
+
+namespace hexuki {
+namespace api {
+
+using Clock = std::chrono::steady_clock;
+
+// Work per scheduler slice: about a millisecond either way
+static constexpr int MINIMAX_SLICE_NODES = 4096;
+static constexpr int MCTS_SLICE_SIMS = 64;
+
+struct AnalysisServer::Request {
+    std::string id;
+    Kind kind = Kind::STATS;
+    HexukiBitboard board;
+    bool useMCTS = false;
+    int depth = 0;
+    int sims = 0;
+    uint32_t seed = 0;
+
+    Clock::time_point received;
+    Clock::time_point deadline;
+    Clock::time_point started;
+    bool hasStarted = false;
+    bool deadlineHit = false;
+    Reply reply;
+
+    // Search state, created by the first slice
+    std::unique_ptr<minimax::SearchTask> minimaxTask;
+    std::unique_ptr<mcts::MCTS> mctsEngine;
+};
+
+static double msBetween(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+static std::string jsonQuote(const std::string& s) {
+    std::string quoted = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            quoted += escaped;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+static std::string fixed3(double value) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3) << value;
+    return oss.str();
+}
+
+static std::string moveText(const Move& move) {
+    return move.isValid() ? move.toString() : "none";
+}
+
+static int countEmpty(const HexukiBitboard& board) {
+    int empty = 0;
+    for (int i = 0; i < NUM_HEXES; i++) {
+        if (!board.isHexOccupied(i)) empty++;
+    }
+    return empty;
+}
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+AnalysisServer::AnalysisServer(const ServerConfig& config)
+    : config(config)
+    , running(false) {
+    // The server process owns the pool: make room for the shared table
+    minimax::TablePool& pool = minimax::TablePool::global();
+    pool.setBudgetMB(std::max(pool.getBudgetMB(), config.hashMB));
+    table = pool.acquire(config.hashMB);
+    scheduler = std::make_unique<SearchScheduler>(config.maxRunning);
+}
+
+AnalysisServer::~AnalysisServer() {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        batchesClosed = true;
+    }
+    cancelBatches();    // Queued moves/eval answer "cancelled"
+    scheduler.reset();  // Outstanding searches answer "cancelled"
+    waitIdle();         // Batches in progress
+}
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+// <id> <kind> [<pos>] [key value]...
+std::shared_ptr<AnalysisServer::Request> AnalysisServer::parse(const std::string& line, Clock::time_point received) {
+    std::istringstream iss(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (iss >> token) tokens.push_back(token);
+
+    auto request = std::make_shared<Request>();
+    request->received = received;
+    if (!tokens.empty()) request->id = tokens[0];
+    if (tokens.size() < 2) throw std::invalid_argument("expected <id> <request> ...");
+
+    const std::string& kind = tokens[1];
+    if (kind == "stats") {
+        request->kind = Kind::STATS;
+        return request;
+    } else if (kind == "moves") {
+        request->kind = Kind::MOVES;
+    } else if (kind == "eval") {
+        request->kind = Kind::EVAL;
+    } else if (kind == "analyze") {
+        request->kind = Kind::ANALYZE;
+    } else if (kind == "solve") {
+        request->kind = Kind::SOLVE;
+    } else {
+        throw std::invalid_argument("unknown request: " + kind);
+    }
+
+    if (tokens.size() < 3) throw std::invalid_argument(kind + " needs a position");
+    if (tokens[2] != "startpos") {
+        if (!isValidPositionString(tokens[2])) throw std::invalid_argument("invalid position: " + tokens[2]);
+        request->board.loadPosition(tokens[2]);
+    }
+
+    int deadlineMs = config.defaultDeadlineMs;
+    for (size_t i = 3; i < tokens.size(); i += 2) {
+        const std::string& key = tokens[i];
+        if (i + 1 >= tokens.size()) throw std::invalid_argument(key + " needs a value");
+        const std::string& value = tokens[i + 1];
+        if (key == "deadline") {
+            deadlineMs = std::max(1, std::min(std::stoi(value), config.maxDeadlineMs));
+        } else if (request->kind == Kind::ANALYZE && key == "engine") {
+            if (value != "minimax" && value != "mcts") throw std::invalid_argument("engine must be minimax or mcts");
+            request->useMCTS = value == "mcts";
+        } else if (request->kind == Kind::ANALYZE && key == "depth") {
+            request->depth = std::max(1, std::stoi(value));
+        } else if (request->kind == Kind::ANALYZE && key == "sims") {
+            request->sims = std::max(1, std::stoi(value));
+        } else if (request->kind == Kind::ANALYZE && key == "seed") {
+            request->seed = static_cast<uint32_t>(std::stoul(value));
+        } else {
+            throw std::invalid_argument("unknown " + kind + " parameter: " + key);
+        }
+    }
+    request->deadline = request->received + std::chrono::milliseconds(deadlineMs);
+    return request;
+}
+
+void AnalysisServer::handleRequest(const std::string& line, Reply reply) {
+    Clock::time_point now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counters.received++;
+        counters.inFlight++;
+        counters.maxInFlight = std::max(counters.maxInFlight, counters.inFlight);
+    }
+
+    std::shared_ptr<Request> request;
+    try {
+        request = parse(line, now);
+    } catch (const std::exception& e) {
+        Request failed;
+        std::istringstream(line) >> failed.id;
+        failed.received = now;
+        failed.reply = std::move(reply);
+        complete(failed, "error", ",\"error\":" + jsonQuote(e.what()));
+        return;
+    }
+    request->reply = std::move(reply);
+
+    switch (request->kind) {
+        case Kind::STATS:
+            markStarted(*request);
+            complete(*request, "ok", ",\"stats\":" + statsJson());
+            break;
+        case Kind::MOVES:
+        case Kind::EVAL:
+            enqueueBatch(request);
+            break;
+        case Kind::ANALYZE:
+        case Kind::SOLVE:
+            if (request->board.getValidMoves().empty()) {
+                markStarted(*request);
+                complete(*request, "ok", ",\"bestmove\":\"none\",\"complete\":true");
+            } else {
+                submitSearch(request);
+            }
+            break;
+    }
+}
+
+void AnalysisServer::markStarted(Request& request) {
+    if (!request.hasStarted) {
+        request.started = Clock::now();
+        request.hasStarted = true;
+    }
+}
+
+// Sends {"id":...,"status":...<fields>,"queue_ms":...,"total_ms":...}
+void AnalysisServer::complete(Request& request, const std::string& status, const std::string& fields) {
+    Clock::time_point now = Clock::now();
+    double totalMs = msBetween(request.received, now);
+    double queueMs = request.hasStarted ? msBetween(request.received, request.started) : totalMs;
+
+    std::string line = "{\"id\":" + jsonQuote(request.id) + ",\"status\":" + jsonQuote(status) + fields +
+                       ",\"queue_ms\":" + fixed3(queueMs) + ",\"total_ms\":" + fixed3(totalMs) + "}";
+    if (request.reply) request.reply(line);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    counters.completed++;
+    if (status == "error" || status == "cancelled") counters.errors++;
+    if (latencies.size() < LATENCY_WINDOW) {
+        latencies.push_back(totalMs);
+        queueTimes.push_back(queueMs);
+    } else {
+        latencies[latencyNext] = totalMs;
+        queueTimes[latencyNext] = queueMs;
+    }
+    latencyNext = (latencyNext + 1) % LATENCY_WINDOW;
+    counters.inFlight--;
+    if (counters.inFlight == 0) idle.notify_all();
+}
+
+void AnalysisServer::waitIdle() {
+    std::unique_lock<std::mutex> lock(statsMutex);
+    idle.wait(lock, [this] { return counters.inFlight == 0; });
+}
+
+// ============================================================================
+// Searches (scheduler slices)
+// ============================================================================
+
+void AnalysisServer::submitSearch(const std::shared_ptr<Request>& request) {
+    SearchScheduler::TaskOptions options;
+    options.sliceUnits = request->useMCTS ? MCTS_SLICE_SIMS : MINIMAX_SLICE_NODES;
+
+    // The deadline is absolute; the engines' own clocks start at the first
+    // slice and are only a backstop
+    auto step = [this, request](int units) {
+        Request& r = *request;
+        if (!r.hasStarted) {
+            markStarted(r);
+            int remainingMs = std::max(1, static_cast<int>(msBetween(Clock::now(), r.deadline)));
+            if (r.useMCTS) {
+                mcts::MCTSConfig mctsConfig;
+                mctsConfig.seed = r.seed;
+                if (r.sims > 0) mctsConfig.numSimulations = r.sims;
+                mctsConfig.useTimeLimit = false;
+                r.mctsEngine = std::make_unique<mcts::MCTS>();
+                r.mctsEngine->beginSearch(r.board, mctsConfig);
+            } else {
+                minimax::SearchConfig searchConfig;
+                searchConfig.maxDepth = r.kind == Kind::SOLVE ? countEmpty(r.board)
+                                        : r.depth > 0        ? r.depth
+                                                             : searchConfig.maxDepth;
+                searchConfig.timeLimitMs = remainingMs;
+                r.minimaxTask = std::make_unique<minimax::SearchTask>(r.board, searchConfig, table.get());
+            }
+        }
+        if (Clock::now() >= r.deadline) {
+            r.deadlineHit = true;
+            if (r.minimaxTask) r.minimaxTask->stop();
+            return true;
+        }
+        return r.mctsEngine ? r.mctsEngine->step(units) : r.minimaxTask->step(units);
+    };
+
+    scheduler->submit(step, options, [this, request](uint64_t, SearchScheduler::Outcome outcome) {
+        finishSearch(*request, outcome);
+    });
+}
+
+void AnalysisServer::finishSearch(Request& request, SearchScheduler::Outcome outcome) {
+    if (outcome == SearchScheduler::Outcome::CANCELLED) {
+        complete(request, "cancelled", "");
+        return;
+    }
+    if (outcome == SearchScheduler::Outcome::FAILED) {
+        complete(request, "error", ",\"error\":\"search failed\"");
+        return;
+    }
+    // The engine's own clock (started at the first slice) may trip first
+    if (request.minimaxTask && request.minimaxTask->getResult().timeout) request.deadlineHit = true;
+    if (request.deadlineHit) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counters.deadlineHits++;
+    }
+
+    std::ostringstream fields;
+    if (request.mctsEngine) {
+        mcts::MCTSResult result = request.mctsEngine->getResult();
+        request.mctsEngine->endSearch();
+        if (result.simulations == 0) {
+            complete(request, "deadline", "");
+            return;
+        }
+        fields << ",\"engine\":\"mcts\",\"bestmove\":\"" << moveText(result.bestMove) << "\",\"winrate\":"
+               << fixed3(result.winRate) << ",\"visits\":" << result.visits << ",\"sims\":" << result.simulations;
+    } else {
+        const minimax::SearchResult& result = request.minimaxTask->getResult();
+        if (result.depth == 0) {
+            complete(request, "deadline", "");
+            return;
+        }
+        fields << ",\"engine\":\"minimax\",\"bestmove\":\"" << moveText(result.bestMove) << "\",\"score\":"
+               << result.score << ",\"depth\":" << result.depth << ",\"nodes\":" << result.nodesSearched;
+    }
+    fields << ",\"complete\":" << (request.deadlineHit ? "false" : "true");
+
+    // Free the tree/search state before answering
+    request.mctsEngine.reset();
+    request.minimaxTask.reset();
+    complete(request, "ok", fields.str());
+}
+
+// ============================================================================
+// Batched moves/eval
+// ============================================================================
+
+void AnalysisServer::enqueueBatch(const std::shared_ptr<Request>& request) {
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        if (!batchesClosed) {
+            batchQueue.push_back(request);
+            if (!batchScheduled) {
+                batchScheduled = true;
+                submitBatch();
+            }
+            return;
+        }
+    }
+    complete(*request, "cancelled", "");
+}
+
+// A batch is one scheduler slice: the stride order runs it ahead of a long
+// search's next slice (a plain pool task would wait behind the slices a busy
+// worker keeps pushing onto its own deque)
+void AnalysisServer::submitBatch() {
+    scheduler->submit(
+        [this](int) {
+            runBatch();
+            return true;
+        },
+        SearchScheduler::TaskOptions(),
+        [this](uint64_t, SearchScheduler::Outcome outcome) {
+            if (outcome != SearchScheduler::Outcome::FINISHED) cancelBatches();
+        });
+}
+
+// The batch task will not run (shutdown) or threw: answer everything still queued
+void AnalysisServer::cancelBatches() {
+    std::vector<std::shared_ptr<Request>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        batchScheduled = false;
+        dropped.swap(batchQueue);
+    }
+    for (const auto& request : dropped) complete(*request, "cancelled", "");
+}
+
+// Everything queued while the previous batch waited for a slot goes in one slice
+void AnalysisServer::runBatch() {
+    std::vector<std::shared_ptr<Request>> batch;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        size_t count = std::min(batchQueue.size(), static_cast<size_t>(std::max(1, config.maxBatch)));
+        batch.assign(batchQueue.begin(), batchQueue.begin() + count);
+        batchQueue.erase(batchQueue.begin(), batchQueue.begin() + count);
+        if (batchQueue.empty() || batchesClosed) {
+            batchScheduled = false;
+        } else {
+            submitBatch();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counters.batches++;
+        counters.batchedRequests += batch.size();
+    }
+
+    for (const auto& request : batch) markStarted(*request);
+    for (const auto& request : batch) {
+        const HexukiBitboard& board = request->board;
+        std::ostringstream fields;
+        if (request->kind == Kind::EVAL) {
+            fields << ",\"eval\":" << minimax::evaluate(board);
+        } else {
+            fields << ",\"moves\":[";
+            std::vector<Move> moves = board.getValidMoves();
+            for (size_t i = 0; i < moves.size(); i++) {
+                fields << (i > 0 ? "," : "") << "\"" << moves[i].toString() << "\"";
+            }
+            int p1 = 0;
+            int p2 = 0;
+            board.getScores(p1, p2);
+            fields << "],\"p1\":" << p1 << ",\"p2\":" << p2 << ",\"turn\":" << board.getCurrentPlayer()
+                   << ",\"game_over\":" << (board.isGameOver() ? "true" : "false");
+        }
+        complete(*request, "ok", fields.str());
+    }
+}
+
+// ============================================================================
+// Monitoring
+// ============================================================================
+
+ServerStats AnalysisServer::getStats() const {
+    ServerStats stats;
+    std::vector<double> latencyCopy;
+    std::vector<double> queueCopy;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats = counters;
+        latencyCopy = latencies;
+        queueCopy = queueTimes;
+    }
+    stats.scheduledTasks = scheduler->getTaskCount();
+    {
+        std::lock_guard<std::mutex> lock(batchMutex);
+        stats.batchPending = batchQueue.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        stats.connections = connections.size();
+    }
+    stats.latencyP50Ms = percentile(latencyCopy, 0.50);
+    stats.latencyP90Ms = percentile(latencyCopy, 0.90);
+    stats.latencyP99Ms = percentile(latencyCopy, 0.99);
+    stats.latencyMaxMs = latencyCopy.empty() ? 0.0 : *std::max_element(latencyCopy.begin(), latencyCopy.end());
+    stats.queueP50Ms = percentile(queueCopy, 0.50);
+    stats.queueP99Ms = percentile(queueCopy, 0.99);
+    return stats;
+}
+
+std::string AnalysisServer::statsJson() const {
+    ServerStats stats = getStats();
+    std::ostringstream json;
+    json << "{\"received\":" << stats.received << ",\"completed\":" << stats.completed
+         << ",\"errors\":" << stats.errors << ",\"deadline_hits\":" << stats.deadlineHits
+         << ",\"batches\":" << stats.batches << ",\"batched_requests\":" << stats.batchedRequests
+         << ",\"in_flight\":" << stats.inFlight << ",\"max_in_flight\":" << stats.maxInFlight
+         << ",\"scheduled_tasks\":" << stats.scheduledTasks << ",\"batch_pending\":" << stats.batchPending
+         << ",\"connections\":" << stats.connections << ",\"latency_p50_ms\":" << fixed3(stats.latencyP50Ms)
+         << ",\"latency_p90_ms\":" << fixed3(stats.latencyP90Ms) << ",\"latency_p99_ms\":"
+         << fixed3(stats.latencyP99Ms) << ",\"latency_max_ms\":" << fixed3(stats.latencyMaxMs)
+         << ",\"queue_p50_ms\":" << fixed3(stats.queueP50Ms) << ",\"queue_p99_ms\":" << fixed3(stats.queueP99Ms)
+         << "}";
+    return json.str();
+}
+
+// ============================================================================
+// Transport
+// ============================================================================
+
+std::string AnalysisServer::getEndpoint() const {
+    return config.socketPath.empty() ? "127.0.0.1:" + std::to_string(boundPort) : config.socketPath;
+}
+
+#ifdef _WIN32
+
+struct AnalysisServer::Connection {};
+
+void AnalysisServer::start() {
+    throw std::runtime_error("the analysis server needs POSIX sockets");
+}
+
+void AnalysisServer::stop() {}
+void AnalysisServer::ioLoop() {}
+void AnalysisServer::closeAll() {}
+
+AnalysisClient::~AnalysisClient() {}
+void AnalysisClient::connectUnix(const std::string&) { throw std::runtime_error("Unix sockets are not supported"); }
+void AnalysisClient::connectTcp(int) { throw std::runtime_error("the analysis client needs POSIX sockets"); }
+void AnalysisClient::close() {}
+void AnalysisClient::send(const std::string&) { throw std::runtime_error("not connected"); }
+std::string AnalysisClient::receive() { throw std::runtime_error("not connected"); }
+
+#else
+
+// One client; responses are written by whichever thread finishes a request
+struct AnalysisServer::Connection {
+    int fd;
+    std::mutex writeMutex;
+    std::string inbox;  // Bytes after the last complete line (I/O thread only)
+
+    explicit Connection(int fd) : fd(fd) {}
+
+    void write(const std::string& line) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::string data = line + "\n";
+        size_t sent = 0;
+        while (fd >= 0 && sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return;  // Client gone; the I/O thread closes it
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+};
+
+static void configureSocket(int fd) {
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+}
+
+static std::runtime_error socketError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void AnalysisServer::start() {
+    if (running.load()) return;
+
+    if (!config.socketPath.empty()) {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (config.socketPath.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("socket path too long: " + config.socketPath);
+        }
+        std::strncpy(address.sun_path, config.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+        // A stale socket from an earlier run would make bind fail; never remove anything else
+        struct stat info;
+        if (::stat(config.socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+            ::unlink(config.socketPath.c_str());
+        }
+
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) throw socketError("socket");
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            int error = errno;
+            ::close(listenFd);
+            listenFd = -1;
+            errno = error;
+            throw socketError("bind " + config.socketPath);
+        }
+    } else {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<uint16_t>(config.port));
+
+        listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd < 0) throw socketError("socket");
+        int one = 1;
+        ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            int error = errno;
+            ::close(listenFd);
+            listenFd = -1;
+            errno = error;
+            throw socketError("bind 127.0.0.1:" + std::to_string(config.port));
+        }
+        socklen_t length = sizeof(address);
+        ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        boundPort = ntohs(address.sin_port);
+    }
+    configureSocket(listenFd);
+
+    if (::listen(listenFd, 64) < 0 || ::pipe(wakeFds) < 0) {
+        int error = errno;
+        ::close(listenFd);
+        listenFd = -1;
+        errno = error;
+        throw socketError("listen");
+    }
+
+    running.store(true);
+    ioThread = std::thread(&AnalysisServer::ioLoop, this);
+}
+
+void AnalysisServer::stop() {
+    if (!running.exchange(false)) return;
+
+    char byte = 0;
+    ssize_t ignored = ::write(wakeFds[1], &byte, 1);
+    (void)ignored;
+    ioThread.join();
+
+    closeAll();
+    ::close(listenFd);
+    listenFd = -1;
+    if (!config.socketPath.empty()) ::unlink(config.socketPath.c_str());
+    ::close(wakeFds[0]);
+    ::close(wakeFds[1]);
+    wakeFds[0] = wakeFds[1] = -1;
+}
+
+void AnalysisServer::closeAll() {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    for (const auto& connection : connections) connection->close();
+    connections.clear();
+}
+
+// Accepts connections and reads request lines; all the work happens elsewhere
+void AnalysisServer::ioLoop() {
+    std::vector<pollfd> fds;
+    std::vector<std::shared_ptr<Connection>> polled;
+    char buffer[4096];
+
+    while (running.load()) {
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            polled = connections;
+        }
+        fds.assign(1, pollfd{wakeFds[0], POLLIN, 0});
+        fds.push_back(pollfd{listenFd, POLLIN, 0});
+        for (const auto& connection : polled) fds.push_back(pollfd{connection->fd, POLLIN, 0});
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents != 0) break;  // stop()
+
+        if (fds[1].revents & POLLIN) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd >= 0) {
+                configureSocket(fd);
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                connections.push_back(std::make_shared<Connection>(fd));
+            }
+        }
+
+        for (size_t i = 0; i < polled.size(); i++) {
+            if (fds[i + 2].revents == 0) continue;
+            const std::shared_ptr<Connection>& connection = polled[i];
+
+            ssize_t n = ::recv(connection->fd, buffer, sizeof(buffer), 0);
+            if (n < 0 && errno == EINTR) continue;
+            bool closing = n <= 0;
+            if (n > 0) {
+                connection->inbox.append(buffer, static_cast<size_t>(n));
+                size_t begin = 0;
+                size_t end;
+                std::weak_ptr<Connection> target = connection;
+                while ((end = connection->inbox.find('\n', begin)) != std::string::npos) {
+                    std::string line = connection->inbox.substr(begin, end - begin);
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    begin = end + 1;
+                    if (line.find_first_not_of(" \t") == std::string::npos) continue;
+                    handleRequest(line, [target](const std::string& response) {
+                        if (auto open = target.lock()) open->write(response);
+                    });
+                }
+                connection->inbox.erase(0, begin);
+                closing = connection->inbox.size() > MAX_LINE_BYTES;
+            }
+
+            if (closing) {
+                connection->close();
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                connections.erase(std::remove(connections.begin(), connections.end(), connection),
+                                  connections.end());
+            }
+        }
+    }
+}
+
+// ============================================================================
+// AnalysisClient
+// ============================================================================
+
+AnalysisClient::~AnalysisClient() {
+    close();
+}
+
+void AnalysisClient::connectUnix(const std::string& path) {
+    close();
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) throw std::invalid_argument("socket path too long: " + path);
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw socketError("socket");
+    configureSocket(fd);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        int error = errno;
+        close();
+        errno = error;
+        throw socketError("connect " + path);
+    }
+}
+
+void AnalysisClient::connectTcp(int port) {
+    close();
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) throw socketError("socket");
+    configureSocket(fd);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        int error = errno;
+        close();
+        errno = error;
+        throw socketError("connect 127.0.0.1:" + std::to_string(port));
+    }
+}
+
+void AnalysisClient::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    inbox.clear();
+}
+
+void AnalysisClient::send(const std::string& line) {
+    if (fd < 0) throw std::runtime_error("not connected");
+    std::string data = line + "\n";
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw socketError("send");
+        sent += static_cast<size_t>(n);
+    }
+}
+
+std::string AnalysisClient::receive() {
+    if (fd < 0) throw std::runtime_error("not connected");
+    char buffer[4096];
+    size_t end;
+    while ((end = inbox.find('\n')) == std::string::npos) {
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw std::runtime_error("connection closed by server");
+        inbox.append(buffer, static_cast<size_t>(n));
+    }
+    std::string line = inbox.substr(0, end);
+    inbox.erase(0, end + 1);
+    return line;
+}
+
+#endif // _WIN32
+
+std::string AnalysisClient::request(const std::string& line) {
+    send(line);
+    return receive();
+}
+
+} // namespace api
+} // namespace hexuki
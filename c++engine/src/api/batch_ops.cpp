@@ -0,0 +1,240 @@
+#include "api/batch_ops.h"
+#include "core/thread_pool.h"
+#include "core/trace.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+namespace hexuki {
+namespace api {
+
+// Positions per pool task: a playout is a few microseconds
+static constexpr size_t PLAYOUT_GRAIN = 16;
+
+// ============================================================================
+// Position Records
+// ============================================================================
+
+bool isValidPositionRecord(const int32_t* record) {
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (record[POS_HEX_VALUES + hexId] < 0 || record[POS_HEX_VALUES + hexId] > MAX_TILE_VALUE) return false;
+    }
+    if (record[POS_PLAYER] != PLAYER_1 && record[POS_PLAYER] != PLAYER_2) return false;
+    if (record[POS_MOVE_COUNT] < 0) return false;
+
+    const int countFields[2] = {POS_P1_TILE_COUNT, POS_P2_TILE_COUNT};
+    const int offsets[2] = {POS_P1_TILES, POS_P2_TILES};
+    for (int p = 0; p < 2; p++) {
+        int count = record[countFields[p]];
+        if (count < 0 || count > NUM_TILES_PER_PLAYER) return false;
+        for (int t = 0; t < count; t++) {
+            if (record[offsets[p] + t] < 1 || record[offsets[p] + t] > MAX_TILE_VALUE) return false;
+        }
+    }
+    return true;
+}
+
+// 1-2 digits in [low, high]; no signs, spaces or other text
+static bool parseField(const std::string& text, int low, int high, int& value) {
+    if (text.empty() || text.size() > 2) return false;
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + (c - '0');
+    }
+    return value >= low && value <= high;
+}
+
+bool isValidPositionString(const std::string& position) {
+    std::istringstream sections(position);
+    std::string section;
+    int value = 0;
+    while (std::getline(sections, section, '|')) {
+        if (section.empty()) continue;
+
+        if (section[0] == 'h') {
+            // h6:5,h9:1
+            std::istringstream pairs(section);
+            std::string pair;
+            while (std::getline(pairs, pair, ',')) {
+                size_t colon = pair.find(':');
+                if (pair.empty() || pair[0] != 'h' || colon == std::string::npos) return false;
+                if (!parseField(pair.substr(1, colon - 1), 0, NUM_HEXES - 1, value)) return false;
+                if (!parseField(pair.substr(colon + 1), 1, MAX_TILE_VALUE, value)) return false;
+            }
+        } else if (section.compare(0, 3, "p1:") == 0 || section.compare(0, 3, "p2:") == 0) {
+            // p1:2,3,4 (duplicates allowed, at most a full hand)
+            std::istringstream tiles(section.substr(3));
+            std::string tile;
+            int count = 0;
+            while (std::getline(tiles, tile, ',')) {
+                if (!parseField(tile, 1, MAX_TILE_VALUE, value) || ++count > NUM_TILES_PER_PLAYER) return false;
+            }
+        } else if (section.compare(0, 5, "turn:") == 0) {
+            if (!parseField(section.substr(5), PLAYER_1, PLAYER_2, value)) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+HexukiBitboard unpackPosition(const int32_t* record) {
+    HexukiBitboard board;
+    board.clearBoard();
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (record[POS_HEX_VALUES + hexId] != 0) {
+            board.setHexValue(hexId, record[POS_HEX_VALUES + hexId]);
+        }
+    }
+
+    const int counts[2] = {record[POS_P1_TILE_COUNT], record[POS_P2_TILE_COUNT]};
+    const int offsets[2] = {POS_P1_TILES, POS_P2_TILES};
+    for (int p = 0; p < 2; p++) {
+        int count = std::max(0, std::min(counts[p], NUM_TILES_PER_PLAYER));
+        board.setAvailableTiles(p + 1, std::vector<int>(record + offsets[p], record + offsets[p] + count));
+    }
+    board.setCurrentPlayer(record[POS_PLAYER]);
+    return board;
+}
+
+void packPosition(const HexukiBitboard& board, int moveCount, int32_t* record) {
+    std::fill(record, record + POSITION_STRIDE, 0);
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        record[POS_HEX_VALUES + hexId] = board.getTileValue(hexId);
+    }
+    record[POS_PLAYER] = board.getCurrentPlayer();
+    record[POS_MOVE_COUNT] = moveCount;
+
+    const int countFields[2] = {POS_P1_TILE_COUNT, POS_P2_TILE_COUNT};
+    const int offsets[2] = {POS_P1_TILES, POS_P2_TILES};
+    for (int p = 0; p < 2; p++) {
+        std::vector<int> tiles = board.getAvailableTiles(p + 1);
+        int count = std::min(static_cast<int>(tiles.size()), NUM_TILES_PER_PLAYER);
+        record[countFields[p]] = count;
+        std::copy(tiles.begin(), tiles.begin() + count, record + offsets[p]);
+    }
+}
+
+// ============================================================================
+// JS Engine Rules
+// ============================================================================
+
+// Mirrored = every mirror pair holds equal values (0 = empty): one compare
+// covers both "one side empty" and "different tiles"
+static bool isMirroredWith(const HexukiBitboard& board, int hexId, int tileValue) {
+    for (int id = 0; id < NUM_HEXES; id++) {
+        int mirror = VERTICAL_MIRROR_PAIRS[id];
+        if (mirror <= id) continue;  // Center column, or pair already checked
+        int value = id == hexId ? tileValue : board.getTileValue(id);
+        int mirrorValue = mirror == hexId ? tileValue : board.getTileValue(mirror);
+        if (value != mirrorValue) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isBoardMirrored(const HexukiBitboard& board) {
+    return isMirroredWith(board, -1, 0);
+}
+
+// Symmetry is out of reach for good once a pair holds two different tiles
+static bool symmetryStillPossible(const HexukiBitboard& board) {
+    for (int id = 0; id < NUM_HEXES; id++) {
+        int mirror = VERTICAL_MIRROR_PAIRS[id];
+        if (mirror <= id) continue;
+        int value = board.getTileValue(id);
+        int mirrorValue = board.getTileValue(mirror);
+        if (value != 0 && mirrorValue != 0 && value != mirrorValue) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void getV2ValidMoves(const HexukiBitboard& board, int moveCount, std::vector<Move>& moves) {
+    moves.clear();
+    std::vector<int> tiles = board.getAvailableTiles(board.getCurrentPlayer());
+    const bool checkSymmetry = moveCount >= 1 && symmetryStillPossible(board);
+
+    uint32_t legal = board.getLegalHexMask();
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (!(legal & (1u << hexId))) continue;
+        for (int tile : tiles) {
+            if (checkSymmetry && isMirroredWith(board, hexId, tile)) continue;
+            moves.push_back(Move(hexId, tile));
+        }
+    }
+}
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+void batchValidMoves(const int32_t* positions, int count, std::vector<int32_t>& out) {
+    out.clear();
+    std::vector<Move> moves;
+    for (int i = 0; i < count; i++) {
+        const int32_t* record = positions + static_cast<size_t>(i) * POSITION_STRIDE;
+        if (isValidPositionRecord(record)) {
+            getV2ValidMoves(unpackPosition(record), record[POS_MOVE_COUNT], moves);
+        } else {
+            moves.clear();
+        }
+        out.push_back(static_cast<int32_t>(moves.size()));
+        for (const Move& move : moves) {
+            out.push_back(move.hexId);
+            out.push_back(move.tileValue);
+        }
+    }
+}
+
+void batchScores(const int32_t* positions, int count, std::vector<int32_t>& out) {
+    out.resize(static_cast<size_t>(count) * 2);
+    for (int i = 0; i < count; i++) {
+        const int32_t* record = positions + static_cast<size_t>(i) * POSITION_STRIDE;
+        int p1Score = 0, p2Score = 0;
+        if (isValidPositionRecord(record)) {
+            unpackPosition(record).getScores(p1Score, p2Score);
+        }
+        out[i * 2] = p1Score;
+        out[i * 2 + 1] = p2Score;
+    }
+}
+
+void batchPlayouts(const int32_t* positions, int count, uint32_t seed, std::vector<int32_t>& out) {
+    out.assign(static_cast<size_t>(count) * PLAYOUT_STRIDE, 0);
+    parallelFor(0, static_cast<size_t>(count), PLAYOUT_GRAIN, [&](size_t i) {
+        HEXUKI_TRACE_SCOPE("game.playout", "index", static_cast<int64_t>(i));
+        const int32_t* record = positions + i * POSITION_STRIDE;
+        int32_t* result = out.data() + i * PLAYOUT_STRIDE;
+        if (!isValidPositionRecord(record)) return;  // Left empty: no moves, zero scores
+        HexukiBitboard board = unpackPosition(record);
+        int moveCount = record[POS_MOVE_COUNT];
+        std::mt19937 rng(seed + static_cast<uint32_t>(i));
+        std::vector<Move> moves;
+
+        int played = 0;
+        while (moveCount < V2_GAME_MOVES && played < MAX_PLAYOUT_MOVES) {
+            getV2ValidMoves(board, moveCount, moves);
+            if (moves.empty()) break;
+            // Multiply-shift index, as in MCTS rollouts
+            const Move& move = moves[(static_cast<uint64_t>(rng()) * moves.size()) >> 32];
+            board.makeMove(move);
+            result[PLAYOUT_MOVES + played * MOVE_STRIDE] = move.hexId;
+            result[PLAYOUT_MOVES + played * MOVE_STRIDE + 1] = move.tileValue;
+            played++;
+            moveCount++;
+        }
+
+        int p1Score, p2Score;
+        board.getScores(p1Score, p2Score);
+        result[PLAYOUT_P1_SCORE] = p1Score;
+        result[PLAYOUT_P2_SCORE] = p2Score;
+        result[PLAYOUT_MOVE_COUNT] = played;
+    });
+}
+
+} // namespace api
+} // namespace hexuki
@@ -0,0 +1,131 @@
+#include "api/engine_bench.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include "core/bitboard.h"
+#include <chrono>
+#include <iomanip>
+
+namespace hexuki {
+namespace api {
+
+using Clock = std::chrono::steady_clock;
+
+// Minimax nodes per SearchTask::step() (no limit is reached mid-step)
+static constexpr int BENCH_STEP_NODES = 1 << 20;
+
+const std::vector<std::string>& benchPositions() {
+    // Openings, midgames and endgames from seeded random games
+    static const std::vector<std::string> positions = {
+        "startpos",
+        "h6:4,h9:1|p1:1,2,3,5,6,7,8,9|p2:1,2,3,4,5,6,7,8,9|turn:2",
+        "h4:8,h7:3,h9:1|p1:1,2,3,4,5,6,7,9|p2:1,2,4,5,6,7,8,9|turn:1",
+        "h3:8,h5:3,h6:3,h7:7,h9:1|p1:1,2,4,5,6,7,9|p2:1,2,4,5,6,8,9|turn:1",
+        "h0:6,h1:4,h6:3,h9:1,h10:8,h12:5,h14:4,h17:8|p1:1,2,3,7,9|p2:1,2,5,6,7,9|turn:2",
+        "h2:5,h4:6,h5:5,h9:1,h10:3,h11:9,h12:1,h15:7,h17:6|p1:2,3,4,8,9|p2:1,2,4,7,8|turn:1",
+        "h2:3,h6:7,h7:5,h8:6,h9:1,h11:5,h12:8,h14:6,h16:7,h18:9|p1:1,2,4,9|p2:1,2,3,4,8|turn:2",
+        "h6:2,h8:1,h9:1,h10:9,h11:8,h12:9,h13:2,h14:6,h16:1,h17:3,h18:6|p1:3,4,5,7|p2:4,5,7,8|turn:1",
+        "h1:1,h2:5,h4:7,h5:5,h7:1,h9:1,h10:6,h11:3,h12:4,h13:6,h14:2,h16:8,h18:7|p1:3,8,9|p2:2,4,9|turn:1",
+        "h0:2,h2:3,h4:8,h6:9,h7:7,h8:5,h9:1,h10:8,h11:1,h13:6,h14:7,h15:3,h17:4,h18:6|p1:1,2|p2:4,5,9|turn:2",
+        "h0:5,h2:6,h3:4,h4:9,h6:4,h7:6,h8:3,h9:1,h10:9,h11:2,h12:1,h13:7,h15:3,h16:7,h17:5|p1:1,8|p2:2,8|turn:1",
+        "h0:9,h2:1,h3:1,h5:2,h6:5,h8:7,h9:1,h10:7,h11:4,h12:3,h13:9,h14:6,h15:8,h16:3,h17:4,h18:8|p1:5|p2:2,6|turn:2",
+    };
+    return positions;
+}
+
+// FNV-1a over the little-endian bytes of value
+static void mix(uint64_t& hash, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (8 * i)) & 0xff;
+        hash *= 0x100000001b3ULL;
+    }
+}
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+BenchReport runBench(const BenchConfig& config, std::ostream* log) {
+    BenchReport report;
+    report.signature = 0xcbf29ce484222325ULL;
+
+    minimax::TranspositionTable tt(config.hashMB);
+    mcts::MCTS engine;
+
+    minimax::SearchConfig searchConfig;
+    searchConfig.maxDepth = config.depth;
+    searchConfig.timeLimitMs = INT32_MAX;
+
+    mcts::MCTSConfig mctsConfig;
+    mctsConfig.numSimulations = config.sims;
+    mctsConfig.useTimeLimit = false;
+    mctsConfig.seed = config.seed;
+
+    const std::vector<std::string>& positions = benchPositions();
+    for (size_t i = 0; i < positions.size(); i++) {
+        HexukiBitboard board;
+        if (positions[i] != "startpos") board.loadPosition(positions[i]);
+
+        BenchPositionResult result;
+        result.position = positions[i];
+
+        tt.clear();
+        Clock::time_point start = Clock::now();
+        minimax::SearchTask task(board, searchConfig, &tt);
+        while (!task.step(BENCH_STEP_NODES)) {}
+        result.minimaxMs = msSince(start);
+        const minimax::SearchResult& searched = task.getResult();
+        result.minimaxMove = searched.bestMove;
+        result.score = searched.score;
+        result.depth = searched.depth;
+        result.nodes = static_cast<uint64_t>(searched.nodesSearched);
+
+        if (config.sims > 0) {
+            HexukiBitboard copy = board;
+            start = Clock::now();
+            mcts::MCTSResult mctsResult = engine.findBestMove(copy, mctsConfig);
+            result.mctsMs = msSince(start);
+            result.mctsMove = mctsResult.bestMove;
+            result.visits = mctsResult.visits;
+            result.sims = mctsResult.simulations;
+        }
+
+        mix(report.signature, result.nodes);
+        mix(report.signature, static_cast<uint64_t>(static_cast<int64_t>(result.score)));
+        mix(report.signature, static_cast<uint64_t>(result.minimaxMove.hexId * 16 + result.minimaxMove.tileValue));
+        mix(report.signature, static_cast<uint64_t>(result.mctsMove.hexId * 16 + result.mctsMove.tileValue));
+        mix(report.signature, static_cast<uint64_t>(result.visits));
+
+        report.nodes += result.nodes;
+        report.sims += static_cast<uint64_t>(result.sims);
+        report.minimaxMs += result.minimaxMs;
+        report.mctsMs += result.mctsMs;
+
+        if (log) {
+            *log << "Position " << (i + 1) << "/" << positions.size() << ": depth " << result.depth
+                 << " nodes " << result.nodes << " score " << result.score
+                 << " bestmove " << result.minimaxMove.toString();
+            if (config.sims > 0) {
+                *log << " | mcts " << result.mctsMove.toString() << " visits " << result.visits;
+            }
+            *log << "\n" << std::flush;
+        }
+        report.positions.push_back(result);
+    }
+    return report;
+}
+
+void printBenchReport(const BenchReport& report, const BenchConfig& config, std::ostream& out) {
+    out << "===========================\n"
+        << "Depth           : " << config.depth << "\n"
+        << "Simulations     : " << config.sims << " per position\n"
+        << "Total time (ms) : " << static_cast<long long>(report.minimaxMs + report.mctsMs) << "\n"
+        << "Nodes searched  : " << report.nodes << "\n"
+        << "Sims played     : " << report.sims << "\n"
+        << "Signature       : " << std::hex << std::setw(16) << std::setfill('0') << report.signature
+        << std::dec << std::setfill(' ') << "\n"
+        << "Nodes/second    : " << static_cast<long long>(report.nodesPerSecond()) << "\n"
+        << "Sims/second     : " << static_cast<long long>(report.simsPerSecond()) << "\n";
+}
+
+} // namespace api
+} // namespace hexuki
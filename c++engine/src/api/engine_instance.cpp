@@ -0,0 +1,227 @@
+#include "api/engine_instance.h"
+#include "core/trace.h"
+
+namespace hexuki {
+namespace api {
+
+// ============================================================================
+// Engine Instance
+// ============================================================================
+
+EngineInstance::EngineInstance() {
+}
+
+void EngineInstance::reset() {
+    HEXUKI_TRACE_INSTANT("game.new");
+    abandonSearch();
+    board.reset();
+    history.clear();
+}
+
+void EngineInstance::loadPosition(const std::string& position) {
+    abandonSearch();
+    board.loadPosition(position);
+    history.clear();
+}
+
+bool EngineInstance::makeMove(const Move& move) {
+    if (!board.isValidMove(move)) {
+        return false;
+    }
+    abandonSearch();
+    board.makeMove(move);
+    history.push_back(move);
+    return true;
+}
+
+bool EngineInstance::undoMove() {
+    if (history.empty()) {
+        return false;
+    }
+    abandonSearch();
+    board.unmakeMove(history.back());
+    history.pop_back();
+    return true;
+}
+
+mcts::MCTS& EngineInstance::getMCTS() {
+    if (!mctsEngine) {
+        mctsEngine = std::make_unique<mcts::MCTS>();
+    }
+    return *mctsEngine;
+}
+
+mcts::MCTSResult EngineInstance::runMCTS(const mcts::MCTSConfig& config) {
+    abandonSearch();  // Shares the MCTS tree
+    mcts::MCTSConfig threaded = config;
+    threaded.numThreads = searchThreads;
+    threaded.seed = searchSeed;
+    return getMCTS().findBestMove(board, threaded);
+}
+
+minimax::SearchResult EngineInstance::runMinimax(int depth, int timeLimitMs) {
+    abandonSearch();  // One search at a time, as for runMCTS
+    minimax::SearchConfig config;
+    config.maxDepth = depth;
+    config.timeLimitMs = timeLimitMs;
+    config.numThreads = searchThreads;
+    return minimax::findBestMove(board, config);
+}
+
+// ============================================================================
+// Incremental Search
+// ============================================================================
+
+void EngineInstance::beginMCTSSearch(const mcts::MCTSConfig& config) {
+    abandonSearch();
+    getMCTS().beginSearch(board, config);
+    searchEngine = SearchEngine::MCTS;
+    searchDone = false;
+}
+
+void EngineInstance::beginMinimaxSearch(const minimax::SearchConfig& config) {
+    abandonSearch();
+    minimaxTask = std::make_unique<minimax::SearchTask>(board, config);
+    searchEngine = SearchEngine::MINIMAX;
+    searchDone = false;
+}
+
+bool EngineInstance::stepSearch(double budgetMs, int maxWork) {
+    if (searchEngine == SearchEngine::NONE || searchDone) {
+        return true;
+    }
+
+    const int chunk = searchEngine == SearchEngine::MCTS ? MCTS_STEP_CHUNK : MINIMAX_STEP_CHUNK;
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double, std::milli>(budgetMs));
+    const bool timed = budgetMs > 0;
+    const bool counted = maxWork > 0;
+    int remaining = maxWork;
+
+    while (true) {
+        int work = (counted && remaining < chunk) ? remaining : chunk;
+        bool finished = searchEngine == SearchEngine::MCTS ? mctsEngine->step(work)
+                                                           : minimaxTask->step(work);
+        remaining -= work;
+        if (finished) {
+            finishSearch();
+            break;
+        }
+        if (!timed && !counted) break;
+        if (counted && remaining <= 0) break;
+        if (timed && std::chrono::steady_clock::now() >= deadline) break;
+    }
+
+    return searchDone;
+}
+
+mcts::MCTSResult EngineInstance::peekMCTS() const {
+    if (searchEngine != SearchEngine::MCTS) {
+        return mcts::MCTSResult();
+    }
+    return mctsEngine->getResult();
+}
+
+minimax::SearchResult EngineInstance::peekMinimax() const {
+    if (searchEngine != SearchEngine::MINIMAX) {
+        return minimax::SearchResult();
+    }
+    return minimaxTask ? minimaxTask->getResult() : minimaxFinal;
+}
+
+void EngineInstance::finishSearch() {
+    if (minimaxTask) {
+        // Keep the result, release the task's table
+        minimaxTask->stop();
+        minimaxFinal = minimaxTask->getResult();
+        minimaxTask.reset();
+    }
+    if (searchEngine == SearchEngine::MCTS) {
+        mctsEngine->endSearch();  // Keep the tree, release the rollout table
+    }
+    searchDone = true;
+}
+
+void EngineInstance::abandonSearch() {
+    minimaxTask.reset();
+    if (searchEngine == SearchEngine::MCTS) {
+        mctsEngine->endSearch();
+    }
+    searchEngine = SearchEngine::NONE;
+    searchDone = true;
+}
+
+// ============================================================================
+// Packed Results
+// ============================================================================
+
+const std::vector<int32_t>& EngineInstance::packValidMoves() {
+    packMoves(board.getValidMoves(), moveBuffer);
+    return moveBuffer;
+}
+
+const std::vector<double>& EngineInstance::packResult(const mcts::MCTSResult& result) {
+    packMCTSResult(result, true, resultBuffer);
+    return resultBuffer;
+}
+
+const std::vector<double>& EngineInstance::packResult(const minimax::SearchResult& result) {
+    packMinimaxResult(result, true, resultBuffer);
+    return resultBuffer;
+}
+
+const std::vector<double>& EngineInstance::packSearchState() {
+    switch (searchEngine) {
+        case SearchEngine::MCTS:
+            packMCTSResult(peekMCTS(), searchDone, resultBuffer);
+            break;
+        case SearchEngine::MINIMAX:
+            packMinimaxResult(peekMinimax(), searchDone, resultBuffer);
+            break;
+        default:
+            packEmptyResult(resultBuffer);
+            break;
+    }
+    return resultBuffer;
+}
+
+// ============================================================================
+// Instance Registry
+// ============================================================================
+
+InstanceHandle InstanceRegistry::create() {
+    auto instance = std::make_unique<EngineInstance>();
+    std::lock_guard<std::mutex> lock(mutex);
+    InstanceHandle handle = nextHandle++;
+    instances[handle] = std::move(instance);
+    return handle;
+}
+
+bool InstanceRegistry::destroy(InstanceHandle handle) {
+    std::unique_ptr<EngineInstance> instance;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = instances.find(handle);
+        if (it == instances.end()) {
+            return false;
+        }
+        instance = std::move(it->second);
+        instances.erase(it);
+    }
+    return true;  // Freed outside the lock
+}
+
+EngineInstance* InstanceRegistry::get(InstanceHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = instances.find(handle);
+    return it == instances.end() ? nullptr : it->second.get();
+}
+
+size_t InstanceRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return instances.size();
+}
+
+} // namespace api
+} // namespace hexuki
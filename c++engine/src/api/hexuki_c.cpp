@@ -0,0 +1,260 @@
+#include "api/hexuki_c.h"
+#include "api/batch_ops.h"
+#include "api/engine_instance.h"
+#include "api/result_layout.h"
+#include "core/thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+using namespace hexuki;
+
+// The C header spells the layouts out as numbers; keep them in step
+static_assert(HEXUKI_POSITION_STRIDE == api::POSITION_STRIDE, "position record size");
+static_assert(HEXUKI_MAX_VALID_MOVES == api::MAX_VALID_MOVES, "move record capacity");
+static_assert(HEXUKI_MOVES_STRIDE == 1 + api::MAX_VALID_MOVES * api::MOVE_STRIDE, "move record size");
+static_assert(HEXUKI_PLAYOUT_STRIDE == api::PLAYOUT_STRIDE, "playout record size");
+static_assert(HEXUKI_SEARCH_STRIDE == api::SEARCH_HEADER_SIZE, "search record size");
+
+struct hexuki_board {
+    api::EngineInstance instance;
+};
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+static thread_local std::string lastError;
+
+static int fail(int code, const std::string& message) {
+    lastError = message;
+    return code;
+}
+
+// Runs body, turning exceptions into error codes (nothing may unwind into C)
+template <typename Body>
+static int guarded(Body&& body) {
+    lastError.clear();
+    try {
+        return body();
+    } catch (const std::invalid_argument& e) {
+        return fail(HEXUKI_ERROR_INVALID_ARGUMENT, e.what());
+    } catch (const std::out_of_range& e) {
+        return fail(HEXUKI_ERROR_INVALID_ARGUMENT, e.what());
+    } catch (const std::exception& e) {
+        return fail(HEXUKI_ERROR_INTERNAL, e.what());
+    } catch (...) {
+        return fail(HEXUKI_ERROR_INTERNAL, "unknown error");
+    }
+}
+
+// Records come from foreign code: reject anything unpackPosition cannot take
+static int checkBatch(const int32_t* positions, int count, const void* out) {
+    if (count < 0 || (count > 0 && (positions == nullptr || out == nullptr))) {
+        return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "null array or negative count");
+    }
+    for (int i = 0; i < count; i++) {
+        if (!api::isValidPositionRecord(positions + static_cast<size_t>(i) * api::POSITION_STRIDE)) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "malformed position record " + std::to_string(i));
+        }
+    }
+    return HEXUKI_OK;
+}
+
+// One search per position on the global pool; finished games get an empty
+// result (FIELD_DONE set, no move)
+template <typename Search>
+static int batchSearch(const int32_t* positions, int count, double* out, Search&& search) {
+    int status = checkBatch(positions, count, out);
+    if (status != HEXUKI_OK) return status;
+
+    parallelFor(0, static_cast<size_t>(count), 1, [&](size_t i) {
+        HexukiBitboard board = api::unpackPosition(positions + i * api::POSITION_STRIDE);
+        std::vector<double> packed;
+        if (board.getValidMoves().empty()) {
+            api::packEmptyResult(packed);
+            packed[api::FIELD_DONE] = 1;
+        } else {
+            search(board, i, packed);
+        }
+        std::copy(packed.begin(), packed.begin() + api::SEARCH_HEADER_SIZE, out + i * HEXUKI_SEARCH_STRIDE);
+    });
+    return HEXUKI_OK;
+}
+
+extern "C" {
+
+int hexuki_abi_version(void) {
+    return HEXUKI_ABI_VERSION;
+}
+
+const char* hexuki_last_error(void) {
+    return lastError.c_str();
+}
+
+// ============================================================================
+// Boards
+// ============================================================================
+
+hexuki_board* hexuki_board_create(void) {
+    return new (std::nothrow) hexuki_board();
+}
+
+void hexuki_board_destroy(hexuki_board* board) {
+    delete board;
+}
+
+int hexuki_board_load(hexuki_board* board, const char* position) {
+    return guarded([&] {
+        if (board == nullptr || position == nullptr) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "null board or position");
+        }
+        if (!api::isValidPositionString(position)) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, std::string("invalid position: ") + position);
+        }
+        board->instance.loadPosition(position);
+        return HEXUKI_OK;
+    });
+}
+
+int hexuki_board_save(const hexuki_board* board, char* out, int capacity) {
+    return guarded([&] {
+        if (board == nullptr || out == nullptr) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "null board or buffer");
+        }
+        std::string position = board->instance.getBoard().savePosition();
+        if (static_cast<int>(position.size()) >= capacity) {
+            return fail(HEXUKI_ERROR_BUFFER_TOO_SMALL, "position needs " + std::to_string(position.size() + 1) + " bytes");
+        }
+        std::memcpy(out, position.c_str(), position.size() + 1);
+        return static_cast<int>(position.size());
+    });
+}
+
+int hexuki_board_make_move(hexuki_board* board, int hex_id, int tile_value) {
+    return guarded([&] {
+        if (board == nullptr) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "null board");
+        }
+        Move move(hex_id, tile_value);
+        if (!board->instance.makeMove(move)) {
+            return fail(HEXUKI_ERROR_ILLEGAL_MOVE, "illegal move " + move.toString());
+        }
+        return HEXUKI_OK;
+    });
+}
+
+int hexuki_board_undo_move(hexuki_board* board) {
+    return guarded([&] {
+        if (board == nullptr) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "null board");
+        }
+        if (!board->instance.undoMove()) {
+            return fail(HEXUKI_ERROR_ILLEGAL_MOVE, "no move to undo");
+        }
+        return HEXUKI_OK;
+    });
+}
+
+int hexuki_board_pack(const hexuki_board* board, int32_t* record) {
+    return guarded([&] {
+        if (board == nullptr || record == nullptr) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "null board or record");
+        }
+        api::packPosition(board->instance.getBoard(), static_cast<int>(board->instance.getHistory().size()), record);
+        return HEXUKI_OK;
+    });
+}
+
+int hexuki_position_init(int32_t* record) {
+    return guarded([&] {
+        if (record == nullptr) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "null record");
+        }
+        api::packPosition(HexukiBitboard(), 0, record);
+        return HEXUKI_OK;
+    });
+}
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+int hexuki_batch_valid_moves(const int32_t* positions, int count, int32_t* out) {
+    return guarded([&] {
+        int status = checkBatch(positions, count, out);
+        if (status != HEXUKI_OK) return status;
+
+        std::fill(out, out + static_cast<size_t>(count) * HEXUKI_MOVES_STRIDE, 0);
+        std::vector<Move> moves;
+        for (int i = 0; i < count; i++) {
+            const int32_t* record = positions + static_cast<size_t>(i) * api::POSITION_STRIDE;
+            int32_t* result = out + static_cast<size_t>(i) * HEXUKI_MOVES_STRIDE;
+            api::getV2ValidMoves(api::unpackPosition(record), record[api::POS_MOVE_COUNT], moves);
+            result[0] = static_cast<int32_t>(moves.size());
+            for (size_t m = 0; m < moves.size(); m++) {
+                result[1 + m * api::MOVE_STRIDE] = moves[m].hexId;
+                result[2 + m * api::MOVE_STRIDE] = moves[m].tileValue;
+            }
+        }
+        return HEXUKI_OK;
+    });
+}
+
+int hexuki_batch_scores(const int32_t* positions, int count, int32_t* out) {
+    return guarded([&] {
+        int status = checkBatch(positions, count, out);
+        if (status != HEXUKI_OK) return status;
+
+        std::vector<int32_t> scores;
+        api::batchScores(positions, count, scores);
+        std::copy(scores.begin(), scores.end(), out);
+        return HEXUKI_OK;
+    });
+}
+
+int hexuki_batch_playouts(const int32_t* positions, int count, uint32_t seed, int32_t* out) {
+    return guarded([&] {
+        int status = checkBatch(positions, count, out);
+        if (status != HEXUKI_OK) return status;
+
+        std::vector<int32_t> playouts;
+        api::batchPlayouts(positions, count, seed, playouts);
+        std::copy(playouts.begin(), playouts.end(), out);
+        return HEXUKI_OK;
+    });
+}
+
+int hexuki_batch_minimax(const int32_t* positions, int count, int depth, int time_limit_ms, double* out) {
+    return guarded([&] {
+        if (depth < 1 || time_limit_ms < 1) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "depth and time limit must be positive");
+        }
+        minimax::SearchConfig config;
+        config.maxDepth = depth;
+        config.timeLimitMs = time_limit_ms;
+        return batchSearch(positions, count, out, [&](HexukiBitboard& board, size_t, std::vector<double>& packed) {
+            api::packMinimaxResult(minimax::findBestMove(board, config), true, packed);
+        });
+    });
+}
+
+int hexuki_batch_mcts(const int32_t* positions, int count, int simulations, uint32_t seed, double* out) {
+    return guarded([&] {
+        if (simulations < 1) {
+            return fail(HEXUKI_ERROR_INVALID_ARGUMENT, "simulations must be positive");
+        }
+        return batchSearch(positions, count, out, [&](HexukiBitboard& board, size_t i, std::vector<double>& packed) {
+            mcts::MCTSConfig config;
+            config.numSimulations = simulations;
+            config.useTimeLimit = false;
+            config.seed = seed == 0 ? 0 : seed + static_cast<uint32_t>(i);
+            mcts::MCTS engine;
+            api::packMCTSResult(engine.findBestMove(board, config), true, packed);
+        });
+    });
+}
+
+} // extern "C"
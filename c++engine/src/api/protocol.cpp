@@ -0,0 +1,358 @@
+#include "api/protocol.h"
+#include "api/batch_ops.h"
+#include "core/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <sstream>
+#include <stdexcept>
+
+namespace hexuki {
+namespace api {
+
+// Work per step between stop/clock checks (as in EngineInstance::stepSearch)
+static constexpr int MINIMAX_CHUNK = 2048;
+static constexpr int MCTS_CHUNK = 16;
+
+static std::vector<std::string> tokenize(const std::string& line) {
+    std::istringstream iss(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (iss >> token) tokens.push_back(token);
+    return tokens;
+}
+
+static std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// "h6t5", or "none" when there is no move (finished game)
+static std::string moveText(const Move& move) {
+    return move.isValid() ? move.toString() : "none";
+}
+
+ProtocolEngine::ProtocolEngine(std::ostream& out) : out(out), stopRequested(false), parallelRunning(false) {}
+
+ProtocolEngine::~ProtocolEngine() {
+    stopSearch();
+}
+
+void ProtocolEngine::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outMutex);
+    out << line << std::endl;
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+bool ProtocolEngine::handleLine(const std::string& line) {
+    std::vector<std::string> tokens = tokenize(line);
+    if (tokens.empty()) return true;
+
+    const std::string command = tokens[0];
+    const std::vector<std::string> args(tokens.begin() + 1, tokens.end());
+
+    try {
+        if (command == "uci") {
+            cmdUci();
+        } else if (command == "isready") {
+            send("readyok");
+        } else if (command == "setoption") {
+            stopSearch();
+            cmdSetOption(args);
+        } else if (command == "ucinewgame") {
+            HEXUKI_TRACE_INSTANT("game.new");
+            stopSearch();
+            if (table && !table.isShared()) table->clear();
+            mctsEngine.reset();
+        } else if (command == "position") {
+            stopSearch();
+            cmdPosition(args);
+        } else if (command == "go") {
+            stopSearch();
+            cmdGo(args);
+        } else if (command == "stop") {
+            if (parallelRunning.load()) send("info string stop: a Threads > 1 search runs to its limit");
+            stopSearch();
+        } else if (command == "d") {
+            cmdDisplay();
+        } else if (command == "quit") {
+            stopSearch();
+            return false;
+        } else {
+            send("info string unknown command: " + command);
+        }
+    } catch (const std::exception& e) {
+        send("info string error: " + std::string(e.what()));
+    }
+    return true;
+}
+
+void ProtocolEngine::run(std::istream& in) {
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!handleLine(line)) return;
+    }
+    // End of input: let a bounded search finish (pipelines close stdin early)
+    waitForSearch();
+}
+
+void ProtocolEngine::waitForSearch() {
+    if (searchThread.joinable()) searchThread.join();
+}
+
+void ProtocolEngine::stopSearch() {
+    stopRequested.store(true, std::memory_order_relaxed);
+    waitForSearch();
+    stopRequested.store(false, std::memory_order_relaxed);
+}
+
+void ProtocolEngine::cmdUci() {
+    send("id name Hexuki Engine");
+    send("id author Hexuki");
+    send("option name Hash type spin default 128 min 1 max " + std::to_string(MAX_HASH_MB));
+    send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+    send("option name Engine type combo default minimax var minimax var mcts");
+    send("option name Seed type spin default 0 min 0 max 4294967295");
+    send("uciok");
+}
+
+// setoption name <name> value <value>
+void ProtocolEngine::cmdSetOption(const std::vector<std::string>& args) {
+    if (args.size() < 4 || args[0] != "name" || args[2] != "value") {
+        throw std::invalid_argument("usage: setoption name <name> value <value>");
+    }
+    const std::string name = lower(args[1]);
+    const std::string& value = args[3];
+
+    if (name == "hash") {
+        int mb = std::stoi(value);
+        hashMB = static_cast<size_t>(std::max(1, std::min(mb, MAX_HASH_MB)));
+        // The engine process owns the pool: make room for the requested table
+        minimax::TablePool& pool = minimax::TablePool::global();
+        pool.setBudgetMB(std::max(pool.getBudgetMB(), hashMB));
+        table.reset();  // Re-leased at the new size by the next search
+    } else if (name == "threads") {
+        threads = std::max(1, std::min(std::stoi(value), MAX_THREADS));
+    } else if (name == "engine") {
+        std::string type = lower(value);
+        if (type == "minimax") {
+            engineType = EngineType::MINIMAX;
+        } else if (type == "mcts") {
+            engineType = EngineType::MCTS;
+        } else {
+            throw std::invalid_argument("Engine must be minimax or mcts");
+        }
+    } else if (name == "seed") {
+        seed = static_cast<uint32_t>(std::stoul(value));
+    } else {
+        throw std::invalid_argument("unknown option: " + args[1]);
+    }
+}
+
+// position startpos|fen <savePosition> [moves ...]
+void ProtocolEngine::cmdPosition(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        throw std::invalid_argument("usage: position startpos|fen <position> [moves ...]");
+    }
+
+    HexukiBitboard next;
+    size_t i = 1;
+    if (args[0] == "fen") {
+        if (args.size() < 2) throw std::invalid_argument("position fen needs a position string");
+        if (!api::isValidPositionString(args[1])) throw std::invalid_argument("invalid position " + args[1]);
+        next.loadPosition(args[1]);
+        i = 2;
+    } else if (args[0] != "startpos") {
+        throw std::invalid_argument("position must start with startpos or fen");
+    }
+
+    if (i < args.size()) {
+        if (args[i] != "moves") throw std::invalid_argument("expected moves, got " + args[i]);
+        for (i++; i < args.size(); i++) {
+            Move move = Move::fromString(args[i]);
+            if (!next.isValidMove(move)) throw std::invalid_argument("illegal move " + args[i]);
+            next.makeMove(move);
+        }
+    }
+    board = next;  // Only a fully valid command changes the position
+}
+
+void ProtocolEngine::cmdGo(const std::vector<std::string>& args) {
+    Limits limits;
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& key = args[i];
+        if (key == "infinite") {
+            limits.infinite = true;
+            continue;
+        }
+        if (i + 1 >= args.size()) throw std::invalid_argument("go " + key + " needs a value");
+        const std::string& value = args[++i];
+        if (key == "depth") {
+            limits.depth = std::max(1, std::stoi(value));
+        } else if (key == "nodes") {
+            limits.nodes = std::max(1LL, std::stoll(value));
+        } else if (key == "sims") {
+            limits.sims = std::max(1, std::stoi(value));
+        } else if (key == "movetime") {
+            limits.movetimeMs = std::max(1, std::stoi(value));
+        } else {
+            throw std::invalid_argument("unknown go limit: " + key);
+        }
+    }
+
+    if (board.getValidMoves().empty()) {
+        send("bestmove none");
+        return;
+    }
+
+    // The root-parallel searches cannot be interrupted or counted
+    if (threads > 1 && (limits.infinite || limits.nodes > 0)) {
+        send("info string Threads " + std::to_string(threads) + " ignored: go " +
+             (limits.infinite ? "infinite" : "nodes") + " searches single-threaded");
+    }
+    if (threads > 1 && !limits.infinite && limits.nodes == 0) {
+        parallelRunning.store(true);
+        searchThread = std::thread(&ProtocolEngine::searchParallel, this, board, limits);
+    } else if (engineType == EngineType::MCTS) {
+        searchThread = std::thread(&ProtocolEngine::searchMCTS, this, board, limits);
+    } else {
+        searchThread = std::thread(&ProtocolEngine::searchMinimax, this, board, limits);
+    }
+}
+
+void ProtocolEngine::cmdDisplay() {
+    send("position " + board.savePosition());
+    std::string legal = "legal";
+    for (const Move& move : board.getValidMoves()) legal += " " + move.toString();
+    send(legal);
+}
+
+minimax::TranspositionTable& ProtocolEngine::warmTable() {
+    if (!table) {
+        table = minimax::TablePool::global().acquire(hashMB);
+    }
+    return *table;
+}
+
+// ============================================================================
+// Searches (search thread)
+// ============================================================================
+
+void ProtocolEngine::sendMinimaxInfo(const minimax::SearchResult& result, double timeMs) {
+    std::ostringstream line;
+    long long nps = timeMs > 0 ? static_cast<long long>(result.nodesSearched * 1000.0 / timeMs) : 0;
+    line << "info depth " << result.depth << " score " << result.score << " nodes " << result.nodesSearched
+         << " time " << static_cast<long long>(timeMs) << " nps " << nps << " pv " << moveText(result.bestMove);
+    send(line.str());
+}
+
+void ProtocolEngine::sendMCTSInfo(const mcts::MCTSResult& result, double timeMs) {
+    std::ostringstream line;
+    line << "info sims " << result.simulations << " time " << static_cast<long long>(timeMs) << " winrate "
+         << result.winRate << " visits " << result.visits << " pv " << moveText(result.bestMove);
+    send(line.str());
+}
+
+void ProtocolEngine::searchMinimax(HexukiBitboard root, Limits limits) {
+    minimax::SearchConfig config;
+    if (limits.depth > 0) config.maxDepth = limits.depth;
+    if (limits.movetimeMs > 0) config.timeLimitMs = limits.movetimeMs;
+    if (limits.infinite) config.timeLimitMs = INT_MAX;
+    config.ttSizeMB = hashMB;
+
+    auto start = std::chrono::steady_clock::now();
+    minimax::SearchTask task(root, config, &warmTable());
+    long long spent = 0;
+    int reportedDepth = 0;
+
+    bool done = false;
+    while (!done) {
+        if (stopRequested.load(std::memory_order_relaxed) || (limits.nodes > 0 && spent >= limits.nodes)) {
+            task.stop();
+            break;
+        }
+        done = task.step(MINIMAX_CHUNK);
+        spent += MINIMAX_CHUNK;
+        if (task.getResult().depth > reportedDepth) {
+            reportedDepth = task.getResult().depth;
+            sendMinimaxInfo(task.getResult(), elapsedMs(start));
+        }
+    }
+
+    minimax::SearchResult result = task.getResult();
+    if (result.depth > reportedDepth) sendMinimaxInfo(result, elapsedMs(start));
+    send("bestmove " + moveText(result.bestMove));
+}
+
+void ProtocolEngine::searchMCTS(HexukiBitboard root, Limits limits) {
+    mcts::MCTSConfig config;
+    config.seed = seed;
+    if (limits.sims > 0) config.numSimulations = limits.sims;
+    if (limits.movetimeMs > 0) config.timeLimitMs = limits.movetimeMs;
+    // A simulation count alone means exactly that many (no default clock)
+    config.useTimeLimit = limits.movetimeMs > 0 || (limits.sims == 0 && !limits.infinite);
+    if (limits.infinite) config.numSimulations = INT_MAX;
+    if (limits.movetimeMs > 0 && limits.sims == 0) config.numSimulations = INT_MAX;
+
+    if (!mctsEngine) mctsEngine = std::make_unique<mcts::MCTS>();
+    auto start = std::chrono::steady_clock::now();
+    auto nextInfo = start + std::chrono::milliseconds(INFO_INTERVAL_MS);
+    mctsEngine->beginSearch(root, config);
+
+    while (!stopRequested.load(std::memory_order_relaxed) && !mctsEngine->step(MCTS_CHUNK)) {
+        if (std::chrono::steady_clock::now() >= nextInfo) {
+            sendMCTSInfo(mctsEngine->getResult(), elapsedMs(start));
+            nextInfo += std::chrono::milliseconds(INFO_INTERVAL_MS);
+        }
+    }
+
+    mcts::MCTSResult result = mctsEngine->getResult();
+    mctsEngine->endSearch();
+    sendMCTSInfo(result, elapsedMs(start));
+    send("bestmove " + moveText(result.bestMove));
+}
+
+// Threads > 1: the blocking root-parallel searches (one report at the end).
+// Minimax gives each thread its own pool table, so the warm table goes back
+// to the pool for them to use.
+void ProtocolEngine::searchParallel(HexukiBitboard root, Limits limits) {
+    auto start = std::chrono::steady_clock::now();
+    Move best;
+    if (engineType == EngineType::MCTS) {
+        mcts::MCTSConfig config;
+        config.numThreads = threads;
+        config.seed = seed;
+        if (limits.sims > 0) config.numSimulations = limits.sims;
+        if (limits.movetimeMs > 0) config.timeLimitMs = limits.movetimeMs;
+        config.useTimeLimit = limits.movetimeMs > 0 || limits.sims == 0;
+        if (limits.movetimeMs > 0 && limits.sims == 0) config.numSimulations = INT_MAX;
+
+        if (!mctsEngine) mctsEngine = std::make_unique<mcts::MCTS>();
+        mcts::MCTSResult result = mctsEngine->findBestMove(root, config);
+        sendMCTSInfo(result, elapsedMs(start));
+        best = result.bestMove;
+    } else {
+        minimax::SearchConfig config;
+        config.numThreads = threads;
+        config.ttSizeMB = hashMB;
+        if (limits.depth > 0) config.maxDepth = limits.depth;
+        if (limits.movetimeMs > 0) config.timeLimitMs = limits.movetimeMs;
+
+        table.reset();
+        minimax::SearchResult result = minimax::findBestMove(root, config);
+        sendMinimaxInfo(result, elapsedMs(start));
+        best = result.bestMove;
+    }
+    parallelRunning.store(false);
+    send("bestmove " + moveText(best));
+}
+
+} // namespace api
+} // namespace hexuki
@@ -0,0 +1,51 @@
+#include "api/result_layout.h"
+
+namespace hexuki {
+namespace api {
+
+void packMoves(const std::vector<Move>& moves, std::vector<int32_t>& out) {
+    out.resize(moves.size() * MOVE_STRIDE);
+    for (size_t i = 0; i < moves.size(); i++) {
+        out[i * MOVE_STRIDE] = moves[i].hexId;
+        out[i * MOVE_STRIDE + 1] = moves[i].tileValue;
+    }
+}
+
+void packEmptyResult(std::vector<double>& out) {
+    out.assign(SEARCH_HEADER_SIZE, 0.0);
+}
+
+void packMCTSResult(const mcts::MCTSResult& result, bool done, std::vector<double>& out) {
+    packEmptyResult(out);
+    out[FIELD_ENGINE] = 1;
+    out[FIELD_DONE] = done ? 1 : 0;
+    out[FIELD_HEX] = result.bestMove.hexId;
+    out[FIELD_TILE] = result.bestMove.tileValue;
+    out[FIELD_TIME_MS] = result.timeMs;
+    out[FIELD_WORK] = result.simulations;
+    out[FIELD_VISITS] = result.visits;
+    out[FIELD_WIN_RATE] = result.winRate;
+    out[FIELD_TOP_MOVE_COUNT] = static_cast<double>(result.topMoves.size());
+
+    for (const auto& top : result.topMoves) {
+        out.push_back(top.move.hexId);
+        out.push_back(top.move.tileValue);
+        out.push_back(top.visits);
+        out.push_back(top.winRate);
+    }
+}
+
+void packMinimaxResult(const minimax::SearchResult& result, bool done, std::vector<double>& out) {
+    packEmptyResult(out);
+    out[FIELD_ENGINE] = 2;
+    out[FIELD_DONE] = done ? 1 : 0;
+    out[FIELD_HEX] = result.bestMove.hexId;
+    out[FIELD_TILE] = result.bestMove.tileValue;
+    out[FIELD_TIME_MS] = result.timeMs;
+    out[FIELD_WORK] = result.nodesSearched;
+    out[FIELD_SCORE] = result.score;
+    out[FIELD_DEPTH] = result.depth;
+}
+
+} // namespace api
+} // namespace hexuki
@@ -1,4 +1,5 @@
 #include "core/bitboard.h"
+#include "core/board_kernels.h"
 #include "core/zobrist.h"
 #include "utils/timer.h"
 #include <iostream>
@@ -72,11 +73,7 @@ void HexukiBitboard::reset() {
 bool HexukiBitboard::isGameOver() const {
     // Game ends when all 19 hexes are filled
     // Can't use moveCount >= 18 because puzzles might have empty center hex (allowing 19 moves)
-    int occupiedCount = 0;
-    for (int i = 0; i < NUM_HEXES; i++) {
-        if (isHexOccupied(i)) occupiedCount++;
-    }
-    return occupiedCount >= NUM_HEXES;
+    return (hexOccupied & kernels::ALL_HEXES_MASK) == kernels::ALL_HEXES_MASK;
 }
 
 bool HexukiBitboard::isTileAvailable(int player, int tileValue) const {
@@ -429,40 +426,50 @@ bool HexukiBitboard::isValidMove(const Move& move) const {
     return true;
 }
 
-std::vector<Move> HexukiBitboard::getValidMoves() const {
-    std::vector<Move> moves;
-
-    // OPTIMIZATION: Use const reference to avoid copying the tiles vector
+int HexukiBitboard::getUniqueTiles(int* tiles) const {
     const std::vector<int>& availableTiles = (currentPlayer == PLAYER_1) ? p1AvailableTiles : p2AvailableTiles;
 
-    // Get unique tile values (handle duplicates like [1,1,1,1,1,1,1,1,1])
-    // If tiles = [1,1,1], we only want to try placing "1" once, not three times
-    // OPTIMIZATION: Reserve capacity to avoid reallocations
-    std::vector<int> uniqueTileValues;
-    uniqueTileValues.reserve(9);  // Max 9 unique tiles
-
-    // Manual deduplication (faster than copy+sort+unique for small vectors)
+    // Handle duplicates like [1,1,1,1,1,1,1,1,1]: each value is tried once.
+    // Bounded by the buffer even if a hand got past setAvailableTiles().
+    int count = 0;
     for (int tile : availableTiles) {
-        if (std::find(uniqueTileValues.begin(), uniqueTileValues.end(), tile) == uniqueTileValues.end()) {
-            uniqueTileValues.push_back(tile);
+        if (count == NUM_TILES_PER_PLAYER) break;
+        if (std::find(tiles, tiles + count, tile) == tiles + count) {
+            tiles[count++] = tile;
         }
     }
+    return count;
+}
+
+uint32_t HexukiBitboard::getLegalHexMask() const {
+    // Adjacency + chain length constraint for every hex in one kernel call
+    return kernels::legalHexMask(hexOccupied);
+}
+
+std::vector<Move> HexukiBitboard::getValidMoves() const {
+    Move moves[MAX_LEGAL_MOVES];
+    int count = getValidMoves(moves);
+    return std::vector<Move>(moves, moves + count);
+}
+
+int HexukiBitboard::getValidMoves(Move* moves) const {
+    int uniqueTileValues[NUM_TILES_PER_PLAYER];
+    int tileCount = getUniqueTiles(uniqueTileValues);
 
     // Symmetry checks removed - no longer enforcing anti-symmetry rule
 
+    int count = 0;
+    uint32_t legal = getLegalHexMask();
     for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
-        if (isHexOccupied(hexId)) continue;
+        if (!(legal & (1u << hexId))) continue;
 
-        if (isMoveLegal(hexId)) {
-            // Try each unique tile value (avoids generating duplicate moves)
-            for (int tileValue : uniqueTileValues) {
-                // Add all valid moves without symmetry checks
-                moves.push_back(Move(hexId, tileValue));
-            }
+        // Try each unique tile value (avoids generating duplicate moves)
+        for (int i = 0; i < tileCount; i++) {
+            moves[count++] = Move(hexId, uniqueTileValues[i]);
         }
     }
 
-    return moves;
+    return count;
 }
 
 // ============================================================================
@@ -552,7 +559,13 @@ int HexukiBitboard::calculatePlayerScore(int player) const {
 }
 
 int HexukiBitboard::getScore(int player) const {
-    return calculatePlayerScore(player);
+    int p1Score, p2Score;
+    kernels::chainScores(hexValues, p1Score, p2Score);
+    return player == PLAYER_1 ? p1Score : p2Score;
+}
+
+void HexukiBitboard::getScores(int& p1Score, int& p2Score) const {
+    kernels::chainScores(hexValues, p1Score, p2Score);
 }
 
 // ============================================================================
@@ -626,6 +639,7 @@ std::string HexukiBitboard::toNotation() const {
 
 void HexukiBitboard::setHexValue(int hexId, int tileValue) {
     if (hexId < 0 || hexId >= NUM_HEXES) return;
+    if (tileValue < 1 || tileValue > MAX_TILE_VALUE) return;  // Zobrist keys exist for 1..MAX_TILE_VALUE only
 
     // Place the tile
     hexOccupied |= (1u << hexId);
@@ -647,7 +661,12 @@ void HexukiBitboard::removeHexValue(int hexId) {
 }
 
 void HexukiBitboard::setAvailableTiles(int player, const std::vector<int>& tiles) {
-    // Directly assign tile vector (supports duplicates like [1,1,1,1,1,1,1,1,1])
+    // Directly assign tile vector (supports duplicates like [1,1,1,1,1,1,1,1,1]).
+    // Hands larger than 9 or with values outside 1..MAX_TILE_VALUE are ignored.
+    if (tiles.size() > static_cast<size_t>(NUM_TILES_PER_PLAYER)) return;
+    for (int tile : tiles) {
+        if (tile < 1 || tile > MAX_TILE_VALUE) return;
+    }
     if (player == PLAYER_1) {
         p1AvailableTiles = tiles;
     } else if (player == PLAYER_2) {
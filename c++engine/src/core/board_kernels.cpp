@@ -0,0 +1,428 @@
+#include "core/board_kernels.h"
+
+#if defined(HEXUKI_SIMD) && defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(HEXUKI_SIMD)
+#include <smmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace hexuki {
+namespace kernels {
+
+// ============================================================================
+// Tables (derived at compile time from constants.h)
+// ============================================================================
+
+namespace {
+
+constexpr int LINE_COUNT = 15;
+constexpr int LINE_MAX = 5;
+constexpr int LINES_PER_HEX = 3;   // One per direction
+constexpr int SENTINEL = NUM_HEXES;  // Score gather index of a constant 1
+
+// The 15 lines walked by the chain length constraint (CHAIN_STARTERS)
+struct LineTable {
+    int hexes[LINE_COUNT][LINE_MAX];
+    int length[LINE_COUNT];
+    int hexLine[NUM_HEXES][LINES_PER_HEX];  // Lines through each hex...
+    int hexPos[NUM_HEXES][LINES_PER_HEX];   // ...and its position on them
+};
+
+constexpr LineTable computeLines() {
+    LineTable table = {};
+    int found[NUM_HEXES] = {};
+    for (int line = 0; line < LINE_COUNT; line++) {
+        const ChainStarter& starter = CHAIN_STARTERS[line];
+        int row = HEX_POSITIONS[starter.startHex].row;
+        int col = HEX_POSITIONS[starter.startHex].col;
+        int length = 0;
+        while (row >= 0 && row < 9 && col >= 0 && col < 5 && ROW_COL_TO_HEX[row][col] >= 0) {
+            int hex = ROW_COL_TO_HEX[row][col];
+            table.hexes[line][length] = hex;
+            table.hexLine[hex][found[hex]] = line;
+            table.hexPos[hex][found[hex]] = length;
+            found[hex]++;
+            length++;
+            row += starter.dir.dr;
+            col += starter.dir.dc;
+        }
+        table.length[line] = length;
+        for (int k = length; k < LINE_MAX; k++) {
+            table.hexes[line][k] = -1;
+        }
+    }
+    return table;
+}
+
+constexpr LineTable LINES = computeLines();
+
+// Occupied-run statistics of a line pattern (bit k = position k occupied)
+struct RunTable {
+    uint8_t top1[1 << LINE_MAX];           // Longest run
+    uint8_t top2[1 << LINE_MAX];           // Second longest run (0 if none)
+    uint8_t at[1 << LINE_MAX][LINE_MAX];   // Length of the run covering position k
+};
+
+constexpr RunTable computeRuns() {
+    RunTable table = {};
+    for (int pattern = 0; pattern < (1 << LINE_MAX); pattern++) {
+        int first = 0, second = 0;
+        int k = 0;
+        while (k < LINE_MAX) {
+            if (!(pattern & (1 << k))) {
+                k++;
+                continue;
+            }
+            int start = k;
+            while (k < LINE_MAX && (pattern & (1 << k))) k++;
+            int run = k - start;
+            for (int j = start; j < k; j++) {
+                table.at[pattern][j] = static_cast<uint8_t>(run);
+            }
+            if (run > first) {
+                second = first;
+                first = run;
+            } else if (run > second) {
+                second = run;
+            }
+        }
+        table.top1[pattern] = static_cast<uint8_t>(first);
+        table.top2[pattern] = static_cast<uint8_t>(second);
+    }
+    return table;
+}
+
+constexpr RunTable RUNS = computeRuns();
+
+struct AdjacencyMasks {
+    uint32_t mask[20];  // Padded to a multiple of 4 lanes
+};
+
+constexpr AdjacencyMasks computeAdjacencyMasks() {
+    AdjacencyMasks table = {};
+    for (int hex = 0; hex < NUM_HEXES; hex++) {
+        for (int i = 0; i < ADJACENT_HEXES[hex].count; i++) {
+            table.mask[hex] |= 1u << ADJACENT_HEXES[hex].hexes[i];
+        }
+    }
+    return table;
+}
+
+constexpr AdjacencyMasks ADJACENCY = computeAdjacencyMasks();
+
+inline int countTrailingZeros(uint32_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(x);
+#endif
+}
+
+// Top two run lengths over all lines (multiset, as in checkChainLengthConstraint)
+inline void insertRun(int run, int& first, int& second) {
+    if (run > first) {
+        second = first;
+        first = run;
+    } else if (run > second) {
+        second = run;
+    }
+}
+
+// Chain length constraint for each frontier hex, given the line patterns of
+// the current occupancy
+uint32_t applyChainConstraint(uint32_t frontier, const uint8_t patterns[LINE_COUNT]) {
+    uint32_t legal = 0;
+    while (frontier) {
+        int hex = countTrailingZeros(frontier);
+        frontier &= frontier - 1;
+
+        uint8_t placed[LINE_COUNT];
+        for (int l = 0; l < LINE_COUNT; l++) placed[l] = patterns[l];
+
+        int affected = 0;
+        for (int i = 0; i < LINES_PER_HEX; i++) {
+            int line = LINES.hexLine[hex][i];
+            int pos = LINES.hexPos[hex][i];
+            placed[line] = static_cast<uint8_t>(placed[line] | (1u << pos));
+            int run = RUNS.at[placed[line]][pos];
+            if (run > affected) affected = run;
+        }
+
+        int first = 0, second = 0;
+        for (int l = 0; l < LINE_COUNT; l++) {
+            insertRun(RUNS.top1[placed[l]], first, second);
+            insertRun(RUNS.top2[placed[l]], first, second);
+        }
+
+        // Longest chain through the new tile may be at most 1 longer than the second longest
+        if (affected <= second + 1) {
+            legal |= 1u << hex;
+        }
+    }
+    return legal;
+}
+
+#ifdef HEXUKI_SIMD
+
+// Per-position bit masks of the 15 lines, one lane per line (lane 15 unused)
+struct LineBitVectors {
+    alignas(16) uint32_t bits[LINE_MAX][16];
+};
+
+constexpr LineBitVectors computeLineBits() {
+    LineBitVectors table = {};
+    for (int k = 0; k < LINE_MAX; k++) {
+        for (int line = 0; line < LINE_COUNT; line++) {
+            int hex = LINES.hexes[line][k];
+            table.bits[k][line] = hex >= 0 ? (1u << hex) : 0;
+        }
+    }
+    return table;
+}
+
+constexpr LineBitVectors LINE_BITS = computeLineBits();
+
+// Byte shuffles gathering, for chain position k, P1's five chain values into
+// lanes 0-4 and P2's into lanes 8-12 (other lanes read the constant 1). The
+// value array is 32 bytes, so each gather is split into a low and a high
+// 16-byte table; out-of-range lanes (0x80) read 0 in both pshufb and swizzle.
+struct ScoreShuffles {
+    alignas(16) uint8_t lo[LINE_MAX][16];
+    alignas(16) uint8_t hi[LINE_MAX][16];
+};
+
+constexpr ScoreShuffles computeScoreShuffles() {
+    ScoreShuffles table = {};
+    for (int k = 0; k < LINE_MAX; k++) {
+        for (int lane = 0; lane < 16; lane++) {
+            int index = SENTINEL;
+            if (lane < 5 && P1_CHAINS[lane][k] >= 0) index = P1_CHAINS[lane][k];
+            if (lane >= 8 && lane < 13 && P2_CHAINS[lane - 8][k] >= 0) index = P2_CHAINS[lane - 8][k];
+            table.lo[k][lane] = static_cast<uint8_t>(index < 16 ? index : 0x80);
+            table.hi[k][lane] = static_cast<uint8_t>(index >= 16 ? index - 16 : 0x80);
+        }
+    }
+    return table;
+}
+
+constexpr ScoreShuffles SCORE_SHUFFLES = computeScoreShuffles();
+
+#endif // HEXUKI_SIMD
+
+} // namespace
+
+// ============================================================================
+// Scalar Kernels
+// ============================================================================
+
+namespace scalar {
+
+uint32_t frontierMask(uint32_t occupied) {
+    uint32_t frontier = 0;
+    for (int hex = 0; hex < NUM_HEXES; hex++) {
+        if (occupied & ADJACENCY.mask[hex]) frontier |= 1u << hex;
+    }
+    return frontier & ~occupied & ALL_HEXES_MASK;
+}
+
+uint32_t legalHexMask(uint32_t occupied) {
+    uint8_t patterns[LINE_COUNT];
+    for (int line = 0; line < LINE_COUNT; line++) {
+        uint8_t pattern = 0;
+        for (int k = 0; k < LINES.length[line]; k++) {
+            if (occupied & (1u << LINES.hexes[line][k])) pattern |= 1u << k;
+        }
+        patterns[line] = pattern;
+    }
+    return applyChainConstraint(frontierMask(occupied), patterns);
+}
+
+void chainScores(const uint8_t hexValues[NUM_HEXES], int& p1Score, int& p2Score) {
+    p1Score = 0;
+    p2Score = 0;
+    for (int chain = 0; chain < 5; chain++) {
+        int p1Product = 1, p2Product = 1;
+        for (int k = 0; k < LINE_MAX; k++) {
+            if (P1_CHAINS[chain][k] >= 0 && hexValues[P1_CHAINS[chain][k]]) p1Product *= hexValues[P1_CHAINS[chain][k]];
+            if (P2_CHAINS[chain][k] >= 0 && hexValues[P2_CHAINS[chain][k]]) p2Product *= hexValues[P2_CHAINS[chain][k]];
+        }
+        p1Score += p1Product;
+        p2Score += p2Product;
+    }
+}
+
+} // namespace scalar
+
+// ============================================================================
+// SIMD Kernels
+// ============================================================================
+
+#if defined(HEXUKI_SIMD) && defined(__wasm_simd128__)
+
+uint32_t frontierMask(uint32_t occupied) {
+    const v128_t occ = wasm_u32x4_splat(occupied);
+    uint32_t frontier = 0;
+    for (int i = 0; i < 5; i++) {
+        v128_t adj = wasm_v128_load(&ADJACENCY.mask[i * 4]);
+        v128_t touches = wasm_i32x4_ne(wasm_v128_and(adj, occ), wasm_i32x4_splat(0));
+        frontier |= static_cast<uint32_t>(wasm_i32x4_bitmask(touches)) << (i * 4);
+    }
+    return frontier & ~occupied & ALL_HEXES_MASK;
+}
+
+uint32_t legalHexMask(uint32_t occupied) {
+    const v128_t occ = wasm_u32x4_splat(occupied);
+    alignas(16) uint32_t lanes[16];
+    for (int v = 0; v < 4; v++) {
+        v128_t pattern = wasm_i32x4_splat(0);
+        for (int k = 0; k < LINE_MAX; k++) {
+            v128_t bits = wasm_v128_load(&LINE_BITS.bits[k][v * 4]);
+            v128_t set = wasm_i32x4_ne(wasm_v128_and(bits, occ), wasm_i32x4_splat(0));
+            pattern = wasm_v128_or(pattern, wasm_v128_and(set, wasm_i32x4_splat(1 << k)));
+        }
+        wasm_v128_store(&lanes[v * 4], pattern);
+    }
+    uint8_t patterns[LINE_COUNT];
+    for (int line = 0; line < LINE_COUNT; line++) patterns[line] = static_cast<uint8_t>(lanes[line]);
+    return applyChainConstraint(frontierMask(occupied), patterns);
+}
+
+void chainScores(const uint8_t hexValues[NUM_HEXES], int& p1Score, int& p2Score) {
+    alignas(16) uint8_t values[32] = {};
+    for (int i = 0; i < NUM_HEXES; i++) values[i] = hexValues[i];
+    const v128_t one = wasm_i8x16_splat(1);
+    const v128_t lo = wasm_u8x16_max(wasm_v128_load(values), one);       // Empty hex counts as 1
+    const v128_t hi = wasm_u8x16_max(wasm_v128_load(values + 16), one);
+
+    v128_t product[4];
+    for (int j = 0; j < 4; j++) product[j] = wasm_i32x4_splat(1);
+    for (int k = 0; k < LINE_MAX; k++) {
+        v128_t bytes = wasm_v128_or(wasm_i8x16_swizzle(lo, wasm_v128_load(SCORE_SHUFFLES.lo[k])),
+                                    wasm_i8x16_swizzle(hi, wasm_v128_load(SCORE_SHUFFLES.hi[k])));
+        v128_t low16 = wasm_u16x8_extend_low_u8x16(bytes);
+        v128_t high16 = wasm_u16x8_extend_high_u8x16(bytes);
+        product[0] = wasm_i32x4_mul(product[0], wasm_u32x4_extend_low_u16x8(low16));
+        product[1] = wasm_i32x4_mul(product[1], wasm_u32x4_extend_high_u16x8(low16));
+        product[2] = wasm_i32x4_mul(product[2], wasm_u32x4_extend_low_u16x8(high16));
+        product[3] = wasm_i32x4_mul(product[3], wasm_u32x4_extend_high_u16x8(high16));
+    }
+
+    alignas(16) int32_t lanes[16];
+    for (int j = 0; j < 4; j++) wasm_v128_store(&lanes[j * 4], product[j]);
+    p1Score = lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4];
+    p2Score = lanes[8] + lanes[9] + lanes[10] + lanes[11] + lanes[12];
+}
+
+const char* simdName() {
+    return "wasm-simd128";
+}
+
+#elif defined(HEXUKI_SIMD)
+
+uint32_t frontierMask(uint32_t occupied) {
+    const __m128i occ = _mm_set1_epi32(static_cast<int>(occupied));
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t frontier = 0;
+    for (int i = 0; i < 5; i++) {
+        __m128i adj = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ADJACENCY.mask[i * 4]));
+        __m128i untouched = _mm_cmpeq_epi32(_mm_and_si128(adj, occ), zero);
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(untouched)));
+        frontier |= (~bits & 0xF) << (i * 4);
+    }
+    return frontier & ~occupied & ALL_HEXES_MASK;
+}
+
+uint32_t legalHexMask(uint32_t occupied) {
+    const __m128i occ = _mm_set1_epi32(static_cast<int>(occupied));
+    const __m128i zero = _mm_setzero_si128();
+    alignas(16) uint32_t lanes[16];
+    for (int v = 0; v < 4; v++) {
+        __m128i pattern = zero;
+        for (int k = 0; k < LINE_MAX; k++) {
+            __m128i bits = _mm_load_si128(reinterpret_cast<const __m128i*>(&LINE_BITS.bits[k][v * 4]));
+            __m128i clear = _mm_cmpeq_epi32(_mm_and_si128(bits, occ), zero);
+            pattern = _mm_or_si128(pattern, _mm_andnot_si128(clear, _mm_set1_epi32(1 << k)));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(&lanes[v * 4]), pattern);
+    }
+    uint8_t patterns[LINE_COUNT];
+    for (int line = 0; line < LINE_COUNT; line++) patterns[line] = static_cast<uint8_t>(lanes[line]);
+    return applyChainConstraint(frontierMask(occupied), patterns);
+}
+
+void chainScores(const uint8_t hexValues[NUM_HEXES], int& p1Score, int& p2Score) {
+    alignas(16) uint8_t values[32] = {};
+    for (int i = 0; i < NUM_HEXES; i++) values[i] = hexValues[i];
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i lo = _mm_max_epu8(_mm_load_si128(reinterpret_cast<const __m128i*>(values)), one);  // Empty hex counts as 1
+    const __m128i hi = _mm_max_epu8(_mm_load_si128(reinterpret_cast<const __m128i*>(values + 16)), one);
+
+    __m128i product[4];
+    for (int j = 0; j < 4; j++) product[j] = _mm_set1_epi32(1);
+    for (int k = 0; k < LINE_MAX; k++) {
+        __m128i bytes = _mm_or_si128(
+            _mm_shuffle_epi8(lo, _mm_load_si128(reinterpret_cast<const __m128i*>(SCORE_SHUFFLES.lo[k]))),
+            _mm_shuffle_epi8(hi, _mm_load_si128(reinterpret_cast<const __m128i*>(SCORE_SHUFFLES.hi[k]))));
+        product[0] = _mm_mullo_epi32(product[0], _mm_cvtepu8_epi32(bytes));
+        product[1] = _mm_mullo_epi32(product[1], _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4)));
+        product[2] = _mm_mullo_epi32(product[2], _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+        product[3] = _mm_mullo_epi32(product[3], _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 12)));
+    }
+
+    alignas(16) int32_t lanes[16];
+    for (int j = 0; j < 4; j++) _mm_store_si128(reinterpret_cast<__m128i*>(&lanes[j * 4]), product[j]);
+    p1Score = lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4];
+    p2Score = lanes[8] + lanes[9] + lanes[10] + lanes[11] + lanes[12];
+}
+
+const char* simdName() {
+    return "sse4.1";
+}
+
+#else
+
+uint32_t frontierMask(uint32_t occupied) {
+    return scalar::frontierMask(occupied);
+}
+
+uint32_t legalHexMask(uint32_t occupied) {
+    return scalar::legalHexMask(occupied);
+}
+
+void chainScores(const uint8_t hexValues[NUM_HEXES], int& p1Score, int& p2Score) {
+    scalar::chainScores(hexValues, p1Score, p2Score);
+}
+
+const char* simdName() {
+    return "scalar";
+}
+
+#endif
+
+// ============================================================================
+// Rollout Helpers
+// ============================================================================
+
+int popCount(uint32_t mask) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt(mask));
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+int nthSetBit(uint32_t mask, int n) {
+    for (int i = 0; i < n; i++) {
+        mask &= mask - 1;
+    }
+    return countTrailingZeros(mask);
+}
+
+} // namespace kernels
+} // namespace hexuki
@@ -0,0 +1,187 @@
+#include "core/large_pages.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__EMSCRIPTEN__)
+#include <cstdlib>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace hexuki {
+
+const char* pageBackingName(PageBacking backing) {
+    switch (backing) {
+        case PageBacking::HUGETLB: return "hugetlb";
+        case PageBacking::TRANSPARENT_HUGE: return "transparent huge pages";
+        default: return "standard pages";
+    }
+}
+
+static std::mutex g_defaultsMutex;
+static LargePageConfig g_defaults;
+
+LargePageConfig largePageDefaults() {
+    std::lock_guard<std::mutex> lock(g_defaultsMutex);
+    return g_defaults;
+}
+
+void setLargePageDefaults(const LargePageConfig& config) {
+    std::lock_guard<std::mutex> lock(g_defaultsMutex);
+    g_defaults = config;
+}
+
+static double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ============================================================================
+// LargePageBuffer
+// ============================================================================
+
+LargePageBuffer::LargePageBuffer()
+    : base(nullptr)
+    , length(0)
+    , backing(PageBacking::STANDARD)
+    , allocMs(0.0)
+    , prefaultMs(0.0) {
+}
+
+LargePageBuffer::LargePageBuffer(size_t bytes, const LargePageConfig& config)
+    : LargePageBuffer() {
+    if (bytes == 0) {
+        return;
+    }
+    length = (bytes + LARGE_PAGE_SIZE - 1) / LARGE_PAGE_SIZE * LARGE_PAGE_SIZE;
+    auto start = std::chrono::steady_clock::now();
+
+#if defined(_WIN32)
+    if (config.enabled && config.allowHugetlb) {
+        // Needs the "Lock pages in memory" privilege; fails cleanly without it
+        SIZE_T largePage = GetLargePageMinimum();
+        if (largePage > 0 && length % largePage == 0) {
+            base = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (base) backing = PageBacking::HUGETLB;
+        }
+    }
+    if (!base) {
+        base = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        backing = PageBacking::STANDARD;
+    }
+    if (!base) {
+        throw std::bad_alloc();
+    }
+#elif defined(__EMSCRIPTEN__)
+    // Wasm linear memory has no page tables to speak of
+    base = std::calloc(1, length);
+    if (!base) {
+        throw std::bad_alloc();
+    }
+#else
+#ifdef MAP_HUGETLB
+    if (config.enabled && config.allowHugetlb) {
+        // Only succeeds if the administrator reserved pages (vm.nr_hugepages)
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            base = p;
+            backing = PageBacking::HUGETLB;
+        }
+    }
+#endif
+    if (!base) {
+        // Over-map by one large page and trim, so the region starts on a 2MB
+        // boundary and the kernel can back all of it with huge pages
+        size_t padded = length + (config.enabled ? LARGE_PAGE_SIZE : 0);
+        void* p = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        char* raw = static_cast<char*>(p);
+        char* aligned = raw;
+        if (config.enabled) {
+            uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+            aligned = raw + ((LARGE_PAGE_SIZE - addr % LARGE_PAGE_SIZE) % LARGE_PAGE_SIZE);
+            if (aligned > raw) munmap(raw, aligned - raw);
+            size_t tail = (raw + padded) - (aligned + length);
+            if (tail > 0) munmap(aligned + length, tail);
+        }
+        base = aligned;
+        backing = PageBacking::STANDARD;
+#ifdef MADV_HUGEPAGE
+        if (config.enabled && madvise(base, length, MADV_HUGEPAGE) == 0) {
+            backing = PageBacking::TRANSPARENT_HUGE;
+        }
+#endif
+    }
+#endif
+    allocMs = msSince(start);
+
+    if (config.prefault) {
+        // Write one byte per 4KB page: faults everything in now rather than
+        // during the search (anonymous memory is already zero)
+        auto prefaultStart = std::chrono::steady_clock::now();
+        volatile char* bytesPtr = static_cast<volatile char*>(base);
+        for (size_t offset = 0; offset < length; offset += 4096) {
+            bytesPtr[offset] = 0;
+        }
+        prefaultMs = msSince(prefaultStart);
+    }
+
+    if (config.verbose) {
+        std::cerr << "Allocated " << (length >> 20) << " MB (" << pageBackingName(backing) << ") in "
+                  << allocMs << " ms";
+        if (config.prefault) {
+            std::cerr << ", prefaulted in " << prefaultMs << " ms";
+        }
+        std::cerr << "\n";
+    }
+}
+
+LargePageBuffer::~LargePageBuffer() {
+    release();
+}
+
+LargePageBuffer::LargePageBuffer(LargePageBuffer&& other) noexcept
+    : base(other.base)
+    , length(other.length)
+    , backing(other.backing)
+    , allocMs(other.allocMs)
+    , prefaultMs(other.prefaultMs) {
+    other.base = nullptr;
+    other.length = 0;
+}
+
+LargePageBuffer& LargePageBuffer::operator=(LargePageBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        base = std::exchange(other.base, nullptr);
+        length = std::exchange(other.length, 0);
+        backing = other.backing;
+        allocMs = other.allocMs;
+        prefaultMs = other.prefaultMs;
+    }
+    return *this;
+}
+
+void LargePageBuffer::release() {
+    if (!base) {
+        return;
+    }
+#if defined(_WIN32)
+    VirtualFree(base, 0, MEM_RELEASE);
+#elif defined(__EMSCRIPTEN__)
+    std::free(base);
+#else
+    munmap(base, length);
+#endif
+    base = nullptr;
+}
+
+} // namespace hexuki
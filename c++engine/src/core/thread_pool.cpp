@@ -0,0 +1,279 @@
+#include "core/thread_pool.h"
+#include "core/trace.h"
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace hexuki {
+
+// Which pool (if any) the current thread works for, and its index there
+static thread_local const ThreadPool* t_pool = nullptr;
+static thread_local int t_workerIndex = -1;
+
+static void pinCurrentThread(int cpu) {
+#ifdef _WIN32
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (cpu % (8 * sizeof(DWORD_PTR))));
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;  // Pinning not supported on this platform
+#endif
+}
+
+// ============================================================================
+// ThreadPool
+// ============================================================================
+
+ThreadPool::ThreadPool(int numThreads, bool pinThreads)
+    : queuedTasks(0)
+    , stopping(false) {
+    if (numThreads == NO_WORKERS) {
+        numThreads = 0;
+    } else if (numThreads <= 0) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // WASM without pthreads: no workers. Submitted tasks stay queued until a
+    // TaskGroup waits on them, which runs them on the calling thread.
+    numThreads = 0;
+#elif defined(__EMSCRIPTEN_PTHREADS__)
+    // Workers come from the prestarted PTHREAD_POOL_SIZE web workers; a thread
+    // beyond those would only start after the main thread yields to the browser
+    numThreads = std::min(numThreads, HEXUKI_WASM_MAX_THREADS - 1);
+#endif
+
+    for (int i = 0; i < numThreads; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < numThreads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i, pinThreads);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    sleepCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::currentWorkerIndex() const {
+    return (t_pool == this) ? t_workerIndex : -1;
+}
+
+void ThreadPool::submit(Task task) {
+    int index = currentWorkerIndex();
+    WorkerQueue& queue = (index >= 0) ? *queues[index] : injectQueue;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    queuedTasks.fetch_add(1, std::memory_order_release);
+
+    // Lock/unlock pairs with the sleeper's predicate check: no lost wakeups
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    sleepCondition.notify_one();
+}
+
+bool ThreadPool::popTask(int index, Task& task) {
+    if (queuedTasks.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    // 1. Own deque, newest first
+    if (index >= 0) {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // 2. Externally submitted tasks
+    {
+        std::lock_guard<std::mutex> lock(injectQueue.mutex);
+        if (!injectQueue.tasks.empty()) {
+            task = std::move(injectQueue.tasks.front());
+            injectQueue.tasks.pop_front();
+            queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // 3. Steal the oldest task from another worker
+    int n = static_cast<int>(queues.size());
+    int start = (index >= 0) ? index + 1 : 0;
+    for (int k = 0; k < n; k++) {
+        int victim = (start + k) % n;
+        if (victim == index) continue;
+        WorkerQueue& other = *queues[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::tryRunOne() {
+    Task task;
+    if (!popTask(currentWorkerIndex(), task)) {
+        return false;
+    }
+    HEXUKI_TRACE_SCOPE("pool.task");
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(int index, bool pin) {
+    t_pool = this;
+    t_workerIndex = index;
+    HEXUKI_TRACE_THREAD_NAME("pool worker " + std::to_string(index));
+    if (pin) {
+        unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+        pinCurrentThread(static_cast<int>(index % cpus));
+    }
+
+    while (true) {
+        Task task;
+        if (popTask(index, task)) {
+            HEXUKI_TRACE_SCOPE("pool.task");
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this] {
+            return stopping.load() || queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping.load() && queuedTasks.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+// Global pool (created on first use)
+static std::mutex g_globalMutex;
+static std::unique_ptr<ThreadPool> g_globalPool;
+static int g_globalThreads = 0;
+static bool g_globalPin = false;
+
+ThreadPool& ThreadPool::global() {
+    std::lock_guard<std::mutex> lock(g_globalMutex);
+    if (!g_globalPool) {
+        g_globalPool = std::make_unique<ThreadPool>(g_globalThreads, g_globalPin);
+    }
+    return *g_globalPool;
+}
+
+bool ThreadPool::configureGlobal(int numThreads, bool pinThreads) {
+    std::lock_guard<std::mutex> lock(g_globalMutex);
+    if (g_globalPool) {
+        return false;
+    }
+    g_globalThreads = numThreads;
+    g_globalPin = pinThreads;
+    return true;
+}
+
+// ============================================================================
+// TaskGroup
+// ============================================================================
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+    : pool(pool)
+    , pendingTasks(0)
+    , cancelled(false) {
+}
+
+TaskGroup::~TaskGroup() {
+    wait(0);
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    pendingTasks.fetch_add(1, std::memory_order_relaxed);
+    pool.submit([this, task = std::move(task)]() {
+        if (!isCancelled()) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!firstError) firstError = std::current_exception();
+                // A failed task cancels the rest of the group
+                cancelled.store(true, std::memory_order_relaxed);
+            }
+        }
+        // Notify under the lock: once pending hits zero the waiter may destroy the group
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+        done.notify_all();
+    });
+}
+
+void TaskGroup::wait(size_t maxPending) {
+    while (pending() > maxPending) {
+        // Help instead of blocking: also guarantees progress for nested groups
+        if (pool.tryRunOne()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait_for(lock, std::chrono::milliseconds(1), [&] { return pending() <= maxPending; });
+    }
+    // The last task decrements under the lock; taking it here means that task
+    // has released the group before the caller can destroy it
+    std::lock_guard<std::mutex> lock(mutex);
+}
+
+void TaskGroup::wait() {
+    wait(0);
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = firstError;
+        firstError = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// ============================================================================
+// parallelFor
+// ============================================================================
+
+void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t)>& body,
+                 ThreadPool& pool) {
+    grain = std::max<size_t>(1, grain);
+    TaskGroup group(pool);
+    for (size_t chunk = begin; chunk < end; chunk += grain) {
+        size_t chunkEnd = std::min(end, chunk + grain);
+        group.run([&body, chunk, chunkEnd]() {
+            for (size_t i = chunk; i < chunkEnd; i++) {
+                body(i);
+            }
+        });
+    }
+    group.wait();
+}
+
+} // namespace hexuki
@@ -0,0 +1,245 @@
+#include "core/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hexuki {
+namespace trace {
+
+namespace detail {
+std::atomic<bool> enabled(false);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    const char* name;
+    const char* argName;  // Null: no argument
+    int64_t arg;
+    uint64_t startNs;
+    uint64_t durationNs;
+    bool instant;
+};
+
+// One thread's ring buffer. Only the owning thread writes; `written` counts
+// every event ever recorded, so slot = written & mask and the newest
+// min(written, capacity) events are the ones kept; older ones have been
+// overwritten and are reported as dropped_events.
+struct ThreadBuffer {
+    int tid = 0;
+    std::string name;
+    std::vector<Event> events;
+    uint64_t mask = 0;
+    std::atomic<uint64_t> written{0};
+    uint64_t clearedAt = 0;  // `written` at the last clear()
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;  // Kept after their thread exits
+    size_t capacity = size_t(1) << 16;
+    int nextTid = 1;
+    Clock::time_point epoch = Clock::now();
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        Registry& reg = registry();
+        auto buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        size_t capacity = 1;
+        while (capacity < reg.capacity) capacity <<= 1;
+        buffer->events.resize(capacity);
+        buffer->mask = capacity - 1;
+        buffer->tid = reg.nextTid++;
+        buffer->name = "thread " + std::to_string(buffer->tid);
+        reg.buffers.push_back(buffer);
+        t_buffer = buffer;
+    }
+    return *t_buffer;
+}
+
+void record(const char* name, const char* argName, int64_t arg, uint64_t startNs, uint64_t durationNs, bool instant) {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    Event& event = buffer.events[index & buffer.mask];
+    event.name = name;
+    event.argName = argName;
+    event.arg = arg;
+    event.startNs = startNs;
+    event.durationNs = durationNs;
+    event.instant = instant;
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+std::string jsonQuote(const std::string& s) {
+    std::string quoted = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            quoted += ' ';
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+// Microseconds with nanosecond precision, as the trace format expects
+void writeMicros(std::ostream& out, uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out << text;
+}
+
+// HEXUKI_TRACE_FILE: trace the whole run, write at exit
+std::string& exitPath() {
+    static std::string path;
+    return path;
+}
+
+void writeAtExit() {
+    stop();
+    if (!writeChromeJson(exitPath())) {
+        std::fprintf(stderr, "Cannot write trace: %s\n", exitPath().c_str());
+    }
+}
+
+struct EnvironmentStart {
+    EnvironmentStart() {
+        const char* path = std::getenv("HEXUKI_TRACE_FILE");
+        if (!path || !*path) return;
+        registry();  // Constructed first, destroyed after writeAtExit
+        exitPath() = path;
+        std::atexit(writeAtExit);
+        start();
+    }
+};
+
+#ifdef HEXUKI_TRACE
+const EnvironmentStart environmentStart;
+#endif
+
+} // namespace
+
+uint64_t now() {
+    // + 1: 0 means "not started" to complete()
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - registry().epoch).count()) + 1;
+}
+
+void start() {
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void stop() {
+    detail::enabled.store(false, std::memory_order_relaxed);
+}
+
+void setBufferCapacity(size_t events) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.capacity = std::max<size_t>(events, 16);
+}
+
+void setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+void complete(const char* name, uint64_t startNs, const char* argName, int64_t arg) {
+    if (startNs == 0 || !isEnabled()) return;
+    uint64_t end = now();
+    record(name, argName, arg, startNs, end > startNs ? end - startNs : 0, false);
+}
+
+void instant(const char* name, const char* argName, int64_t arg) {
+    if (!isEnabled()) return;
+    record(name, argName, arg, now(), 0, true);
+}
+
+size_t writeChromeJson(std::ostream& out) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    size_t count = 0;
+    uint64_t dropped = 0;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : reg.buffers) {
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":" << jsonQuote(buffer->name) << "}}";
+        first = false;
+
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = buffer->clearedAt;
+        if (written - begin > buffer->events.size()) {
+            dropped += written - begin - buffer->events.size();
+            begin = written - buffer->events.size();
+        }
+        for (uint64_t i = begin; i < written; i++) {
+            const Event& event = buffer->events[i & buffer->mask];
+            out << ",\n{\"name\":" << jsonQuote(event.name) << ",\"ph\":\"" << (event.instant ? "i" : "X")
+                << "\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":";
+            writeMicros(out, event.startNs);
+            if (event.instant) {
+                out << ",\"s\":\"t\"";
+            } else {
+                out << ",\"dur\":";
+                writeMicros(out, event.durationNs);
+            }
+            if (event.argName) out << ",\"args\":{" << jsonQuote(event.argName) << ":" << event.arg << "}";
+            out << "}";
+            count++;
+        }
+    }
+    out << "\n],\"otherData\":{\"dropped_events\":" << dropped << "}}\n";
+    return count;
+}
+
+bool writeChromeJson(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) return false;
+    writeChromeJson(file);
+    return static_cast<bool>(file);
+}
+
+void clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        buffer->clearedAt = buffer->written.load(std::memory_order_acquire);
+    }
+}
+
+uint64_t droppedEvents() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t dropped = 0;
+    for (const auto& buffer : reg.buffers) {
+        uint64_t recorded = buffer->written.load(std::memory_order_acquire) - buffer->clearedAt;
+        if (recorded > buffer->events.size()) dropped += recorded - buffer->events.size();
+    }
+    return dropped;
+}
+
+} // namespace trace
+} // namespace hexuki
@@ -0,0 +1,109 @@
+#include "io/columnar.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace hexuki {
+namespace io {
+
+size_t columnTypeSize(ColumnType type) {
+    switch (type) {
+        case ColumnType::U8:
+        case ColumnType::I8:
+            return 1;
+        case ColumnType::U32:
+        case ColumnType::I32:
+            return 4;
+    }
+    return 0;
+}
+
+const char* columnTypeName(ColumnType type) {
+    switch (type) {
+        case ColumnType::U8:  return "u1";
+        case ColumnType::I8:  return "i1";
+        case ColumnType::U32: return "<u4";
+        case ColumnType::I32: return "<i4";
+    }
+    return "";
+}
+
+// ============================================================================
+// ColumnBatch
+// ============================================================================
+
+ColumnBatch::ColumnBatch(const std::vector<ColumnSpec>& schema)
+    : schema(schema)
+    , data(schema.size()) {
+}
+
+size_t ColumnBatch::numRows() const {
+    if (schema.empty()) return 0;
+    return data[0].size() / columnTypeSize(schema[0].type);
+}
+
+void ColumnBatch::clear() {
+    for (auto& column : data) {
+        column.clear();
+    }
+}
+
+// ============================================================================
+// ColumnarWriter
+// ============================================================================
+
+ColumnarWriter::ColumnarWriter(const std::string& dir, const std::vector<ColumnSpec>& schema)
+    : dir(dir)
+    , schema(schema)
+    , rows(0) {
+    fs::create_directories(dir);
+    for (const auto& column : schema) {
+        std::string path = (fs::path(dir) / (column.name + ".bin")).string();
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            for (std::FILE* opened : files) std::fclose(opened);
+            files.clear();
+            throw std::runtime_error("Cannot create column file: " + path);
+        }
+        files.push_back(file);
+    }
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    close();
+}
+
+void ColumnarWriter::write(const ColumnBatch& batch) {
+    if (batch.numColumns() != schema.size()) {
+        throw std::invalid_argument("Column batch does not match writer schema");
+    }
+    for (size_t c = 0; c < files.size(); c++) {
+        const auto& bytes = batch.columnData(c);
+        if (!bytes.empty() && std::fwrite(bytes.data(), 1, bytes.size(), files[c]) != bytes.size()) {
+            throw std::runtime_error("Column write failed: " + schema[c].name);
+        }
+    }
+    rows += batch.numRows();
+}
+
+void ColumnarWriter::close() {
+    if (files.empty()) return;
+
+    for (std::FILE* file : files) {
+        std::fclose(file);
+    }
+    files.clear();
+
+    std::ofstream json(fs::path(dir) / "schema.json");
+    json << "{\n  \"rows\": " << rows << ",\n  \"columns\": [\n";
+    for (size_t c = 0; c < schema.size(); c++) {
+        json << "    {\"name\": \"" << schema[c].name << "\", \"dtype\": \"" << columnTypeName(schema[c].type)
+             << "\", \"file\": \"" << schema[c].name << ".bin\"}" << (c + 1 < schema.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+}
+
+} // namespace io
+} // namespace hexuki
@@ -0,0 +1,289 @@
+#include "io/game_archive.h"
+#include "core/bitboard.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace hexuki {
+namespace io {
+
+// ============================================================================
+// Record Packing
+// ============================================================================
+
+uint8_t ArchiveRecord::packMove(const Move& move) {
+    for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+        if (TILE_VALUES[i] == move.tileValue && move.hexId >= 0 && move.hexId < NUM_HEXES) {
+            return static_cast<uint8_t>(move.hexId * NUM_TILES_PER_PLAYER + i);
+        }
+    }
+    throw std::invalid_argument("Move cannot be archived: " + move.toString());
+}
+
+Move ArchiveRecord::unpackMove(uint8_t code) {
+    if (code >= ARCHIVE_MOVE_CODES) return Move();
+    return Move(code / NUM_TILES_PER_PLAYER, TILE_VALUES[code % NUM_TILES_PER_PLAYER]);
+}
+
+std::vector<Move> ArchiveRecord::getMoves() const {
+    int count = std::min<int>(numMoves, ARCHIVE_MAX_MOVES);
+    std::vector<Move> result;
+    result.reserve(count);
+    for (int i = 0; i < count; i++) {
+        result.push_back(getMove(i));
+    }
+    return result;
+}
+
+bool ArchiveRecord::isValid() const {
+    if (numMoves > ARCHIVE_MAX_MOVES) return false;
+    for (int i = 0; i < numMoves; i++) {
+        if (moves[i] >= ARCHIVE_MOVE_CODES) return false;
+    }
+    return true;
+}
+
+ArchiveRecord ArchiveRecord::fromGame(const std::vector<Move>& moves, GameSource source, uint8_t flags) {
+    if (moves.size() > static_cast<size_t>(ARCHIVE_MAX_MOVES)) {
+        throw std::invalid_argument("Game too long to archive: " + std::to_string(moves.size()) + " moves");
+    }
+
+    ArchiveRecord record;
+    std::memset(&record, 0, sizeof(record));
+    std::memset(record.moves, ARCHIVE_NO_MOVE, sizeof(record.moves));
+
+    HexukiBitboard board;
+    for (size_t i = 0; i < moves.size(); i++) {
+        if (!board.isValidMove(moves[i])) {
+            throw std::invalid_argument("Illegal move in game: " + moves[i].toString() +
+                                        " at ply " + std::to_string(i));
+        }
+        board.makeMove(moves[i]);
+        record.moves[i] = packMove(moves[i]);
+    }
+
+    record.numMoves = static_cast<uint8_t>(moves.size());
+    record.p1Score = board.getScore(PLAYER_1);
+    record.p2Score = board.getScore(PLAYER_2);
+    record.result = (record.p1Score > record.p2Score) ? 1 : (record.p1Score < record.p2Score) ? -1 : 0;
+    record.source = source;
+    record.flags = flags;
+    return record;
+}
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+static ArchiveSegmentHeader makeHeader() {
+    ArchiveSegmentHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+    header.version = ARCHIVE_VERSION;
+    header.recordSize = sizeof(ArchiveRecord);
+    return header;
+}
+
+static bool headerValid(const ArchiveSegmentHeader& header) {
+    return std::memcmp(header.magic, ARCHIVE_MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == ARCHIVE_VERSION &&
+           header.recordSize == sizeof(ArchiveRecord);
+}
+
+ArchiveWriter::ArchiveWriter(const std::string& archiveDir, const std::string& writerName)
+    : path((fs::path(archiveDir) / (writerName + ARCHIVE_SEGMENT_EXT)).string())
+    , file(nullptr)
+    , count(0) {
+    fs::create_directories(archiveDir);
+
+    std::error_code ec;
+    uint64_t existingSize = fs::exists(path, ec) ? fs::file_size(path, ec) : 0;
+
+    if (existingSize == 0) {
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("Cannot create archive segment: " + path);
+        }
+        ArchiveSegmentHeader header = makeHeader();
+        if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            std::fclose(file);
+            throw std::runtime_error("Cannot write archive segment header: " + path);
+        }
+        return;
+    }
+
+    // Existing segment: validate, drop any torn trailing record, then append
+    ArchiveSegmentHeader header;
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    bool ok = in && std::fread(&header, sizeof(header), 1, in) == 1 && headerValid(header);
+    if (in) std::fclose(in);
+    if (!ok) {
+        throw std::runtime_error("Not an archive segment (or wrong version): " + path);
+    }
+
+    count = (existingSize - sizeof(ArchiveSegmentHeader)) / sizeof(ArchiveRecord);
+    uint64_t wholeSize = sizeof(ArchiveSegmentHeader) + count * sizeof(ArchiveRecord);
+    if (wholeSize != existingSize) {
+        fs::resize_file(path, wholeSize);
+    }
+
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        throw std::runtime_error("Cannot open archive segment for append: " + path);
+    }
+}
+
+ArchiveWriter::~ArchiveWriter() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+void ArchiveWriter::append(const ArchiveRecord& record) {
+    if (std::fwrite(&record, sizeof(record), 1, file) != 1) {
+        throw std::runtime_error("Archive write failed: " + path);
+    }
+    count++;
+}
+
+void ArchiveWriter::flush() {
+    std::fflush(file);
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+GameArchive::GameArchive(const std::string& archiveDir)
+    : totalRecords(0) {
+    if (!fs::is_directory(archiveDir)) {
+        throw std::runtime_error("Archive directory not found: " + archiveDir);
+    }
+
+    std::vector<std::string> paths;
+    for (const auto& entry : fs::directory_iterator(archiveDir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ARCHIVE_SEGMENT_EXT) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());  // Stable global ids
+
+    for (const auto& segmentPath : paths) {
+        MappedFile mapped(segmentPath);
+        if (mapped.size() < sizeof(ArchiveSegmentHeader)) {
+            continue;  // Writer has created the file but not the header yet
+        }
+
+        ArchiveSegmentHeader header;
+        std::memcpy(&header, mapped.data(), sizeof(header));
+        if (!headerValid(header)) {
+            throw std::runtime_error("Not an archive segment (or wrong version): " + segmentPath);
+        }
+
+        Segment segment;
+        segment.path = segmentPath;
+        segment.records = reinterpret_cast<const ArchiveRecord*>(mapped.data() + sizeof(ArchiveSegmentHeader));
+        segment.count = (mapped.size() - sizeof(ArchiveSegmentHeader)) / sizeof(ArchiveRecord);  // Ignores torn tail
+        segment.firstId = totalRecords;
+        totalRecords += segment.count;
+
+        segments.push_back(segment);
+        files.push_back(std::move(mapped));  // Moving keeps the mapping address
+    }
+}
+
+const ArchiveRecord& GameArchive::operator[](uint64_t id) const {
+    if (id >= totalRecords) {
+        throw std::out_of_range("Archive record id out of range: " + std::to_string(id));
+    }
+    // Last segment whose firstId <= id
+    auto it = std::upper_bound(segments.begin(), segments.end(), id,
+                               [](uint64_t value, const Segment& s) { return value < s.firstId; });
+    --it;
+    return it->records[id - it->firstId];
+}
+
+// ============================================================================
+// Index
+// ============================================================================
+
+uint64_t ArchiveIndex::makeKey(const ArchiveRecord& record) {
+    // Byte i (from the top) = packed move i + 1, 0 = no move
+    uint64_t key = 0;
+    for (int i = 0; i < PREFIX_MOVES; i++) {
+        uint64_t byte = (i < record.numMoves) ? static_cast<uint64_t>(record.moves[i]) + 1 : 0;
+        key |= byte << (56 - 8 * i);
+    }
+    return key;
+}
+
+bool ArchiveIndex::prefixRange(const std::vector<Move>& prefix, uint64_t& lo, uint64_t& hi) {
+    if (prefix.size() > static_cast<size_t>(PREFIX_MOVES)) {
+        throw std::invalid_argument("Index prefix longer than " + std::to_string(PREFIX_MOVES) + " moves");
+    }
+
+    lo = 0;
+    for (size_t i = 0; i < prefix.size(); i++) {
+        uint8_t code;
+        try {
+            code = ArchiveRecord::packMove(prefix[i]);
+        } catch (const std::invalid_argument&) {
+            return false;  // Unarchivable move: no game can match
+        }
+        lo |= (static_cast<uint64_t>(code) + 1) << (56 - 8 * i);
+    }
+    uint64_t freeBits = 64 - 8 * prefix.size();
+    hi = lo | (freeBits == 64 ? ~0ull : ((1ull << freeBits) - 1));
+    return true;
+}
+
+ArchiveIndex::ArchiveIndex(const GameArchive& archive) {
+    for (const auto& segment : archive.getSegments()) {
+        for (uint64_t i = 0; i < segment.count; i++) {
+            const ArchiveRecord& record = segment.records[i];
+            int slot = std::clamp(static_cast<int>(record.result), -1, 1) + 1;
+            byResult[slot].push_back(Entry{makeKey(record), segment.firstId + i});
+        }
+    }
+    for (auto& entries : byResult) {
+        std::sort(entries.begin(), entries.end());
+    }
+}
+
+std::vector<uint64_t> ArchiveIndex::find(const std::vector<Move>& prefix, int result) const {
+    std::vector<uint64_t> ids;
+    uint64_t lo, hi;
+    if (!prefixRange(prefix, lo, hi)) return ids;
+
+    for (int r = -1; r <= 1; r++) {
+        if (result != ANY_RESULT && result != r) continue;
+        const auto& entries = byResult[r + 1];
+        auto first = std::lower_bound(entries.begin(), entries.end(), Entry{lo, 0});
+        for (auto it = first; it != entries.end() && it->key <= hi; ++it) {
+            ids.push_back(it->id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+uint64_t ArchiveIndex::count(const std::vector<Move>& prefix, int result) const {
+    uint64_t lo, hi;
+    if (!prefixRange(prefix, lo, hi)) return 0;
+
+    uint64_t total = 0;
+    for (int r = -1; r <= 1; r++) {
+        if (result != ANY_RESULT && result != r) continue;
+        const auto& entries = byResult[r + 1];
+        auto first = std::lower_bound(entries.begin(), entries.end(), Entry{lo, 0});
+        auto last = std::upper_bound(entries.begin(), entries.end(), Entry{hi, ~0ull});
+        total += static_cast<uint64_t>(last - first);
+    }
+    return total;
+}
+
+} // namespace io
+} // namespace hexuki
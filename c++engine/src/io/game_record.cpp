@@ -0,0 +1,123 @@
+#include "io/game_record.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace hexuki {
+namespace io {
+
+// Parse a run of digits starting at pos; returns -1 if there are none
+static int parseNumber(const std::string& s, size_t& pos) {
+    if (pos >= s.size() || !std::isdigit(static_cast<unsigned char>(s[pos]))) return -1;
+    int value = 0;
+    while (pos < s.size() && std::isdigit(static_cast<unsigned char>(s[pos]))) {
+        value = value * 10 + (s[pos] - '0');
+        pos++;
+    }
+    return value;
+}
+
+// Extract every move token ("h6t5" or "t5h6") from a string, in order
+static void parseMoves(const std::string& s, std::vector<Move>& moves) {
+    size_t pos = 0;
+    while (pos < s.size()) {
+        char c = s[pos];
+        bool tokenStart = (c == 'h' || c == 't') &&
+                          (pos == 0 || !std::isalnum(static_cast<unsigned char>(s[pos - 1])));
+        if (!tokenStart) {
+            pos++;
+            continue;
+        }
+
+        size_t p = pos + 1;
+        int first = parseNumber(s, p);
+        char other = (c == 'h') ? 't' : 'h';
+        if (first < 0 || p >= s.size() || s[p] != other) {
+            pos++;
+            continue;
+        }
+        p++;
+        int second = parseNumber(s, p);
+        if (second < 0) {
+            pos++;
+            continue;
+        }
+
+        // "h6t5" = hex 6 tile 5, "t5h6" = tile 5 hex 6
+        Move move = (c == 'h') ? Move(first, second) : Move(second, first);
+        if (move.isValid()) {
+            moves.push_back(move);
+        }
+        pos = p;
+    }
+}
+
+bool parseGameRecord(const std::string& line, GameRecord& record) {
+    record.startPosition.clear();
+    record.moves.clear();
+
+    size_t first = line.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos || line[first] == '#') {
+        return false;
+    }
+
+    // Position strings always contain a '|' section separator
+    if (line.find('|') != std::string::npos) {
+        size_t split = line.find(';');
+        std::string position = line.substr(first, split == std::string::npos ? std::string::npos : split - first);
+        size_t last = position.find_last_not_of(" \t\r\n");
+        record.startPosition = position.substr(0, last + 1);
+        if (split != std::string::npos) {
+            parseMoves(line.substr(split + 1), record.moves);
+        }
+        return true;
+    }
+
+    parseMoves(line, record.moves);
+    return !record.moves.empty();
+}
+
+bool GameRecordReader::next(GameRecord& record) {
+    std::string line;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (parseGameRecord(line, record)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uintmax_t truncatePartialLine(const std::string& path) {
+    // Search backwards from the end in blocks: outputs can be large, and
+    // usually only the last few bytes matter
+    constexpr std::streamoff BLOCK = 4096;
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return 0;
+    const std::streamoff size = in.tellg();
+
+    std::streamoff keep = 0;
+    char buffer[BLOCK];
+    for (std::streamoff end = size; end > 0 && keep == 0;) {
+        std::streamoff start = std::max<std::streamoff>(0, end - BLOCK);
+        in.seekg(start);
+        in.read(buffer, end - start);
+        for (std::streamoff i = end - start; i > 0; i--) {
+            if (buffer[i - 1] == '\n') {
+                keep = start + i;
+                break;
+            }
+        }
+        end = start;
+    }
+
+    if (keep < size) {
+        in.close();
+        std::filesystem::resize_file(path, static_cast<std::uintmax_t>(keep));
+    }
+    return static_cast<std::uintmax_t>(keep);
+}
+
+} // namespace io
+} // namespace hexuki
@@ -0,0 +1,106 @@
+#include "io/mapped_file.h"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hexuki {
+namespace io {
+
+MappedFile::MappedFile(const std::string& path)
+    : mappedData(nullptr)
+    , mappedSize(0) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+
+    if (mappedSize > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            mappedData = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);  // View keeps the mapping alive
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    mappedSize = static_cast<size_t>(st.st_size);
+
+    if (mappedSize > 0) {
+        void* addr = ::mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            mappedData = static_cast<const unsigned char*>(addr);
+            // Archives are mostly scanned front to back
+            ::madvise(addr, mappedSize, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(fd);  // Mapping stays valid after close
+#endif
+
+    if (mappedSize > 0 && !mappedData) {
+        mappedSize = 0;
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mappedData(other.mappedData)
+    , mappedSize(other.mappedSize) {
+    other.mappedData = nullptr;
+    other.mappedSize = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        mappedData = std::exchange(other.mappedData, nullptr);
+        mappedSize = std::exchange(other.mappedSize, 0);
+    }
+    return *this;
+}
+
+void MappedFile::unmap() {
+    if (mappedData) {
+#ifdef _WIN32
+        UnmapViewOfFile(mappedData);
+#else
+        ::munmap(const_cast<unsigned char*>(mappedData), mappedSize);
+#endif
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
+}
+
+} // namespace io
+} // namespace hexuki
@@ -1,82 +1,146 @@
+#include <chrono>
+#include <csignal>
+#include <cstring>
 #include <iostream>
-#include "core/bitboard.h"
-#include "core/move.h"
-#include "core/zobrist.h"
+#include <string>
+#include <thread>
+#include "api/analysis_server.h"
+#include "api/engine_bench.h"
+#include "api/protocol.h"
+#include "core/thread_pool.h"
 
 using namespace hexuki;
 
-int main() {
-    std::cout << "===========================================\n";
-    std::cout << "HEXUKI C++ ENGINE - Phase 1 Test Program\n";
-    std::cout << "===========================================\n\n";
+static volatile std::sig_atomic_t stopSignal = 0;
 
-    // Initialize Zobrist hashing
-    Zobrist::initialize();
-    std::cout << "✓ Zobrist hashing initialized\n\n";
-
-    // Create a game
-    HexukiBitboard game;
-    std::cout << "✓ Game created\n\n";
+static void onStopSignal(int) {
+    stopSignal = 1;
+}
 
-    // Print initial state
-    std::cout << "Initial board state:\n";
-    game.print();
-    std::cout << "\n";
+static void printUsage() {
+    std::cout << "Usage: hexuki_engine\n"
+              << "  Reads engine commands on stdin, answers on stdout (UCI style):\n"
+              << "    uci | isready | ucinewgame | quit\n"
+              << "    setoption name <Hash|Threads|Engine|Seed> value <v>\n"
+              << "    position startpos|fen <savePosition> [moves h6t5 ...]\n"
+              << "    go [depth N] [nodes N] [sims N] [movetime MS] [infinite]\n"
+              << "    stop | d\n"
+              << "\n"
+              << "Usage: hexuki_engine serve [--socket PATH | --port N] [--threads N] [--hash MB]\n"
+              << "                           [--max-batch N] [--deadline MS]\n"
+              << "  Local analysis server (see include/api/analysis_server.h):\n"
+              << "    --socket PATH   Unix domain socket (default: 127.0.0.1, --port)\n"
+              << "    --port N        Localhost TCP port (default 0 = any free port)\n"
+              << "    --threads N     Worker threads in the shared pool (default: all cores)\n"
+              << "    --hash MB       Minimax table shared by all requests (default 256)\n"
+              << "    --max-batch N   moves/eval requests per batch (default 64)\n"
+              << "    --deadline MS   Default request deadline (default 10000)\n"
+              << "\n"
+              << "Usage: hexuki_engine bench [--depth N] [--sims N] [--seed N] [--hash MB]\n"
+              << "  Fixed minimax and MCTS searches; prints total nodes, the node-count\n"
+              << "  signature (unchanged = search-neutral change) and nodes per second\n"
+              << "    --depth N       Minimax depth (default 5)\n"
+              << "    --sims N        MCTS simulations per position (default 5000, 0 = none)\n"
+              << "    --seed N        MCTS seed (default 1)\n"
+              << "    --hash MB       Minimax table, cleared per position (default 16)\n";
+}
 
-    // Test: Get valid moves
-    auto moves = game.getValidMoves();
-    std::cout << "Valid first moves: " << moves.size() << " total\n";
-    std::cout << "First 10: ";
-    for (size_t i = 0; i < std::min(size_t(10), moves.size()); i++) {
-        std::cout << moves[i].toString();
-        if (i < 9 && i < moves.size() - 1) std::cout << ", ";
+static int serve(int argc, char** argv) {
+    api::ServerConfig config;
+    int threads = 0;
+    try {
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--socket" && hasValue) {
+                config.socketPath = argv[++i];
+            } else if (arg == "--port" && hasValue) {
+                config.port = std::stoi(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                threads = std::stoi(argv[++i]);
+            } else if (arg == "--hash" && hasValue) {
+                config.hashMB = std::stoul(argv[++i]);
+            } else if (arg == "--max-batch" && hasValue) {
+                config.maxBatch = std::stoi(argv[++i]);
+            } else if (arg == "--deadline" && hasValue) {
+                config.defaultDeadlineMs = std::stoi(argv[++i]);
+            } else {
+                printUsage();
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage();
+        return 1;
     }
-    std::cout << "...\n\n";
+    ThreadPool::configureGlobal(threads);
 
-    // Play a few moves using tile values from TILE_VALUES array
-    std::cout << "Playing opening sequence using tiles: "
-              << TILE_VALUES[4] << ", " << TILE_VALUES[3] << ", " << TILE_VALUES[0] << "\n\n";
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
 
-    Move m1(6, TILE_VALUES[4]);  // Hex 6, middle tile
-    if (game.isValidMove(m1)) {
-        game.makeMove(m1);
-        std::cout << "Move 1: " << m1.toString() << " (P1)\n";
-        game.print();
-        std::cout << "\n";
+    api::AnalysisServer server(config);
+    try {
+        server.start();
+    } catch (const std::exception& e) {
+        std::cerr << "Cannot start server: " << e.what() << "\n";
+        return 1;
     }
+    std::cout << "listening " << server.getEndpoint() << std::endl;
 
-    Move m2(7, TILE_VALUES[3]);  // Hex 7, 4th tile
-    if (game.isValidMove(m2)) {
-        game.makeMove(m2);
-        std::cout << "Move 2: " << m2.toString() << " (P2)\n";
-        game.print();
-        std::cout << "\n";
+    while (!stopSignal) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
+    server.stop();
+    return 0;
+}
 
-    Move m3(2, TILE_VALUES[0]);  // Hex 2, first tile
-    if (game.isValidMove(m3)) {
-        game.makeMove(m3);
-        std::cout << "Move 3: " << m3.toString() << " (P1)\n";
-        game.print();
-        std::cout << "\n";
+static int bench(int argc, char** argv) {
+    api::BenchConfig config;
+    try {
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--depth" && hasValue) {
+                config.depth = std::stoi(argv[++i]);
+            } else if (arg == "--sims" && hasValue) {
+                config.sims = std::stoi(argv[++i]);
+            } else if (arg == "--seed" && hasValue) {
+                config.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--hash" && hasValue) {
+                config.hashMB = std::stoul(argv[++i]);
+            } else {
+                printUsage();
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage();
+        return 1;
     }
 
-    // Test unmake
-    std::cout << "Testing unmake...\n";
-    game.unmakeMove();
-    std::cout << "After unmake (should be back to move 2):\n";
-    game.print();
-    std::cout << "\n";
+    api::BenchReport report = api::runBench(config, &std::cout);
+    api::printBenchReport(report, config, std::cout);
+    return 0;
+}
 
-    // Final stats
-    std::cout << "===========================================\n";
-    std::cout << "PHASE 1 TESTS COMPLETE\n";
-    std::cout << "✓ Bitboard structure working\n";
-    std::cout << "✓ Move generation working\n";
-    std::cout << "✓ Move make/unmake working\n";
-    std::cout << "✓ Scoring calculation working\n";
-    std::cout << "✓ Zobrist hashing working\n";
-    std::cout << "===========================================\n";
+int main(int argc, char** argv) {
+    if (argc > 1 && (std::strcmp(argv[1], "--help") == 0 || std::strcmp(argv[1], "-h") == 0)) {
+        printUsage();
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "serve") == 0) {
+        return serve(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "bench") == 0) {
+        return bench(argc, argv);
+    }
+    if (argc > 1) {
+        std::cerr << "Unknown argument: " << argv[1] << "\n";
+        printUsage();
+        return 1;
+    }
 
+    api::ProtocolEngine engine(std::cout);
+    engine.run(std::cin);
     return 0;
 }
@@ -0,0 +1,238 @@
+#include "tools/archive_stats.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+namespace hexuki {
+namespace tools {
+
+// Packed prefix keys hold one byte per move
+constexpr int MAX_PREFIX_DEPTH = 8;
+
+static int keyLength(uint64_t key) {
+    int length = 0;
+    while (length < MAX_PREFIX_DEPTH && ((key >> (56 - 8 * length)) & 0xFF) != 0) {
+        length++;
+    }
+    return length;
+}
+
+static std::string movesToString(const std::vector<Move>& moves) {
+    std::string s;
+    for (size_t i = 0; i < moves.size(); i++) {
+        if (i > 0) s += ' ';
+        s += moves[i].toString();
+    }
+    return s;
+}
+
+// ============================================================================
+// ArchiveStats
+// ============================================================================
+
+ArchiveStats::ArchiveStats(const StatsConfig& config)
+    : config(config) {
+    this->config.prefixDepth = std::clamp(config.prefixDepth, 0, MAX_PREFIX_DEPTH);
+    this->config.scoreBucket = std::max(1, config.scoreBucket);
+    std::memset(moveCounts, 0, sizeof(moveCounts));
+}
+
+uint64_t ArchiveStats::prefixKey(const io::ArchiveRecord& record, int length) {
+    // Same layout as ArchiveIndex: byte i from the top = packed move i + 1
+    uint64_t key = 0;
+    for (int i = 0; i < length; i++) {
+        key |= (static_cast<uint64_t>(record.moves[i]) + 1) << (56 - 8 * i);
+    }
+    return key;
+}
+
+std::vector<Move> ArchiveStats::keyToMoves(uint64_t key) {
+    std::vector<Move> moves;
+    for (int i = 0; i < keyLength(key); i++) {
+        moves.push_back(io::ArchiveRecord::unpackMove(static_cast<uint8_t>(((key >> (56 - 8 * i)) & 0xFF) - 1)));
+    }
+    return moves;
+}
+
+int ArchiveStats::bucketOf(int score) const {
+    // Floor division so negative margins bucket consistently
+    int bucket = score / config.scoreBucket;
+    if (score < 0 && score % config.scoreBucket != 0) bucket--;
+    return bucket * config.scoreBucket;
+}
+
+void ArchiveStats::add(const io::ArchiveRecord& record) {
+    totals.add(record.result);
+
+    int numMoves = std::min<int>(record.numMoves, io::ARCHIVE_MAX_MOVES);
+    int depth = std::min(config.prefixDepth, numMoves);
+    for (int length = 1; length <= depth; length++) {
+        prefixes[prefixKey(record, length)].add(record.result);
+    }
+
+    // FNV-1a over the move sequence identifies distinct games
+    uint64_t gameHash = 1469598103934665603ull;
+    for (int ply = 0; ply < numMoves; ply++) {
+        uint8_t code = record.moves[ply];
+        if (code < NUM_MOVE_CODES) {
+            moveCounts[ply][code]++;
+        }
+        gameHash = (gameHash ^ code) * 1099511628211ull;
+    }
+    distinctGames.insert(gameHash);
+
+    p1Scores[bucketOf(record.p1Score)]++;
+    p2Scores[bucketOf(record.p2Score)]++;
+    margins[bucketOf(record.p1Score - record.p2Score)]++;
+}
+
+void ArchiveStats::merge(const ArchiveStats& other) {
+    totals.merge(other.totals);
+    for (const auto& entry : other.prefixes) {
+        prefixes[entry.first].merge(entry.second);
+    }
+    for (int ply = 0; ply < io::ARCHIVE_MAX_MOVES; ply++) {
+        for (int code = 0; code < NUM_MOVE_CODES; code++) {
+            moveCounts[ply][code] += other.moveCounts[ply][code];
+        }
+    }
+    for (const auto& entry : other.p1Scores) p1Scores[entry.first] += entry.second;
+    for (const auto& entry : other.p2Scores) p2Scores[entry.first] += entry.second;
+    for (const auto& entry : other.margins) margins[entry.first] += entry.second;
+    distinctGames.insert(other.distinctGames.begin(), other.distinctGames.end());
+}
+
+uint64_t ArchiveStats::getDistinctPrefixes(int length) const {
+    uint64_t count = 0;
+    for (const auto& entry : prefixes) {
+        if (keyLength(entry.first) == length) count++;
+    }
+    return count;
+}
+
+double ArchiveStats::getPrefixEntropy(int length) const {
+    uint64_t total = 0;
+    for (const auto& entry : prefixes) {
+        if (keyLength(entry.first) == length) total += entry.second.games();
+    }
+    if (total == 0) return 0.0;
+
+    double entropy = 0.0;
+    for (const auto& entry : prefixes) {
+        if (keyLength(entry.first) != length) continue;
+        double p = static_cast<double>(entry.second.games()) / total;
+        entropy -= p * std::log2(p);
+    }
+    return entropy;
+}
+
+// ============================================================================
+// CSV Reports
+// ============================================================================
+
+void ArchiveStats::writePrefixCsv(std::ostream& out) const {
+    // Deterministic order: shorter prefixes first, then most played
+    std::vector<std::pair<uint64_t, ResultCounts>> rows(prefixes.begin(), prefixes.end());
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        int la = keyLength(a.first), lb = keyLength(b.first);
+        if (la != lb) return la < lb;
+        if (a.second.games() != b.second.games()) return a.second.games() > b.second.games();
+        return a.first < b.first;
+    });
+
+    out << "prefix,length,games,p1_wins,draws,p2_wins,p1_win_rate\n";
+    for (const auto& row : rows) {
+        const ResultCounts& c = row.second;
+        double winRate = (c.p1Wins + 0.5 * c.draws) / static_cast<double>(c.games());
+        out << movesToString(keyToMoves(row.first)) << ',' << keyLength(row.first) << ','
+            << c.games() << ',' << c.p1Wins << ',' << c.draws << ',' << c.p2Wins << ','
+            << winRate << '\n';
+    }
+}
+
+void ArchiveStats::writeMoveCsv(std::ostream& out) const {
+    out << "ply,move,count,share\n";
+    for (int ply = 0; ply < io::ARCHIVE_MAX_MOVES; ply++) {
+        uint64_t plyTotal = 0;
+        for (int code = 0; code < NUM_MOVE_CODES; code++) plyTotal += moveCounts[ply][code];
+        for (int code = 0; code < NUM_MOVE_CODES; code++) {
+            uint64_t count = moveCounts[ply][code];
+            if (count == 0) continue;
+            out << (ply + 1) << ',' << io::ArchiveRecord::unpackMove(static_cast<uint8_t>(code)).toString()
+                << ',' << count << ',' << (static_cast<double>(count) / plyTotal) << '\n';
+        }
+    }
+}
+
+void ArchiveStats::writeScoreCsv(std::ostream& out) const {
+    out << "kind,bucket,count\n";
+    auto writeHistogram = [&](const char* kind, const std::unordered_map<int, uint64_t>& histogram) {
+        std::map<int, uint64_t> sorted(histogram.begin(), histogram.end());
+        for (const auto& entry : sorted) {
+            out << kind << ',' << entry.first << ',' << entry.second << '\n';
+        }
+    };
+    writeHistogram("p1_score", p1Scores);
+    writeHistogram("p2_score", p2Scores);
+    writeHistogram("margin", margins);
+}
+
+void ArchiveStats::writeSummaryCsv(std::ostream& out) const {
+    out << "metric,value\n";
+    out << "games," << totals.games() << '\n';
+    out << "p1_wins," << totals.p1Wins << '\n';
+    out << "draws," << totals.draws << '\n';
+    out << "p2_wins," << totals.p2Wins << '\n';
+    out << "distinct_games," << getDistinctGames() << '\n';
+    for (int length = 1; length <= config.prefixDepth; length++) {
+        out << "distinct_prefixes_" << length << ',' << getDistinctPrefixes(length) << '\n';
+        out << "prefix_entropy_bits_" << length << ',' << getPrefixEntropy(length) << '\n';
+    }
+}
+
+// ============================================================================
+// Parallel Scan
+// ============================================================================
+
+ArchiveStats aggregateArchive(const io::GameArchive& archive, const StatsConfig& config, ThreadPool& pool) {
+    struct Chunk {
+        const io::ArchiveRecord* records;
+        uint64_t count;
+    };
+
+    std::vector<Chunk> chunks;
+    uint64_t chunkSize = std::max<uint64_t>(1, config.chunkRecords);
+    for (const auto& segment : archive.getSegments()) {
+        for (uint64_t begin = 0; begin < segment.count; begin += chunkSize) {
+            chunks.push_back(Chunk{segment.records + begin, std::min(chunkSize, segment.count - begin)});
+        }
+    }
+
+    // One partial aggregate per task; tasks claim chunks dynamically
+    int numTasks = std::max(1, std::min<int>(pool.size() + 1, static_cast<int>(chunks.size())));
+    std::vector<ArchiveStats> partials(numTasks, ArchiveStats(config));
+    std::atomic<size_t> nextChunk(0);
+
+    TaskGroup group(pool);
+    for (int t = 0; t < numTasks; t++) {
+        group.run([&, t]() {
+            ArchiveStats& stats = partials[t];
+            for (size_t c = nextChunk++; c < chunks.size(); c = nextChunk++) {
+                for (uint64_t i = 0; i < chunks[c].count; i++) {
+                    stats.add(chunks[c].records[i]);
+                }
+            }
+        });
+    }
+    group.wait();
+
+    for (int t = 1; t < numTasks; t++) {
+        partials[0].merge(partials[t]);
+    }
+    return std::move(partials[0]);
+}
+
+} // namespace tools
+} // namespace hexuki
@@ -0,0 +1,495 @@
+#include "tools/batch_analysis.h"
+#include "tools/labeller.h"
+#include "api/batch_ops.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace hexuki {
+namespace tools {
+
+constexpr int NO_TIME_LIMIT = std::numeric_limits<int>::max();
+
+// Nodes per SearchTask::step() call; the task checks its clock inside
+static constexpr int MINIMAX_STEP_NODES = 1 << 16;
+
+static std::string trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r\n");
+    return s.substr(begin, end - begin + 1);
+}
+
+static std::string moveText(const Move& move) {
+    return move.isValid() ? move.toString() : "none";
+}
+
+// ============================================================================
+// Input
+// ============================================================================
+
+PositionReader::PositionReader(std::istream& in, PositionFormat format)
+    : in(in)
+    , format(format) {
+}
+
+PositionFormat PositionReader::formatForPath(const std::string& path) {
+    auto endsWith = [&path](const std::string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".json") || endsWith(".jsonl")) return PositionFormat::JSON;
+    if (endsWith(".bin") || endsWith(".pos")) return PositionFormat::PACKED;
+    return PositionFormat::TEXT;
+}
+
+bool PositionReader::next(PositionRecord& record) {
+    record.board = HexukiBitboard();
+    record.error.clear();
+
+    if (format == PositionFormat::TEXT) {
+        std::string line;
+        while (std::getline(in, line)) {
+            line = trim(line);
+            if (line.empty() || line[0] == '#') continue;
+            record.index = nextIndex++;
+            try {
+                // savePosition() always writes the turn; loadPosition() trusts its input
+                if (line != "startpos" && line.find("|turn:") == std::string::npos) {
+                    throw std::invalid_argument("not a savePosition string");
+                }
+                if (line != "startpos" && !api::isValidPositionString(line)) {
+                    throw std::invalid_argument("malformed position");
+                }
+                if (line != "startpos") record.board.loadPosition(line);
+            } catch (const std::exception& e) {
+                record.error = e.what();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    if (format == PositionFormat::PACKED) {
+        int32_t fields[api::POSITION_STRIDE];
+        in.read(reinterpret_cast<char*>(fields), sizeof(fields));
+        if (in.gcount() == 0) return false;
+        record.index = nextIndex++;
+        if (in.gcount() != static_cast<std::streamsize>(sizeof(fields))) {
+            record.error = "truncated position record";
+        } else if (!api::isValidPositionRecord(fields)) {
+            record.error = "malformed position record";
+        } else {
+            record.board = api::unpackPosition(fields);
+        }
+        return true;
+    }
+
+    loadObjects();
+    if (nextObject >= objects.size()) return false;
+    record.index = nextIndex++;
+    try {
+        record.board = parseLevel(objects[nextObject]);
+    } catch (const std::exception& e) {
+        record.error = e.what();
+    }
+    nextObject++;
+    return true;
+}
+
+// Splits the input into its top-level {...} objects; array brackets and
+// commas between them are ignored, so one level, an array of levels and
+// one level per line all read the same way
+void PositionReader::loadObjects() {
+    if (objectsLoaded) return;
+    objectsLoaded = true;
+
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    int depth = 0;
+    bool inString = false;
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (inString) {
+            if (c == '\\') {
+                i++;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{') {
+            if (depth++ == 0) start = i;
+        } else if (c == '}' && depth > 0) {
+            if (--depth == 0) objects.push_back(text.substr(start, i - start + 1));
+        }
+    }
+}
+
+// Raw value of a top-level "key" in a flat JSON object ("" if absent)
+static std::string levelField(const std::string& json, const std::string& key) {
+    size_t at = json.find("\"" + key + "\"");
+    if (at == std::string::npos) return "";
+    at = json.find(':', at + key.size() + 2);
+    if (at == std::string::npos) return "";
+    size_t begin = json.find_first_not_of(" \t\r\n", at + 1);
+    if (begin == std::string::npos) return "";
+
+    size_t end;
+    if (json[begin] == '"') {
+        end = begin + 1;
+        while (end < json.size() && json[end] != '"') end += json[end] == '\\' ? 2 : 1;
+        end++;
+    } else if (json[begin] == '[') {
+        end = json.find(']', begin) + 1;
+    } else {
+        end = json.find_first_of(",}", begin);
+    }
+    return trim(json.substr(begin, end - begin));
+}
+
+// [1, null, 3] -> {1, 0, 3}
+static std::vector<int> levelNumbers(const std::string& array) {
+    std::vector<int> values;
+    std::string inner = array.size() >= 2 ? array.substr(1, array.size() - 2) : "";
+    std::istringstream iss(inner);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        item = trim(item);
+        if (item.empty()) continue;
+        values.push_back(item == "null" ? 0 : std::stoi(item));
+    }
+    return values;
+}
+
+HexukiBitboard parseLevel(const std::string& json) {
+    std::string board = levelField(json, "board");
+    std::string p1 = levelField(json, "p1Tiles");
+    std::string p2 = levelField(json, "p2Tiles");
+
+    std::string position;
+    if (!board.empty() && !p1.empty() && !p2.empty()) {
+        std::vector<int> hexes = levelNumbers(board);
+        if (hexes.size() != static_cast<size_t>(NUM_HEXES)) {
+            throw std::invalid_argument("level board needs " + std::to_string(NUM_HEXES) + " entries");
+        }
+        std::ostringstream oss;
+        bool first = true;
+        for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+            if (hexes[hexId] == 0) continue;
+            oss << (first ? "" : ",") << "h" << hexId << ":" << hexes[hexId];
+            first = false;
+        }
+        const std::vector<int> tiles[2] = {levelNumbers(p1), levelNumbers(p2)};
+        for (int p = 0; p < 2; p++) {
+            oss << "|p" << (p + 1) << ":";
+            for (size_t i = 0; i < tiles[p].size(); i++) oss << (i > 0 ? "," : "") << tiles[p][i];
+        }
+        std::string player = levelField(json, "startingPlayer");
+        oss << "|turn:" << (player.empty() ? "1" : player);
+        position = oss.str();
+    } else {
+        position = levelField(json, "position");
+        if (position.size() < 2) throw std::invalid_argument("level has no board or position");
+        position = position.substr(1, position.size() - 2);
+    }
+
+    if (!api::isValidPositionString(position)) throw std::invalid_argument("malformed level position");
+    HexukiBitboard result;
+    result.loadPosition(position);
+    return result;
+}
+
+// ============================================================================
+// Analysis
+// ============================================================================
+
+PositionAnalysis analyzePosition(const PositionRecord& record, const AnalysisConfig& config,
+                                 minimax::TranspositionTable* tt, mcts::MCTS* engine) {
+    if ((config.engine == AnalysisEngine::MCTS && !engine) || (config.engine != AnalysisEngine::MCTS && !tt)) {
+        throw std::invalid_argument("analyzePosition: no table/engine for the configured engine");
+    }
+    PositionAnalysis analysis;
+    analysis.index = record.index;
+    if (!record.error.empty()) {
+        analysis.error = record.error;
+        return analysis;
+    }
+    analysis.position = record.board.savePosition();
+    auto startTime = std::chrono::steady_clock::now();
+    HexukiBitboard board = record.board;
+
+    if (config.engine == AnalysisEngine::SOLVE) {
+        PositionLabel label = solveExact(board, *tt);
+        analysis.score = label.value;
+        analysis.nodes = label.nodes;
+        analysis.bestMoves = label.bestMoves;
+        if (!label.bestMoves.empty()) analysis.bestMove = label.bestMoves[0];
+    } else if (config.engine == AnalysisEngine::MINIMAX) {
+        minimax::SearchConfig searchConfig;
+        searchConfig.maxDepth = config.depth;
+        searchConfig.timeLimitMs = config.movetimeMs > 0 ? config.movetimeMs : NO_TIME_LIMIT;
+        minimax::SearchTask task(board, searchConfig, tt);
+        while (!task.step(MINIMAX_STEP_NODES)) {
+        }
+        const minimax::SearchResult& result = task.getResult();
+        analysis.bestMove = result.bestMove;
+        analysis.score = result.score;
+        analysis.depth = result.depth;
+        analysis.nodes = result.nodesSearched;
+    } else if (!board.getValidMoves().empty()) {
+        mcts::MCTSConfig mctsConfig;
+        mctsConfig.numSimulations = config.movetimeMs > 0 ? std::numeric_limits<int>::max() : config.sims;
+        mctsConfig.useTimeLimit = config.movetimeMs > 0;
+        mctsConfig.timeLimitMs = config.movetimeMs;
+        mctsConfig.seed = config.seed == 0 ? 0 : config.seed + static_cast<uint32_t>(record.index);
+        mcts::MCTSResult result = engine->findBestMove(board, mctsConfig);
+        analysis.bestMove = result.bestMove;
+        analysis.winRate = result.winRate;
+        analysis.visits = result.visits;
+        analysis.sims = result.simulations;
+    }
+
+    analysis.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return analysis;
+}
+
+// ============================================================================
+// Output Format
+// ============================================================================
+
+static std::string jsonQuote(const std::string& s) {
+    std::string quoted = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+    return quoted + "\"";
+}
+
+static std::string csvQuote(const std::string& s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string quoted = "\"";
+    for (char c : s) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+std::string csvHeader(const AnalysisConfig& config) {
+    switch (config.engine) {
+        case AnalysisEngine::MINIMAX: return "index,position,bestmove,score,depth,nodes,time_ms,error";
+        case AnalysisEngine::MCTS:    return "index,position,bestmove,winrate,visits,sims,time_ms,error";
+        case AnalysisEngine::SOLVE:   return "index,position,bestmove,score,best_moves,nodes,time_ms,error";
+    }
+    return "";
+}
+
+std::string formatAnalysis(const PositionAnalysis& analysis, const AnalysisConfig& config) {
+    std::string bestMoves;
+    for (size_t i = 0; i < analysis.bestMoves.size(); i++) {
+        bestMoves += (i > 0 ? " " : "") + analysis.bestMoves[i].toString();
+    }
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3);
+
+    if (config.output == OutputFormat::CSV) {
+        line << analysis.index << "," << csvQuote(analysis.position) << ",";
+        if (analysis.error.empty()) {
+            line << moveText(analysis.bestMove) << ",";
+            switch (config.engine) {
+                case AnalysisEngine::MINIMAX:
+                    line << analysis.score << "," << analysis.depth << "," << analysis.nodes;
+                    break;
+                case AnalysisEngine::MCTS:
+                    line << analysis.winRate << "," << analysis.visits << "," << analysis.sims;
+                    break;
+                case AnalysisEngine::SOLVE:
+                    line << analysis.score << "," << bestMoves << "," << analysis.nodes;
+                    break;
+            }
+            line << "," << analysis.timeMs << ",";
+        } else {
+            line << ",,,,," << csvQuote(analysis.error);
+        }
+        return line.str();
+    }
+
+    line << "{\"index\":" << analysis.index;
+    if (!analysis.error.empty()) {
+        line << ",\"error\":" << jsonQuote(analysis.error) << "}";
+        return line.str();
+    }
+    line << ",\"position\":" << jsonQuote(analysis.position) << ",\"bestmove\":\"" << moveText(analysis.bestMove)
+         << "\"";
+    switch (config.engine) {
+        case AnalysisEngine::MINIMAX:
+            line << ",\"score\":" << analysis.score << ",\"depth\":" << analysis.depth << ",\"nodes\":"
+                 << analysis.nodes;
+            break;
+        case AnalysisEngine::MCTS:
+            line << ",\"winrate\":" << analysis.winRate << ",\"visits\":" << analysis.visits << ",\"sims\":"
+                 << analysis.sims;
+            break;
+        case AnalysisEngine::SOLVE:
+            line << ",\"score\":" << analysis.score << ",\"best_moves\":\"" << bestMoves << "\",\"nodes\":"
+                 << analysis.nodes;
+            break;
+    }
+    line << ",\"time_ms\":" << analysis.timeMs << "}";
+    return line.str();
+}
+
+bool parseAnalysisIndex(const std::string& line, size_t& index) {
+    // A truncated final line (interrupted run) is treated as not written
+    std::string text = trim(line);
+    bool json = text.compare(0, 9, "{\"index\":") == 0;
+    if (json ? text.back() != '}' : text.find(',') == std::string::npos) return false;
+
+    size_t begin = json ? 9 : 0;
+    size_t end = text.find_first_not_of("0123456789", begin);
+    if (end == begin || end == std::string::npos || text[end] != ',') return false;
+    index = std::stoull(text.substr(begin, end - begin));
+    return true;
+}
+
+// ============================================================================
+// BatchAnalyzer
+// ============================================================================
+
+BatchAnalyzer::BatchAnalyzer(const AnalysisConfig& config, ThreadPool& pool)
+    : config(config)
+    , pool(pool) {
+}
+
+size_t BatchAnalyzer::loadExisting(std::istream& output) {
+    size_t loaded = 0;
+    std::string line;
+    size_t index;
+    while (std::getline(output, line)) {
+        if (parseAnalysisIndex(line, index) && done.insert(index).second) {
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+AnalysisStats BatchAnalyzer::run(PositionReader& reader, std::ostream& out, bool writeHeader) {
+    AnalysisStats stats;
+    auto startTime = std::chrono::steady_clock::now();
+
+    // MCTS needs no table; minimax and solve share one
+    minimax::TableLease table;
+    if (config.engine != AnalysisEngine::MCTS) {
+        table = minimax::TablePool::global().acquire(config.ttSizeMB);
+    }
+
+    // One MCTS engine (tree memory) per thread that can run tasks: the pool
+    // workers, plus this thread while it waits in the task group
+    std::vector<std::unique_ptr<mcts::MCTS>> engines(static_cast<size_t>(pool.size()) + 1);
+
+    TaskGroup group(pool);
+    const size_t maxQueued = static_cast<size_t>(pool.size() + 1) * 64;
+
+    std::mutex outMutex;
+    std::map<size_t, std::string> held;  // Ordered: finished or skipped, waiting for earlier records
+    size_t nextToWrite = 0;
+    std::atomic<size_t> analyzed(0);
+    std::atomic<size_t> errors(0);
+    std::atomic<uint64_t> nodes(0);
+    std::atomic<uint64_t> sims(0);
+    auto lastFlush = startTime;
+
+    auto report = [&](bool final) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        size_t count = analyzed.load();
+        std::cerr << (final ? "Done: " : "Progress: ") << count << " analyzed"
+                  << " | " << (seconds > 0 ? static_cast<int>(count / seconds) : 0) << " positions/s";
+        if (config.engine == AnalysisEngine::MCTS) {
+            std::cerr << " | " << (seconds > 0 ? static_cast<long long>(sims.load() / seconds) : 0) << " sims/s";
+        } else {
+            std::cerr << " | " << (seconds > 0 ? static_cast<long long>(nodes.load() / seconds) : 0) << " nodes/s";
+        }
+        std::cerr << std::endl;
+    };
+
+    // Under outMutex. Skipped records hold an empty line.
+    auto emit = [&](size_t index, const std::string& line) {
+        if (!config.ordered) {
+            if (!line.empty()) out << line << '\n';
+        } else {
+            held[index] = line;
+            while (!held.empty() && held.begin()->first == nextToWrite) {
+                if (!held.begin()->second.empty()) out << held.begin()->second << '\n';
+                held.erase(held.begin());
+                nextToWrite++;
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastFlush).count()
+                >= config.progressIntervalMs) {
+            lastFlush = now;
+            out.flush();  // Checkpoint: everything written so far survives an interruption
+            if (config.verbose) report(false);
+        }
+    };
+
+    auto analyze = [&](const PositionRecord& record) {
+        std::unique_ptr<mcts::MCTS>& engine = engines[pool.currentWorkerIndex() + 1];
+        if (!engine && config.engine == AnalysisEngine::MCTS) engine = std::make_unique<mcts::MCTS>();
+        PositionAnalysis analysis = analyzePosition(record, config, table.get(), engine.get());
+        std::string line = formatAnalysis(analysis, config);
+
+        analyzed++;
+        if (!analysis.error.empty()) errors++;
+        nodes += analysis.nodes;
+        sims += analysis.sims;
+
+        std::lock_guard<std::mutex> lock(outMutex);
+        emit(record.index, line);
+    };
+
+    if (writeHeader && config.output == OutputFormat::CSV) {
+        out << csvHeader(config) << '\n';
+    }
+
+    PositionRecord record;
+    while (reader.next(record)) {
+        stats.read++;
+        if (done.count(record.index)) {
+            stats.skipped++;
+            std::lock_guard<std::mutex> lock(outMutex);
+            emit(record.index, "");
+            continue;
+        }
+        group.run([&analyze, record]() { analyze(record); });
+        group.wait(maxQueued);
+    }
+
+    group.wait();
+    out.flush();
+
+    stats.analyzed = analyzed.load();
+    stats.errors = errors.load();
+    stats.nodes = nodes.load();
+    stats.sims = sims.load();
+    stats.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (config.verbose) {
+        report(true);
+    }
+    return stats;
+}
+
+} // namespace tools
+} // namespace hexuki
@@ -0,0 +1,229 @@
+#include "tools/feature_extractor.h"
+#include "utils/timer.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace hexuki {
+namespace tools {
+
+// ============================================================================
+// Schema
+// ============================================================================
+
+static std::vector<io::ColumnSpec> buildSchema() {
+    using io::ColumnType;
+    std::vector<io::ColumnSpec> schema = {
+        {"game", ColumnType::U32},
+        {"ply", ColumnType::U8},
+        {"player", ColumnType::U8},
+        {"hex", ColumnType::U8},
+        {"tile", ColumnType::U8},
+        {"result", ColumnType::I8},
+        {"final_margin", ColumnType::I32},
+    };
+    for (int i = 0; i < P1_CHAIN_COUNT; i++) {
+        schema.push_back({"p1_chain" + std::to_string(i) + "_filled", ColumnType::U8});
+        schema.push_back({"p1_chain" + std::to_string(i) + "_product", ColumnType::I32});
+    }
+    for (int i = 0; i < P2_CHAIN_COUNT; i++) {
+        schema.push_back({"p2_chain" + std::to_string(i) + "_filled", ColumnType::U8});
+        schema.push_back({"p2_chain" + std::to_string(i) + "_product", ColumnType::I32});
+    }
+    schema.push_back({"empty", ColumnType::U8});
+    schema.push_back({"frontier", ColumnType::U8});
+    schema.push_back({"legal_hexes", ColumnType::U8});
+    schema.push_back({"legal_moves", ColumnType::U8});
+    for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+        schema.push_back({"p1_tile" + std::to_string(TILE_VALUES[i]), ColumnType::U8});
+    }
+    for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+        schema.push_back({"p2_tile" + std::to_string(TILE_VALUES[i]), ColumnType::U8});
+    }
+    schema.push_back({"p1_score", ColumnType::I32});
+    schema.push_back({"p2_score", ColumnType::I32});
+    schema.push_back({"p1_delta", ColumnType::I32});
+    schema.push_back({"p2_delta", ColumnType::I32});
+    return schema;
+}
+
+const std::vector<io::ColumnSpec>& featureSchema() {
+    static const std::vector<io::ColumnSpec> schema = buildSchema();
+    return schema;
+}
+
+// ============================================================================
+// Per-Game Extraction
+// ============================================================================
+
+static void addChainFeatures(const HexukiBitboard& board, const int chains[][5], const int* lengths,
+                             int chainCount, io::ColumnBatch& batch, size_t& column) {
+    for (int c = 0; c < chainCount; c++) {
+        int filled = 0;
+        int product = 1;
+        for (int i = 0; i < lengths[c]; i++) {
+            int value = board.getTileValue(chains[c][i]);
+            if (value > 0) {
+                filled++;
+                product *= value;
+            }
+        }
+        batch.set(column++, filled);
+        batch.set(column++, product);
+    }
+}
+
+// Every move of the record is legal when replayed from board (board is restored)
+static bool isReplayable(HexukiBitboard& board, const io::ArchiveRecord& record) {
+    if (!record.isValid()) return false;
+
+    int played = 0;
+    bool legal = true;
+    for (; played < record.numMoves; played++) {
+        Move move = record.getMove(played);
+        if (!board.isValidMove(move)) {
+            legal = false;
+            break;
+        }
+        board.makeMove(move);
+    }
+    for (int ply = played - 1; ply >= 0; ply--) {
+        board.unmakeMove(record.getMove(ply));
+    }
+    return legal;
+}
+
+bool extractGameFeatures(HexukiBitboard& board, const io::ArchiveRecord& record, uint32_t gameId,
+                         io::ColumnBatch& batch) {
+    if (!isReplayable(board, record)) return false;
+
+    int numMoves = record.numMoves;
+    std::vector<Move> played;
+    played.reserve(numMoves);
+
+    for (int ply = 0; ply < numMoves; ply++) {
+        Move move = record.getMove(ply);
+        int player = board.getCurrentPlayer();
+        size_t column = 0;
+
+        batch.set(column++, gameId);
+        batch.set(column++, ply);
+        batch.set(column++, player);
+        batch.set(column++, move.hexId);
+        batch.set(column++, move.tileValue);
+        batch.set(column++, record.result);
+        batch.set(column++, record.p1Score - record.p2Score);
+
+        addChainFeatures(board, P1_CHAINS, P1_CHAIN_LENGTHS, P1_CHAIN_COUNT, batch, column);
+        addChainFeatures(board, P2_CHAINS, P2_CHAIN_LENGTHS, P2_CHAIN_COUNT, batch, column);
+
+        // Empty hexes, and those touching the occupied area
+        int empty = 0;
+        int frontier = 0;
+        for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+            if (board.isHexOccupied(hexId)) continue;
+            empty++;
+            const AdjacentList& adj = ADJACENT_HEXES[hexId];
+            for (int i = 0; i < adj.count; i++) {
+                if (board.isHexOccupied(adj.hexes[i])) {
+                    frontier++;
+                    break;
+                }
+            }
+        }
+
+        // Legal hexes after the chain-length rule
+        auto moves = board.getValidMoves();
+        uint32_t legalHexMask = 0;
+        for (const auto& m : moves) {
+            legalHexMask |= (1u << m.hexId);
+        }
+
+        batch.set(column++, empty);
+        batch.set(column++, frontier);
+        batch.set(column++, BitOps::popcount(legalHexMask));
+        batch.set(column++, moves.size());
+
+        for (int p = PLAYER_1; p <= PLAYER_2; p++) {
+            auto tiles = board.getAvailableTiles(p);
+            for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+                batch.set(column++, std::count(tiles.begin(), tiles.end(), TILE_VALUES[i]));
+            }
+        }
+
+        int p1Before = board.getScore(PLAYER_1);
+        int p2Before = board.getScore(PLAYER_2);
+        board.makeMove(move);
+        played.push_back(move);
+
+        batch.set(column++, p1Before);
+        batch.set(column++, p2Before);
+        batch.set(column++, board.getScore(PLAYER_1) - p1Before);
+        batch.set(column++, board.getScore(PLAYER_2) - p2Before);
+    }
+
+    // Restore the initial position for the next game
+    for (auto it = played.rbegin(); it != played.rend(); ++it) {
+        board.unmakeMove(*it);
+    }
+    return true;
+}
+
+// ============================================================================
+// Parallel Extraction
+// ============================================================================
+
+uint64_t extractArchiveFeatures(const io::GameArchive& archive, const std::string& outDir,
+                                const FeatureConfig& config, ThreadPool& pool, uint64_t* skippedGames) {
+    uint64_t chunkGames = std::max<uint64_t>(1, config.chunkGames);
+    uint64_t numChunks = (archive.size() + chunkGames - 1) / chunkGames;
+
+    int numTasks = std::max(1, std::min<int>(pool.size() + 1, static_cast<int>(numChunks)));
+
+    io::ColumnarWriter writer(outDir, featureSchema());
+
+    // Chunks are extracted in any order but written strictly in archive order.
+    // Claims are handed out in order, so the chunk being waited for is always
+    // held by a running task and blocking here cannot deadlock the pool.
+    std::atomic<uint64_t> nextChunk(0);
+    std::atomic<uint64_t> skipped(0);
+    uint64_t nextToWrite = 0;
+    std::mutex writeMutex;
+    std::condition_variable writeTurn;
+
+    auto worker = [&]() {
+        HexukiBitboard board;
+        io::ColumnBatch batch(featureSchema());
+
+        for (uint64_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+            batch.clear();
+            uint64_t begin = chunk * chunkGames;
+            uint64_t end = std::min(begin + chunkGames, archive.size());
+            for (uint64_t id = begin; id < end; id++) {
+                if (!extractGameFeatures(board, archive[id], static_cast<uint32_t>(id), batch)) {
+                    skipped++;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(writeMutex);
+            writeTurn.wait(lock, [&] { return nextToWrite == chunk; });
+            writer.write(batch);
+            nextToWrite++;
+            writeTurn.notify_all();
+        }
+    };
+
+    TaskGroup group(pool);
+    for (int t = 0; t < numTasks; t++) {
+        group.run(worker);
+    }
+    group.wait();
+
+    writer.close();
+    if (skippedGames) *skippedGames = skipped;
+    return writer.getRows();
+}
+
+} // namespace tools
+} // namespace hexuki
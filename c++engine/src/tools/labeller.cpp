@@ -0,0 +1,244 @@
+#include "tools/labeller.h"
+#include "io/game_record.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+namespace hexuki {
+namespace tools {
+
+constexpr int INF = 1000000;
+constexpr int NO_TIME_LIMIT = std::numeric_limits<int>::max();
+
+static int countEmpty(const HexukiBitboard& board) {
+    int empty = 0;
+    for (int i = 0; i < NUM_HEXES; i++) {
+        if (!board.isHexOccupied(i)) empty++;
+    }
+    return empty;
+}
+
+// ============================================================================
+// Exact Solver
+// ============================================================================
+
+PositionLabel solveExact(HexukiBitboard& board, minimax::TranspositionTable& tt) {
+    PositionLabel label;
+    label.hash = board.getHash();
+    label.position = board.savePosition();
+
+    std::vector<Move> moves = board.getValidMoves();
+    if (moves.empty()) {
+        label.value = minimax::evaluate(board);
+        return label;
+    }
+
+    // Remaining empty hexes bound the game length, so this depth reaches the end
+    int depth = countEmpty(board);
+    auto startTime = std::chrono::steady_clock::now();
+    minimax::KillerMoves killers;
+    minimax::HistoryTable history;
+    minimax::orderMoves(moves, nullptr, killers, history, 0);
+
+    int bestScore = -INF;
+    for (const auto& move : moves) {
+        // Fail-soft: a score above alpha is exact, so alpha = best - 1 keeps ties exact
+        int alpha = (bestScore == -INF) ? -INF : bestScore - 1;
+
+        board.makeMove(move);
+        int score = -minimax::alphaBeta(board, depth - 1, -INF, -alpha, tt, label.nodes,
+                                        startTime, NO_TIME_LIMIT, killers, history, 1);
+        board.unmakeMove(move);
+
+        if (score > bestScore) {
+            bestScore = score;
+            label.bestMoves.clear();
+            label.bestMoves.push_back(move);
+        } else if (score == bestScore) {
+            label.bestMoves.push_back(move);
+        }
+    }
+
+    label.value = bestScore;
+    return label;
+}
+
+// ============================================================================
+// Label File Format
+// ============================================================================
+
+std::string formatLabel(const PositionLabel& label) {
+    char hashHex[17];
+    std::snprintf(hashHex, sizeof(hashHex), "%016llx", static_cast<unsigned long long>(label.hash));
+
+    std::string line = hashHex;
+    line += '\t';
+    line += label.position;
+    line += '\t';
+    line += std::to_string(label.value);
+    line += '\t';
+    for (size_t i = 0; i < label.bestMoves.size(); i++) {
+        if (i > 0) line += ' ';
+        line += label.bestMoves[i].toString();
+    }
+    line += '\t';
+    line += std::to_string(label.nodes);
+    return line;
+}
+
+bool parseLabel(const std::string& line, PositionLabel& label) {
+    std::vector<std::string> fields;
+    std::istringstream iss(line);
+    std::string field;
+    while (std::getline(iss, field, '\t')) {
+        fields.push_back(field);
+    }
+    // A truncated final line (interrupted run) has fewer fields; treat it as unlabelled
+    if (fields.size() != 5 || fields[0].size() != 16) {
+        return false;
+    }
+
+    try {
+        label.hash = std::stoull(fields[0], nullptr, 16);
+        label.position = fields[1];
+        label.value = std::stoi(fields[2]);
+        label.nodes = std::stoi(fields[4]);
+        label.bestMoves.clear();
+        std::istringstream moveStream(fields[3]);
+        std::string moveStr;
+        while (moveStream >> moveStr) {
+            label.bestMoves.push_back(Move::fromString(moveStr));
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Labeller
+// ============================================================================
+
+Labeller::Labeller(const LabelConfig& config, ThreadPool& pool)
+    : config(config)
+    , pool(pool) {
+}
+
+size_t Labeller::loadExisting(std::istream& labels) {
+    size_t loaded = 0;
+    std::string line;
+    PositionLabel label;
+    while (std::getline(labels, line)) {
+        if (parseLabel(line, label) && seen.insert(label.hash).second) {
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+LabelStats Labeller::run(std::istream& games, std::ostream& out) {
+    LabelStats stats;
+    auto startTime = std::chrono::steady_clock::now();
+
+    minimax::TranspositionTable tt(config.ttSizeMB);
+
+    // Bounded in-flight work: the reader helps solve when solvers fall behind
+    TaskGroup group(pool);
+    const size_t maxQueued = static_cast<size_t>(pool.size() + 1) * 64;
+
+    std::mutex outMutex;
+    std::atomic<size_t> labelled(0);
+    std::atomic<uint64_t> nodes(0);
+    std::atomic<size_t> positionsSeen(0);
+    std::atomic<size_t> duplicates(0);
+    auto lastReport = startTime;
+
+    auto report = [&](bool final) {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - startTime).count();
+        size_t done = labelled.load();
+        std::cerr << (final ? "Done: " : "Progress: ") << done << " labelled"
+                  << " | " << positionsSeen.load() << " seen, " << duplicates.load() << " duplicate"
+                  << " | " << (seconds > 0 ? static_cast<int>(done / seconds) : 0) << " labels/s"
+                  << " | " << (seconds > 0 ? static_cast<long long>(nodes.load() / seconds) : 0) << " nodes/s"
+                  << std::endl;
+    };
+
+    auto solve = [&](HexukiBitboard& board) {
+        PositionLabel label = solveExact(board, tt);
+        std::string line = formatLabel(label);
+
+        std::lock_guard<std::mutex> lock(outMutex);
+        out << line << '\n';
+        labelled++;
+        nodes += label.nodes;
+
+        if (config.verbose) {
+            auto now = std::chrono::steady_clock::now();
+            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastReport).count()
+                    >= config.progressIntervalMs) {
+                lastReport = now;
+                out.flush();  // Keep the file resumable at report granularity
+                report(false);
+            }
+        }
+    };
+
+    // Reader: replay each game, queue every new in-range position
+    io::GameRecordReader reader(games);
+    io::GameRecord record;
+    while (reader.next(record)) {
+        stats.gamesRead++;
+
+        HexukiBitboard board;
+        if (!record.startPosition.empty()) {
+            board.loadPosition(record.startPosition);
+        }
+
+        for (size_t ply = 0; ply <= record.moves.size(); ply++) {
+            int empty = countEmpty(board);
+            if (empty >= config.minEmpty && empty <= config.maxEmpty && !board.isGameOver()) {
+                positionsSeen++;
+                if (!seen.insert(board.getHash()).second) {
+                    duplicates++;
+                } else {
+                    group.run([&solve, board]() mutable { solve(board); });
+                    group.wait(maxQueued);
+                }
+            }
+
+            if (ply == record.moves.size()) break;
+            const Move& move = record.moves[ply];
+            if (!board.isValidMove(move)) {
+                if (config.verbose) {
+                    std::cerr << "Line " << reader.getLineNumber() << ": illegal move "
+                              << move.toString() << " at ply " << ply << ", rest of game skipped\n";
+                }
+                break;
+            }
+            board.makeMove(move);
+        }
+    }
+
+    group.wait();
+    out.flush();
+
+    stats.positionsSeen = positionsSeen.load();
+    stats.duplicates = duplicates.load();
+    stats.labelled = labelled.load();
+    stats.nodes = nodes.load();
+    stats.timeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+
+    if (config.verbose) {
+        report(true);
+    }
+    return stats;
+}
+
+} // namespace tools
+} // namespace hexuki
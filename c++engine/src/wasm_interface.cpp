@@ -3,15 +3,25 @@
  *
  * This file provides C-style functions that can be called from JavaScript
  * Emscripten will compile these to WebAssembly and generate JS bindings
+ *
+ * Every game lives in an api::EngineInstance addressed by an integer handle
+ * (wasmEngine* functions), so a page can run several boards and engines side
+ * by side. The original single-game functions (wasmMakeMove etc.) operate on
+ * a default instance created by wasmInitialize and are kept for existing pages.
  */
 
 #include "core/bitboard.h"
-#include "core/zobrist.h"
 #include "core/move.h"
 #include "ai/mcts.h"
 #include "ai/minimax.h"
+#include "api/engine_instance.h"
+#include "api/batch_ops.h"
+#include "api/result_layout.h"
+#include "core/board_kernels.h"
+#include "core/thread_pool.h"
 #include <emscripten/emscripten.h>
 #include <emscripten/bind.h>
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -19,208 +29,589 @@ using namespace hexuki;
 using namespace emscripten;
 
 // ============================================================================
-// Global State (one game instance for simplicity)
+// Instance State
 // ============================================================================
 
-static HexukiBitboard* g_board = nullptr;
-static mcts::MCTS* g_mcts = nullptr;
-static bool g_initialized = false;
-static Move g_lastMove(-1, 0);  // Track last move for unmake
+static api::InstanceRegistry g_instances;
+static api::InstanceHandle g_defaultHandle = api::INVALID_HANDLE;  // Used by the legacy functions
+
+static const char* NOT_INITIALIZED = "{\"error\":\"Not initialized\"}";
 
 // ============================================================================
-// Initialization
+// JSON Results
 // ============================================================================
 
-EMSCRIPTEN_KEEPALIVE
-extern "C" void wasmInitialize() {
-    if (!g_initialized) {
-        Zobrist::initialize();
-        g_board = new HexukiBitboard();
-        g_mcts = new mcts::MCTS();
-        g_initialized = true;
+static std::string validMovesJson(const HexukiBitboard& board) {
+    auto moves = board.getValidMoves();
+    std::string result = "[";
+    for (size_t i = 0; i < moves.size(); i++) {
+        result += "{\"h\":" + std::to_string(moves[i].hexId) +
+                  ",\"t\":" + std::to_string(moves[i].tileValue) + "}";
+        if (i < moves.size() - 1) result += ",";
     }
+    result += "]";
+    return result;
 }
 
-EMSCRIPTEN_KEEPALIVE
-extern "C" void wasmReset() {
-    if (g_board) {
-        g_board->reset();
+static std::string mctsResultJson(const mcts::MCTSResult& searchResult) {
+    std::string result = "{";
+    result += "\"hexId\":" + std::to_string(searchResult.bestMove.hexId) + ",";
+    result += "\"tileValue\":" + std::to_string(searchResult.bestMove.tileValue) + ",";
+    result += "\"visits\":" + std::to_string(searchResult.visits) + ",";
+    result += "\"winRate\":" + std::to_string(searchResult.winRate) + ",";
+    result += "\"simulations\":" + std::to_string(searchResult.simulations) + ",";
+    result += "\"timeMs\":" + std::to_string(searchResult.timeMs) + ",";
+
+    // Add topMoves array
+    result += "\"topMoves\":[";
+    for (size_t i = 0; i < searchResult.topMoves.size(); i++) {
+        result += "{";
+        result += "\"hexId\":" + std::to_string(searchResult.topMoves[i].move.hexId) + ",";
+        result += "\"tileValue\":" + std::to_string(searchResult.topMoves[i].move.tileValue) + ",";
+        result += "\"visits\":" + std::to_string(searchResult.topMoves[i].visits) + ",";
+        result += "\"winRate\":" + std::to_string(searchResult.topMoves[i].winRate);
+        result += "}";
+        if (i < searchResult.topMoves.size() - 1) result += ",";
+    }
+    result += "]}";
+    return result;
+}
+
+static std::string minimaxResultJson(const minimax::SearchResult& searchResult) {
+    std::string result = "{";
+    result += "\"hexId\":" + std::to_string(searchResult.bestMove.hexId) + ",";
+    result += "\"tileValue\":" + std::to_string(searchResult.bestMove.tileValue) + ",";
+    result += "\"score\":" + std::to_string(searchResult.score) + ",";
+    result += "\"depth\":" + std::to_string(searchResult.depth) + ",";
+    result += "\"nodes\":" + std::to_string(searchResult.nodesSearched) + ",";
+    result += "\"timeMs\":" + std::to_string(searchResult.timeMs);
+    result += "}";
+    return result;
+}
+
+// Current state of an instance's incremental search: the usual result
+// object of its engine plus "engine" and "done"
+static std::string searchStateJson(const api::EngineInstance& engine) {
+    std::string body;
+    std::string name;
+    switch (engine.getSearchEngine()) {
+        case api::SearchEngine::MCTS:
+            name = "mcts";
+            body = mctsResultJson(engine.peekMCTS());
+            break;
+        case api::SearchEngine::MINIMAX:
+            name = "minimax";
+            body = minimaxResultJson(engine.peekMinimax());
+            break;
+        default:
+            return "{\"error\":\"No search\"}";
     }
+    return "{\"engine\":\"" + name + "\",\"done\":" + (engine.isSearchDone() ? "true," : "false,") +
+           body.substr(1);
+}
+
+static mcts::MCTSConfig makeMCTSConfig(int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
+    mcts::MCTSConfig config;
+    config.numSimulations = simulations;
+    config.timeLimitMs = timeLimitMs;
+    config.useTimeLimit = useTimeLimit;
+    config.verbose = false;
+    config.useMinimaxRollouts = useMinimaxRollouts;
+    config.minimaxThreshold = minimaxThreshold;
+    return config;
 }
 
 // ============================================================================
-// Game State Management
+// Instance Lifetime
 // ============================================================================
 
+// Returns a handle > 0. Instances are independent: own board, history and engine.
 EMSCRIPTEN_KEEPALIVE
-extern "C" void wasmLoadPosition(const char* position) {
-    if (g_board) {
-        g_board->loadPosition(std::string(position));
+extern "C" int wasmEngineCreate() {
+    return g_instances.create();
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmEngineDestroy(int handle) {
+    return g_instances.destroy(handle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmEngineCount() {
+    return static_cast<int>(g_instances.size());
+}
+
+// ============================================================================
+// Game State Management (per instance)
+// ============================================================================
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmEngineReset(int handle) {
+    if (auto* engine = g_instances.get(handle)) {
+        engine->reset();
     }
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" const char* wasmSavePosition() {
-    static std::string result;
-    if (g_board) {
-        result = g_board->savePosition();
-        return result.c_str();
+extern "C" void wasmEngineLoadPosition(int handle, const char* position) {
+    if (auto* engine = g_instances.get(handle)) {
+        engine->loadPosition(std::string(position));
     }
-    return "";
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" int wasmGetCurrentPlayer() {
-    return g_board ? g_board->getCurrentPlayer() : 1;
+extern "C" const char* wasmEngineSavePosition(int handle) {
+    static std::string result;
+    auto* engine = g_instances.get(handle);
+    result = engine ? engine->getBoard().savePosition() : "";
+    return result.c_str();
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" int wasmGetScoreP1() {
-    return g_board ? g_board->getScore(PLAYER_1) : 0;
+extern "C" int wasmEngineGetCurrentPlayer(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->getBoard().getCurrentPlayer() : 1;
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" int wasmGetScoreP2() {
-    return g_board ? g_board->getScore(PLAYER_2) : 0;
+extern "C" int wasmEngineGetScoreP1(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->getBoard().getScore(PLAYER_1) : 0;
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" bool wasmIsGameOver() {
-    return g_board ? g_board->isGameOver() : false;
+extern "C" int wasmEngineGetScoreP2(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->getBoard().getScore(PLAYER_2) : 0;
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" int wasmGetTileValue(int hexId) {
-    return g_board ? g_board->getTileValue(hexId) : 0;
+extern "C" bool wasmEngineIsGameOver(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->getBoard().isGameOver() : false;
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmEngineGetTileValue(int handle, int hexId) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->getBoard().getTileValue(hexId) : 0;
 }
 
 // ============================================================================
-// Move Operations
+// Move Operations (per instance)
 // ============================================================================
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" bool wasmMakeMove(int hexId, int tileValue) {
-    if (!g_board) return false;
+extern "C" bool wasmEngineMakeMove(int handle, int hexId, int tileValue) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->makeMove(Move(hexId, tileValue)) : false;
+}
 
-    Move move(hexId, tileValue);
-    if (g_board->isValidMove(move)) {
-        g_lastMove = move;  // Track for unmake
-        g_board->makeMove(move);
-        return true;
-    }
-    return false;
+// Undoes the most recent move; can be called repeatedly back to the last reset/load
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmEngineUndoMove(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->undoMove() : false;
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" void wasmUnmakeMove() {
-    if (g_board && g_lastMove.hexId != -1) {
-        g_board->unmakeMove(g_lastMove);
-        g_lastMove = Move(-1, 0);  // Reset
-    }
+extern "C" int wasmEngineGetHistoryLength(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? static_cast<int>(engine->getHistory().size()) : 0;
 }
 
 EMSCRIPTEN_KEEPALIVE
-extern "C" int wasmGetValidMovesCount() {
-    if (!g_board) return 0;
-    return g_board->getValidMoves().size();
+extern "C" int wasmEngineGetValidMovesCount(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? static_cast<int>(engine->getBoard().getValidMoves().size()) : 0;
 }
 
 // Returns valid moves as a JSON string: "[{h:6,t:5},{h:7,t:4},...]"
 EMSCRIPTEN_KEEPALIVE
-extern "C" const char* wasmGetValidMoves() {
+extern "C" const char* wasmEngineGetValidMoves(int handle) {
+    static std::string result;
+    auto* engine = g_instances.get(handle);
+    result = engine ? validMovesJson(engine->getBoard()) : "[]";
+    return result.c_str();
+}
+
+// ============================================================================
+// AI (per instance)
+// ============================================================================
+
+// Returns best move as JSON: {hexId:6, tileValue:5, visits:1234, winRate:0.6, simulations:10000, timeMs:500}
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmEngineMCTSFindBestMove(int handle, int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
     static std::string result;
-    if (!g_board) {
-        result = "[]";
+
+    auto* engine = g_instances.get(handle);
+    if (!engine) {
+        result = NOT_INITIALIZED;
         return result.c_str();
     }
 
-    auto moves = g_board->getValidMoves();
-    result = "[";
-    for (size_t i = 0; i < moves.size(); i++) {
-        result += "{\"h\":" + std::to_string(moves[i].hexId) +
-                  ",\"t\":" + std::to_string(moves[i].tileValue) + "}";
-        if (i < moves.size() - 1) result += ",";
+    result = mctsResultJson(engine->runMCTS(
+        makeMCTSConfig(simulations, timeLimitMs, useTimeLimit, useMinimaxRollouts, minimaxThreshold)));
+    return result.c_str();
+}
+
+// Returns best move as JSON: {hexId:6, tileValue:5, score:100, depth:8, nodes:50000, timeMs:200}
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmEngineMinimaxFindBestMove(int handle, int depth, int timeLimitMs) {
+    static std::string result;
+
+    auto* engine = g_instances.get(handle);
+    if (!engine) {
+        result = NOT_INITIALIZED;
+        return result.c_str();
     }
-    result += "]";
+
+    result = minimaxResultJson(engine->runMinimax(depth, timeLimitMs));
     return result.c_str();
 }
 
 // ============================================================================
-// MCTS AI
+// Search Threads (per instance)
+//
+// Blocking searches (wasm*FindBestMove) run threads parallel MCTS trees /
+// minimax root tasks on the engine's worker pool. In the pthreads build
+// (hexuki_mt.js) these use web workers; in the other builds they run one
+// after another on the calling thread. Fixed-budget results only depend on
+// the settings, so a page can always ask for several threads; time-limited
+// searches share one deadline, so fewer workers mean fewer simulations, not
+// a longer search.
 // ============================================================================
 
-// Returns best move as JSON: {hexId:6, tileValue:5, visits:1234, winRate:0.6, simulations:10000, timeMs:500}
+// Workers + calling thread available to searches (1 without pthreads)
 EMSCRIPTEN_KEEPALIVE
-extern "C" const char* wasmMCTSFindBestMove(int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
-    static std::string result;
+extern "C" int wasmGetHardwareThreads() {
+    return ThreadPool::global().size() + 1;
+}
 
-    if (!g_board || !g_mcts) {
-        result = "{\"error\":\"Not initialized\"}";
-        return result.c_str();
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmEngineSetThreads(int handle, int threads) {
+    if (auto* engine = g_instances.get(handle)) {
+        engine->setSearchThreads(threads);
     }
+}
 
-    mcts::MCTSConfig config;
-    config.numSimulations = simulations;
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmEngineGetThreads(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->getSearchThreads() : 1;
+}
+
+// MCTS seed (0 = random). With a seed, simulation-count searches repeat exactly.
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmEngineSetSeed(int handle, unsigned int seed) {
+    if (auto* engine = g_instances.get(handle)) {
+        engine->setSearchSeed(seed);
+    }
+}
+
+// ============================================================================
+// Incremental Search (per instance)
+//
+// begin → step (repeatedly, e.g. once per animation frame) → peekBest at any
+// time → finishSearch. Only one incremental search per instance; a new begin,
+// a position change or a blocking search replaces it.
+// ============================================================================
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmEngineBeginMCTSSearch(int handle, int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
+    auto* engine = g_instances.get(handle);
+    if (!engine) return false;
+    engine->beginMCTSSearch(makeMCTSConfig(simulations, timeLimitMs, useTimeLimit, useMinimaxRollouts, minimaxThreshold));
+    return true;
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmEngineBeginMinimaxSearch(int handle, int depth, int timeLimitMs) {
+    auto* engine = g_instances.get(handle);
+    if (!engine) return false;
+
+    minimax::SearchConfig config;
+    config.maxDepth = depth;
     config.timeLimitMs = timeLimitMs;
-    config.useTimeLimit = useTimeLimit;
     config.verbose = false;
-    config.useMinimaxRollouts = useMinimaxRollouts;
-    config.minimaxThreshold = minimaxThreshold;
+    engine->beginMinimaxSearch(config);
+    return true;
+}
 
-    auto searchResult = g_mcts->findBestMove(*g_board, config);
+// Searches for up to budgetMs and/or maxWork simulations (MCTS) or nodes
+// (minimax), <= 0 meaning no limit of that kind. Returns true when finished.
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmEngineStep(int handle, double budgetMs, int maxWork) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->stepSearch(budgetMs, maxWork) : true;
+}
 
-    // Build JSON response with topMoves
-    result = "{";
-    result += "\"hexId\":" + std::to_string(searchResult.bestMove.hexId) + ",";
-    result += "\"tileValue\":" + std::to_string(searchResult.bestMove.tileValue) + ",";
-    result += "\"visits\":" + std::to_string(searchResult.visits) + ",";
-    result += "\"winRate\":" + std::to_string(searchResult.winRate) + ",";
-    result += "\"simulations\":" + std::to_string(searchResult.simulations) + ",";
-    result += "\"timeMs\":" + std::to_string(searchResult.timeMs) + ",";
+// Returns the search result JSON of the running engine plus
+// {engine:"mcts"|"minimax", done:false, ...}
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmEnginePeekBest(int handle) {
+    static std::string result;
+    auto* engine = g_instances.get(handle);
+    result = engine ? searchStateJson(*engine) : NOT_INITIALIZED;
+    return result.c_str();
+}
 
-    // Add topMoves array
-    result += "\"topMoves\":[";
-    for (size_t i = 0; i < searchResult.topMoves.size(); i++) {
-        result += "{";
-        result += "\"hexId\":" + std::to_string(searchResult.topMoves[i].move.hexId) + ",";
-        result += "\"tileValue\":" + std::to_string(searchResult.topMoves[i].move.tileValue) + ",";
-        result += "\"visits\":" + std::to_string(searchResult.topMoves[i].visits) + ",";
-        result += "\"winRate\":" + std::to_string(searchResult.topMoves[i].winRate);
-        result += "}";
-        if (i < searchResult.topMoves.size() - 1) result += ",";
+// Stops the search and returns its final result (same format as peekBest)
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmEngineFinishSearch(int handle) {
+    static std::string result;
+    auto* engine = g_instances.get(handle);
+    if (!engine) {
+        result = NOT_INITIALIZED;
+        return result.c_str();
     }
-    result += "]}";
-
+    engine->finishSearch();
+    result = searchStateJson(*engine);
     return result.c_str();
 }
 
 // ============================================================================
-// Minimax AI
+// Packed Results (per instance)
+//
+// Same data as the JSON functions, written into buffers owned by the
+// instance (layouts in api/result_layout.h and WASM_SETUP.md). The returned
+// pointers index Module.HEAP32 / Module.HEAPF64 directly; the data stays
+// valid until the next packed call on the same instance, or until memory
+// grows. Lengths are in elements.
 // ============================================================================
 
-// Returns best move as JSON: {hexId:6, tileValue:5, score:100, depth:8, nodes:50000, timeMs:200}
 EMSCRIPTEN_KEEPALIVE
-extern "C" const char* wasmMinimaxFindBestMove(int depth, int timeLimitMs) {
-    static std::string result;
+extern "C" const int32_t* wasmEngineGetValidMovesPacked(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->packValidMoves().data() : nullptr;
+}
 
-    if (!g_board) {
-        result = "{\"error\":\"Not initialized\"}";
-        return result.c_str();
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmEngineGetMoveBufferLength(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? static_cast<int>(engine->getMoveBuffer().size()) : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const double* wasmEngineMCTSFindBestMovePacked(int handle, int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
+    auto* engine = g_instances.get(handle);
+    if (!engine) return nullptr;
+    return engine->packResult(engine->runMCTS(
+        makeMCTSConfig(simulations, timeLimitMs, useTimeLimit, useMinimaxRollouts, minimaxThreshold))).data();
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const double* wasmEngineMinimaxFindBestMovePacked(int handle, int depth, int timeLimitMs) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->packResult(engine->runMinimax(depth, timeLimitMs)).data() : nullptr;
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const double* wasmEnginePeekBestPacked(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? engine->packSearchState().data() : nullptr;
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const double* wasmEngineFinishSearchPacked(int handle) {
+    auto* engine = g_instances.get(handle);
+    if (!engine) return nullptr;
+    engine->finishSearch();
+    return engine->packSearchState().data();
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmEngineGetResultBufferLength(int handle) {
+    auto* engine = g_instances.get(handle);
+    return engine ? static_cast<int>(engine->getResultBuffer().size()) : 0;
+}
+
+// ============================================================================
+// Batched Rules (hexuki_game_engine_wasm.js)
+//
+// JS writes POSITION_STRIDE Int32 records (result_layout.h) into the buffer
+// returned by wasmBatchInput(count), calls one wasmBatch* function and reads
+// wasmBatchOutputLength() values at the returned pointer. Both buffers are
+// reused by the next call. Records with out-of-range fields get empty
+// results (api::isValidPositionRecord).
+// ============================================================================
+
+static std::vector<int32_t> g_batchInput;
+static std::vector<int32_t> g_batchOutput;
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int32_t* wasmBatchInput(int count) {
+    g_batchInput.assign(static_cast<size_t>(std::max(count, 0)) * api::POSITION_STRIDE, 0);
+    return g_batchInput.data();
+}
+
+// Record count that fits in the current input buffer
+static int batchCount(int count) {
+    return std::max(0, std::min(count, static_cast<int>(g_batchInput.size() / api::POSITION_STRIDE)));
+}
+
+// Per position: move count, then (hexId, tileValue) pairs in JS engine order
+EMSCRIPTEN_KEEPALIVE
+extern "C" const int32_t* wasmBatchValidMoves(int count) {
+    api::batchValidMoves(g_batchInput.data(), batchCount(count), g_batchOutput);
+    return g_batchOutput.data();
+}
+
+// Per position: p1 score, p2 score
+EMSCRIPTEN_KEEPALIVE
+extern "C" const int32_t* wasmBatchScores(int count) {
+    api::batchScores(g_batchInput.data(), batchCount(count), g_batchOutput);
+    return g_batchOutput.data();
+}
+
+// Per position: one PLAYOUT_STRIDE record (scores, then the moves played)
+EMSCRIPTEN_KEEPALIVE
+extern "C" const int32_t* wasmBatchPlayouts(int count, unsigned int seed) {
+    api::batchPlayouts(g_batchInput.data(), batchCount(count), seed, g_batchOutput);
+    return g_batchOutput.data();
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmBatchOutputLength() {
+    return static_cast<int>(g_batchOutput.size());
+}
+
+// Hexes where a tile may be placed (adjacency + chain length rule) as a bit
+// mask; depends only on which hexes are occupied
+EMSCRIPTEN_KEEPALIVE
+extern "C" unsigned int wasmLegalHexMask(unsigned int occupied) {
+    return kernels::legalHexMask(occupied);
+}
+
+// ============================================================================
+// Memory Budget
+//
+// Search tables are allocated on first use, from one budget shared by all
+// instances (default 64MB), and reused by later searches. Creating instances
+// allocates no tables. MCTS node chunks (2MB each here) are charged to the
+// same budget, and a search that finds it exhausted shares a table already in
+// use instead of allocating one.
+// ============================================================================
+
+// Lowering the budget frees tables kept for reuse; tables in use are kept
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmSetMemoryBudget(int budgetMB) {
+    if (budgetMB > 0) {
+        minimax::TablePool::global().setBudgetMB(budgetMB);
     }
+}
 
-    auto searchResult = minimax::findBestMove(*g_board, depth, timeLimitMs);
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetMemoryBudget() {
+    return static_cast<int>(minimax::TablePool::global().getBudgetMB());
+}
 
-    // Build JSON response
-    result = "{";
-    result += "\"hexId\":" + std::to_string(searchResult.bestMove.hexId) + ",";
-    result += "\"tileValue\":" + std::to_string(searchResult.bestMove.tileValue) + ",";
-    result += "\"score\":" + std::to_string(searchResult.score) + ",";
-    result += "\"depth\":" + std::to_string(searchResult.depth) + ",";
-    result += "\"nodes\":" + std::to_string(searchResult.nodesSearched) + ",";
-    result += "\"timeMs\":" + std::to_string(searchResult.timeMs);
-    result += "}";
+// MB of tables allocated now (in use + kept for reuse)
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetTableMemory() {
+    return static_cast<int>(minimax::TablePool::global().getAllocatedMB());
+}
 
-    return result.c_str();
+// Free the tables kept for reuse, e.g. when the page goes to the background
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmReleaseTables() {
+    minimax::TablePool::global().trim();
+}
+
+// ============================================================================
+// Single-Instance API (compatibility wrappers over the default instance)
+// ============================================================================
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmInitialize() {
+    if (g_defaultHandle == api::INVALID_HANDLE) {
+        g_defaultHandle = wasmEngineCreate();
+    }
+}
+
+// wasmInitialize() with a table memory budget (MB, <= 0 keeps the default)
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmInitializeWithBudget(int budgetMB) {
+    wasmSetMemoryBudget(budgetMB);
+    wasmInitialize();
+}
+
+// Handle of the default instance, for the wasmEngine* functions
+// (e.g. the packed results) from pages written against the single-game API
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetDefaultEngine() {
+    return g_defaultHandle;
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmReset() {
+    wasmEngineReset(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmLoadPosition(const char* position) {
+    wasmEngineLoadPosition(g_defaultHandle, position);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmSavePosition() {
+    return wasmEngineSavePosition(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetCurrentPlayer() {
+    return wasmEngineGetCurrentPlayer(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetScoreP1() {
+    return wasmEngineGetScoreP1(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetScoreP2() {
+    return wasmEngineGetScoreP2(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmIsGameOver() {
+    return wasmEngineIsGameOver(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetTileValue(int hexId) {
+    return wasmEngineGetTileValue(g_defaultHandle, hexId);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmMakeMove(int hexId, int tileValue) {
+    return wasmEngineMakeMove(g_defaultHandle, hexId, tileValue);
+}
+
+// Now backed by the instance's history, so repeated calls keep undoing
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmUnmakeMove() {
+    wasmEngineUndoMove(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetValidMovesCount() {
+    return wasmEngineGetValidMovesCount(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmGetValidMoves() {
+    return wasmEngineGetValidMoves(g_defaultHandle);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmMCTSFindBestMove(int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
+    return wasmEngineMCTSFindBestMove(g_defaultHandle, simulations, timeLimitMs, useTimeLimit, useMinimaxRollouts, minimaxThreshold);
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmMinimaxFindBestMove(int depth, int timeLimitMs) {
+    return wasmEngineMinimaxFindBestMove(g_defaultHandle, depth, timeLimitMs);
 }
 
 // ============================================================================
@@ -229,11 +620,8 @@ extern "C" const char* wasmMinimaxFindBestMove(int depth, int timeLimitMs) {
 
 EMSCRIPTEN_KEEPALIVE
 extern "C" void wasmCleanup() {
-    delete g_board;
-    delete g_mcts;
-    g_board = nullptr;
-    g_mcts = nullptr;
-    g_initialized = false;
+    wasmEngineDestroy(g_defaultHandle);
+    g_defaultHandle = api::INVALID_HANDLE;
 }
 
 // ============================================================================
@@ -260,12 +648,82 @@ std::string wasmMinimaxFindBestMoveStr(int depth, int timeLimitMs) {
     return std::string(wasmMinimaxFindBestMove(depth, timeLimitMs));
 }
 
+void wasmEngineLoadPositionStr(int handle, std::string position) {
+    wasmEngineLoadPosition(handle, position.c_str());
+}
+
+std::string wasmEngineSavePositionStr(int handle) {
+    return std::string(wasmEngineSavePosition(handle));
+}
+
+std::string wasmEngineGetValidMovesStr(int handle) {
+    return std::string(wasmEngineGetValidMoves(handle));
+}
+
+std::string wasmEngineMCTSFindBestMoveStr(int handle, int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
+    return std::string(wasmEngineMCTSFindBestMove(handle, simulations, timeLimitMs, useTimeLimit, useMinimaxRollouts, minimaxThreshold));
+}
+
+std::string wasmEngineMinimaxFindBestMoveStr(int handle, int depth, int timeLimitMs) {
+    return std::string(wasmEngineMinimaxFindBestMove(handle, depth, timeLimitMs));
+}
+
+std::string wasmEnginePeekBestStr(int handle) {
+    return std::string(wasmEnginePeekBest(handle));
+}
+
+std::string wasmEngineFinishSearchStr(int handle) {
+    return std::string(wasmEngineFinishSearch(handle));
+}
+
+// Typed array views over the instance buffers (no copy; same lifetime rules
+// as the pointers above)
+
+val wasmEngineGetValidMovesView(int handle) {
+    auto* engine = g_instances.get(handle);
+    if (!engine) return val(typed_memory_view(0, static_cast<const int32_t*>(nullptr)));
+    const auto& buffer = engine->packValidMoves();
+    return val(typed_memory_view(buffer.size(), buffer.data()));
+}
+
+static val resultView(const api::EngineInstance* engine) {
+    if (!engine) return val(typed_memory_view(0, static_cast<const double*>(nullptr)));
+    const auto& buffer = engine->getResultBuffer();
+    return val(typed_memory_view(buffer.size(), buffer.data()));
+}
+
+val wasmEngineMCTSFindBestMoveView(int handle, int simulations, int timeLimitMs, bool useTimeLimit, bool useMinimaxRollouts, int minimaxThreshold) {
+    wasmEngineMCTSFindBestMovePacked(handle, simulations, timeLimitMs, useTimeLimit, useMinimaxRollouts, minimaxThreshold);
+    return resultView(g_instances.get(handle));
+}
+
+val wasmEngineMinimaxFindBestMoveView(int handle, int depth, int timeLimitMs) {
+    wasmEngineMinimaxFindBestMovePacked(handle, depth, timeLimitMs);
+    return resultView(g_instances.get(handle));
+}
+
+val wasmEnginePeekBestView(int handle) {
+    wasmEnginePeekBestPacked(handle);
+    return resultView(g_instances.get(handle));
+}
+
+val wasmEngineFinishSearchView(int handle) {
+    wasmEngineFinishSearchPacked(handle);
+    return resultView(g_instances.get(handle));
+}
+
 // ============================================================================
 // Emscripten Bindings (using std::string - no raw pointers)
 // ============================================================================
 
 EMSCRIPTEN_BINDINGS(hexuki_module) {
+    // Single-instance API
     function("initialize", &wasmInitialize);
+    function("initializeWithBudget", &wasmInitializeWithBudget);
+    function("setMemoryBudget", &wasmSetMemoryBudget);
+    function("getMemoryBudget", &wasmGetMemoryBudget);
+    function("getTableMemory", &wasmGetTableMemory);
+    function("releaseTables", &wasmReleaseTables);
     function("reset", &wasmReset);
     function("loadPosition", &wasmLoadPositionStr);
     function("savePosition", &wasmSavePositionStr);
@@ -281,4 +739,41 @@ EMSCRIPTEN_BINDINGS(hexuki_module) {
     function("mctsFindBestMove", &wasmMCTSFindBestMoveStr);
     function("minimaxFindBestMove", &wasmMinimaxFindBestMoveStr);
     function("cleanup", &wasmCleanup);
+
+    // Handle-based API
+    function("engineCreate", &wasmEngineCreate);
+    function("engineDestroy", &wasmEngineDestroy);
+    function("engineCount", &wasmEngineCount);
+    function("engineReset", &wasmEngineReset);
+    function("engineLoadPosition", &wasmEngineLoadPositionStr);
+    function("engineSavePosition", &wasmEngineSavePositionStr);
+    function("engineGetCurrentPlayer", &wasmEngineGetCurrentPlayer);
+    function("engineGetScoreP1", &wasmEngineGetScoreP1);
+    function("engineGetScoreP2", &wasmEngineGetScoreP2);
+    function("engineIsGameOver", &wasmEngineIsGameOver);
+    function("engineGetTileValue", &wasmEngineGetTileValue);
+    function("engineMakeMove", &wasmEngineMakeMove);
+    function("engineUndoMove", &wasmEngineUndoMove);
+    function("engineGetHistoryLength", &wasmEngineGetHistoryLength);
+    function("engineGetValidMovesCount", &wasmEngineGetValidMovesCount);
+    function("engineGetValidMoves", &wasmEngineGetValidMovesStr);
+    function("engineMctsFindBestMove", &wasmEngineMCTSFindBestMoveStr);
+    function("engineMinimaxFindBestMove", &wasmEngineMinimaxFindBestMoveStr);
+    function("engineBeginMctsSearch", &wasmEngineBeginMCTSSearch);
+    function("engineBeginMinimaxSearch", &wasmEngineBeginMinimaxSearch);
+    function("engineStep", &wasmEngineStep);
+    function("enginePeekBest", &wasmEnginePeekBestStr);
+    function("engineFinishSearch", &wasmEngineFinishSearchStr);
+    function("getDefaultEngine", &wasmGetDefaultEngine);
+    function("getHardwareThreads", &wasmGetHardwareThreads);
+    function("engineSetThreads", &wasmEngineSetThreads);
+    function("engineGetThreads", &wasmEngineGetThreads);
+    function("engineSetSeed", &wasmEngineSetSeed);
+
+    // Packed results as typed array views (layouts in WASM_SETUP.md)
+    function("engineGetValidMovesView", &wasmEngineGetValidMovesView);
+    function("engineMctsFindBestMoveView", &wasmEngineMCTSFindBestMoveView);
+    function("engineMinimaxFindBestMoveView", &wasmEngineMinimaxFindBestMoveView);
+    function("enginePeekBestView", &wasmEnginePeekBestView);
+    function("engineFinishSearchView", &wasmEngineFinishSearchView);
 }
@@ -0,0 +1,101 @@
+"""
+hexuki_native.py (ctypes) against libhexuki
+
+Usage: python3 tests/python/test_hexuki_native.py <path to libhexuki>
+"""
+
+import os
+import sys
+from array import array
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..'))
+import hexuki_native as hx  # noqa: E402
+
+failures = 0
+
+
+def check(condition, what):
+    global failures
+    if not condition:
+        print(f'✗ FAILED: {what}')
+        failures += 1
+
+
+def test_batches():
+    positions = hx.Positions.start(64)
+    moves = hx.valid_moves(positions)
+    check(len(moves) == 64 and len(moves[0]) == 54, 'start position has 54 moves')
+    check(moves[0][0] == (4, 1), 'moves in JS engine order')
+
+    results = hx.playouts(positions, seed=9)
+    check(all(len(r[2]) == 18 for r in results), 'playouts run 18 moves')
+    check(results == hx.playouts(positions, seed=9), 'playouts reproducible by seed')
+    check(hx.playouts(positions[1:2], seed=10)[0] == results[1], 'position i uses seed + i')
+
+    # Replay a playout on a board: same final scores
+    with hx.Board() as board:
+        for hex_id, tile in results[0][2]:
+            board.make_move(hex_id, tile)
+        final = hx.Positions.from_boards([board])
+    check(hx.scores(final)[0] == results[0][:2], 'replayed playout has the same scores')
+    check(final.get(0)['move_count'] == 18 and final.get(0)['p1_tiles'] == [], 'packed final position')
+
+    print('✓ Batch calls test passed')
+
+
+def test_buffers_and_searches():
+    # Positions in caller memory (array('i') here; numpy int32 works the same way)
+    buffer = array('i', [0] * (4 * hx.POSITION_STRIDE))
+    positions = hx.Positions.from_buffer(buffer)
+    for i in range(4):
+        positions.set(i, [1 if h == 9 else 0 for h in range(19)], 1, 0, list(range(1, 10)), list(range(1, 10)))
+    positions.set(3, [5 if h == 7 else 1 if h == 9 else 0 for h in range(19)], 2, 1,
+                  [1, 2, 3, 4, 6, 7, 8, 9], list(range(1, 10)))
+    check(buffer[3 * hx.POSITION_STRIDE + 7] == 5, 'from_buffer shares memory')
+    check((6, 5) not in hx.valid_moves(positions)[3], 'anti-symmetry rule applied')
+
+    best = hx.minimax(positions[2:4], depth=3)
+    check(len(best) == 2 and all(r['depth'] == 3 and r['hex'] >= 0 for r in best), 'minimax per position')
+    first = hx.mcts(positions, simulations=100, seed=5)
+    again = hx.mcts(positions, simulations=100, seed=5)
+    key = lambda r: (r['hex'], r['tile'], r['visits'], r['win_rate'])  # noqa: E731 (time_ms varies)
+    check(list(map(key, first)) == list(map(key, again)), 'seeded MCTS reproducible')
+    check(all(r['work'] == 100 for r in first), 'MCTS runs the requested simulations')
+
+    try:
+        positions.set(0, [0] * 19, 3, 0, [], [])
+        hx.scores(positions)
+        check(False, 'bad record raises')
+    except hx.HexukiError as e:
+        check(e.code == -1, 'bad record is an invalid argument')
+
+    try:
+        hx.Board().make_move(0, 5)
+        check(False, 'illegal move raises')
+    except hx.HexukiError as e:
+        check(e.code == -2 and 'illegal' in str(e), 'illegal move error')
+
+    print('✓ Buffers and searches test passed')
+
+
+def main():
+    print('===========================================')
+    print('HEXUKI - Python ctypes wrapper tests')
+    print('===========================================\n')
+
+    hx.load(sys.argv[1] if len(sys.argv) > 1 else None)
+    test_batches()
+    test_buffers_and_searches()
+
+    print('\n===========================================')
+    if failures > 0:
+        print(f'✗ {failures} check(s) failed')
+        print('===========================================')
+        return 1
+    print('✅ All Python wrapper tests passed!')
+    print('===========================================')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,195 @@
+#include "api/analysis_server.h"
+#include "test_util.h"
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace hexuki;
+
+// Raw JSON value of "key" (strings keep their quotes)
+static std::string field(const std::string& json, const std::string& key) {
+    size_t at = json.find("\"" + key + "\":");
+    if (at == std::string::npos) return "";
+    size_t begin = at + key.size() + 3;
+    size_t end = begin;
+    if (json[begin] == '"') {
+        end = json.find('"', begin + 1) + 1;
+    } else if (json[begin] == '[' || json[begin] == '{') {
+        end = json.find(json[begin] == '[' ? ']' : '}', begin) + 1;
+    } else {
+        while (end < json.size() && json[end] != ',' && json[end] != '}') end++;
+    }
+    return json.substr(begin, end - begin);
+}
+
+static long long number(const std::string& json, const std::string& key) {
+    std::string value = field(json, key);
+    return value.empty() ? -1 : std::stoll(value);
+}
+
+static std::string socketPath() {
+    return "/tmp/hexuki_server_test_" + std::to_string(::getpid()) + ".sock";
+}
+
+void testRequests() {
+    api::ServerConfig config;
+    config.socketPath = socketPath();
+    config.hashMB = 16;
+    api::AnalysisServer server(config);
+    server.start();
+
+    api::AnalysisClient client;
+    client.connectUnix(server.getEndpoint());
+
+    std::string moves = client.request("m1 moves startpos");
+    check(field(moves, "id") == "\"m1\"" && field(moves, "status") == "\"ok\"", "moves answered");
+    check(field(moves, "moves").find("\"h") != std::string::npos, "moves listed");
+    check(field(moves, "game_over") == "false", "start is not game over");
+
+    std::string eval = client.request("e1 eval h7:5,h9:1|p1:1,2,3,4,5,6,7,8,9|p2:1,2,3,4,6,7,8,9|turn:1");
+    check(field(eval, "status") == "\"ok\"" && !field(eval, "eval").empty(), "eval answered");
+
+    std::string analysis = client.request("a1 analyze startpos depth 3");
+    check(field(analysis, "status") == "\"ok\"" && number(analysis, "depth") == 3, "fixed-depth analysis");
+    check(field(analysis, "bestmove").size() > 3 && field(analysis, "complete") == "true", "analysis complete");
+
+    check(field(client.request("x1 frobnicate startpos"), "status") == "\"error\"", "unknown request rejected");
+    check(field(client.request("x2 moves hx:yy"), "status") == "\"error\"", "bad position rejected");
+    check(field(client.request("x4 moves h9:1|p1:1,2,3,4,5,6,7,8,9,10,11,12|p2:1,2|turn:1"), "status") ==
+              "\"error\"", "oversized hand rejected");
+    check(field(client.request("x5 analyze h9:1,h4:12|turn:1 depth 2"), "status") == "\"error\"",
+          "out-of-range tile rejected");
+    check(field(client.request("x6 eval h9:1|turn:3"), "status") == "\"error\"", "bad turn rejected");
+    check(field(client.request("x3 analyze startpos depth"), "status") == "\"error\"", "missing value rejected");
+
+    // Seeded MCTS is reproducible
+    std::string first = client.request("c1 analyze startpos engine mcts sims 200 seed 3");
+    std::string second = client.request("c2 analyze startpos engine mcts sims 200 seed 3");
+    check(number(first, "sims") == 200, "MCTS simulation count");
+    check(field(first, "bestmove") == field(second, "bestmove") && field(first, "visits") == field(second, "visits"),
+          "seeded MCTS reproducible");
+
+    std::cout << "✓ Request test passed\n";
+}
+
+void testSharedTableAndDeadlines() {
+    api::ServerConfig config;
+    config.socketPath = socketPath();
+    config.hashMB = 16;
+    api::AnalysisServer server(config);
+    server.start();
+
+    // Second client benefits from the first one's table entries
+    const std::string request = " analyze h7:5,h6:4|p1:1,2,3,4,6,7,8,9|p2:1,2,3,5,6,7,8,9|turn:1 depth 5";
+    api::AnalysisClient a;
+    api::AnalysisClient b;
+    a.connectUnix(server.getEndpoint());
+    b.connectUnix(server.getEndpoint());
+    std::string cold = a.request("cold" + request);
+    std::string warm = b.request("warm" + request);
+    check(field(cold, "score") == field(warm, "score"), "shared table gives the same score");
+    check(number(warm, "nodes") < number(cold, "nodes"), "shared table saves nodes");
+
+    // A long solve does not hold up a short request behind it
+    a.send("long solve startpos deadline 300");
+    a.send("short moves startpos");
+    std::string reply = a.receive();
+    check(field(reply, "id") == "\"short\"", "short request answered before the long one");
+    reply = a.receive();
+    check(field(reply, "id") == "\"long\"", "long request answered");
+    check(field(reply, "complete") == "false" || field(reply, "status") == "\"deadline\"", "deadline cut the solve");
+    check(number(reply, "total_ms") < 2000, "deadline respected");
+
+    std::string stats = b.request("s stats");
+    check(number(stats, "deadline_hits") >= 1, "deadline hit counted");
+    check(number(stats, "connections") == 2, "connections counted");
+
+    std::cout << "✓ Shared table and deadline test passed\n";
+}
+
+void testPipelinedBatches() {
+    api::ServerConfig config;
+    config.port = 0;  // Localhost TCP, any free port
+    config.hashMB = 16;
+    config.maxBatch = 16;
+    api::AnalysisServer server(config);
+    server.start();
+    check(server.getPort() > 0, "TCP port bound");
+
+    api::AnalysisClient client;
+    client.connectTcp(server.getPort());
+
+    const int count = 200;
+    for (int i = 0; i < count; i++) {
+        client.send(std::to_string(i) + (i % 2 ? " eval startpos" : " moves startpos"));
+    }
+    std::set<std::string> ids;
+    for (int i = 0; i < count; i++) {
+        std::string reply = client.receive();
+        if (field(reply, "status") == "\"ok\"") ids.insert(field(reply, "id"));
+    }
+    check(ids.size() == count, "every pipelined request answered once");
+
+    server.waitIdle();
+    api::ServerStats stats = server.getStats();
+    check(stats.batchedRequests == static_cast<uint64_t>(count), "moves/eval go through batches");
+    const uint64_t requests = static_cast<uint64_t>(count);
+    check(stats.batches >= (requests + config.maxBatch - 1) / config.maxBatch && stats.batches <= requests,
+          "batches hold at most maxBatch requests");
+    check(stats.inFlight == 0 && stats.maxInFlight >= 1, "queue depth tracked");
+    check(stats.latencyP50Ms <= stats.latencyP99Ms && stats.latencyP99Ms <= stats.latencyMaxMs,
+          "latency percentiles ordered");
+
+    std::string json = client.request("s stats");
+    check(number(json, "received") == count + 1 && number(json, "batches") > 0, "stats request");
+
+    std::cout << "✓ Pipelined batch test passed\n";
+}
+
+void testShutdownAnswersQueued() {
+    std::mutex mutex;
+    std::vector<std::string> replies;
+    auto reply = [&](const std::string& line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        replies.push_back(line);
+    };
+
+    {
+        api::ServerConfig config;
+        config.hashMB = 16;
+        config.maxRunning = 1;
+        api::AnalysisServer server(config);
+        server.handleRequest("long solve startpos deadline 60000", reply);
+        for (int i = 0; i < 3; i++) {
+            server.handleRequest("m" + std::to_string(i) + " moves startpos", reply);
+        }
+    }  // Destroyed with the solve running and the moves possibly still queued
+
+    check(replies.size() == 4, "every request answered at shutdown");
+    for (const auto& line : replies) {
+        std::string status = field(line, "status");
+        check(status == "\"ok\"" || status == "\"cancelled\"", "shutdown reply is ok or cancelled");
+    }
+
+    std::cout << "✓ Shutdown test passed\n";
+}
+
+int main() {
+    printHeader("Analysis Server");
+
+    try {
+        testRequests();
+        testSharedTableAndDeadlines();
+        testPipelinedBatches();
+        testShutdownAnswersQueued();
+    } catch (const std::exception& e) {
+        std::cout << "✗ FAILED: " << e.what() << "\n";
+        failures++;
+    }
+
+    return printSummary("analysis server");
+}
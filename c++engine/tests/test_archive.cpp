@@ -0,0 +1,284 @@
+#include "core/bitboard.h"
+#include "core/thread_pool.h"
+#include "core/zobrist.h"
+#include "io/game_archive.h"
+#include "tools/archive_stats.h"
+#include "tools/feature_extractor.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace hexuki;
+namespace fs = std::filesystem;
+
+static std::vector<Move> randomGame(std::mt19937& rng) {
+    HexukiBitboard board;
+    std::vector<Move> game;
+    while (!board.isGameOver()) {
+        auto moves = board.getValidMoves();
+        if (moves.empty()) break;
+        Move move = moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(rng)];
+        board.makeMove(move);
+        game.push_back(move);
+    }
+    return game;
+}
+
+void testPacking() {
+    for (int hex = 0; hex < NUM_HEXES; hex++) {
+        for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+            Move move(hex, TILE_VALUES[i]);
+            check(io::ArchiveRecord::unpackMove(io::ArchiveRecord::packMove(move)) == move, "move packing round-trips");
+        }
+    }
+    std::cout << "✓ Move packing test passed\n";
+}
+
+void testWriteReadIndex(const std::string& dir) {
+    const int gamesPerWriter = 200;
+    std::vector<std::vector<Move>> written[2];
+
+    // Two concurrent writers, one segment each
+    std::thread writers[2];
+    for (int w = 0; w < 2; w++) {
+        writers[w] = std::thread([&, w]() {
+            std::mt19937 rng(1000 + w);
+            io::ArchiveWriter writer(dir, "writer" + std::to_string(w));
+            for (int g = 0; g < gamesPerWriter; g++) {
+                written[w].push_back(randomGame(rng));
+                writer.append(io::ArchiveRecord::fromGame(written[w].back(), io::GameSource::RANDOM));
+            }
+            writer.flush();
+        });
+    }
+    for (auto& t : writers) t.join();
+
+    io::GameArchive archive(dir);
+    check(archive.size() == 2 * gamesPerWriter, "archive holds every game");
+    check(archive.getSegments().size() == 2, "one segment per writer");
+
+    // Segments are ordered by name, so global ids follow writer order
+    for (int w = 0; w < 2; w++) {
+        for (int g = 0; g < gamesPerWriter; g++) {
+            const io::ArchiveRecord& record = archive[w * gamesPerWriter + g];
+            check(record.getMoves() == written[w][g], "random access returns the written game");
+
+            HexukiBitboard board;
+            for (const auto& move : written[w][g]) board.makeMove(move);
+            check(record.p1Score == board.getScore(PLAYER_1) && record.p2Score == board.getScore(PLAYER_2),
+                  "scores recorded");
+        }
+    }
+
+    // Index lookups agree with a brute-force scan
+    io::ArchiveIndex index(archive);
+    const auto& sample = written[0][0];
+    for (size_t len = 0; len <= 3; len++) {
+        std::vector<Move> prefix(sample.begin(), sample.begin() + len);
+        for (int result : {io::ArchiveIndex::ANY_RESULT, 1, 0, -1}) {
+            std::vector<uint64_t> expected;
+            for (uint64_t id = 0; id < archive.size(); id++) {
+                auto moves = archive[id].getMoves();
+                bool match = moves.size() >= len && std::equal(prefix.begin(), prefix.end(), moves.begin());
+                if (match && (result == io::ArchiveIndex::ANY_RESULT || archive[id].result == result)) {
+                    expected.push_back(id);
+                }
+            }
+            check(index.find(prefix, result) == expected, "index find matches scan");
+            check(index.count(prefix, result) == expected.size(), "index count matches scan");
+        }
+    }
+
+    std::cout << "✓ Write/read/index test passed\n";
+}
+
+void testTornRecordRecovery(const std::string& dir) {
+    std::string path;
+    {
+        io::ArchiveWriter writer(dir, "writer0");
+        path = writer.getPath();
+    }
+
+    // Simulate a crash mid-append: half a record at the end of the segment
+    uint64_t before = io::GameArchive(dir).size();
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        char junk[13] = {};
+        out.write(junk, sizeof(junk));
+    }
+    check(io::GameArchive(dir).size() == before, "reader ignores torn tail");
+
+    std::mt19937 rng(7);
+    auto game = randomGame(rng);
+    {
+        io::ArchiveWriter writer(dir, "writer0");
+        writer.append(io::ArchiveRecord::fromGame(game));
+    }
+
+    io::GameArchive archive(dir);
+    check(archive.size() == before + 1, "append after torn tail");
+    check(archive.getSegments()[0].records[archive.getSegments()[0].count - 1].getMoves() == game,
+          "appended record aligned after truncation");
+
+    std::cout << "✓ Torn record recovery test passed\n";
+}
+
+void testStatsAggregation(const std::string& dir) {
+    io::GameArchive archive(dir);
+    io::ArchiveIndex index(archive);
+
+    // Chunking and thread count must not change the merged result
+    ThreadPool pool1(1);
+    ThreadPool pool3(3);
+    tools::StatsConfig serial;
+    tools::StatsConfig parallel;
+    parallel.chunkRecords = 17;
+
+    tools::ArchiveStats a = tools::aggregateArchive(archive, serial, pool1);
+    tools::ArchiveStats b = tools::aggregateArchive(archive, parallel, pool3);
+
+    std::ostringstream csvA, csvB;
+    a.writePrefixCsv(csvA); a.writeMoveCsv(csvA); a.writeScoreCsv(csvA); a.writeSummaryCsv(csvA);
+    b.writePrefixCsv(csvB); b.writeMoveCsv(csvB); b.writeScoreCsv(csvB); b.writeSummaryCsv(csvB);
+    check(csvA.str() == csvB.str(), "parallel aggregate equals serial aggregate");
+
+    check(a.getGames() == archive.size(), "every game counted");
+    check(a.getTotals().p1Wins == index.count({}, 1) && a.getTotals().draws == index.count({}, 0) &&
+          a.getTotals().p2Wins == index.count({}, -1), "totals match index");
+
+    // Per-prefix counts agree with the index
+    for (const auto& entry : a.getPrefixes()) {
+        auto prefix = tools::ArchiveStats::keyToMoves(entry.first);
+        check(entry.second.games() == index.count(prefix), "prefix games match index");
+        check(entry.second.p1Wins == index.count(prefix, 1), "prefix P1 wins match index");
+    }
+
+    std::cout << "✓ Statistics aggregation test passed\n";
+}
+
+static std::vector<char> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+template <typename T>
+static std::vector<T> readColumn(const std::string& dir, const std::string& name) {
+    std::vector<char> bytes = readFile((fs::path(dir) / (name + ".bin")).string());
+    std::vector<T> values(bytes.size() / sizeof(T));
+    std::memcpy(values.data(), bytes.data(), values.size() * sizeof(T));
+    return values;
+}
+
+void testFeatureExtraction(const std::string& dir) {
+    io::GameArchive archive(dir);
+    std::string serialDir = dir + "_features1";
+    std::string parallelDir = dir + "_features3";
+
+    ThreadPool pool1(1);
+    ThreadPool pool3(3);
+    tools::FeatureConfig serial;
+    tools::FeatureConfig parallel;
+    parallel.chunkGames = 7;
+
+    uint64_t rows = tools::extractArchiveFeatures(archive, serialDir, serial, pool1);
+    check(tools::extractArchiveFeatures(archive, parallelDir, parallel, pool3) == rows,
+          "row count independent of threads");
+
+    uint64_t expectedRows = 0;
+    for (uint64_t id = 0; id < archive.size(); id++) expectedRows += archive[id].numMoves;
+    check(rows == expectedRows, "one row per move");
+
+    for (const auto& column : tools::featureSchema()) {
+        std::string file = column.name + ".bin";
+        check(readFile((fs::path(serialDir) / file).string()) == readFile((fs::path(parallelDir) / file).string()),
+              "column identical for parallel extraction: " + column.name);
+    }
+
+    // Starting score plus every delta reproduces the final score
+    auto game = readColumn<uint32_t>(serialDir, "game");
+    auto ply = readColumn<uint8_t>(serialDir, "ply");
+    auto p1Score = readColumn<int32_t>(serialDir, "p1_score");
+    auto p1Delta = readColumn<int32_t>(serialDir, "p1_delta");
+    auto p2Score = readColumn<int32_t>(serialDir, "p2_score");
+    auto p2Delta = readColumn<int32_t>(serialDir, "p2_delta");
+    check(game.size() == rows && p1Delta.size() == rows, "column lengths");
+
+    for (size_t row = 0; row < rows; row++) {
+        const io::ArchiveRecord& record = archive[game[row]];
+        if (ply[row] + 1 == record.numMoves) {
+            check(p1Score[row] + p1Delta[row] == record.p1Score, "P1 deltas sum to final score");
+            check(p2Score[row] + p2Delta[row] == record.p2Score, "P2 deltas sum to final score");
+        }
+    }
+
+    fs::remove_all(serialDir);
+    fs::remove_all(parallelDir);
+    std::cout << "✓ Feature extraction test passed (" << rows << " rows)\n";
+}
+
+void testMalformedRecords(const std::string& dir) {
+    std::string badDir = dir + "_malformed";
+    std::string outDir = dir + "_malformed_features";
+    fs::remove_all(badDir);
+
+    std::mt19937 rng(77);
+    io::ArchiveRecord good = io::ArchiveRecord::fromGame(randomGame(rng));
+    io::ArchiveRecord tooLong = good;
+    tooLong.numMoves = 30;
+    io::ArchiveRecord badCode = good;
+    badCode.moves[1] = 200;
+    io::ArchiveRecord illegal = good;
+    illegal.moves[1] = illegal.moves[0];   // Same hex twice
+    check(good.isValid() && !tooLong.isValid() && !badCode.isValid() && illegal.isValid(),
+          "record range validation");
+    check(io::ArchiveRecord::unpackMove(200) == Move(), "out-of-range code unpacks to no move");
+    check(tooLong.getMoves().size() == static_cast<size_t>(io::ARCHIVE_MAX_MOVES), "getMoves stays in the record");
+
+    {
+        io::ArchiveWriter writer(badDir, "bad");
+        writer.append(tooLong);
+        writer.append(good);
+        writer.append(badCode);
+        writer.append(illegal);
+        writer.flush();
+    }
+
+    io::GameArchive archive(badDir);
+    ThreadPool pool(2);
+    uint64_t skipped = 0;
+    uint64_t rows = tools::extractArchiveFeatures(archive, outDir, tools::FeatureConfig(), pool, &skipped);
+    check(skipped == 3, "malformed records skipped");
+    check(rows == good.numMoves, "only the valid record extracted");
+    check(readColumn<uint32_t>(outDir, "game") == std::vector<uint32_t>(good.numMoves, 1), "rows keep the game id");
+
+    fs::remove_all(badDir);
+    fs::remove_all(outDir);
+    std::cout << "✓ Malformed record test passed\n";
+}
+
+int main() {
+    printHeader("Game Archive");
+
+    Zobrist::initialize();
+
+    std::string dir = (fs::temp_directory_path() / "hexuki_test_archive").string();
+    fs::remove_all(dir);
+
+    testPacking();
+    testWriteReadIndex(dir);
+    testTornRecordRecovery(dir);
+    testStatsAggregation(dir);
+    testFeatureExtraction(dir);
+    testMalformedRecords(dir);
+
+    fs::remove_all(dir);
+
+    return printSummary("archive");
+}
@@ -0,0 +1,205 @@
+#include "tools/batch_analysis.h"
+#include "api/batch_ops.h"
+#include "test_util.h"
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+
+static std::vector<std::string> lines(const std::string& text) {
+    std::vector<std::string> result;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) result.push_back(line);
+    return result;
+}
+
+// JSON output without node counts (they depend on what the shared table
+// already holds) and times
+static std::string results(const std::string& text) {
+    std::string result;
+    for (const std::string& line : lines(text)) {
+        size_t at = line.find(",\"nodes\":");
+        if (at == std::string::npos) at = line.find(",\"time_ms\":");
+        result += (at == std::string::npos ? line : line.substr(0, at)) + "\n";
+    }
+    return result;
+}
+
+// Endgame positions with `empty` hexes left, reached by varied move choices
+static std::string endgames(int count, int empty) {
+    std::string text = "# endgames\n";
+    for (int g = 0; g < count; g++) {
+        HexukiBitboard board;
+        for (int ply = 0; ply < 18 - empty; ply++) {
+            std::vector<Move> moves = board.getValidMoves();
+            board.makeMove(moves[(g * 7 + ply * 3) % moves.size()]);
+        }
+        text += board.savePosition() + "\n";
+    }
+    return text;
+}
+
+static std::string analyze(const std::string& input, const tools::AnalysisConfig& config, ThreadPool& pool,
+                           const std::string& existing = "", tools::AnalysisStats* stats = nullptr) {
+    tools::BatchAnalyzer analyzer(config, pool);
+    std::istringstream previous(existing);
+    analyzer.loadExisting(previous);
+
+    std::istringstream in(input);
+    tools::PositionReader reader(in, tools::PositionFormat::TEXT);
+    std::ostringstream out;
+    tools::AnalysisStats result = analyzer.run(reader, out, existing.empty());
+    if (stats) *stats = result;
+    return out.str();
+}
+
+void testReaders() {
+    std::istringstream text("# comment\n\nstartpos\nh7:5,h9:1|p1:1,2,3,4,6,7,8,9|p2:1,2,3,4,5,6,7,8,9|turn:2\nbogus\n");
+    tools::PositionReader textReader(text, tools::PositionFormat::TEXT);
+    std::vector<tools::PositionRecord> records;
+    tools::PositionRecord record;
+    while (textReader.next(record)) records.push_back(record);
+    check(records.size() == 3, "text: comments and blank lines are not records");
+    check(records.size() == 3 && records[1].index == 1 && records[1].board.getTileValue(7) == 5, "text: position read");
+    check(records.size() == 3 && !records[2].error.empty(), "text: unreadable line kept as an error record");
+
+    std::istringstream outOfRange("h9:1|p1:1,2,3,4,5,6,7,8,9,10,11,12|p2:1,2|turn:1\nh9:1,h4:10|turn:1\nh9:1|turn:3\n");
+    tools::PositionReader rangeReader(outOfRange, tools::PositionFormat::TEXT);
+    int rejected = 0;
+    while (rangeReader.next(record)) rejected += record.error.empty() ? 0 : 1;
+    check(rejected == 3, "text: out-of-range hands, tiles and turns are error records");
+
+    // Level arrays: board/tiles win over the (older, 1-indexed) position string
+    std::istringstream json(
+        "[{\"title\":\"a\",\"position\":\"h8:3|p1:1|p2:2|turn:1\",\"board\":[null,null,null,null,null,null,null,3,"
+        "null,null,null,null,null,null,null,null,null,null,null],\"p1Tiles\":[1,1],\"p2Tiles\":[2],"
+        "\"startingPlayer\":2},\n{\"position\":\"h4:6|p1:1,2|p2:3|turn:1\"},\n{\"title\":\"broken\"},\n"
+        "{\"board\":[null,null,null,null,null,null,null,12,null,null,null,null,null,null,null,null,null,null,null],"
+        "\"p1Tiles\":[1],\"p2Tiles\":[2]}]");
+    tools::PositionReader jsonReader(json, tools::PositionFormat::JSON);
+    records.clear();
+    while (jsonReader.next(record)) records.push_back(record);
+    check(records.size() == 4, "json: one record per level");
+    check(records.size() == 4 && records[0].board.getTileValue(7) == 3 && records[0].board.getTileValue(8) == 0 &&
+              records[0].board.getCurrentPlayer() == PLAYER_2,
+          "json: level board, tiles and starting player");
+    check(records.size() == 4 && records[1].board.getTileValue(4) == 6, "json: position-only level");
+    check(records.size() == 4 && !records[2].error.empty(), "json: level without a position is an error record");
+    check(records.size() == 4 && !records[3].error.empty(), "json: out-of-range board value is an error record");
+
+    HexukiBitboard start;
+    HexukiBitboard next = start;
+    next.makeMove(next.getValidMoves()[3]);
+    int32_t packed[2 * api::POSITION_STRIDE];
+    api::packPosition(start, 0, packed);
+    api::packPosition(next, 1, packed + api::POSITION_STRIDE);
+    std::string bytes(reinterpret_cast<const char*>(packed), sizeof(packed));
+    std::istringstream binary(bytes + bytes.substr(0, 10));
+    tools::PositionReader packedReader(binary, tools::PositionFormat::PACKED);
+    records.clear();
+    while (packedReader.next(record)) records.push_back(record);
+    check(records.size() == 3, "packed: one record per stride, truncated tail included");
+    check(records.size() == 3 && records[1].board.savePosition() == next.savePosition(), "packed: position read");
+    check(records.size() == 3 && !records[2].error.empty(), "packed: truncated record is an error");
+
+    check(tools::PositionReader::formatForPath("levels/a.json") == tools::PositionFormat::JSON &&
+              tools::PositionReader::formatForPath("batch.bin") == tools::PositionFormat::PACKED &&
+              tools::PositionReader::formatForPath("-") == tools::PositionFormat::TEXT,
+          "format from the file extension");
+
+    std::cout << "✓ Reader test passed\n";
+}
+
+void testOrderingAndThreads() {
+    ThreadPool one(1);
+    ThreadPool three(3);
+    std::string input = endgames(12, 6) + "not a position\n";
+
+    tools::AnalysisConfig config;
+    config.engine = tools::AnalysisEngine::SOLVE;
+    config.ttSizeMB = 16;
+    config.verbose = false;
+
+    tools::AnalysisStats stats;
+    std::string serial = analyze(input, config, one, "", &stats);
+    std::string parallel = analyze(input, config, three);
+    check(stats.read == 13 && stats.analyzed == 13 && stats.errors == 1, "every record answered");
+    check(results(serial) == results(parallel), "ordered solve output independent of threads");
+
+    std::vector<std::string> rows = lines(serial);
+    size_t index = 99;
+    check(rows.size() == 13 && tools::parseAnalysisIndex(rows[5], index) && index == 5, "ordered by input index");
+    check(rows.back().find("\"error\"") != std::string::npos, "error record in place");
+
+    config.ordered = false;
+    std::vector<std::string> unordered = lines(results(analyze(input, config, three)));
+    std::vector<std::string> ordered = lines(results(serial));
+    std::sort(unordered.begin(), unordered.end());
+    std::sort(ordered.begin(), ordered.end());
+    check(unordered == ordered, "unordered output has the same records");
+
+    // Seeded MCTS: position i uses seed + i, whichever thread runs it
+    config.ordered = true;
+    config.engine = tools::AnalysisEngine::MCTS;
+    config.sims = 300;
+    check(results(analyze(input, config, one)) == results(analyze(input, config, three)),
+          "seeded MCTS output independent of threads");
+
+    config.engine = tools::AnalysisEngine::MINIMAX;
+    config.depth = 3;
+    rows = lines(analyze(input, config, three));
+    check(rows.size() == 13 && rows[0].find("\"depth\":3") != std::string::npos, "minimax depth budget");
+
+    std::cout << "✓ Ordering and thread test passed\n";
+}
+
+void testResumeAndCsv() {
+    ThreadPool pool(2);
+    std::string input = endgames(10, 5);
+
+    tools::AnalysisConfig config;
+    config.engine = tools::AnalysisEngine::SOLVE;
+    config.ttSizeMB = 16;
+    config.verbose = false;
+
+    std::string full = analyze(input, config, pool);
+    std::vector<std::string> rows = lines(full);
+    size_t index;
+
+    // Interrupted after four rows (hexuki_analyze cuts a partial last line off first)
+    std::string partial = rows[0] + "\n" + rows[1] + "\n" + rows[2] + "\n" + rows[3] + "\n";
+    tools::AnalysisStats stats;
+    std::string rest = analyze(input, config, pool, partial, &stats);
+    check(stats.skipped == 4 && stats.analyzed == 6, "resume skips written records only");
+    check(results(partial + rest) == results(full), "resumed output completes the file");
+
+    std::set<size_t> seen;
+    for (const std::string& row : lines(rest)) {
+        if (tools::parseAnalysisIndex(row, index)) seen.insert(index);
+    }
+    check(seen.size() == 6 && *seen.begin() == 4, "resumed records not repeated");
+
+    config.output = tools::OutputFormat::CSV;
+    rows = lines(analyze(input, config, pool));
+    check(rows.size() == 11 && rows[0] == tools::csvHeader(config), "CSV header");
+    check(!tools::parseAnalysisIndex(rows[0], index), "header is not a record");
+    check(tools::parseAnalysisIndex(rows[3], index) && index == 2 && rows[3].find(",\"h") != std::string::npos,
+          "CSV rows with quoted positions");
+
+    std::cout << "✓ Resume and CSV test passed\n";
+}
+
+int main() {
+    printHeader("Batch Analysis");
+
+    testReaders();
+    testOrderingAndThreads();
+    testResumeAndCsv();
+
+    return printSummary("batch analysis");
+}
@@ -0,0 +1,219 @@
+#include "api/batch_ops.h"
+#include "test_util.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+using namespace hexuki::api;
+
+static bool contains(const std::vector<Move>& moves, int hexId, int tileValue) {
+    return std::find(moves.begin(), moves.end(), Move(hexId, tileValue)) != moves.end();
+}
+
+void testPackRoundTrip() {
+    HexukiBitboard board;
+    board.makeMove(Move(7, 5));
+    board.makeMove(Move(4, 3));
+    board.makeMove(Move(12, 9));
+
+    int32_t record[POSITION_STRIDE];
+    packPosition(board, 3, record);
+    check(record[POS_MOVE_COUNT] == 3 && record[POS_PLAYER] == board.getCurrentPlayer(), "header fields packed");
+    check(record[POS_P1_TILE_COUNT] == 7 && record[POS_P2_TILE_COUNT] == 8, "hands packed");
+
+    HexukiBitboard copy = unpackPosition(record);
+    check(copy.savePosition() == board.savePosition(), "unpacked position equals the original");
+
+    std::vector<Move> expected = board.getValidMoves();
+    std::vector<Move> actual = copy.getValidMoves();
+    check(expected == actual, "unpacked position has the same moves");
+
+    std::cout << "✓ Position record round trip test passed\n";
+}
+
+void testAntiSymmetry() {
+    HexukiBitboard board;
+    std::vector<Move> moves;
+
+    // First move is exempt: h4 is on the center column, so 4:x leaves the board mirrored
+    getV2ValidMoves(board, 0, moves);
+    check(moves == board.getValidMoves(), "first move unrestricted");
+
+    // P1 plays 7:5; P2 answering 6:5 would mirror it
+    board.makeMove(Move(7, 5));
+    getV2ValidMoves(board, 1, moves);
+    check(!contains(moves, 6, 5), "mirroring move excluded");
+    check(contains(moves, 6, 4), "non-mirroring move on the mirror hex kept");
+    check(moves.size() + 1 == board.getValidMoves().size(), "only the mirroring move excluded");
+
+    // Once a pair holds different tiles, symmetry can never return
+    board.makeMove(Move(6, 4));
+    getV2ValidMoves(board, 2, moves);
+    check(moves == board.getValidMoves(), "no restriction once symmetry is broken");
+
+    HexukiBitboard mirrored;
+    mirrored.makeMove(Move(7, 5));
+    mirrored.makeMove(Move(6, 5));
+    check(isBoardMirrored(mirrored) && !isBoardMirrored(board), "mirror detection");
+
+    std::cout << "✓ Anti-symmetry rule test passed\n";
+}
+
+void testBatches() {
+    const int count = 40;
+    std::vector<int32_t> positions(count * POSITION_STRIDE);
+    for (int i = 0; i < count; i++) {
+        HexukiBitboard board;
+        for (int ply = 0; ply < i % 6; ply++) {
+            std::vector<Move> moves;
+            getV2ValidMoves(board, ply, moves);
+            board.makeMove(moves[(i + ply * 5) % moves.size()]);
+        }
+        packPosition(board, i % 6, positions.data() + i * POSITION_STRIDE);
+    }
+
+    std::vector<int32_t> out;
+    batchValidMoves(positions.data(), count, out);
+    size_t offset = 0;
+    bool same = true;
+    for (int i = 0; i < count; i++) {
+        const int32_t* record = positions.data() + i * POSITION_STRIDE;
+        std::vector<Move> moves;
+        getV2ValidMoves(unpackPosition(record), record[POS_MOVE_COUNT], moves);
+        same = same && out[offset] == static_cast<int32_t>(moves.size());
+        for (size_t m = 0; m < moves.size() && same; m++) {
+            same = out[offset + 1 + m * 2] == moves[m].hexId && out[offset + 2 + m * 2] == moves[m].tileValue;
+        }
+        offset += 1 + moves.size() * 2;
+    }
+    check(same && offset == out.size(), "batched moves match per-position moves");
+
+    std::vector<int32_t> playouts;
+    batchPlayouts(positions.data(), count, 99, playouts);
+    check(playouts.size() == static_cast<size_t>(count) * PLAYOUT_STRIDE, "one record per playout");
+
+    bool legal = true;
+    for (int i = 0; i < count; i++) {
+        const int32_t* record = positions.data() + i * POSITION_STRIDE;
+        const int32_t* result = playouts.data() + i * PLAYOUT_STRIDE;
+        HexukiBitboard board = unpackPosition(record);
+        int moveCount = record[POS_MOVE_COUNT];
+        for (int m = 0; m < result[PLAYOUT_MOVE_COUNT]; m++) {
+            Move move(result[PLAYOUT_MOVES + m * MOVE_STRIDE], result[PLAYOUT_MOVES + m * MOVE_STRIDE + 1]);
+            std::vector<Move> moves;
+            getV2ValidMoves(board, moveCount++, moves);
+            legal = legal && contains(moves, move.hexId, move.tileValue);
+            board.makeMove(move);
+        }
+        int p1Score, p2Score;
+        board.getScores(p1Score, p2Score);
+        legal = legal && moveCount == V2_GAME_MOVES &&
+                result[PLAYOUT_P1_SCORE] == p1Score && result[PLAYOUT_P2_SCORE] == p2Score;
+    }
+    check(legal, "playouts are legal, run to the end and report final scores");
+
+    std::vector<int32_t> again;
+    batchPlayouts(positions.data(), count, 99, again);
+    check(again == playouts, "playouts reproducible by seed");
+    std::vector<int32_t> tail;
+    batchPlayouts(positions.data() + POSITION_STRIDE, 1, 100, tail);
+    check(std::equal(tail.begin(), tail.end(), playouts.begin() + PLAYOUT_STRIDE), "position i uses seed + i");
+
+    std::vector<int32_t> scores;
+    batchScores(positions.data(), count, scores);
+    int p1Score, p2Score;
+    unpackPosition(positions.data() + 5 * POSITION_STRIDE).getScores(p1Score, p2Score);
+    check(scores.size() == count * 2u && scores[10] == p1Score && scores[11] == p2Score, "batched scores");
+
+    std::cout << "✓ Batch operations test passed\n";
+}
+
+void testInvalidRecords() {
+    // Records written by JS are not trusted: bad ones give empty results and
+    // do not disturb their neighbours
+    std::vector<int32_t> positions(3 * POSITION_STRIDE);
+    for (int i = 0; i < 3; i++) packPosition(HexukiBitboard(), 0, positions.data() + i * POSITION_STRIDE);
+    int32_t* bad = positions.data() + POSITION_STRIDE;
+    bad[POS_P1_TILES] = 12;
+    bad[POS_HEX_VALUES + 4] = 10;
+
+    std::vector<int32_t> moves;
+    batchValidMoves(positions.data(), 3, moves);
+    int32_t first = moves[0];
+    check(moves[1 + first * 2] == 0, "invalid record has no moves");
+    check(moves.size() == 3 + 4u * first && moves[2 + first * 2] == first, "valid records around it unchanged");
+
+    std::vector<int32_t> scores;
+    batchScores(positions.data(), 3, scores);
+    check(scores[2] == 0 && scores[3] == 0, "invalid record scores zero");
+
+    std::vector<int32_t> playouts;
+    batchPlayouts(positions.data(), 3, 1, playouts);
+    check(playouts[PLAYOUT_STRIDE + PLAYOUT_MOVE_COUNT] == 0, "invalid record plays no moves");
+    check(playouts[PLAYOUT_MOVE_COUNT] > 0 && playouts[2 * PLAYOUT_STRIDE + PLAYOUT_MOVE_COUNT] > 0,
+          "valid records still played out");
+
+    bad[POS_HEX_VALUES + 4] = 0;
+    bad[POS_P1_TILES] = 1;
+    bad[POS_PLAYER] = 3;
+    batchValidMoves(positions.data(), 3, moves);
+    check(moves[1 + first * 2] == 0, "invalid player rejected");
+
+    std::cout << "✓ Invalid record test passed\n";
+}
+
+/**
+ * --reference: print seeded random games as JSON for
+ * tests/wasm/js_engine_parity.js, which replays them on
+ * hexuki_game_engine_v2.js: the legal moves before every ply (in the JS
+ * engine's order), the move played and the final scores.
+ */
+static void printReference() {
+    const int games = 12;
+    std::vector<int32_t> positions(games * POSITION_STRIDE);
+    for (int i = 0; i < games; i++) {
+        packPosition(HexukiBitboard(), 0, positions.data() + i * POSITION_STRIDE);
+    }
+    std::vector<int32_t> playouts;
+    batchPlayouts(positions.data(), games, 2024, playouts);
+
+    std::cout << "[";
+    for (int i = 0; i < games; i++) {
+        const int32_t* result = playouts.data() + i * PLAYOUT_STRIDE;
+        HexukiBitboard board;
+        std::cout << (i ? "," : "") << "\n  {\"plies\":[";
+        for (int m = 0; m < result[PLAYOUT_MOVE_COUNT]; m++) {
+            std::vector<Move> moves;
+            getV2ValidMoves(board, m, moves);
+            std::cout << (m ? "," : "") << "\n    {\"legal\":[";
+            for (size_t k = 0; k < moves.size(); k++) {
+                std::cout << (k ? "," : "") << moves[k].hexId << "," << moves[k].tileValue;
+            }
+            Move move(result[PLAYOUT_MOVES + m * MOVE_STRIDE], result[PLAYOUT_MOVES + m * MOVE_STRIDE + 1]);
+            std::cout << "],\"move\":[" << move.hexId << "," << move.tileValue << "]}";
+            board.makeMove(move);
+        }
+        std::cout << "],\n   \"player1\":" << result[PLAYOUT_P1_SCORE]
+                  << ",\"player2\":" << result[PLAYOUT_P2_SCORE] << "}";
+    }
+    std::cout << "\n]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--reference") == 0) {
+        printReference();
+        return 0;
+    }
+
+    printHeader("Batch Operations");
+
+    testPackRoundTrip();
+    testAntiSymmetry();
+    testBatches();
+    testInvalidRecords();
+
+    return printSummary("batch operations");
+}
@@ -0,0 +1,150 @@
+#include "core/board_kernels.h"
+#include "core/bitboard.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+
+// Board with the given hexes occupied (arbitrary values 1-9)
+static HexukiBitboard boardWith(uint32_t occupied, std::mt19937& rng) {
+    HexukiBitboard board;
+    board.clearBoard();
+    for (int hex = 0; hex < NUM_HEXES; hex++) {
+        if (occupied & (1u << hex)) board.setHexValue(hex, 1 + static_cast<int>(rng() % 9));
+    }
+    return board;
+}
+
+// Legal hexes according to the original per-hex rules (isValidMove walks the chains)
+static uint32_t referenceLegalMask(const HexukiBitboard& board) {
+    int tiles[NUM_TILES_PER_PLAYER];
+    int tileCount = board.getUniqueTiles(tiles);
+    uint32_t mask = 0;
+    for (int hex = 0; hex < NUM_HEXES && tileCount > 0; hex++) {
+        if (board.isValidMove(Move(hex, tiles[0]))) mask |= 1u << hex;
+    }
+    return mask;
+}
+
+static void referenceScores(const HexukiBitboard& board, int& p1, int& p2) {
+    p1 = 0;
+    p2 = 0;
+    for (int chain = 0; chain < 5; chain++) {
+        int a = 1, b = 1;
+        for (int k = 0; k < 5; k++) {
+            int h1 = P1_CHAINS[chain][k], h2 = P2_CHAINS[chain][k];
+            if (h1 >= 0 && board.isHexOccupied(h1)) a *= board.getTileValue(h1);
+            if (h2 >= 0 && board.isHexOccupied(h2)) b *= board.getTileValue(h2);
+        }
+        p1 += a;
+        p2 += b;
+    }
+}
+
+void testLegalMasks() {
+    std::mt19937 rng(12345);
+    int tested = 0;
+    for (int i = 0; i < 20000; i++) {
+        // Random (often unreachable) occupancies stress every chain pattern
+        uint32_t occupied = rng() & kernels::ALL_HEXES_MASK;
+        if (i % 2) occupied &= rng();
+        HexukiBitboard board = boardWith(occupied, rng);
+
+        uint32_t simd = kernels::legalHexMask(occupied);
+        uint32_t scalar = kernels::scalar::legalHexMask(occupied);
+        if (simd != scalar || scalar != referenceLegalMask(board)) {
+            check(false, "legal mask mismatch for occupancy " + std::to_string(occupied));
+            break;
+        }
+        if (kernels::frontierMask(occupied) != kernels::scalar::frontierMask(occupied)) {
+            check(false, "frontier mask mismatch for occupancy " + std::to_string(occupied));
+            break;
+        }
+        tested++;
+    }
+    check(tested == 20000, "all random occupancies agree");
+
+    std::cout << "✓ Legal mask parity test passed (" << kernels::simdName() << ")\n";
+}
+
+void testScores() {
+    std::mt19937 rng(777);
+    bool agree = true;
+    for (int i = 0; i < 20000 && agree; i++) {
+        HexukiBitboard board = boardWith(rng() & kernels::ALL_HEXES_MASK, rng);
+        int p1, p2, s1, s2, r1, r2;
+        board.getScores(p1, p2);
+        uint8_t values[NUM_HEXES];
+        for (int hex = 0; hex < NUM_HEXES; hex++) values[hex] = static_cast<uint8_t>(board.getTileValue(hex));
+        kernels::scalar::chainScores(values, s1, s2);
+        referenceScores(board, r1, r2);
+        agree = p1 == s1 && p2 == s2 && p1 == r1 && p2 == r2 &&
+                board.getScore(PLAYER_1) == r1 && board.getScore(PLAYER_2) == r2;
+    }
+    check(agree, "chain scores match the reference");
+
+    std::cout << "✓ Chain score parity test passed\n";
+}
+
+void testGameplay() {
+    // Real games: move lists and rollout indexing stay in getValidMoves() order
+    std::mt19937 rng(99);
+    bool ordered = true;
+    for (int game = 0; game < 200; game++) {
+        HexukiBitboard board;
+        while (!board.isGameOver()) {
+            auto moves = board.getValidMoves();
+            if (moves.empty()) break;
+
+            uint32_t legal = board.getLegalHexMask();
+            int tiles[NUM_TILES_PER_PLAYER];
+            int tileCount = board.getUniqueTiles(tiles);
+            if (static_cast<int>(moves.size()) != kernels::popCount(legal) * tileCount) ordered = false;
+            for (size_t i = 0; i < moves.size() && ordered; i++) {
+                Move indexed(kernels::nthSetBit(legal, static_cast<int>(i) / tileCount), tiles[i % tileCount]);
+                if (!(indexed == moves[i])) ordered = false;
+            }
+            board.makeMove(moves[rng() % moves.size()]);
+        }
+    }
+    check(ordered, "rollout indexing matches getValidMoves order");
+
+    std::cout << "✓ Gameplay parity test passed\n";
+}
+
+void testOutOfRangeHands() {
+    // Move generation writes into fixed buffers: oversized or out-of-range
+    // hands and tile values must not reach it
+    HexukiBitboard board;
+    board.loadPosition("h9:1|p1:1,2,3,4,5,6,7,8,9,10,11,12|p2:1,2|turn:1");
+    check(board.getAvailableTiles(PLAYER_1).size() == 9, "oversized hand ignored");
+    Move moves[MAX_LEGAL_MOVES];
+    check(board.getValidMoves(moves) <= MAX_LEGAL_MOVES, "move count within MAX_LEGAL_MOVES");
+
+    board.setAvailableTiles(PLAYER_2, {1, 0});
+    board.setAvailableTiles(PLAYER_2, {3, 12});
+    check(board.getAvailableTiles(PLAYER_2) == std::vector<int>({1, 2}), "tile values outside 1-9 ignored");
+    board.setAvailableTiles(PLAYER_2, {1, 1, 1, 1, 1, 1, 1, 1, 1});
+    check(board.getAvailableTiles(PLAYER_2).size() == 9, "duplicate hands still accepted");
+
+    uint64_t hash = board.getHash();
+    board.setHexValue(4, 10);
+    board.setHexValue(4, 0);
+    check(!board.isHexOccupied(4) && board.getHash() == hash, "hex values outside 1-9 ignored");
+
+    std::cout << "✓ Out-of-range hand test passed\n";
+}
+
+int main() {
+    printHeader("Board Kernel");
+
+    testLegalMasks();
+    testScores();
+    testGameplay();
+    testOutOfRangeHands();
+
+    return printSummary("board kernel");
+}
@@ -0,0 +1,153 @@
+#include "api/hexuki_c.h"
+#include "api/batch_ops.h"
+#include "test_util.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+
+void testBoards() {
+    check(hexuki_abi_version() == HEXUKI_ABI_VERSION, "ABI version");
+
+    hexuki_board* board = hexuki_board_create();
+    check(board != nullptr, "board created");
+    check(hexuki_board_make_move(board, 7, 5) == HEXUKI_OK, "legal move accepted");
+    check(hexuki_board_make_move(board, 0, 5) == HEXUKI_ERROR_ILLEGAL_MOVE, "illegal move rejected");
+    check(std::strlen(hexuki_last_error()) > 0, "error message set");
+
+    char position[256];
+    int length = hexuki_board_save(board, position, sizeof(position));
+    check(length > 0 && static_cast<int>(std::strlen(position)) == length, "position saved");
+    check(hexuki_board_save(board, position, 4) == HEXUKI_ERROR_BUFFER_TOO_SMALL, "short buffer reported");
+
+    int32_t record[HEXUKI_POSITION_STRIDE];
+    check(hexuki_board_pack(board, record) == HEXUKI_OK, "board packed");
+    check(record[api::POS_MOVE_COUNT] == 1 && record[api::POS_HEX_VALUES + 7] == 5, "packed move count and tile");
+
+    hexuki_board* copy = hexuki_board_create();
+    std::string saved(position, length);
+    check(hexuki_board_load(copy, saved.c_str()) == HEXUKI_OK, "position loaded");
+    check(hexuki_board_load(copy, "hx:yy") == HEXUKI_ERROR_INVALID_ARGUMENT, "malformed position rejected");
+    check(hexuki_board_undo_move(board) == HEXUKI_OK && hexuki_board_undo_move(board) == HEXUKI_ERROR_ILLEGAL_MOVE,
+          "undo to the start, then nothing to undo");
+
+    hexuki_board_destroy(copy);
+    hexuki_board_destroy(board);
+    hexuki_board_destroy(nullptr);
+
+    std::cout << "✓ Board handle test passed\n";
+}
+
+void testBatches() {
+    const int count = 8;
+    std::vector<int32_t> positions(count * HEXUKI_POSITION_STRIDE);
+    for (int i = 0; i < count; i++) {
+        hexuki_position_init(positions.data() + i * HEXUKI_POSITION_STRIDE);
+    }
+
+    // Advance position i by i random moves
+    std::vector<int32_t> playouts(count * HEXUKI_PLAYOUT_STRIDE);
+    check(hexuki_batch_playouts(positions.data(), count, 5, playouts.data()) == HEXUKI_OK, "playouts run");
+    for (int i = 0; i < count; i++) {
+        HexukiBitboard board;
+        for (int m = 0; m < i; m++) {
+            const int32_t* move = playouts.data() + i * HEXUKI_PLAYOUT_STRIDE + api::PLAYOUT_MOVES + m * 2;
+            board.makeMove(Move(move[0], move[1]));
+        }
+        api::packPosition(board, i, positions.data() + i * HEXUKI_POSITION_STRIDE);
+    }
+
+    std::vector<int32_t> moves(count * HEXUKI_MOVES_STRIDE);
+    check(hexuki_batch_valid_moves(positions.data(), count, moves.data()) == HEXUKI_OK, "moves generated");
+    bool same = true;
+    for (int i = 0; i < count; i++) {
+        const int32_t* record = positions.data() + i * HEXUKI_POSITION_STRIDE;
+        std::vector<Move> expected;
+        api::getV2ValidMoves(api::unpackPosition(record), record[api::POS_MOVE_COUNT], expected);
+        const int32_t* result = moves.data() + i * HEXUKI_MOVES_STRIDE;
+        same = same && result[0] == static_cast<int32_t>(expected.size());
+        for (size_t m = 0; m < expected.size() && same; m++) {
+            same = result[1 + m * 2] == expected[m].hexId && result[2 + m * 2] == expected[m].tileValue;
+        }
+    }
+    check(same, "fixed-stride move records match the batch layer");
+
+    std::vector<int32_t> scores(count * HEXUKI_SCORES_STRIDE);
+    check(hexuki_batch_scores(positions.data(), count, scores.data()) == HEXUKI_OK, "scores computed");
+    int p1Score, p2Score;
+    api::unpackPosition(positions.data() + 3 * HEXUKI_POSITION_STRIDE).getScores(p1Score, p2Score);
+    check(scores[6] == p1Score && scores[7] == p2Score, "batched scores");
+
+    std::vector<double> searches(count * HEXUKI_SEARCH_STRIDE);
+    check(hexuki_batch_minimax(positions.data(), count, 2, 60000, searches.data()) == HEXUKI_OK, "minimax batch");
+    bool found = true;
+    for (int i = 0; i < count; i++) {
+        const double* result = searches.data() + i * HEXUKI_SEARCH_STRIDE;
+        found = found && result[api::FIELD_ENGINE] == 2 && result[api::FIELD_DEPTH] == 2 && result[api::FIELD_HEX] >= 0;
+    }
+    check(found, "one minimax result per position");
+
+    std::vector<double> again(count * HEXUKI_SEARCH_STRIDE);
+    check(hexuki_batch_mcts(positions.data(), count, 200, 11, searches.data()) == HEXUKI_OK &&
+          hexuki_batch_mcts(positions.data(), count, 200, 11, again.data()) == HEXUKI_OK, "MCTS batch");
+    bool reproducible = true;
+    for (int i = 0; i < count; i++) {
+        for (int f : {api::FIELD_HEX, api::FIELD_TILE, api::FIELD_WORK, api::FIELD_VISITS, api::FIELD_WIN_RATE}) {
+            reproducible = reproducible && searches[i * HEXUKI_SEARCH_STRIDE + f] == again[i * HEXUKI_SEARCH_STRIDE + f];
+        }
+    }
+    check(reproducible, "seeded MCTS batch is reproducible");
+
+    std::cout << "✓ Batch entry points test passed\n";
+}
+
+void testBadInput() {
+    int32_t record[HEXUKI_POSITION_STRIDE];
+    int32_t out[HEXUKI_MOVES_STRIDE];
+    hexuki_position_init(record);
+    check(hexuki_batch_valid_moves(record, -1, out) == HEXUKI_ERROR_INVALID_ARGUMENT, "negative count");
+    check(hexuki_batch_valid_moves(nullptr, 1, out) == HEXUKI_ERROR_INVALID_ARGUMENT, "null positions");
+    check(hexuki_batch_valid_moves(record, 0, nullptr) == HEXUKI_OK, "empty batch");
+
+    record[api::POS_PLAYER] = 3;
+    check(hexuki_batch_scores(record, 1, out) == HEXUKI_ERROR_INVALID_ARGUMENT, "bad player rejected");
+    hexuki_position_init(record);
+    record[api::POS_P1_TILE_COUNT] = 12;
+    check(hexuki_batch_playouts(record, 1, 1, out) == HEXUKI_ERROR_INVALID_ARGUMENT, "bad hand rejected");
+
+    hexuki_board* board = hexuki_board_create();
+    const char* badPositions[] = {
+        "h9:1|p1:1,2,3,4,5,6,7,8,9,1|turn:1",  // 10 tiles
+        "h9:1|p1:1,2,12|turn:1",                // tile value
+        "h9:10|turn:1",                         // hex value
+        "h19:1|turn:1",                         // hex id
+        "h9:1|turn:3",                          // player
+        "h9:x|turn:1",                          // not a number
+        "h9:1|q:1",                             // unknown section
+    };
+    for (const char* position : badPositions) {
+        check(hexuki_board_load(board, position) == HEXUKI_ERROR_INVALID_ARGUMENT,
+              std::string("bad position rejected: ") + position);
+    }
+    char saved[256];
+    hexuki_board_save(board, saved, sizeof(saved));
+    HexukiBitboard start;
+    check(std::string(saved) == start.savePosition(), "rejected position leaves the board unchanged");
+    check(hexuki_board_load(board, "h9:1,h4:1|p1:1,1,1,1,1,1,1,1,1|p2:|turn:2") == HEXUKI_OK,
+          "duplicate and empty hands accepted");
+    hexuki_board_destroy(board);
+
+    std::cout << "✓ Bad input test passed\n";
+}
+
+int main() {
+    printHeader("C ABI");
+
+    testBoards();
+    testBatches();
+    testBadInput();
+
+    return printSummary("C ABI");
+}
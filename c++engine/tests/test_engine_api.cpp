@@ -0,0 +1,207 @@
+#include "api/engine_instance.h"
+#include "test_util.h"
+#include <iostream>
+#include <string>
+
+using namespace hexuki;
+using namespace hexuki::api;
+
+void testIndependentInstances() {
+    InstanceRegistry registry;
+    InstanceHandle a = registry.create();
+    InstanceHandle b = registry.create();
+    check(a != INVALID_HANDLE && b != INVALID_HANDLE && a != b, "distinct valid handles");
+    check(registry.size() == 2, "registry counts instances");
+
+    EngineInstance* engineA = registry.get(a);
+    EngineInstance* engineB = registry.get(b);
+    Move first = engineA->getBoard().getValidMoves()[0];
+    check(engineA->makeMove(first), "legal move accepted");
+    check(engineA->getBoard().savePosition() != engineB->getBoard().savePosition(),
+          "moves on one instance do not touch another");
+    check(engineB->getHistory().empty(), "other instance history untouched");
+
+    std::cout << "✓ Independent instances test passed\n";
+}
+
+void testUndoStack() {
+    EngineInstance engine;
+    std::string start = engine.getBoard().savePosition();
+    std::vector<std::string> positions;
+
+    for (int i = 0; i < 6 && !engine.getBoard().isGameOver(); i++) {
+        positions.push_back(engine.getBoard().savePosition());
+        check(engine.makeMove(engine.getBoard().getValidMoves().back()), "move accepted");
+    }
+    check(engine.getHistory().size() == positions.size(), "history records every move");
+    check(!engine.makeMove(Move(-1, 0)), "illegal move rejected");
+    check(engine.getHistory().size() == positions.size(), "illegal move not recorded");
+
+    while (!positions.empty()) {
+        check(engine.undoMove(), "undo succeeds");
+        check(engine.getBoard().savePosition() == positions.back(), "undo restores the previous position");
+        positions.pop_back();
+    }
+    check(!engine.undoMove(), "undo past the start fails");
+    check(engine.getBoard().savePosition() == start, "back at the start");
+
+    // Loading a position starts a new history
+    engine.makeMove(engine.getBoard().getValidMoves()[0]);
+    std::string saved = engine.getBoard().savePosition();
+    engine.reset();
+    engine.loadPosition(saved);
+    check(engine.getHistory().empty() && !engine.undoMove(), "loadPosition clears history");
+
+    std::cout << "✓ Undo stack test passed\n";
+}
+
+void testStaleHandles() {
+    InstanceRegistry registry;
+    InstanceHandle a = registry.create();
+    check(registry.destroy(a), "destroy live handle");
+    check(!registry.destroy(a), "double destroy rejected");
+    check(registry.get(a) == nullptr, "destroyed handle resolves to nothing");
+    check(registry.get(INVALID_HANDLE) == nullptr, "invalid handle resolves to nothing");
+
+    InstanceHandle b = registry.create();
+    check(b != a, "handles are not reused");
+
+    std::cout << "✓ Stale handle test passed\n";
+}
+
+void testSearch() {
+    EngineInstance engine;
+    engine.makeMove(engine.getBoard().getValidMoves()[0]);
+    std::string before = engine.getBoard().savePosition();
+
+    minimax::SearchResult mm = engine.runMinimax(2, 5000);
+    check(engine.getBoard().isValidMove(mm.bestMove), "minimax returns a legal move");
+
+    mcts::MCTSConfig config;
+    config.numSimulations = 200;
+    config.verbose = false;
+    mcts::MCTSResult mc = engine.runMCTS(config);
+    check(engine.getBoard().isValidMove(mc.bestMove), "MCTS returns a legal move");
+
+    check(engine.getBoard().savePosition() == before, "search leaves the position unchanged");
+    check(engine.getHistory().size() == 1, "search leaves the history unchanged");
+
+    std::cout << "✓ Instance search test passed\n";
+}
+
+void testIncrementalSearch() {
+    EngineInstance engine;
+    engine.makeMove(engine.getBoard().getValidMoves()[0]);
+
+    // Minimax in small node slices gives exactly the blocking result
+    minimax::SearchConfig config;
+    config.maxDepth = 4;
+    config.timeLimitMs = 60000;
+    engine.beginMinimaxSearch(config);
+    check(engine.getSearchEngine() == SearchEngine::MINIMAX && !engine.isSearchDone(), "minimax search started");
+    int steps = 0;
+    int lastDepth = 0;
+    bool depthMonotonic = true;
+    while (!engine.stepSearch(0, 500)) {
+        steps++;
+        int depth = engine.peekMinimax().depth;
+        if (depth < lastDepth) depthMonotonic = false;
+        lastDepth = depth;
+    }
+    check(steps > 1, "minimax search spans several steps");
+    check(depthMonotonic, "peeked depth never goes backwards");
+    minimax::SearchResult sliced = engine.peekMinimax();
+    minimax::SearchResult blocking = engine.runMinimax(4, 60000);
+    check(sliced.bestMove == blocking.bestMove && sliced.score == blocking.score &&
+          sliced.nodesSearched == blocking.nodesSearched, "sliced minimax matches blocking search");
+    check(engine.getSearchEngine() == SearchEngine::NONE, "blocking search abandons the incremental one");
+
+    // MCTS steps respect the work budget
+    mcts::MCTSConfig mctsConfig;
+    mctsConfig.numSimulations = 200;
+    mctsConfig.useTimeLimit = false;
+    engine.beginMCTSSearch(mctsConfig);
+    check(!engine.stepSearch(0, 50), "MCTS not finished after one slice");
+    check(engine.peekMCTS().simulations == 50, "MCTS slice runs the requested simulations");
+    check(engine.getBoard().isValidMove(engine.peekMCTS().bestMove), "MCTS peek returns a legal move");
+    while (!engine.stepSearch(5.0, 0)) {
+    }
+    check(engine.peekMCTS().simulations == 200, "MCTS stops at its simulation limit");
+
+    // finishSearch stops early and keeps the result
+    engine.beginMinimaxSearch(config);
+    engine.stepSearch(0, 300);
+    engine.finishSearch();
+    check(engine.isSearchDone() && engine.stepSearch(0, 100), "finished search does not resume");
+    check(engine.peekMinimax().nodesSearched >= 0, "result readable after finish");
+
+    // Changing the position abandons the search
+    engine.beginMCTSSearch(mctsConfig);
+    engine.makeMove(engine.getBoard().getValidMoves()[0]);
+    check(engine.getSearchEngine() == SearchEngine::NONE, "move abandons the search");
+
+    std::cout << "✓ Incremental search test passed\n";
+}
+
+void testPackedResults() {
+    EngineInstance engine;
+    auto moves = engine.getBoard().getValidMoves();
+    const std::vector<int32_t>& packed = engine.packValidMoves();
+    check(packed.size() == moves.size() * MOVE_STRIDE, "packed move count");
+    bool same = true;
+    for (size_t i = 0; i < moves.size(); i++) {
+        if (packed[i * MOVE_STRIDE] != moves[i].hexId || packed[i * MOVE_STRIDE + 1] != moves[i].tileValue) same = false;
+    }
+    check(same, "packed moves match getValidMoves");
+    const int32_t* before = packed.data();
+    engine.packValidMoves();
+    check(engine.getMoveBuffer().data() == before, "repacking reuses the buffer");
+
+    minimax::SearchResult mm = engine.runMinimax(3, 60000);
+    const std::vector<double>& mmPacked = engine.packResult(mm);
+    check(mmPacked.size() == SEARCH_HEADER_SIZE, "minimax result is header only");
+    check(mmPacked[FIELD_ENGINE] == 2 && mmPacked[FIELD_DONE] == 1, "minimax engine/done fields");
+    check(mmPacked[FIELD_HEX] == mm.bestMove.hexId && mmPacked[FIELD_TILE] == mm.bestMove.tileValue,
+          "minimax best move packed");
+    check(mmPacked[FIELD_SCORE] == mm.score && mmPacked[FIELD_DEPTH] == mm.depth &&
+          mmPacked[FIELD_WORK] == mm.nodesSearched, "minimax stats packed");
+
+    mcts::MCTSConfig config;
+    config.numSimulations = 300;
+    config.useTimeLimit = false;
+    mcts::MCTSResult mc = engine.runMCTS(config);
+    const std::vector<double>& mcPacked = engine.packResult(mc);
+    check(mcPacked[FIELD_ENGINE] == 1 && mcPacked[FIELD_WORK] == 300, "MCTS header packed");
+    check(mcPacked[FIELD_TOP_MOVE_COUNT] == static_cast<double>(mc.topMoves.size()) &&
+          mcPacked.size() == SEARCH_HEADER_SIZE + mc.topMoves.size() * TOP_MOVE_STRIDE, "MCTS top move records");
+    if (!mc.topMoves.empty()) {
+        const double* top = &mcPacked[SEARCH_HEADER_SIZE];
+        check(top[TOP_HEX] == mc.topMoves[0].move.hexId && top[TOP_VISITS] == mc.topMoves[0].visits &&
+              top[TOP_WIN_RATE] == mc.topMoves[0].winRate, "MCTS first top move packed");
+    }
+
+    // Incremental search state
+    engine.beginMCTSSearch(config);
+    engine.stepSearch(0, 32);
+    check(engine.packSearchState()[FIELD_DONE] == 0 && engine.getResultBuffer()[FIELD_WORK] == 32,
+          "running search packed as not done");
+    engine.finishSearch();
+    check(engine.packSearchState()[FIELD_DONE] == 1, "finished search packed as done");
+    engine.reset();
+    check(engine.packSearchState()[FIELD_ENGINE] == 0, "no search packs as engine 0");
+
+    std::cout << "✓ Packed results test passed\n";
+}
+
+int main() {
+    printHeader("Engine API");
+
+    testIndependentInstances();
+    testUndoStack();
+    testStaleHandles();
+    testSearch();
+    testIncrementalSearch();
+    testPackedResults();
+
+    return printSummary("engine API");
+}
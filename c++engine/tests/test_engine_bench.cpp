@@ -0,0 +1,84 @@
+#include "api/engine_bench.h"
+#include "ai/minimax.h"
+#include "core/bitboard.h"
+#include "test_util.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace hexuki;
+
+static HexukiBitboard load(const std::string& position) {
+    HexukiBitboard board;
+    if (position != "startpos") board.loadPosition(position);
+    return board;
+}
+
+void testSignature() {
+    api::BenchConfig config;
+    config.depth = 3;
+    config.sims = 300;
+
+    std::ostringstream log;
+    api::BenchReport first = api::runBench(config, &log);
+    api::BenchReport second = api::runBench(config);
+    check(first.positions.size() == api::benchPositions().size(), "every position searched");
+    check(first.signature == second.signature && first.nodes == second.nodes && first.sims == second.sims,
+          "signature repeats");
+
+    uint64_t nodes = 0;
+    bool legal = true;
+    for (const api::BenchPositionResult& result : first.positions) {
+        HexukiBitboard board = load(result.position);
+        nodes += result.nodes;
+        legal = legal && board.isValidMove(result.minimaxMove) && board.isValidMove(result.mctsMove);
+    }
+    check(nodes == first.nodes && first.sims == 300 * first.positions.size(), "totals");
+    check(legal, "best moves are legal");
+
+    config.depth = 4;
+    check(api::runBench(config).signature != first.signature, "signature follows the search");
+    config.depth = 3;
+    config.seed = 2;
+    check(api::runBench(config).signature != first.signature, "signature covers MCTS");
+
+    std::ostringstream summary;
+    api::printBenchReport(first, config, summary);
+    check(summary.str().find("Signature") != std::string::npos &&
+              summary.str().find("Nodes/second") != std::string::npos,
+          "summary");
+
+    std::cout << "✓ Signature test passed\n";
+}
+
+// The bench measures what findBestMove does: same nodes, move and score
+void testMatchesFindBestMove() {
+    api::BenchConfig config;
+    config.depth = 4;
+    config.sims = 0;
+    api::BenchReport report = api::runBench(config);
+
+    bool same = true;
+    for (const api::BenchPositionResult& result : report.positions) {
+        HexukiBitboard board = load(result.position);
+        minimax::SearchConfig search;
+        search.maxDepth = config.depth;
+        search.ttSizeMB = config.hashMB;
+        minimax::SearchResult found = minimax::findBestMove(board, search);
+        same = same && static_cast<uint64_t>(found.nodesSearched) == result.nodes &&
+               found.bestMove == result.minimaxMove && found.score == result.score;
+    }
+    check(same, "bench searches match findBestMove");
+    check(report.sims == 0, "sims 0 skips MCTS");
+
+    std::cout << "✓ findBestMove parity test passed\n";
+}
+
+int main() {
+    printHeader("Engine Bench");
+
+    testSignature();
+    testMatchesFindBestMove();
+
+    return printSummary("engine bench");
+}
@@ -0,0 +1,170 @@
+#include "core/bitboard.h"
+#include "core/zobrist.h"
+#include "ai/minimax.h"
+#include "io/game_record.h"
+#include "tools/labeller.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace hexuki;
+
+// Random game from the initial position, written in C++ move notation
+static std::string randomGame(std::mt19937& rng) {
+    HexukiBitboard board;
+    std::string line;
+    while (!board.isGameOver()) {
+        auto moves = board.getValidMoves();
+        if (moves.empty()) break;
+        Move move = moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(rng)];
+        board.makeMove(move);
+        if (!line.empty()) line += ' ';
+        line += move.toString();
+    }
+    return line;
+}
+
+void testGameRecordParsing() {
+    io::GameRecord record;
+
+    check(io::parseGameRecord("h6t5 h7t4,h2t1", record), "C++ notation parses");
+    check(record.moves.size() == 3 && record.moves[0] == Move(6, 5) && record.moves[2] == Move(2, 1),
+          "C++ notation moves");
+
+    check(io::parseGameRecord("[\"t5h6\",\"t4h7\"]", record), "JS notation parses");
+    check(record.moves.size() == 2 && record.moves[1] == Move(7, 4), "JS notation moves");
+
+    check(io::parseGameRecord("h9:1|p1:1,2|p2:3,4|turn:2 ; h6t3", record), "position record parses");
+    check(record.startPosition == "h9:1|p1:1,2|p2:3,4|turn:2", "position record start");
+    check(record.moves.size() == 1 && record.moves[0] == Move(6, 3), "position record moves");
+
+    check(!io::parseGameRecord("# comment", record), "comments skipped");
+    check(!io::parseGameRecord("   ", record), "blank lines skipped");
+
+    std::cout << "✓ Game record parsing test passed\n";
+}
+
+void testSolveExact() {
+    HexukiBitboard board;
+    board.loadPosition("h4:3,h6:5,h7:4,h9:1,h11:2,h12:6,h1:7,h2:8,h3:9,h5:1,h8:2,h10:3,h14:4,h0:5,h13:6|p1:4,9|p2:7,8,9|turn:1");
+
+    minimax::TranspositionTable tt(16);
+    tools::PositionLabel label = tools::solveExact(board, tt);
+
+    auto reference = minimax::findBestMove(board, 20, 60000);
+    check(label.value == reference.score, "exact value matches full minimax search");
+    check(!label.bestMoves.empty(), "best move set not empty");
+
+    // Every move in the set must achieve the value; every other move must not
+    for (const auto& move : board.getValidMoves()) {
+        board.makeMove(move);
+        minimax::TranspositionTable childTT(16);
+        int childValue = -tools::solveExact(board, childTT).value;
+        board.unmakeMove(move);
+
+        bool inSet = false;
+        for (const auto& best : label.bestMoves) {
+            if (best == move) inSet = true;
+        }
+        check(inSet == (childValue == label.value), "best move set is exactly the optimal moves");
+    }
+
+    tools::PositionLabel parsed;
+    check(tools::parseLabel(tools::formatLabel(label), parsed), "label line parses");
+    check(parsed.hash == label.hash && parsed.value == label.value &&
+          parsed.bestMoves == label.bestMoves && parsed.position == label.position,
+          "label line round-trips");
+
+    std::cout << "✓ Exact solve test passed (value " << label.value << ", "
+              << label.bestMoves.size() << " best moves)\n";
+}
+
+void testLabellerDedupAndResume() {
+    std::mt19937 rng(12345);
+    std::string games;
+    std::string repeated = randomGame(rng);
+    games += repeated + "\n" + randomGame(rng) + "\n" + repeated + "\n";
+
+    tools::LabelConfig config;
+    config.maxEmpty = 5;
+    config.ttSizeMB = 16;
+    config.verbose = false;
+
+    ThreadPool pool(4);
+    std::ostringstream firstOut;
+    {
+        tools::Labeller labeller(config, pool);
+        std::istringstream in(games);
+        auto stats = labeller.run(in, firstOut);
+        check(stats.gamesRead == 3, "all games read");
+        check(stats.labelled + stats.duplicates == stats.positionsSeen, "every position labelled or deduplicated");
+        check(stats.duplicates >= 5, "repeated game deduplicated");
+    }
+
+    // Resume from the first output: nothing new to do
+    {
+        tools::Labeller labeller(config);
+        std::istringstream existing(firstOut.str());
+        size_t loaded = labeller.loadExisting(existing);
+        check(loaded > 0, "existing labels loaded");
+
+        std::istringstream in(games);
+        std::ostringstream secondOut;
+        auto stats = labeller.run(in, secondOut);
+        check(stats.labelled == 0 && secondOut.str().empty(), "resumed run labels nothing new");
+    }
+
+    // An interrupted run's partial last line is dropped before appending
+    {
+        std::string path = (std::filesystem::temp_directory_path() / "hexuki_test_labels.tsv").string();
+        std::string complete = firstOut.str();
+        {
+            std::ofstream partial(path, std::ios::binary | std::ios::trunc);
+            partial << complete << complete.substr(0, 20);
+        }
+        check(io::truncatePartialLine(path) == complete.size(), "partial line truncated");
+        std::ifstream kept(path, std::ios::binary);
+        check(std::string((std::istreambuf_iterator<char>(kept)), std::istreambuf_iterator<char>()) == complete,
+              "complete lines kept");
+        kept.close();
+
+        // Partial line longer than one read block, a whole file without a
+        // newline, and a file that already ends with one
+        {
+            std::ofstream partial(path, std::ios::binary | std::ios::trunc);
+            partial << complete << std::string(10000, 'x');
+        }
+        check(io::truncatePartialLine(path) == complete.size(), "long partial line truncated");
+        {
+            std::ofstream partial(path, std::ios::binary | std::ios::trunc);
+            partial << std::string(10000, 'x');
+        }
+        check(io::truncatePartialLine(path) == 0 && std::filesystem::file_size(path) == 0, "no complete line kept");
+        {
+            std::ofstream whole(path, std::ios::binary | std::ios::trunc);
+            whole << complete;
+        }
+        check(io::truncatePartialLine(path) == complete.size() && std::filesystem::file_size(path) == complete.size(),
+              "complete file unchanged");
+        std::filesystem::remove(path);
+    }
+
+    std::cout << "✓ Labeller dedup/resume test passed\n";
+}
+
+int main() {
+    printHeader("Labelling Pipeline");
+
+    Zobrist::initialize();
+
+    testGameRecordParsing();
+    testSolveExact();
+    testLabellerDedupAndResume();
+
+    return printSummary("labelling");
+}
@@ -0,0 +1,92 @@
+#include "core/large_pages.h"
+#include "ai/mcts_node.h"
+#include "ai/minimax.h"
+#include "test_util.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+using namespace hexuki;
+
+void testLargePageBuffer() {
+    LargePageConfig config;
+    config.prefault = true;
+
+    LargePageBuffer buffer(3 * 1024 * 1024 + 5, config);
+    check(buffer.size() == 2 * LargePageBuffer::LARGE_PAGE_SIZE, "size rounded up to whole large pages");
+    check(buffer.data() != nullptr, "buffer allocated");
+    if (buffer.getBacking() != PageBacking::STANDARD) {
+        check(reinterpret_cast<uintptr_t>(buffer.data()) % LargePageBuffer::LARGE_PAGE_SIZE == 0,
+              "large-page buffer is 2MB aligned");
+    }
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(buffer.data());
+    bool zero = true;
+    for (size_t i = 0; i < buffer.size(); i += 777) {
+        if (bytes[i] != 0) zero = false;
+    }
+    check(zero, "buffer is zero-initialized");
+    check(buffer.getPrefaultMs() >= 0.0, "prefault time recorded");
+
+    // Move transfers ownership
+    void* data = buffer.data();
+    LargePageBuffer moved(std::move(buffer));
+    check(moved.data() == data && buffer.data() == nullptr, "move transfers the mapping");
+
+    LargePageConfig disabled;
+    disabled.enabled = false;
+    LargePageBuffer small(4096, disabled);
+    check(small.getBacking() == PageBacking::STANDARD, "disabled large pages fall back to standard pages");
+
+    std::cout << "✓ Large page buffer test passed (" << pageBackingName(moved.getBacking()) << ")\n";
+}
+
+void testNodeArena() {
+    // Tiny chunks so the tree spans several of them
+    mcts::NodeArena arena(16 * sizeof(mcts::MCTSNode));
+    mcts::MCTSNode* root = arena.create();
+    for (int i = 0; i < 100; i++) {
+        mcts::MCTSNode* child = root->addChild(Move(i % 19, 1 + i % 9), arena);
+        child->update(1.0);
+        child->untriedMoves.push_back(Move(1, 2));  // Heap member must be destroyed on reset
+    }
+    check(arena.getNodeCount() == 101, "arena counts nodes");
+    check(root->children.size() == 100 && root->children[99]->parent == root, "children linked to parent");
+    check(root->children[57]->move == Move(57 % 19, 1 + 57 % 9), "node contents intact across chunks");
+
+    size_t reserved = arena.getReservedBytes();
+    arena.reset();
+    check(arena.getNodeCount() == 0, "reset destroys every node");
+    arena.create();
+    check(arena.getReservedBytes() == reserved, "chunks reused after reset");
+
+    std::cout << "✓ Node arena test passed\n";
+}
+
+void testTableBacking() {
+    LargePageConfig disabled;
+    disabled.enabled = false;
+    minimax::TranspositionTable standard(4, disabled);
+    minimax::TranspositionTable large(4);
+
+    for (minimax::TranspositionTable* tt : {&standard, &large}) {
+        tt->store(0x1234, minimax::TTEntry(17, 3, minimax::TTEntry::EXACT, Move(4, 5)));
+        minimax::TTEntry entry;
+        check(tt->probe(0x1234, entry) && entry.score == 17 && entry.bestMove == Move(4, 5),
+              "table works with either backing");
+    }
+    check(standard.getMemory().getBacking() == PageBacking::STANDARD, "table honours page config");
+
+    std::cout << "✓ Table backing test passed\n";
+}
+
+int main() {
+    printHeader("Memory");
+
+    testLargePageBuffer();
+    testNodeArena();
+    testTableBacking();
+
+    return printSummary("memory");
+}
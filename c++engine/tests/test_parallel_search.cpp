@@ -0,0 +1,183 @@
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include "api/engine_instance.h"
+#include "core/thread_pool.h"
+#include "test_util.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+
+// Deterministic mid-game positions (same list as the WASM threads parity test
+// gets through --reference)
+static std::vector<std::string> testPositions() {
+    std::vector<std::string> positions;
+    for (int plies : {4, 8, 11}) {
+        HexukiBitboard board;
+        for (int i = 0; i < plies && !board.isGameOver(); i++) {
+            std::vector<Move> moves = board.getValidMoves();
+            board.makeMove(moves[(i * 7 + plies) % moves.size()]);
+        }
+        positions.push_back(board.savePosition());
+    }
+    return positions;
+}
+
+static minimax::SearchResult runMinimax(const std::string& position, int depth, int threads) {
+    HexukiBitboard board;
+    board.loadPosition(position);
+    minimax::SearchConfig config;
+    config.maxDepth = depth;
+    config.timeLimitMs = 600000;
+    config.ttSizeMB = 16;
+    config.numThreads = threads;
+    return minimax::findBestMove(board, config);
+}
+
+static mcts::MCTSResult runMCTS(mcts::MCTS& engine, const std::string& position, int simulations,
+                                int threads, uint32_t seed) {
+    HexukiBitboard board;
+    board.loadPosition(position);
+    mcts::MCTSConfig config;
+    config.numSimulations = simulations;
+    config.useTimeLimit = false;
+    config.numThreads = threads;
+    config.seed = seed;
+    return engine.findBestMove(board, config);
+}
+
+static bool sameMCTS(const mcts::MCTSResult& a, const mcts::MCTSResult& b) {
+    if (!(a.bestMove == b.bestMove) || a.visits != b.visits || a.winRate != b.winRate ||
+        a.simulations != b.simulations || a.topMoves.size() != b.topMoves.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.topMoves.size(); i++) {
+        if (!(a.topMoves[i].move == b.topMoves[i].move) || a.topMoves[i].visits != b.topMoves[i].visits ||
+            a.topMoves[i].winRate != b.topMoves[i].winRate) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testParallelMinimax() {
+    for (const std::string& position : testPositions()) {
+        minimax::SearchResult serial = runMinimax(position, 4, 1);
+        minimax::SearchResult two = runMinimax(position, 4, 2);
+        check(two.depth == 4 && !two.timeout, "parallel search reaches full depth");
+        check(two.score == serial.score, "root split finds the single-threaded score");
+
+        for (int threads : {3, 4}) {
+            minimax::SearchResult other = runMinimax(position, 4, threads);
+            check(other.score == two.score && other.bestMove == two.bestMove,
+                  "best move and score independent of thread count");
+        }
+
+        minimax::SearchResult again = runMinimax(position, 4, 2);
+        check(again.bestMove == two.bestMove && again.score == two.score &&
+              again.nodesSearched == two.nodesSearched, "parallel search is reproducible");
+    }
+
+    std::cout << "✓ Parallel minimax test passed\n";
+}
+
+void testParallelMCTS() {
+    const std::string position = testPositions()[1];
+    mcts::MCTS engine;
+
+    mcts::MCTSResult single = runMCTS(engine, position, 2000, 1, 42);
+    check(sameMCTS(single, runMCTS(engine, position, 2000, 1, 42)), "seeded search is reproducible");
+
+    mcts::MCTSResult parallel = runMCTS(engine, position, 2000, 4, 42);
+    check(parallel.simulations == 2000, "trees share the simulation budget");
+    check(!parallel.topMoves.empty() && parallel.visits == parallel.topMoves[0].visits,
+          "best move is the most visited merged move");
+    int topVisits = 0;
+    for (const auto& stats : parallel.topMoves) topVisits += stats.visits;
+    check(topVisits <= 2000, "merged visits bounded by simulations");
+
+    // Fresh engine (new helper trees) and repeated runs give the same result
+    mcts::MCTS other;
+    check(sameMCTS(parallel, runMCTS(other, position, 2000, 4, 42)), "parallel search independent of engine");
+    check(sameMCTS(parallel, runMCTS(engine, position, 2000, 4, 42)), "parallel search is reproducible");
+
+    // Timed: the trees share one deadline even when they run one after
+    // another (global pool smaller than the tree count)
+    HexukiBitboard board;
+    board.loadPosition(position);
+    mcts::MCTSConfig timed;
+    timed.useTimeLimit = true;
+    timed.timeLimitMs = 100;
+    timed.numThreads = ThreadPool::global().size() + 4;
+    mcts::MCTSResult limited = engine.findBestMove(board, timed);
+    check(limited.timeMs < 2 * timed.timeLimitMs, "time-limited parallel search keeps one deadline");
+    check(limited.simulations > 0, "time-limited parallel search runs simulations");
+
+    std::cout << "✓ Parallel MCTS test passed\n";
+}
+
+void testEngineThreads() {
+    api::EngineInstance engine;
+    engine.loadPosition(testPositions()[0]);
+    minimax::SearchResult serial = engine.runMinimax(4, 600000);
+
+    engine.setSearchThreads(0);
+    check(engine.getSearchThreads() == 1, "thread count clamped to 1");
+    engine.setSearchThreads(3);
+    minimax::SearchResult parallel = engine.runMinimax(4, 600000);
+    check(parallel.score == serial.score, "instance root split matches single-threaded score");
+
+    mcts::MCTSConfig config;
+    config.numSimulations = 600;
+    config.useTimeLimit = false;
+    engine.setSearchSeed(7);
+    mcts::MCTSResult first = engine.runMCTS(config);
+    check(first.simulations == 600, "instance runs parallel MCTS");
+    check(sameMCTS(first, engine.runMCTS(config)), "instance seed makes MCTS reproducible");
+
+    std::cout << "✓ Engine instance threads test passed\n";
+}
+
+/**
+ * --reference: print the native results that tests/wasm/threads_parity.js
+ * expects from every WASM build (threaded or not) as JSON. Minimax node
+ * counts are left out: they depend on table sizes, which depend on the
+ * memory budget of each build.
+ */
+static void printReference() {
+    const int threads = 4;
+    std::cout << std::setprecision(17) << "[";
+    bool first = true;
+    for (const std::string& position : testPositions()) {
+        minimax::SearchResult mm = runMinimax(position, 4, threads);
+        mcts::MCTS engine;
+        mcts::MCTSResult mc = runMCTS(engine, position, 2000, threads, 42);
+
+        std::cout << (first ? "" : ",") << "\n  {\"position\":\"" << position << "\",\"threads\":" << threads
+                  << ",\n   \"minimax\":{\"depth\":4,\"hexId\":" << mm.bestMove.hexId
+                  << ",\"tileValue\":" << mm.bestMove.tileValue << ",\"score\":" << mm.score << "},"
+                  << "\n   \"mcts\":{\"simulations\":2000,\"seed\":42,\"hexId\":" << mc.bestMove.hexId
+                  << ",\"tileValue\":" << mc.bestMove.tileValue << ",\"visits\":" << mc.visits
+                  << ",\"winRate\":" << mc.winRate << "}}";
+        first = false;
+    }
+    std::cout << "\n]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--reference") == 0) {
+        printReference();
+        return 0;
+    }
+
+    printHeader("Parallel Search");
+
+    testParallelMinimax();
+    testParallelMCTS();
+    testEngineThreads();
+
+    return printSummary("parallel search");
+}
@@ -0,0 +1,151 @@
+#include "api/protocol.h"
+#include "test_util.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+
+// Lines written since the last call
+static std::vector<std::string> takeLines(std::ostringstream& out) {
+    std::istringstream in(out.str());
+    out.str("");
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) lines.push_back(line);
+    return lines;
+}
+
+static std::string lastLine(const std::vector<std::string>& lines) {
+    return lines.empty() ? "" : lines.back();
+}
+
+static bool startsWith(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Value after "key " in an info line
+static long long infoValue(const std::string& line, const std::string& key) {
+    size_t at = line.find(" " + key + " ");
+    return at == std::string::npos ? -1 : std::stoll(line.substr(at + key.size() + 2));
+}
+
+static std::string lastInfo(const std::vector<std::string>& lines) {
+    for (auto it = lines.rbegin(); it != lines.rend(); ++it) {
+        if (startsWith(*it, "info depth") || startsWith(*it, "info sims")) return *it;
+    }
+    return "";
+}
+
+void testHandshake() {
+    std::ostringstream out;
+    api::ProtocolEngine engine(out);
+    engine.handleLine("uci");
+    std::vector<std::string> lines = takeLines(out);
+    check(!lines.empty() && startsWith(lines[0], "id name"), "uci identifies the engine");
+    check(lastLine(lines) == "uciok", "uci ends with uciok");
+
+    engine.handleLine("isready");
+    check(lastLine(takeLines(out)) == "readyok", "isready answered");
+
+    engine.handleLine("position startpos moves h7t5 h0t3");
+    check(startsWith(lastLine(takeLines(out)), "info string error"), "illegal move reported");
+    engine.handleLine("position startpos moves h7t5");
+    engine.handleLine("d");
+    lines = takeLines(out);
+    check(lines.size() == 2 && lines[0].find("h7:5") != std::string::npos, "position applied");
+    engine.handleLine("position fen h9:1|p1:1,2,3,4,5,6,7,8,9,10,11|p2:1,2|turn:1");
+    check(startsWith(lastLine(takeLines(out)), "info string error"), "oversized hand reported");
+    engine.handleLine("position fen h9:1,h4:10|turn:1");
+    check(startsWith(lastLine(takeLines(out)), "info string error"), "out-of-range tile reported");
+    engine.handleLine("d");
+    check(takeLines(out)[0].find("h7:5") != std::string::npos, "rejected position keeps the current one");
+    check(!engine.handleLine("quit"), "quit ends the session");
+
+    engine.handleLine("bogus");
+    check(startsWith(lastLine(takeLines(out)), "info string unknown"), "unknown command reported");
+
+    std::cout << "✓ Handshake and position test passed\n";
+}
+
+void testMinimax() {
+    std::ostringstream out;
+    api::ProtocolEngine engine(out);
+    engine.handleLine("setoption name Hash value 16");
+    engine.handleLine("position startpos moves h7t5 h6t4 h12t9");
+    engine.handleLine("go depth 4");
+    engine.waitForSearch();
+    std::vector<std::string> lines = takeLines(out);
+    std::string info = lastInfo(lines);
+    check(infoValue(info, "depth") == 4, "info for each completed depth");
+    check(startsWith(lastLine(lines), "bestmove h"), "bestmove after the search");
+    long long coldNodes = infoValue(info, "nodes");
+    long long score = infoValue(info, "score");
+
+    // Same position again: the table is kept, so the search is cheaper
+    engine.handleLine("go depth 4");
+    engine.waitForSearch();
+    info = lastInfo(takeLines(out));
+    check(infoValue(info, "score") == score, "warm table gives the same score");
+    check(infoValue(info, "nodes") < coldNodes, "warm table saves nodes");
+
+    engine.handleLine("setoption name Threads value 2");
+    engine.handleLine("go depth 4");
+    engine.waitForSearch();
+    lines = takeLines(out);
+    check(infoValue(lastInfo(lines), "score") == score && startsWith(lastLine(lines), "bestmove h"),
+          "threaded search agrees");
+
+    // Node limits need the incremental search: honored single-threaded, and reported
+    engine.handleLine("position startpos");
+    engine.handleLine("go nodes 20000");
+    engine.waitForSearch();
+    lines = takeLines(out);
+    check(!lines.empty() && startsWith(lines[0], "info string Threads 2 ignored"), "unthreaded go nodes reported");
+    check(infoValue(lastInfo(lines), "nodes") <= 20000 + 4096 && startsWith(lastLine(lines), "bestmove h"),
+          "go nodes honored with Threads > 1");
+
+    std::cout << "✓ Minimax search test passed\n";
+}
+
+void testStopAndMCTS() {
+    std::ostringstream out;
+    api::ProtocolEngine engine(out);
+    engine.handleLine("setoption name Engine value mcts");
+    engine.handleLine("position startpos");
+    engine.handleLine("go infinite");
+    engine.handleLine("isready");
+    engine.handleLine("stop");
+    std::vector<std::string> lines = takeLines(out);
+    bool ready = false;
+    for (const auto& line : lines) ready = ready || line == "readyok";
+    check(ready, "isready answered while searching");
+    check(startsWith(lastLine(lines), "bestmove h"), "stop ends an infinite search with bestmove");
+
+    engine.handleLine("setoption name Seed value 7");
+    engine.handleLine("go sims 300");
+    engine.waitForSearch();
+    lines = takeLines(out);
+    check(infoValue(lastInfo(lines), "sims") == 300, "simulation limit");
+    std::string first = lastLine(lines);
+    engine.handleLine("go sims 300");
+    engine.waitForSearch();
+    check(lastLine(takeLines(out)) == first, "seeded MCTS reproducible");
+
+    engine.handleLine("go movetime 50");
+    engine.waitForSearch();
+    check(startsWith(lastLine(takeLines(out)), "bestmove h"), "movetime search");
+
+    std::cout << "✓ Stop and MCTS test passed\n";
+}
+
+int main() {
+    printHeader("Line Protocol");
+
+    testHandshake();
+    testMinimax();
+    testStopAndMCTS();
+
+    return printSummary("line protocol");
+}
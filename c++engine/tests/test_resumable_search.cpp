@@ -0,0 +1,295 @@
+#include "core/bitboard.h"
+#include "core/thread_pool.h"
+#include "core/zobrist.h"
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include "ai/search_scheduler.h"
+#include "test_util.h"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hexuki;
+
+static HexukiBitboard randomPosition(std::mt19937& rng, int plies) {
+    HexukiBitboard board;
+    for (int i = 0; i < plies && !board.isGameOver(); i++) {
+        auto moves = board.getValidMoves();
+        board.makeMove(moves[rng() % moves.size()]);
+    }
+    return board;
+}
+
+static minimax::SearchResult runSliced(const HexukiBitboard& board, const minimax::SearchConfig& config,
+                                       int slice) {
+    minimax::SearchTask task(board, config);
+    while (!task.step(slice)) {
+    }
+    return task.getResult();
+}
+
+void testSlicedSearchMatchesWhole() {
+    std::mt19937 rng(2024);
+    minimax::SearchConfig config;
+    config.maxDepth = 4;
+    config.timeLimitMs = 600000;
+    config.ttSizeMB = 4;
+
+    for (int i = 0; i < 6; i++) {
+        HexukiBitboard board = randomPosition(rng, 3 + i * 2);
+        auto whole = runSliced(board, config, 1 << 30);
+        for (int slice : {1, 37, 1000}) {
+            auto sliced = runSliced(board, config, slice);
+            check(sliced.bestMove == whole.bestMove && sliced.score == whole.score &&
+                  sliced.nodesSearched == whole.nodesSearched && sliced.depth == whole.depth,
+                  "sliced search identical to uninterrupted search");
+        }
+    }
+
+    std::cout << "✓ Sliced search test passed\n";
+}
+
+void testMatchesRecursiveAlphaBeta() {
+    std::mt19937 rng(99);
+    minimax::SearchConfig config;
+    config.maxDepth = 4;
+    config.timeLimitMs = 600000;
+    config.ttSizeMB = 4;
+    config.useIterativeDeepening = false;
+
+    for (int i = 0; i < 6; i++) {
+        HexukiBitboard board = randomPosition(rng, 2 + i * 2);
+        auto resumable = runSliced(board, config, 50);
+
+        // The same single-depth root loop, on the recursive alphaBeta
+        minimax::TranspositionTable tt(4);
+        minimax::KillerMoves killers;
+        minimax::HistoryTable history;
+        auto moves = board.getValidMoves();
+        minimax::orderMoves(moves, nullptr, killers, history, 0);
+        auto startTime = std::chrono::steady_clock::now();
+        int nodes = 0;
+        int alpha = -1000000;
+        int bestScore = -1000000;
+        Move bestMove;
+        for (const auto& move : moves) {
+            board.makeMove(move);
+            int score = -minimax::alphaBeta(board, config.maxDepth - 1, -1000000, -alpha, tt, nodes,
+                                            startTime, config.timeLimitMs, killers, history, 1);
+            board.unmakeMove(move);
+            if (score > bestScore) {
+                bestScore = score;
+                bestMove = move;
+                alpha = std::max(alpha, score);
+            }
+        }
+
+        check(resumable.bestMove == bestMove && resumable.score == bestScore && resumable.nodesSearched == nodes,
+              "explicit-stack search matches recursive alphaBeta");
+    }
+
+    std::cout << "✓ Recursive equivalence test passed\n";
+}
+
+void testStop() {
+    minimax::SearchConfig config;
+    config.maxDepth = 12;
+    config.timeLimitMs = 600000;
+    config.ttSizeMB = 4;
+
+    HexukiBitboard board;
+    minimax::SearchTask task(board, config);
+    check(!task.step(5000), "deep search not finished after 5000 nodes");
+    task.stop();
+    check(task.isDone() && task.step(100), "stopped task reports done");
+    check(task.getResult().depth < config.maxDepth && task.getResult().depth >= 1,
+          "stop keeps last completed depth");
+
+    std::cout << "✓ Stop test passed\n";
+}
+
+void testDepthClamped() {
+    std::mt19937 rng(7);
+    HexukiBitboard board = randomPosition(rng, 14);
+    minimax::SearchConfig config;
+    config.maxDepth = 1000000;  // Would size a huge frame stack
+    config.timeLimitMs = 600000;
+    config.ttSizeMB = 4;
+
+    minimax::SearchConfig exact = config;
+    exact.maxDepth = 0;
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (!board.isHexOccupied(hexId)) exact.maxDepth++;
+    }
+    auto clamped = runSliced(board, config, 1 << 30);
+    auto whole = runSliced(board, exact, 1 << 30);
+    check(clamped.depth <= exact.maxDepth, "depth clamped to the empty hexes");
+    check(clamped.bestMove == whole.bestMove && clamped.score == whole.score &&
+          clamped.nodesSearched == whole.nodesSearched, "clamped search equals a full-depth search");
+
+    std::cout << "✓ Depth clamp test passed\n";
+}
+
+void testMctsStepping() {
+    mcts::MCTSConfig config;
+    config.useTimeLimit = false;
+    config.numSimulations = 500;
+
+    HexukiBitboard board;
+    mcts::MCTS engine;
+    engine.beginSearch(board, config);
+    int steps = 0;
+    while (!engine.step(64)) {
+        steps++;
+        check(engine.getResult().simulations == steps * 64, "partial result after each step");
+    }
+    auto result = engine.getResult();
+    check(result.simulations == 500, "stepped MCTS runs configured simulation count");
+    check(board.isValidMove(result.bestMove), "stepped MCTS returns a legal move");
+
+    std::cout << "✓ MCTS stepping test passed\n";
+}
+
+void testSchedulerManyTasks() {
+    ThreadPool pool(2);
+    SearchScheduler scheduler(2, pool);
+    minimax::TranspositionTable sharedTT(16);
+
+    minimax::SearchConfig config;
+    config.maxDepth = 3;
+    config.timeLimitMs = 600000;
+
+    std::mt19937 rng(5);
+    std::vector<std::shared_ptr<minimax::SearchTask>> tasks;
+    std::atomic<int> finished(0);
+    for (int i = 0; i < 1000; i++) {
+        auto task = std::make_shared<minimax::SearchTask>(randomPosition(rng, i % 12), config, &sharedTT);
+        tasks.push_back(task);
+        SearchScheduler::TaskOptions options;
+        options.sliceUnits = 64;
+        options.priority = 1 + i % 3;
+        scheduler.submit([task](int units) { return task->step(units); }, options,
+                         [&finished](uint64_t, SearchScheduler::Outcome outcome) {
+                             if (outcome == SearchScheduler::Outcome::FINISHED) finished++;
+                         });
+    }
+    scheduler.waitIdle();
+
+    check(finished.load() == 1000, "all scheduled analyses finish");
+    bool allDone = true;
+    for (const auto& task : tasks) {
+        if (!task->isDone() || task->getResult().depth != config.maxDepth) allDone = false;
+    }
+    check(allDone, "every analysis reached full depth");
+    check(scheduler.getTaskCount() == 0, "scheduler empty after waitIdle");
+
+    std::cout << "✓ Scheduler test passed (1000 analyses, " << scheduler.getSlicesRun() << " slices)\n";
+}
+
+void testSchedulerPriorityAndBudget() {
+    ThreadPool pool(1);
+    SearchScheduler scheduler(1, pool);
+
+    // Two never-finishing tasks with equal budgets: the priority-3 task should
+    // get about three slices for every one of the priority-1 task
+    std::mutex orderMutex;
+    std::vector<int> order;
+    auto recorder = [&](int which) {
+        return [&, which](int) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(which);
+            return false;
+        };
+    };
+
+    std::atomic<int> exhausted(0);
+    auto onDone = [&](uint64_t, SearchScheduler::Outcome outcome) {
+        if (outcome == SearchScheduler::Outcome::BUDGET_EXHAUSTED) exhausted++;
+    };
+
+    SearchScheduler::TaskOptions low;
+    low.priority = 1;
+    low.sliceUnits = 100;
+    low.budget = 6000;
+    SearchScheduler::TaskOptions high = low;
+    high.priority = 3;
+
+    scheduler.submit(recorder(0), low, onDone);
+    scheduler.submit(recorder(1), high, onDone);
+    scheduler.waitIdle();
+
+    check(exhausted.load() == 2, "both tasks stop on budget");
+    check(order.size() == 120, "budget / slice size slices per task");
+
+    int lowBeforeHighDone = 0;
+    int highSeen = 0;
+    for (int which : order) {
+        if (which == 1 && ++highSeen == 60) break;
+        if (which == 0) lowBeforeHighDone++;
+    }
+    check(lowBeforeHighDone >= 15 && lowBeforeHighDone <= 25, "priority 3 task gets ~3x the slices");
+
+    // Budget is honoured exactly even when not a multiple of the slice
+    uint64_t unitsGiven = 0;
+    SearchScheduler::TaskOptions odd;
+    odd.sliceUnits = 300;
+    odd.budget = 1000;
+    scheduler.submit([&](int units) { unitsGiven += units; return false; }, odd);
+    scheduler.waitIdle();
+    check(unitsGiven == 1000, "last slice trimmed to remaining budget");
+
+    std::cout << "✓ Priority and budget test passed\n";
+}
+
+void testSchedulerCancel() {
+    ThreadPool pool(1);
+    SearchScheduler scheduler(1, pool);
+
+    std::atomic<int> slices(0);
+    std::atomic<int> cancelled(0);
+    auto onDone = [&](uint64_t, SearchScheduler::Outcome outcome) {
+        if (outcome == SearchScheduler::Outcome::CANCELLED) cancelled++;
+    };
+    uint64_t endless = scheduler.submit([&](int) { slices++; return false; },
+                                        SearchScheduler::TaskOptions(), onDone);
+    while (slices.load() < 5) {
+        std::this_thread::yield();
+    }
+    check(scheduler.cancel(endless), "cancel live task");
+    scheduler.waitIdle();
+    check(cancelled.load() == 1, "cancelled task reported once");
+    check(!scheduler.cancel(endless), "cancel of finished task fails");
+
+    // A failing step is reported, not propagated
+    std::atomic<int> failed(0);
+    scheduler.submit([](int) -> bool { throw std::runtime_error("step failed"); }, SearchScheduler::TaskOptions(),
+                     [&](uint64_t, SearchScheduler::Outcome outcome) {
+                         if (outcome == SearchScheduler::Outcome::FAILED) failed++;
+                     });
+    scheduler.waitIdle();
+    check(failed.load() == 1, "throwing task reported as failed");
+
+    std::cout << "✓ Cancellation test passed\n";
+}
+
+int main() {
+    printHeader("Resumable Search");
+
+    Zobrist::initialize();
+
+    testSlicedSearchMatchesWhole();
+    testMatchesRecursiveAlphaBeta();
+    testStop();
+    testDepthClamped();
+    testMctsStepping();
+    testSchedulerManyTasks();
+    testSchedulerPriorityAndBudget();
+    testSchedulerCancel();
+
+    return printSummary("resumable search");
+}
@@ -0,0 +1,163 @@
+#include "ai/mcts.h"
+#include "ai/minimax.h"
+#include "api/engine_instance.h"
+#include "test_util.h"
+#include <iostream>
+#include <string>
+
+using namespace hexuki;
+using namespace hexuki::minimax;
+
+void testReuse() {
+    TablePool pool(8);
+    check(pool.getAllocatedMB() == 0, "nothing allocated up front");
+
+    TranspositionTable* first;
+    {
+        TableLease lease = pool.acquire(4);
+        check(lease && lease.getSizeMB() == 4, "table of the requested size");
+        check(pool.getAllocatedMB() == 4 && pool.getLeasedMB() == 4, "lease accounted");
+        lease->store(12345, TTEntry(7, 3, TTEntry::EXACT, Move(1, 2)));
+        first = lease.get();
+    }
+    check(pool.getLeasedMB() == 0 && pool.getAllocatedMB() == 4, "released table kept for reuse");
+
+    TableLease again = pool.acquire(4);
+    TTEntry entry;
+    check(again.get() == first, "same size reuses the pooled table");
+    check(!again->probe(12345, entry), "reused table is cleared");
+
+    TableLease moved = std::move(again);
+    check(!again && moved.get() == first, "lease moves");
+    moved.reset();
+    check(pool.getLeasedMB() == 0, "reset returns the table");
+
+    std::cout << "✓ Table reuse test passed\n";
+}
+
+void testBudget() {
+    TablePool pool(8);
+    TableLease a = pool.acquire(6);
+    check(a.getSizeMB() == 4, "sizes round down to a power of two");
+    TableLease b = pool.acquire(16);
+    check(b.getSizeMB() == 4, "request capped by the remaining budget");
+    TableLease c = pool.acquire(16);
+    check(c.isShared() && c.get() == a.get(), "exhausted budget shares a table in use");
+    check(pool.getAllocatedMB() == 8 && pool.getLeasedMB() == 8, "shared lease allocates nothing");
+    a.reset();
+    check(pool.getLeasedMB() == 8, "shared table stays leased while a lease holds it");
+    c.reset();
+    b.reset();
+    check(pool.getLeasedMB() == 0 && pool.getAllocatedMB() == 8, "allocation bounded by the budget");
+
+    // A different size drops pooled tables to make room
+    TableLease big = pool.acquire(8);
+    check(big.getSizeMB() == 8 && pool.getAllocatedMB() == 8, "pooled tables freed for a larger one");
+
+    // Lowering the budget: pooled tables go now, leased ones when returned
+    pool.setBudgetMB(2);
+    big.reset();
+    check(pool.getAllocatedMB() == 0, "table over the new budget freed on release");
+    TableLease small = pool.acquire(8);
+    check(small.getSizeMB() == 2, "new budget applies to new tables");
+    small.reset();
+    pool.trim();
+    check(pool.getAllocatedMB() == 0, "trim frees pooled tables");
+
+    std::cout << "✓ Budget test passed\n";
+}
+
+void testMappedBytes() {
+    TablePool pool(8);
+    TableLease tiny = pool.acquire(1);
+    check(tiny.getSizeMB() == TablePool::MIN_TABLE_MB, "small requests get the minimum table");
+    check(tiny->getMemory().size() == TablePool::MIN_TABLE_MB * 1024 * 1024, "minimum table maps what it is charged");
+    tiny.reset();
+
+    // Charged engine memory comes out of the tables' share
+    pool.charge(6 * 1024 * 1024);
+    check(pool.getAllocatedMB() == 2 && pool.getChargedMB() == 6, "charge keeps pooled tables that still fit");
+    TableLease rest = pool.acquire(8);
+    check(rest.getSizeMB() == 2 && !rest.isShared(), "charged memory shrinks new tables");
+    pool.uncharge(6 * 1024 * 1024);
+    check(pool.getChargedMB() == 0, "uncharge returns the budget");
+    rest.reset();
+
+    // MCTS node chunks are charged while the engine lives
+    size_t before = TablePool::global().getChargedMB();
+    {
+        mcts::MCTS engine;
+        mcts::MCTSConfig config;
+        config.numSimulations = 50;
+        config.useTimeLimit = false;
+        HexukiBitboard board;
+        engine.findBestMove(board, config);
+        check(TablePool::global().getChargedMB() > before, "node chunks charged");
+    }
+    check(TablePool::global().getChargedMB() == before, "node chunks uncharged with the engine");
+
+    std::cout << "✓ Mapped bytes test passed\n";
+}
+
+void testEnginesUsePool() {
+    TablePool& pool = TablePool::global();
+    pool.trim();
+    size_t before = pool.getAllocatedMB();
+
+    {
+        mcts::MCTS engine;
+        api::EngineInstance instance;
+        check(pool.getAllocatedMB() == before, "engines allocate no tables when created");
+    }
+
+    HexukiBitboard board;
+    SearchConfig config;
+    config.maxDepth = 3;
+    config.ttSizeMB = 4;
+    SearchResult first = findBestMove(board, config);
+    size_t afterFirst = pool.getAllocatedMB();
+    check(afterFirst == before + 4 && pool.getLeasedMB() == 0, "search table returned to the pool");
+    SearchResult second = findBestMove(board, config);
+    check(pool.getAllocatedMB() == afterFirst, "next search reuses the table");
+    check(first.bestMove == second.bestMove && first.score == second.score &&
+          first.nodesSearched == second.nodesSearched, "reused table gives the same search");
+
+    {
+        mcts::MCTS engine;
+        mcts::MCTSConfig mctsConfig;
+        mctsConfig.numSimulations = 50;
+        mctsConfig.useTimeLimit = false;
+        engine.findBestMove(board, mctsConfig);
+        check(pool.getLeasedMB() == 0, "no rollout table without minimax rollouts");
+        mctsConfig.useMinimaxRollouts = true;
+        engine.beginSearch(board, mctsConfig);
+        check(pool.getLeasedMB() > 0, "rollout table leased while searching");
+        engine.endSearch();
+        check(pool.getLeasedMB() == 0, "rollout table returned by endSearch");
+
+        engine.findBestMove(board, mctsConfig);
+        size_t afterRollouts = pool.getAllocatedMB();
+        check(pool.getLeasedMB() == 0, "rollout table returned when the search finishes");
+        engine.findBestMove(board, mctsConfig);
+        check(pool.getAllocatedMB() == afterRollouts, "next search reuses the rollout table");
+
+        // The rollout table's memory is free for a minimax search
+        SearchConfig large = config;
+        large.ttSizeMB = afterRollouts;
+        findBestMove(board, large);
+        check(pool.getAllocatedMB() == afterRollouts, "minimax search reuses the rollout table's memory");
+    }
+
+    std::cout << "✓ Engines use pool test passed\n";
+}
+
+int main() {
+    printHeader("Table Pool");
+
+    testReuse();
+    testBudget();
+    testMappedBytes();
+    testEnginesUsePool();
+
+    return printSummary("table pool");
+}
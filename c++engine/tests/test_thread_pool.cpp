@@ -0,0 +1,115 @@
+#include "core/thread_pool.h"
+#include "test_util.h"
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+
+void testParallelFor() {
+    ThreadPool pool(3);
+
+    std::vector<int> values(10000, 0);
+    parallelFor(0, values.size(), 64, [&](size_t i) { values[i] = static_cast<int>(i) * 2; }, pool);
+
+    long long sum = 0;
+    bool allSet = true;
+    for (size_t i = 0; i < values.size(); i++) {
+        sum += values[i];
+        if (values[i] != static_cast<int>(i) * 2) allSet = false;
+    }
+    check(allSet, "parallelFor visits every index once");
+    check(sum == 9999LL * 10000, "parallelFor sum");
+
+    std::cout << "✓ parallelFor test passed\n";
+}
+
+void testNestedGroups() {
+    // One worker: nested waits only complete if waiting threads run queued tasks
+    ThreadPool pool(1);
+    std::atomic<int> leaves(0);
+
+    TaskGroup outer(pool);
+    for (int i = 0; i < 8; i++) {
+        outer.run([&]() {
+            TaskGroup inner(pool);
+            for (int j = 0; j < 8; j++) {
+                inner.run([&]() { leaves++; });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    check(leaves.load() == 64, "nested groups run every leaf task");
+
+    std::cout << "✓ Nested group test passed\n";
+}
+
+void testExceptionCancelsGroup() {
+    ThreadPool pool(2);
+    std::atomic<int> started(0);
+
+    TaskGroup group(pool);
+    group.run([]() { throw std::runtime_error("task failed"); });
+    bool rethrown = false;
+    try {
+        group.wait();
+    } catch (const std::runtime_error& e) {
+        rethrown = std::string(e.what()) == "task failed";
+    }
+    check(rethrown, "first task exception rethrown from wait()");
+    check(group.isCancelled(), "failing task cancels its group");
+
+    // Tasks added after cancellation are skipped
+    for (int i = 0; i < 100; i++) {
+        group.run([&]() { started++; });
+    }
+    group.wait();
+    check(started.load() == 0, "cancelled group skips queued tasks");
+
+    std::cout << "✓ Exception and cancellation test passed\n";
+}
+
+void testBoundedWait() {
+    ThreadPool pool(2);
+    std::atomic<int> done(0);
+
+    TaskGroup group(pool);
+    for (int i = 0; i < 1000; i++) {
+        group.run([&]() { done++; });
+        group.wait(16);
+        check(group.pending() <= 16, "wait(maxPending) bounds in-flight tasks");
+    }
+    group.wait();
+    check(done.load() == 1000, "bounded producer runs every task");
+
+    std::cout << "✓ Bounded wait test passed\n";
+}
+
+void testNoWorkers() {
+    // Everything runs on the waiting thread
+    ThreadPool pool(ThreadPool::NO_WORKERS);
+    check(pool.size() == 0, "NO_WORKERS pool has no workers");
+
+    std::vector<int> ran(100, 0);
+    parallelFor(0, ran.size(), 7, [&](size_t i) { ran[i] = pool.currentWorkerIndex() == -1 ? 1 : 2; }, pool);
+    bool onCaller = true;
+    for (int value : ran) onCaller = onCaller && value == 1;
+    check(onCaller, "tasks run on the calling thread");
+
+    std::cout << "✓ No-worker pool test passed\n";
+}
+
+int main() {
+    printHeader("Thread Pool");
+
+    testParallelFor();
+    testNestedGroups();
+    testExceptionCancelsGroup();
+    testBoundedWait();
+    testNoWorkers();
+
+    return printSummary("thread pool");
+}
@@ -0,0 +1,147 @@
+// The trace functions are always built; enable the macros in this file too
+#ifndef HEXUKI_TRACE
+#define HEXUKI_TRACE
+#endif
+#include "core/trace.h"
+#include "test_util.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hexuki;
+
+static size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) count++;
+    return count;
+}
+
+static std::string dump(size_t* events = nullptr) {
+    std::ostringstream out;
+    size_t count = trace::writeChromeJson(out);
+    if (events) *events = count;
+    return out.str();
+}
+
+void testOffRecordsNothing() {
+    trace::stop();
+    trace::clear();
+    {
+        HEXUKI_TRACE_SCOPE("off.scope");
+    }
+    HEXUKI_TRACE_INSTANT("off.instant");
+    uint64_t start = HEXUKI_TRACE_NOW();
+    check(start == 0, "NOW is 0 while tracing is off");
+    trace::start();
+    HEXUKI_TRACE_COMPLETE("off.complete", start);  // Started while off: ignored
+    trace::stop();
+
+    size_t events = 0;
+    std::string json = dump(&events);
+    check(events == 0, "no events while off");
+    check(json.find("off.") == std::string::npos, "nothing named off.*");
+
+    std::cout << "✓ Tracing off test passed\n";
+}
+
+void testSpans() {
+    trace::clear();
+    trace::start();
+    {
+        HEXUKI_TRACE_SCOPE("outer", "depth", 7);
+        HEXUKI_TRACE_SCOPE("inner");
+        HEXUKI_TRACE_INSTANT("marker", "move", trace::moveArg(6, 5));
+    }
+    uint64_t start = HEXUKI_TRACE_NOW();
+    check(start != 0, "NOW is non-zero while tracing");
+    HEXUKI_TRACE_COMPLETE("split", start, "nodes", 1234);
+    trace::stop();
+
+    size_t events = 0;
+    std::string json = dump(&events);
+    check(events == 4, "four events recorded");
+    check(json.find("\"traceEvents\":[") != std::string::npos, "traceEvents array");
+    check(json.find("\"name\":\"outer\",\"ph\":\"X\"") != std::string::npos, "outer is a complete event");
+    check(json.find("\"args\":{\"depth\":7}") != std::string::npos, "outer argument");
+    check(json.find("\"name\":\"marker\",\"ph\":\"i\"") != std::string::npos, "marker is an instant event");
+    check(json.find("\"args\":{\"move\":65}") != std::string::npos, "move argument h6t5 -> 65");
+    check(json.find("\"args\":{\"nodes\":1234}") != std::string::npos, "split argument");
+    check(countOf(json, "\"dur\":") == 3, "three spans with a duration");
+    check(json.find("\"dropped_events\":0") != std::string::npos, "nothing dropped");
+
+    trace::clear();
+    check(dump(&events).find("outer") == std::string::npos && events == 0, "clear drops buffered events");
+
+    std::cout << "✓ Span test passed\n";
+}
+
+void testThreads() {
+    const int threads = 4;
+    const int perThread = 100;
+    trace::clear();
+    trace::start();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([t]() {
+            HEXUKI_TRACE_THREAD_NAME("test worker " + std::to_string(t));
+            for (int i = 0; i < perThread; i++) {
+                HEXUKI_TRACE_SCOPE("work", "i", i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    trace::stop();
+
+    size_t events = 0;
+    std::string json = dump(&events);
+    check(events == static_cast<size_t>(threads * perThread), "every thread's events kept after it exits");
+    for (int t = 0; t < threads; t++) {
+        check(json.find("\"name\":\"test worker " + std::to_string(t) + "\"") != std::string::npos,
+              "thread name metadata " + std::to_string(t));
+    }
+
+    std::cout << "✓ Multi-thread test passed\n";
+}
+
+void testOverflow() {
+    const int capacity = 64;
+    const int recorded = 200;
+    trace::setBufferCapacity(capacity);
+    trace::clear();
+    trace::start();
+    std::thread writer([]() {
+        for (int i = 0; i < recorded; i++) {
+            HEXUKI_TRACE_INSTANT("ring", "i", i);
+        }
+    });
+    writer.join();
+    trace::stop();
+
+    check(trace::droppedEvents() == static_cast<uint64_t>(recorded - capacity), "dropped count");
+    size_t events = 0;
+    std::string json = dump(&events);
+    check(events == static_cast<size_t>(capacity), "a full ring keeps its capacity");
+    check(json.find("\"args\":{\"i\":" + std::to_string(recorded - 1) + "}") != std::string::npos,
+          "newest event kept");
+    check(json.find("\"args\":{\"i\":0}") == std::string::npos, "oldest event overwritten");
+    check(json.find("\"dropped_events\":" + std::to_string(recorded - capacity)) != std::string::npos,
+          "dropped count in the trace");
+
+    trace::clear();
+    check(trace::droppedEvents() == 0, "clear resets the dropped count");
+
+    std::cout << "✓ Ring overflow test passed\n";
+}
+
+int main() {
+    printHeader("Trace");
+
+    testOffRecordsNothing();
+    testSpans();
+    testThreads();
+    testOverflow();
+
+    return printSummary("trace");
+}
@@ -0,0 +1,42 @@
+#ifndef HEXUKI_TEST_UTIL_H
+#define HEXUKI_TEST_UTIL_H
+
+#include <iostream>
+#include <string>
+
+/**
+ * Shared harness for the test executables: check() records a failure and
+ * keeps going, so one run reports every broken check; main() prints the
+ * header, runs the tests and returns printSummary().
+ */
+
+inline int failures = 0;
+
+inline void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "✗ FAILED: " << what << "\n";
+        failures++;
+    }
+}
+
+// "HEXUKI C++ ENGINE - <title> Tests" banner
+inline void printHeader(const std::string& title) {
+    std::cout << "===========================================\n";
+    std::cout << "HEXUKI C++ ENGINE - " << title << " Tests\n";
+    std::cout << "===========================================\n\n";
+}
+
+// Pass/fail banner; the exit code for main()
+inline int printSummary(const std::string& suite) {
+    std::cout << "\n===========================================\n";
+    if (failures > 0) {
+        std::cout << "✗ " << failures << " check(s) failed\n";
+        std::cout << "===========================================\n";
+        return 1;
+    }
+    std::cout << "✅ All " << suite << " tests passed!\n";
+    std::cout << "===========================================\n";
+    return 0;
+}
+
+#endif // HEXUKI_TEST_UTIL_H
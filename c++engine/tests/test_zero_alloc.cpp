@@ -0,0 +1,226 @@
+/**
+ * Zero-allocation check for the search hot paths
+ *
+ * Links the counting operator new/malloc hook from benchmarks/alloc_counter
+ * and runs move generation, make/unmake and evaluation, random rollouts,
+ * alphaBeta and resumable-search steps over the benchmark corpus. Each
+ * workload runs once to warm up (tables, lazily built statics), then again
+ * with every allocation on every thread counted; any allocation fails the
+ * test with the call stacks that made it.
+ */
+
+#include "alloc_counter.h"
+#include "bench_corpus.h"
+#include "bench_harness.h"
+#include "ai/minimax.h"
+#include "core/bitboard.h"
+#include "core/board_kernels.h"
+#include "test_util.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace hexuki;
+using namespace hexuki::bench;
+
+// Warm up once, then run counted; prints the allocation sites on failure.
+// prepare (optional) runs uncounted before each run.
+static void checkNoAllocations(const std::string& what, const std::function<void()>& work,
+                               const std::function<void()>& prepare = nullptr) {
+    if (prepare) prepare();
+    work();
+    if (prepare) prepare();
+    beginAllocationCount(true);
+    work();
+    AllocationStats stats = endAllocationCount();
+    if (stats.count > 0) {
+        std::cout << "✗ FAILED: " << what << " allocates: ";
+        printAllocationReport(std::cout, stats);
+        failures++;
+        return;
+    }
+    std::cout << "✓ " << what << ": no allocations\n";
+}
+
+static std::vector<HexukiBitboard> allPositions() {
+    std::vector<HexukiBitboard> positions;
+    for (Phase phase : ALL_PHASES) {
+        for (const HexukiBitboard& board : corpus(phase)) positions.push_back(board);
+    }
+    return positions;
+}
+
+static int emptyHexes(const HexukiBitboard& board) {
+    int empty = 0;
+    for (int hex = 0; hex < NUM_HEXES; hex++) empty += board.isHexOccupied(hex) ? 0 : 1;
+    return empty;
+}
+
+// ============================================================================
+// Hook self-test: without it every check below would pass vacuously
+// ============================================================================
+
+void testHookCounts() {
+    beginAllocationCount(true);
+    int* single = new int(7);
+    std::vector<int> grown;
+    for (int i = 0; i < 100; i++) grown.push_back(i);
+    doNotOptimize(grown.data());
+    AllocationStats stats = endAllocationCount();
+    delete single;
+    check(stats.count >= 2, "new and vector growth are counted");
+    check(stats.bytes >= sizeof(int) + 100 * sizeof(int), "bytes are counted");
+    check(!allocationSites().empty(), "allocation sites recorded");
+
+    if (mallocHooked()) {
+        beginAllocationCount();
+        void* raw = std::malloc(64);
+        doNotOptimize(raw);
+        AllocationStats mallocs = endAllocationCount();
+        std::free(raw);
+        check(mallocs.count == 1 && mallocs.bytes == 64, "malloc counted once");
+
+        beginAllocationCount();
+        int* viaNew = new int(1);
+        doNotOptimize(viaNew);
+        AllocationStats news = endAllocationCount();
+        delete viaNew;
+        check(news.count == 1, "new counted once, not again by malloc");
+    }
+
+    beginAllocationCount();
+    std::vector<int> counted(10);
+    doNotOptimize(counted.data());
+    AllocationStats first = endAllocationCount();
+    std::vector<int> after(10);
+    doNotOptimize(after.data());
+    check(first.count == 1 && endAllocationCount().count == first.count, "nothing counted after endAllocationCount");
+
+    std::cout << "✓ Allocation hook test passed\n";
+}
+
+// ============================================================================
+// Hot paths
+// ============================================================================
+
+void testMoveGeneration(const std::vector<HexukiBitboard>& positions) {
+    auto working = std::make_shared<std::vector<HexukiBitboard>>(positions);
+    checkNoAllocations("move generation, make/unmake, scoring", [working]() {
+        int64_t sink = 0;
+        for (HexukiBitboard& board : *working) {
+            Move moves[MAX_LEGAL_MOVES];
+            int count = board.getValidMoves(moves);
+            int tiles[NUM_TILES_PER_PLAYER];
+            sink += board.getUniqueTiles(tiles) + kernels::popCount(board.getLegalHexMask());
+            for (int i = 0; i < count; i++) {
+                sink += board.isValidMove(moves[i]);
+                board.makeMove(moves[i]);
+                int p1 = 0;
+                int p2 = 0;
+                board.getScores(p1, p2);
+                sink += p1 - p2 + minimax::evaluate(board) + board.isGameOver() + static_cast<int64_t>(board.getHash());
+                board.unmakeMove(moves[i]);
+            }
+        }
+        doNotOptimize(sink);
+    });
+}
+
+// The random phase of MCTS::simulate on a board assigned in place, as MCTS::step does
+void testRollouts(const std::vector<HexukiBitboard>& positions) {
+    auto board = std::make_shared<HexukiBitboard>();
+    auto rng = std::make_shared<std::mt19937>(1);
+    checkNoAllocations("random rollouts", [&positions, board, rng]() {
+        int64_t sink = 0;
+        for (int repeat = 0; repeat < 20; repeat++) {
+            for (const HexukiBitboard& start : positions) {
+                *board = start;
+                while (!board->isGameOver()) {
+                    uint32_t legal = board->getLegalHexMask();
+                    int tiles[NUM_TILES_PER_PLAYER];
+                    int tileCount = board->getUniqueTiles(tiles);
+                    int moveCount = kernels::popCount(legal) * tileCount;
+                    if (moveCount == 0) break;
+                    int index = static_cast<int>((*rng)() % static_cast<uint32_t>(moveCount));
+                    board->makeMove(Move(kernels::nthSetBit(legal, index / tileCount), tiles[index % tileCount]));
+                }
+                int p1 = 0;
+                int p2 = 0;
+                board->getScores(p1, p2);
+                sink += p1 - p2;
+            }
+        }
+        doNotOptimize(sink);
+    });
+}
+
+// Fixed-depth searches, and endgames to the end of the game as MCTS minimax
+// rollouts search them, all on one shared table
+void testAlphaBeta() {
+    auto tt = std::make_shared<minimax::TranspositionTable>(16);
+    const int depths[] = {3, 4, 0};  // 0: every empty hex
+    for (size_t p = 0; p < 3; p++) {
+        Phase phase = ALL_PHASES[p];
+        auto boards = std::make_shared<std::vector<HexukiBitboard>>(corpus(phase));
+        int fixedDepth = depths[p];
+        checkNoAllocations(std::string("alphaBeta, ") + phaseName(phase), [boards, tt, fixedDepth]() {
+            int64_t sink = 0;
+            for (HexukiBitboard& board : *boards) {
+                minimax::KillerMoves killers;
+                minimax::HistoryTable history;
+                int nodes = 0;
+                int depth = fixedDepth > 0 ? fixedDepth : emptyHexes(board);
+                sink += minimax::alphaBeta(board, depth, -1000000, 1000000, *tt, nodes,
+                                           std::chrono::steady_clock::now(), INT_MAX, killers, history, 0);
+                sink += nodes;
+            }
+            doNotOptimize(sink);
+        });
+        tt->clear();
+    }
+}
+
+// SearchTask allocates its stack and root move list when constructed; the
+// search itself, step after step, must not
+void testSearchTaskSteps() {
+    auto tt = std::make_shared<minimax::TranspositionTable>(16);
+    minimax::SearchConfig config;
+    config.maxDepth = 4;
+    config.timeLimitMs = INT_MAX;
+    auto boards = std::make_shared<std::vector<HexukiBitboard>>(corpus(Phase::MIDGAME));
+    auto tasks = std::make_shared<std::vector<std::unique_ptr<minimax::SearchTask>>>();
+
+    auto construct = [boards, tt, config, tasks]() {
+        tasks->clear();
+        tt->clear();
+        for (const HexukiBitboard& board : *boards) {
+            tasks->push_back(std::make_unique<minimax::SearchTask>(board, config, tt.get()));
+        }
+    };
+    checkNoAllocations("SearchTask::step, midgame", [tasks]() {
+        for (auto& task : *tasks) {
+            while (!task->step(1000)) {}
+            doNotOptimize(task->getResult().score);
+        }
+    }, construct);
+}
+
+int main() {
+    printHeader("Zero Allocation");
+
+    std::vector<HexukiBitboard> positions = allPositions();
+
+    testHookCounts();
+    testMoveGeneration(positions);
+    testRollouts(positions);
+    testAlphaBeta();
+    testSearchTaskSteps();
+
+    return printSummary("zero allocation");
+}
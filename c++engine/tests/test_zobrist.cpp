@@ -0,0 +1,68 @@
+#include "core/bitboard.h"
+#include "core/zobrist.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hexuki;
+
+// Keys must be usable in constant expressions (no runtime initialization)
+static_assert(Zobrist::getTileHash(9, 1) != 0, "tile keys are compile-time constants");
+static_assert(Zobrist::getPlayerHash(PLAYER_1) != Zobrist::getPlayerHash(PLAYER_2), "player keys differ");
+
+void testKeysMatchRuntimeGenerator() {
+    // Same seed and draw order as the former runtime initialization, so
+    // hashes stored in label files and tables stay valid
+    std::mt19937_64 rng(0x1234567890ABCDEF);
+    bool tilesMatch = true;
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+            if (Zobrist::getTileHash(hexId, TILE_VALUES[i]) != rng()) tilesMatch = false;
+        }
+    }
+    check(tilesMatch, "tile keys match std::mt19937_64 sequence");
+    check(Zobrist::getPlayerHash(PLAYER_1) == rng() && Zobrist::getPlayerHash(PLAYER_2) == rng(),
+          "player keys match std::mt19937_64 sequence");
+
+    ConstexprMt19937_64 constRng(42);
+    std::mt19937_64 stdRng(42);
+    bool sequenceMatch = true;
+    for (int i = 0; i < 2000; i++) {
+        if (constRng.next() != stdRng()) sequenceMatch = false;
+    }
+    check(sequenceMatch, "constexpr generator matches std::mt19937_64 across twists");
+
+    std::cout << "✓ Key generation test passed\n";
+}
+
+void testConcurrentHashing() {
+    // Boards built on several threads at once hash identically
+    std::vector<uint64_t> hashes(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&hashes, t]() {
+            HexukiBitboard board;
+            board.loadPosition("h9:1,h6:5,h7:3|p1:2,4,8|p2:6,7,9|turn:1");
+            hashes[t] = board.getHash();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    check(hashes[0] == hashes[1] && hashes[1] == hashes[2] && hashes[2] == hashes[3],
+          "concurrent hashing is consistent");
+
+    std::cout << "✓ Concurrent hashing test passed\n";
+}
+
+int main() {
+    printHeader("Zobrist");
+
+    testKeysMatchRuntimeGenerator();
+    testConcurrentHashing();
+
+    return printSummary("Zobrist");
+}
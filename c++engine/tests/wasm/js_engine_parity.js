@@ -0,0 +1,167 @@
+/**
+ * JS engine / batched rules parity test (Node)
+ *
+ * Replays the seeded games of tests/test_batch_ops (--reference) on
+ * hexuki_game_engine_v2.js: before every ply the JS engine must list exactly
+ * the moves the C++ batch layer listed (same order), every move must be
+ * accepted and the final scores must match. When wasm/hexuki.js has been
+ * rebuilt with the batch exports, hexuki_game_engine_wasm.js is also checked against the pure JS
+ * engine on random games, including replays of batchPlayouts.
+ *
+ * Usage:
+ *   node tests/wasm/js_engine_parity.js <path to test_batch_ops>
+ */
+
+const path = require('path');
+const fs = require('fs');
+const vm = require('vm');
+const { execFileSync } = require('child_process');
+
+const REPO_DIR = path.join(__dirname, '..', '..', '..');
+const WASM_MODULE = path.join(__dirname, '..', '..', 'wasm', 'hexuki.js');
+const NATIVE = process.argv[2];
+
+let failures = 0;
+
+function check(condition, what) {
+    if (!condition) {
+        console.log(`✗ FAILED: ${what}`);
+        failures++;
+    }
+}
+
+function sameMoves(moves, flat) {
+    if (moves.length * 2 !== flat.length) return false;
+    return moves.every((move, i) => move.hexId === flat[i * 2] && move.tileValue === flat[i * 2 + 1]);
+}
+
+function movesKey(moves) {
+    return moves.map(move => `${move.hexId}:${move.tileValue}`).join(',');
+}
+
+function replayReference(JsEngine, reference) {
+    reference.forEach((ref, g) => {
+        const game = new JsEngine();
+        ref.plies.forEach((ply, p) => {
+            check(sameMoves(game.getAllValidMoves(), ply.legal), `game ${g} ply ${p}: legal moves differ`);
+            check(game.makeMove(ply.move[0], ply.move[1]), `game ${g} ply ${p}: move rejected`);
+        });
+        const scores = game.calculateScores();
+        check(game.gameEnded && scores.player1 === ref.player1 && scores.player2 === ref.player2,
+              `game ${g}: final scores differ`);
+    });
+    console.log(`✓ ${reference.length} native games replayed on hexuki_game_engine_v2.js`);
+}
+
+// Browser scripts: run them as <script> tags would, in the global scope
+function loadScript(file) {
+    vm.runInThisContext(fs.readFileSync(path.join(REPO_DIR, file), 'utf8'), { filename: file });
+}
+
+// Seeded LCG so failures are reproducible
+function makeRandom(seed) {
+    let state = seed >>> 0;
+    return () => {
+        state = (Math.imul(state, 1664525) + 1013904223) >>> 0;
+        return state / 0x100000000;
+    };
+}
+
+async function checkShim(JsEngine) {
+    const factory = require(WASM_MODULE);
+    loadScript('hexuki_game_engine_wasm.js');
+    const Shim = vm.runInThisContext('HexukiGameEngineV2');
+    check(Shim !== JsEngine && Shim.JsEngine === JsEngine, 'shim replaces HexukiGameEngineV2');
+    check(await Shim.init(factory), 'wasm/hexuki.js has the batch exports');
+    if (!Shim.isWasmReady()) return;
+
+    // Shim and JS engine side by side on random games
+    const random = makeRandom(7);
+    const games = [];
+    for (let g = 0; g < 50; g++) {
+        const js = new JsEngine();
+        const shim = new Shim();
+        while (!js.gameEnded) {
+            const moves = js.getAllValidMoves();
+            check(movesKey(shim.getAllValidMoves()) === movesKey(moves), `game ${g}: shim moves differ`);
+            for (let hexId = 0; hexId < 19; hexId++) {
+                if (js.isMoveLegal(hexId) !== shim.isMoveLegal(hexId)) {
+                    check(false, `game ${g}: isMoveLegal(${hexId}) differs`);
+                }
+            }
+            if (moves.length === 0) break;
+            const move = moves[Math.floor(random() * moves.length)];
+            check(js.makeMove(move.hexId, move.tileValue) && shim.makeMove(move.hexId, move.tileValue),
+                  `game ${g}: move rejected`);
+            if (js.moveCount === g % 17) games.push(cloneOf(shim, Shim));
+        }
+        const a = js.calculateScores();
+        const b = Shim.batchScores([shim])[0];
+        check(a.player1 === b.player1 && a.player2 === b.player2, `game ${g}: scores differ`);
+    }
+    console.log('✓ Shim matches the JS engine on 50 random games');
+
+    // Batched playouts replay legally on the JS engine
+    const snapshot = () => JSON.stringify(games.map(game => [game.board.map(hex => hex.value), game.moveCount]));
+    const before = snapshot();
+    const playouts = Shim.batchPlayouts(games, 123);
+    check(movesKey(Shim.batchPlayouts(games, 123).map(r => r.moves).flat()) ===
+          movesKey(playouts.map(r => r.moves).flat()), 'batchPlayouts reproducible by seed');
+    playouts.forEach((result, i) => {
+        const js = cloneOf(games[i], JsEngine);
+        result.moves.forEach(move => {
+            check(js.makeMove(move.hexId, move.tileValue), `playout ${i}: move rejected by JS engine`);
+        });
+        const scores = js.calculateScores();
+        check(js.gameEnded && scores.player1 === result.player1 && scores.player2 === result.player2,
+              `playout ${i}: final scores differ`);
+    });
+    check(snapshot() === before, 'games unchanged by batchPlayouts');
+    console.log(`✓ ${playouts.length} batched playouts replayed on the JS engine`);
+}
+
+// Copy the public game fields, the way the AI players clone games
+function cloneOf(game, EngineClass) {
+    const cloned = new EngineClass();
+    cloned.board = game.board.map(hex => Object.assign({}, hex));
+    cloned.player1Tiles = [...game.player1Tiles];
+    cloned.player2Tiles = [...game.player2Tiles];
+    cloned.currentPlayer = game.currentPlayer;
+    cloned.gameEnded = game.gameEnded;
+    cloned.moveCount = game.moveCount;
+    return cloned;
+}
+
+async function main() {
+    console.log('===========================================');
+    console.log('HEXUKI - JS Engine / Batched Rules Parity');
+    console.log('===========================================\n');
+
+    if (!NATIVE) {
+        throw new Error('usage: node js_engine_parity.js <path to test_batch_ops>');
+    }
+    loadScript('hexuki_game_engine_v2.js');
+    const JsEngine = vm.runInThisContext('HexukiGameEngineV2');
+    replayReference(JsEngine, JSON.parse(execFileSync(NATIVE, ['--reference']).toString()));
+
+    // Builds from before the batch exports cannot back the shim
+    if (fs.existsSync(WASM_MODULE) && fs.readFileSync(WASM_MODULE, 'utf8').includes('_wasmBatchPlayouts')) {
+        await checkShim(JsEngine);
+    } else {
+        console.log('- wasm/hexuki.js with batch exports not built, shim not checked');
+    }
+
+    console.log('\n===========================================');
+    if (failures > 0) {
+        console.log(`✗ ${failures} check(s) failed`);
+        console.log('===========================================');
+        process.exit(1);
+    }
+    console.log('✅ JS engine matches the batched rules!');
+    console.log('===========================================');
+}
+
+main().catch(err => {
+    console.error(err);
+    process.exit(1);
+});
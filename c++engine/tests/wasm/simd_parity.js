@@ -0,0 +1,106 @@
+/**
+ * SIMD128 / scalar WASM parity test (Node)
+ *
+ * Plays seeded random games on wasm/hexuki.js (scalar kernels) and
+ * wasm/hexuki_simd.js (SIMD128 kernels) side by side and checks that both
+ * modules produce identical move lists, scores and minimax results.
+ *
+ * Usage (after build_wasm.bat):  node tests/wasm/simd_parity.js [games]
+ */
+
+const path = require('path');
+
+const WASM_DIR = path.join(__dirname, '..', '..', 'wasm');
+const GAMES = parseInt(process.argv[2] || '50', 10);
+const MINIMAX_DEPTH = 4;
+
+let failures = 0;
+
+function check(condition, what) {
+    if (!condition) {
+        console.log(`✗ FAILED: ${what}`);
+        failures++;
+    }
+}
+
+// Small deterministic PRNG (xorshift32) so both modules see the same games
+function makeRng(seed) {
+    let state = seed >>> 0 || 1;
+    return () => {
+        state ^= state << 13; state >>>= 0;
+        state ^= state >>> 17;
+        state ^= state << 5; state >>>= 0;
+        return state;
+    };
+}
+
+function packedMoves(Module, h) {
+    const ptr = Module._wasmEngineGetValidMovesPacked(h) >> 2;
+    const len = Module._wasmEngineGetMoveBufferLength(h);
+    return Array.from(Module.HEAP32.subarray(ptr, ptr + len));
+}
+
+function packedMinimax(Module, h) {
+    const ptr = Module._wasmEngineMinimaxFindBestMovePacked(h, MINIMAX_DEPTH, 600000) >> 3;
+    const r = Module.HEAPF64.subarray(ptr, ptr + Module._wasmEngineGetResultBufferLength(h));
+    // hexId, tileValue, nodes, score, depth (timeMs differs by design)
+    return [r[2], r[3], r[5], r[8], r[9]];
+}
+
+function sameArray(a, b) {
+    return a.length === b.length && a.every((v, i) => v === b[i]);
+}
+
+async function main() {
+    console.log('===========================================');
+    console.log('HEXUKI WASM - SIMD128 / Scalar Parity Test');
+    console.log('===========================================\n');
+
+    const scalar = await require(path.join(WASM_DIR, 'hexuki.js'))();
+    const simd = await require(path.join(WASM_DIR, 'hexuki_simd.js'))();
+    const modules = [scalar, simd];
+
+    let positions = 0;
+    let searches = 0;
+    for (let game = 0; game < GAMES && failures === 0; game++) {
+        const rng = makeRng(game + 1);
+        const handles = modules.map(M => M._wasmEngineCreate());
+
+        for (let ply = 0; failures === 0; ply++) {
+            const moves = modules.map((M, i) => packedMoves(M, handles[i]));
+            check(sameArray(moves[0], moves[1]), `game ${game} ply ${ply}: move lists differ`);
+
+            const scores = modules.map((M, i) => [M._wasmEngineGetScoreP1(handles[i]), M._wasmEngineGetScoreP2(handles[i])]);
+            check(sameArray(scores[0], scores[1]), `game ${game} ply ${ply}: scores differ`);
+            positions++;
+
+            if (game < 10 && (ply === 6 || ply === 10)) {
+                const results = modules.map((M, i) => packedMinimax(M, handles[i]));
+                check(sameArray(results[0], results[1]), `game ${game} ply ${ply}: minimax results differ`);
+                searches++;
+            }
+
+            const count = moves[0].length / 2;
+            if (count === 0) break;
+            const pick = rng() % count;
+            modules.forEach((M, i) => M._wasmEngineMakeMove(handles[i], moves[0][2 * pick], moves[0][2 * pick + 1]));
+        }
+
+        modules.forEach((M, i) => M._wasmEngineDestroy(handles[i]));
+    }
+
+    console.log(`✓ ${positions} positions and ${searches} minimax searches compared`);
+    console.log('\n===========================================');
+    if (failures > 0) {
+        console.log(`✗ ${failures} check(s) failed`);
+        console.log('===========================================');
+        process.exit(1);
+    }
+    console.log('✅ SIMD128 and scalar builds agree!');
+    console.log('===========================================');
+}
+
+main().catch(err => {
+    console.error(err);
+    process.exit(1);
+});
@@ -0,0 +1,89 @@
+/**
+ * Multithreaded WASM / native parity test (Node)
+ *
+ * Runs the parallel MCTS and minimax searches of tests/test_parallel_search
+ * (--reference) on wasm/hexuki_mt.js (pthreads) and on the single-threaded
+ * modules, where the same searches fall back to the calling thread, and
+ * checks that every module reproduces the native results exactly.
+ *
+ * Usage (after build_wasm.bat and a native build):
+ *   node tests/wasm/threads_parity.js <path to test_parallel_search>
+ */
+
+const path = require('path');
+const fs = require('fs');
+const { execFileSync } = require('child_process');
+
+const WASM_DIR = path.join(__dirname, '..', '..', 'wasm');
+const NATIVE = process.argv[2];
+
+let failures = 0;
+
+function check(condition, what) {
+    if (!condition) {
+        console.log(`✗ FAILED: ${what}`);
+        failures++;
+    }
+}
+
+function packedResult(Module, h, ptr) {
+    const start = ptr >> 3;
+    return Module.HEAPF64.subarray(start, start + Module._wasmEngineGetResultBufferLength(h));
+}
+
+function runCase(Module, name, ref) {
+    const h = Module._wasmEngineCreate();
+    Module.engineLoadPosition(h, ref.position);
+    Module._wasmEngineSetThreads(h, ref.threads);
+    Module._wasmEngineSetSeed(h, ref.mcts.seed);
+
+    // hexId, tileValue, score, depth
+    let r = packedResult(Module, h, Module._wasmEngineMinimaxFindBestMovePacked(h, ref.minimax.depth, 600000));
+    const mm = ref.minimax;
+    check(r[2] === mm.hexId && r[3] === mm.tileValue && r[8] === mm.score && r[9] === mm.depth,
+          `${name}: minimax differs from native on ${ref.position}`);
+
+    // hexId, tileValue, work (simulations), visits, winRate
+    r = packedResult(Module, h, Module._wasmEngineMCTSFindBestMovePacked(h, ref.mcts.simulations, 0, false, false, 7));
+    const mc = ref.mcts;
+    check(r[2] === mc.hexId && r[3] === mc.tileValue && r[5] === mc.simulations && r[6] === mc.visits && r[7] === mc.winRate,
+          `${name}: MCTS differs from native on ${ref.position}`);
+
+    Module._wasmEngineDestroy(h);
+}
+
+async function main() {
+    console.log('===========================================');
+    console.log('HEXUKI WASM - Threads / Native Parity Test');
+    console.log('===========================================\n');
+
+    if (!NATIVE) {
+        throw new Error('usage: node threads_parity.js <path to test_parallel_search>');
+    }
+    const reference = JSON.parse(execFileSync(NATIVE, ['--reference']).toString());
+
+    const builds = ['hexuki_mt.js', 'hexuki_simd.js', 'hexuki.js']
+        .filter(file => fs.existsSync(path.join(WASM_DIR, file)));
+    for (const file of builds) {
+        const Module = await require(path.join(WASM_DIR, file))();
+        const name = `${file} (${Module._wasmGetHardwareThreads()} thread(s))`;
+        reference.forEach(ref => runCase(Module, name, ref));
+        console.log(`✓ ${name}: ${reference.length} positions compared`);
+    }
+    check(builds.includes('hexuki_mt.js'), 'wasm/hexuki_mt.js found');
+
+    console.log('\n===========================================');
+    if (failures > 0) {
+        console.log(`✗ ${failures} check(s) failed`);
+        console.log('===========================================');
+        process.exit(1);
+    }
+    console.log('✅ Threaded and single-threaded WASM builds match native!');
+    console.log('===========================================');
+    process.exit(0);  // Pthread workers would otherwise keep Node alive
+}
+
+main().catch(err => {
+    console.error(err);
+    process.exit(1);
+});
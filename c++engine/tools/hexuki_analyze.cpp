@@ -0,0 +1,166 @@
+/**
+ * hexuki_analyze - analyze a file of positions in parallel
+ *
+ * Usage:
+ *   hexuki_analyze --input positions.txt --output results.jsonl [options]
+ *
+ * Options:
+ *   --input FILE      Positions ('-' = stdin, default)
+ *   --format F        text (savePosition per line) | json (puzzle levels) | packed
+ *                     (int32 position records); default from the extension
+ *                     (.json/.jsonl, .bin/.pos), else text
+ *   --output FILE     Results ('-' = stdout, default). If the file exists, the
+ *                     run resumes: records already in it are skipped
+ *   --engine E        minimax (default) | mcts | solve
+ *   --depth N         Minimax depth (default 8)
+ *   --sims N          MCTS simulations (default 10000)
+ *   --movetime MS     Per-position time limit instead of depth/simulations
+ *   --seed N          MCTS seed; position i uses seed + i (default 1, 0 = random)
+ *   --csv             CSV instead of JSON lines
+ *   --unordered       Write results as they complete instead of in input order
+ *   --threads N       Worker threads in the shared pool (default: all cores)
+ *   --pin             Pin pool workers to cores
+ *   --tt MB           Shared transposition table size (default 256)
+ *   --quiet           No progress output
+ */
+
+#include "core/thread_pool.h"
+#include "io/game_record.h"
+#include "tools/batch_analysis.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace hexuki;
+
+static void printUsage() {
+    std::cerr << "Usage: hexuki_analyze [--input FILE] [--format text|json|packed] [--output FILE]"
+              << " [--engine minimax|mcts|solve] [--depth N] [--sims N] [--movetime MS] [--seed N]"
+              << " [--csv] [--unordered] [--threads N] [--pin] [--tt MB] [--quiet]\n";
+}
+
+int main(int argc, char** argv) {
+    std::string inputPath = "-";
+    std::string outputPath = "-";
+    std::string format;
+    tools::AnalysisConfig config;
+
+    int threads = 0;
+    bool pinThreads = false;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--input" && hasValue) {
+                inputPath = argv[++i];
+            } else if (arg == "--format" && hasValue) {
+                format = argv[++i];
+            } else if (arg == "--output" && hasValue) {
+                outputPath = argv[++i];
+            } else if (arg == "--engine" && hasValue) {
+                std::string engine = argv[++i];
+                if (engine == "minimax") {
+                    config.engine = tools::AnalysisEngine::MINIMAX;
+                } else if (engine == "mcts") {
+                    config.engine = tools::AnalysisEngine::MCTS;
+                } else if (engine == "solve") {
+                    config.engine = tools::AnalysisEngine::SOLVE;
+                } else {
+                    printUsage();
+                    return 1;
+                }
+            } else if (arg == "--depth" && hasValue) {
+                config.depth = std::stoi(argv[++i]);
+            } else if (arg == "--sims" && hasValue) {
+                config.sims = std::stoi(argv[++i]);
+            } else if (arg == "--movetime" && hasValue) {
+                config.movetimeMs = std::stoi(argv[++i]);
+            } else if (arg == "--seed" && hasValue) {
+                config.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--csv") {
+                config.output = tools::OutputFormat::CSV;
+            } else if (arg == "--unordered") {
+                config.ordered = false;
+            } else if (arg == "--threads" && hasValue) {
+                threads = std::stoi(argv[++i]);
+            } else if (arg == "--pin") {
+                pinThreads = true;
+            } else if (arg == "--tt" && hasValue) {
+                config.ttSizeMB = std::stoul(argv[++i]);
+            } else if (arg == "--quiet") {
+                config.verbose = false;
+            } else {
+                printUsage();
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage();
+        return 1;
+    }
+
+    tools::PositionFormat positionFormat = tools::PositionReader::formatForPath(inputPath);
+    if (format == "text") {
+        positionFormat = tools::PositionFormat::TEXT;
+    } else if (format == "json") {
+        positionFormat = tools::PositionFormat::JSON;
+    } else if (format == "packed") {
+        positionFormat = tools::PositionFormat::PACKED;
+    } else if (!format.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    ThreadPool::configureGlobal(threads, pinThreads);
+    // This process owns the table pool: make room for the requested table
+    minimax::TablePool& tablePool = minimax::TablePool::global();
+    tablePool.setBudgetMB(std::max(tablePool.getBudgetMB(), config.ttSizeMB));
+
+    tools::BatchAnalyzer analyzer(config);
+
+    // Resume: skip everything already in the output file
+    bool resuming = false;
+    if (outputPath != "-" && std::filesystem::exists(outputPath)) {
+        resuming = io::truncatePartialLine(outputPath) > 0;
+        std::ifstream existing(outputPath);
+        size_t loaded = analyzer.loadExisting(existing);
+        if (config.verbose) {
+            std::cerr << "Resuming: " << loaded << " positions already analyzed\n";
+        }
+    }
+
+    std::ofstream file;
+    if (outputPath != "-") {
+        file.open(outputPath, std::ios::app);
+        if (!file) {
+            std::cerr << "Cannot open output file: " << outputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath == "-" ? std::cout : file;
+
+    std::ifstream inputFile;
+    if (inputPath != "-") {
+        inputFile.open(inputPath, std::ios::binary);
+        if (!inputFile) {
+            std::cerr << "Cannot open input file: " << inputPath << "\n";
+            return 1;
+        }
+    } else if (positionFormat == tools::PositionFormat::PACKED) {
+        std::ios::sync_with_stdio(false);
+    }
+    tools::PositionReader reader(inputPath == "-" ? std::cin : inputFile, positionFormat);
+
+    tools::AnalysisStats stats = analyzer.run(reader, out, !resuming);
+
+    if (config.verbose) {
+        std::cerr << "Positions: " << stats.read
+                  << " | Analyzed: " << stats.analyzed
+                  << " | Skipped: " << stats.skipped
+                  << " | Errors: " << stats.errors
+                  << " | Time: " << static_cast<long long>(stats.timeMs) << " ms\n";
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * hexuki_archive - create and inspect game archives
+ *
+ * Usage:
+ *   hexuki_archive import <dir> <writer> [--input FILE] [--source NAME]
+ *       Append game records (text, one game per line) to segment <writer>
+ *   hexuki_archive info <dir>
+ *       Segment and result counts
+ *   hexuki_archive export <dir> [--prefix "h6t5 h7t4"] [--result 1|0|-1]
+ *       Print games (optionally filtered via the index) as move lines
+ */
+
+#include "io/game_archive.h"
+#include "io/game_record.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace hexuki;
+
+static void printUsage() {
+    std::cerr << "Usage:\n"
+              << "  hexuki_archive import <dir> <writer> [--input FILE] [--source NAME]\n"
+              << "  hexuki_archive info <dir>\n"
+              << "  hexuki_archive export <dir> [--prefix \"h6t5 h7t4\"] [--result 1|0|-1]\n";
+}
+
+static io::GameSource parseSource(const std::string& name) {
+    if (name == "mcts") return io::GameSource::SELF_PLAY_MCTS;
+    if (name == "minimax") return io::GameSource::SELF_PLAY_MINIMAX;
+    if (name == "random") return io::GameSource::RANDOM;
+    if (name == "hybrid") return io::GameSource::HYBRID;
+    if (name == "human") return io::GameSource::HUMAN;
+    return io::GameSource::IMPORTED;
+}
+
+static int importGames(const std::string& dir, const std::string& writerName, int argc, char** argv) {
+    std::string inputPath = "-";
+    io::GameSource source = io::GameSource::IMPORTED;
+    for (int i = 4; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--input" && i + 1 < argc) {
+            inputPath = argv[++i];
+        } else if (arg == "--source" && i + 1 < argc) {
+            source = parseSource(argv[++i]);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::ifstream file;
+    if (inputPath != "-") {
+        file.open(inputPath);
+        if (!file) {
+            std::cerr << "Cannot open input file: " << inputPath << "\n";
+            return 1;
+        }
+    }
+    std::istream& in = (inputPath == "-") ? std::cin : file;
+
+    io::ArchiveWriter writer(dir, writerName);
+    io::GameRecordReader reader(in);
+    io::GameRecord game;
+    uint64_t imported = 0;
+    uint64_t skipped = 0;
+
+    while (reader.next(game)) {
+        if (!game.startPosition.empty()) {
+            skipped++;  // Archive records always start from the initial position
+            continue;
+        }
+        try {
+            writer.append(io::ArchiveRecord::fromGame(game.moves, source));
+            imported++;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "Line " << reader.getLineNumber() << ": " << e.what() << "\n";
+            skipped++;
+        }
+    }
+    writer.flush();
+
+    std::cerr << "Imported " << imported << " games (" << skipped << " skipped) into "
+              << writer.getPath() << " (" << writer.getCount() << " total)\n";
+    return 0;
+}
+
+static int printInfo(const std::string& dir) {
+    io::GameArchive archive(dir);
+    uint64_t results[3] = {0, 0, 0};
+
+    for (const auto& segment : archive.getSegments()) {
+        std::cout << segment.path << ": " << segment.count << " games\n";
+        for (uint64_t i = 0; i < segment.count; i++) {
+            int r = segment.records[i].result;
+            results[(r > 0) ? 2 : (r < 0) ? 0 : 1]++;
+        }
+    }
+
+    std::cout << "Total: " << archive.size() << " games"
+              << " | P1 wins: " << results[2]
+              << " | Draws: " << results[1]
+              << " | P2 wins: " << results[0] << "\n";
+    return 0;
+}
+
+static int exportGames(const std::string& dir, int argc, char** argv) {
+    std::vector<Move> prefix;
+    int result = io::ArchiveIndex::ANY_RESULT;
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--prefix" && i + 1 < argc) {
+            io::GameRecord record;
+            io::parseGameRecord(argv[++i], record);
+            prefix = record.moves;
+        } else if (arg == "--result" && i + 1 < argc) {
+            result = std::stoi(argv[++i]);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    io::GameArchive archive(dir);
+    auto printGame = [](const io::ArchiveRecord& record) {
+        auto moves = record.getMoves();
+        for (size_t ply = 0; ply < moves.size(); ply++) {
+            if (ply > 0) std::cout << ' ';
+            std::cout << moves[ply].toString();
+        }
+        std::cout << "\t# P1 " << record.p1Score << " P2 " << record.p2Score << "\n";
+    };
+
+    if (prefix.empty() && result == io::ArchiveIndex::ANY_RESULT) {
+        for (const auto& segment : archive.getSegments()) {
+            for (uint64_t i = 0; i < segment.count; i++) {
+                printGame(segment.records[i]);
+            }
+        }
+    } else {
+        io::ArchiveIndex index(archive);
+        for (uint64_t id : index.find(prefix, result)) {
+            printGame(archive[id]);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    std::string command = argv[1];
+    std::string dir = argv[2];
+
+    try {
+        if (command == "import" && argc >= 4) return importGames(dir, argv[3], argc, argv);
+        if (command == "info") return printInfo(dir);
+        if (command == "export") return exportGames(dir, argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    printUsage();
+    return 1;
+}
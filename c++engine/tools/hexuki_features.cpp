@@ -0,0 +1,79 @@
+/**
+ * hexuki_features - per-ply positional features from archived games
+ *
+ * Usage:
+ *   hexuki_features <archive dir> --out DIR [--threads N] [--pin] [--chunk GAMES]
+ *
+ * Writes one <column>.bin file per feature plus schema.json (see
+ * include/tools/feature_extractor.h for the column list).
+ */
+
+#include "io/game_archive.h"
+#include "tools/feature_extractor.h"
+#include "core/thread_pool.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace hexuki;
+
+static void printUsage() {
+    std::cerr << "Usage: hexuki_features <archive dir> --out DIR [--threads N] [--pin] [--chunk GAMES]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::string archiveDir = argv[1];
+    std::string outDir;
+    tools::FeatureConfig config;
+
+    int threads = 0;
+    bool pinThreads = false;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) {
+            outDir = argv[++i];
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::stoi(argv[++i]);
+        } else if (arg == "--pin") {
+            pinThreads = true;
+        } else if (arg == "--chunk" && hasValue) {
+            config.chunkGames = std::stoull(argv[++i]);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    ThreadPool::configureGlobal(threads, pinThreads);
+
+    if (outDir.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        io::GameArchive archive(archiveDir);
+        uint64_t skipped = 0;
+        uint64_t rows = tools::extractArchiveFeatures(archive, outDir, config, ThreadPool::global(), &skipped);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cerr << "Extracted " << rows << " rows from " << archive.size() << " games in "
+                  << static_cast<long long>(ms) << " ms ("
+                  << (ms > 0 ? static_cast<long long>(archive.size() * 1000.0 / ms) : 0) << " games/s)\n";
+        if (skipped > 0) {
+            std::cerr << "Skipped " << skipped << " malformed games\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * hexuki_label - exact minimax labels for training positions
+ *
+ * Usage:
+ *   hexuki_label --input games.txt --output labels.tsv [options]
+ *
+ * Options:
+ *   --input FILE      Game records, one per line ('-' = stdin, default)
+ *   --output FILE     Label file; if it exists, labelling resumes and appends
+ *   --min-empty N     Only label positions with at least N empty hexes (default 1)
+ *   --max-empty N     Only label positions with at most N empty hexes (default 8)
+ *   --threads N       Worker threads in the shared pool (default: all cores)
+ *   --pin             Pin pool workers to cores
+ *   --tt MB           Shared transposition table size (default 256)
+ *   --prefault        Fault in the whole table at startup
+ *   --no-large-pages  Use standard 4KB pages for the table
+ *   --quiet           No progress output
+ */
+
+#include "core/large_pages.h"
+#include "core/thread_pool.h"
+#include "io/game_record.h"
+#include "tools/labeller.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace hexuki;
+
+static void printUsage() {
+    std::cerr << "Usage: hexuki_label --input games.txt --output labels.tsv"
+              << " [--min-empty N] [--max-empty N] [--threads N] [--pin] [--tt MB]"
+              << " [--prefault] [--no-large-pages] [--quiet]\n";
+}
+
+int main(int argc, char** argv) {
+    std::string inputPath = "-";
+    std::string outputPath;
+    tools::LabelConfig config;
+
+    int threads = 0;
+    bool pinThreads = false;
+    LargePageConfig pages;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--input" && hasValue) {
+            inputPath = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else if (arg == "--min-empty" && hasValue) {
+            config.minEmpty = std::stoi(argv[++i]);
+        } else if (arg == "--max-empty" && hasValue) {
+            config.maxEmpty = std::stoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::stoi(argv[++i]);
+        } else if (arg == "--pin") {
+            pinThreads = true;
+        } else if (arg == "--tt" && hasValue) {
+            config.ttSizeMB = std::stoul(argv[++i]);
+        } else if (arg == "--prefault") {
+            pages.prefault = true;
+        } else if (arg == "--no-large-pages") {
+            pages.enabled = false;
+        } else if (arg == "--quiet") {
+            config.verbose = false;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    ThreadPool::configureGlobal(threads, pinThreads);
+    pages.verbose = config.verbose;
+    setLargePageDefaults(pages);
+
+    if (outputPath.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    tools::Labeller labeller(config);
+
+    // Resume: skip everything already in the output file
+    {
+        std::ifstream existing(outputPath);
+        if (existing) {
+            existing.close();
+            io::truncatePartialLine(outputPath);
+            existing.open(outputPath);
+            size_t loaded = labeller.loadExisting(existing);
+            if (config.verbose) {
+                std::cerr << "Resuming: " << loaded << " positions already labelled\n";
+            }
+        }
+    }
+
+    std::ofstream out(outputPath, std::ios::app);
+    if (!out) {
+        std::cerr << "Cannot open output file: " << outputPath << "\n";
+        return 1;
+    }
+
+    tools::LabelStats stats;
+    if (inputPath == "-") {
+        stats = labeller.run(std::cin, out);
+    } else {
+        std::ifstream in(inputPath);
+        if (!in) {
+            std::cerr << "Cannot open input file: " << inputPath << "\n";
+            return 1;
+        }
+        stats = labeller.run(in, out);
+    }
+
+    if (config.verbose) {
+        std::cerr << "Games: " << stats.gamesRead
+                  << " | Labelled: " << stats.labelled
+                  << " | Duplicates: " << stats.duplicates
+                  << " | Nodes: " << stats.nodes
+                  << " | Time: " << static_cast<long long>(stats.timeMs) << " ms\n";
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * Hexuki Game Engine V2 - WASM backed
+ * Same class API as hexuki_game_engine_v2.js, with the hot rule checks and
+ * random playouts running in the C++ engine (hexuki.js)
+ *
+ * Load after hexuki_game_engine_v2.js and hexuki.js:
+ *   <script src="hexuki_game_engine_v2.js"></script>
+ *   <script src="hexuki.js"></script>
+ *   <script src="hexuki_game_engine_wasm.js"></script>
+ *
+ * HexukiGameEngineV2 is replaced by a subclass, so existing pages, AI players
+ * and clones (which copy board / tiles / currentPlayer / moveCount directly)
+ * keep working. The JS fields stay the game state; WASM only reads them.
+ * Until the module has loaded (HexukiGameEngineV2.ready), or with an older
+ * hexuki.js build that lacks the batch exports, every call falls back to the
+ * pure JS engine.
+ *
+ * Batched hot ops (one WASM call for many games):
+ *   HexukiGameEngineV2.batchValidMoves(games)   -> [[{hexId, tileValue}...]...]
+ *   HexukiGameEngineV2.batchPlayouts(games, seed) -> [{player1, player2, moves}...]
+ *   HexukiGameEngineV2.batchScores(games)       -> [{player1, player2}...]
+ */
+
+(function (global) {
+    const Base = HexukiGameEngineV2;
+
+    // Position record layout (c++engine/include/api/result_layout.h)
+    const NUM_HEXES = 19;
+    const POS_PLAYER = NUM_HEXES;
+    const POS_MOVE_COUNT = NUM_HEXES + 1;
+    const POS_P1_TILE_COUNT = NUM_HEXES + 2;
+    const POS_P1_TILES = NUM_HEXES + 3;
+    const POS_P2_TILE_COUNT = POS_P1_TILES + 9;
+    const POS_P2_TILES = POS_P2_TILE_COUNT + 1;
+    const POSITION_STRIDE = POS_P2_TILES + 9;
+
+    // Playout record layout: scores, move count, then (hexId, tileValue) pairs
+    const PLAYOUT_MOVES = 3;
+    const PLAYOUT_STRIDE = PLAYOUT_MOVES + NUM_HEXES * 2;
+
+    let wasm = null;
+
+    function occupiedMask(game) {
+        let mask = 0;
+        for (let hexId = 0; hexId < NUM_HEXES; hexId++) {
+            if (game.board[hexId].value !== null) mask |= 1 << hexId;
+        }
+        return mask >>> 0;
+    }
+
+    // Copy games into the module's input buffer (one WASM call for the batch)
+    function packGames(games) {
+        const ptr = wasm._wasmBatchInput(games.length);
+        const heap = wasm.HEAP32;
+        games.forEach((game, i) => {
+            const base = (ptr >> 2) + i * POSITION_STRIDE;
+            for (let hexId = 0; hexId < NUM_HEXES; hexId++) {
+                heap[base + hexId] = game.board[hexId].value || 0;
+            }
+            heap[base + POS_PLAYER] = game.currentPlayer;
+            heap[base + POS_MOVE_COUNT] = game.moveCount;
+            heap[base + POS_P1_TILE_COUNT] = game.player1Tiles.length;
+            game.player1Tiles.forEach((tile, t) => { heap[base + POS_P1_TILES + t] = tile; });
+            heap[base + POS_P2_TILE_COUNT] = game.player2Tiles.length;
+            game.player2Tiles.forEach((tile, t) => { heap[base + POS_P2_TILES + t] = tile; });
+        });
+    }
+
+    function output(ptr) {
+        const start = ptr >> 2;
+        return wasm.HEAP32.subarray(start, start + wasm._wasmBatchOutputLength());
+    }
+
+    class HexukiGameEngineWasm extends Base {
+        /**
+         * Use a loaded module (HexukiWasm() result) or load one from a factory.
+         * Modules without the batch exports are ignored.
+         */
+        static init(moduleOrFactory) {
+            const loading = typeof moduleOrFactory === 'function' ? moduleOrFactory() : moduleOrFactory;
+            HexukiGameEngineWasm.ready = Promise.resolve(loading).then(module => {
+                wasm = module && typeof module._wasmBatchPlayouts === 'function' ? module : null;
+                return wasm !== null;
+            });
+            return HexukiGameEngineWasm.ready;
+        }
+
+        static isWasmReady() {
+            return wasm !== null;
+        }
+
+        // Adjacency and chain length rules in one call (the anti-symmetry
+        // rule stays in makeMove / getAllValidMoves as before)
+        isMoveLegal(hexId) {
+            if (wasm === null) return super.isMoveLegal(hexId);
+            return ((wasm._wasmLegalHexMask(occupiedMask(this)) >>> hexId) & 1) === 1;
+        }
+
+        getAllValidMoves() {
+            if (wasm === null) return super.getAllValidMoves();
+            return HexukiGameEngineWasm.batchValidMoves([this])[0];
+        }
+
+        static batchValidMoves(games) {
+            if (wasm === null) return games.map(game => Base.prototype.getAllValidMoves.call(game));
+            packGames(games);
+            const out = output(wasm._wasmBatchValidMoves(games.length));
+            const result = [];
+            let offset = 0;
+            for (let i = 0; i < games.length; i++) {
+                const count = out[offset++];
+                const moves = new Array(count);
+                for (let m = 0; m < count; m++, offset += 2) {
+                    moves[m] = { hexId: out[offset], tileValue: out[offset + 1] };
+                }
+                result.push(moves);
+            }
+            return result;
+        }
+
+        static batchScores(games) {
+            if (wasm === null) return games.map(game => game.calculateScores());
+            packGames(games);
+            const out = output(wasm._wasmBatchScores(games.length));
+            return games.map((game, i) => ({ player1: out[i * 2], player2: out[i * 2 + 1] }));
+        }
+
+        /**
+         * Uniformly random legal moves until each game ends. Games are not
+         * modified; game i is played with seed + i, so a batch is reproducible
+         * (the JS fallback uses Math.random).
+         */
+        static batchPlayouts(games, seed = 0) {
+            if (wasm === null) {
+                return games.map(game => {
+                    const copy = Object.assign(new Base(), game, {
+                        board: game.board.map(hex => Object.assign({}, hex)),
+                        player1Tiles: [...game.player1Tiles],
+                        player2Tiles: [...game.player2Tiles]
+                    });
+                    const moves = [];
+                    while (!copy.gameEnded) {
+                        const valid = copy.getAllValidMoves();
+                        if (valid.length === 0) break;
+                        const move = valid[Math.floor(Math.random() * valid.length)];
+                        copy.makeMove(move.hexId, move.tileValue);
+                        moves.push(move);
+                    }
+                    return Object.assign(copy.calculateScores(), { moves });
+                });
+            }
+            packGames(games);
+            const out = output(wasm._wasmBatchPlayouts(games.length, seed >>> 0));
+            return games.map((game, i) => {
+                const base = i * PLAYOUT_STRIDE;
+                const moves = [];
+                for (let m = 0; m < out[base + 2]; m++) {
+                    const at = base + PLAYOUT_MOVES + m * 2;
+                    moves.push({ hexId: out[at], tileValue: out[at + 1] });
+                }
+                return { player1: out[base], player2: out[base + 1], moves };
+            });
+        }
+
+        // Final scores of a random playout from this position (game unchanged)
+        playoutScores(seed = (Math.random() * 0x100000000) >>> 0) {
+            const result = HexukiGameEngineWasm.batchPlayouts([this], seed)[0];
+            return { player1: result.player1, player2: result.player2 };
+        }
+
+        // Play a random game to the end on this engine; returns the moves played
+        playoutToEnd(seed = (Math.random() * 0x100000000) >>> 0) {
+            const moves = HexukiGameEngineWasm.batchPlayouts([this], seed)[0].moves;
+            moves.forEach(move => this.makeMove(move.hexId, move.tileValue));
+            return moves;
+        }
+    }
+
+    HexukiGameEngineWasm.JsEngine = Base;
+    HexukiGameEngineWasm.ready = Promise.resolve(false);
+    if (typeof global.HexukiWasm === 'function') {
+        HexukiGameEngineWasm.init(global.HexukiWasm);
+    }
+
+    // Rebind the class name other scripts use, not just the window property
+    HexukiGameEngineV2 = HexukiGameEngineWasm;  // eslint-disable-line no-global-assign
+    global.HexukiGameEngineV2 = HexukiGameEngineWasm;
+})(typeof window !== 'undefined' ? window : globalThis);
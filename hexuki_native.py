@@ -0,0 +1,310 @@
+"""
+ctypes wrapper for libhexuki, the C++ engine's shared library
+(c++engine target hexuki_shared, C ABI in c++engine/include/api/hexuki_c.h)
+
+Lets the analysis scripts run rules, scoring, random playouts and searches
+in native code over whole arrays of positions, one call per array:
+
+    import hexuki_native as hx
+
+    positions = hx.Positions.start(1000)          # 1000 starting positions
+    results = hx.playouts(positions, seed=42)     # [(p1, p2, [(hex, tile), ...]), ...]
+    moves = hx.valid_moves(positions)             # [[(hex, tile), ...], ...]
+    best = hx.minimax(positions[:10], depth=6)    # [{'hex': .., 'tile': .., 'score': ..}, ...]
+
+Build the library first (cmake --build build) or point HEXUKI_LIB at it.
+Move generation, scoring and playouts follow hexuki_game_engine_v2.js
+(anti-symmetry rule, 18 moves per game).
+"""
+
+import ctypes
+import os
+import sys
+
+ABI_VERSION = 1
+
+# Record layouts (hexuki_c.h / api/result_layout.h)
+NUM_HEXES = 19
+POSITION_STRIDE = 41
+POS_PLAYER = 19
+POS_MOVE_COUNT = 20
+POS_P1_TILE_COUNT = 21
+POS_P1_TILES = 22
+POS_P2_TILE_COUNT = 31
+POS_P2_TILES = 32
+MOVES_STRIDE = 343
+SCORES_STRIDE = 2
+PLAYOUT_STRIDE = 41
+SEARCH_STRIDE = 11
+
+# Search record fields (SearchField in api/result_layout.h)
+FIELD_HEX, FIELD_TILE, FIELD_TIME_MS, FIELD_WORK = 2, 3, 4, 5
+FIELD_VISITS, FIELD_WIN_RATE, FIELD_SCORE, FIELD_DEPTH = 6, 7, 8, 9
+
+_ERRORS = {-1: 'invalid argument', -2: 'illegal move', -3: 'buffer too small', -4: 'internal error'}
+
+
+class HexukiError(RuntimeError):
+    def __init__(self, code, message):
+        super().__init__(f"{_ERRORS.get(code, 'error')} ({code}): {message}")
+        self.code = code
+
+
+# ============================================================================
+# Library loading
+# ============================================================================
+
+_lib = None
+
+
+def _library_names():
+    if sys.platform == 'win32':
+        return ['hexuki.dll']
+    if sys.platform == 'darwin':
+        return ['libhexuki.dylib']
+    return ['libhexuki.so']
+
+
+def _candidates():
+    if os.environ.get('HEXUKI_LIB'):
+        yield os.environ['HEXUKI_LIB']
+    engine_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'c++engine')
+    for build in ('build', os.path.join('build', 'Release'), os.path.join('build', 'Debug')):
+        for name in _library_names():
+            yield os.path.join(engine_dir, build, name)
+
+
+def load(path=None):
+    """Load libhexuki (path, $HEXUKI_LIB or c++engine/build); called on first use."""
+    global _lib
+    if _lib is not None and path is None:
+        return _lib
+
+    candidates = [path] if path else [p for p in _candidates() if os.path.exists(p)]
+    if not candidates:
+        raise OSError('libhexuki not found: build c++engine (target hexuki_shared) or set HEXUKI_LIB')
+    lib = ctypes.CDLL(candidates[0])
+
+    i32p = ctypes.POINTER(ctypes.c_int32)
+    f64p = ctypes.POINTER(ctypes.c_double)
+    c_int, c_u32 = ctypes.c_int, ctypes.c_uint32
+    signatures = {
+        'hexuki_abi_version': ([], c_int),
+        'hexuki_last_error': ([], ctypes.c_char_p),
+        'hexuki_board_create': ([], ctypes.c_void_p),
+        'hexuki_board_destroy': ([ctypes.c_void_p], None),
+        'hexuki_board_load': ([ctypes.c_void_p, ctypes.c_char_p], c_int),
+        'hexuki_board_save': ([ctypes.c_void_p, ctypes.c_char_p, c_int], c_int),
+        'hexuki_board_make_move': ([ctypes.c_void_p, c_int, c_int], c_int),
+        'hexuki_board_undo_move': ([ctypes.c_void_p], c_int),
+        'hexuki_board_pack': ([ctypes.c_void_p, i32p], c_int),
+        'hexuki_position_init': ([i32p], c_int),
+        'hexuki_batch_valid_moves': ([i32p, c_int, i32p], c_int),
+        'hexuki_batch_scores': ([i32p, c_int, i32p], c_int),
+        'hexuki_batch_playouts': ([i32p, c_int, c_u32, i32p], c_int),
+        'hexuki_batch_minimax': ([i32p, c_int, c_int, c_int, f64p], c_int),
+        'hexuki_batch_mcts': ([i32p, c_int, c_int, c_u32, f64p], c_int),
+    }
+    for name, (args, result) in signatures.items():
+        function = getattr(lib, name)
+        function.argtypes = args
+        function.restype = result
+
+    if lib.hexuki_abi_version() != ABI_VERSION:
+        raise OSError(f'libhexuki ABI {lib.hexuki_abi_version()}, wrapper expects {ABI_VERSION}')
+    _lib = lib
+    return lib
+
+
+def _check(status):
+    if status < 0:
+        raise HexukiError(status, _lib.hexuki_last_error().decode())
+    return status
+
+
+# ============================================================================
+# Positions
+# ============================================================================
+
+class Positions:
+    """
+    Array of packed positions (POSITION_STRIDE int32 values each)
+
+    Wraps a ctypes array; from_buffer() wraps existing int32 memory (an
+    array('i') or a numpy int32 array) without copying.
+    """
+
+    def __init__(self, count, data=None):
+        self.count = count
+        self.data = data if data is not None else (ctypes.c_int32 * (count * POSITION_STRIDE))()
+
+    @classmethod
+    def start(cls, count):
+        positions = cls(count)
+        lib = load()
+        for i in range(count):
+            _check(lib.hexuki_position_init(positions.record(i)))
+        return positions
+
+    @classmethod
+    def from_buffer(cls, buffer):
+        data = (ctypes.c_int32 * (len(memoryview(buffer).cast('B')) // 4)).from_buffer(buffer)
+        return cls(len(data) // POSITION_STRIDE, data)
+
+    @classmethod
+    def from_boards(cls, boards):
+        positions = cls(len(boards))
+        for i, board in enumerate(boards):
+            _check(load().hexuki_board_pack(board.handle, positions.record(i)))
+        return positions
+
+    def __len__(self):
+        return self.count
+
+    def __getitem__(self, index):
+        """Slices share memory with this array"""
+        if not isinstance(index, slice):
+            raise TypeError('index Positions with a slice; use get(i) for one position')
+        start, stop, step = index.indices(self.count)
+        if step != 1:
+            raise ValueError('Positions slices must be contiguous')
+        count = max(0, stop - start)
+        data = (ctypes.c_int32 * (count * POSITION_STRIDE)).from_buffer(self.data, start * POSITION_STRIDE * 4)
+        return Positions(count, data)
+
+    def record(self, i):
+        address = ctypes.addressof(self.data) + i * POSITION_STRIDE * ctypes.sizeof(ctypes.c_int32)
+        return ctypes.cast(address, ctypes.POINTER(ctypes.c_int32))
+
+    def set(self, i, hex_values, player, move_count, p1_tiles, p2_tiles):
+        """hex_values: NUM_HEXES tile values (0 or None = empty)"""
+        base = i * POSITION_STRIDE
+        for offset in range(POSITION_STRIDE):
+            self.data[base + offset] = 0
+        for hex_id, value in enumerate(hex_values):
+            self.data[base + hex_id] = value or 0
+        self.data[base + POS_PLAYER] = player
+        self.data[base + POS_MOVE_COUNT] = move_count
+        for count_field, tiles_field, tiles in ((POS_P1_TILE_COUNT, POS_P1_TILES, p1_tiles),
+                                                (POS_P2_TILE_COUNT, POS_P2_TILES, p2_tiles)):
+            self.data[base + count_field] = len(tiles)
+            for t, tile in enumerate(tiles):
+                self.data[base + tiles_field + t] = tile
+
+    def get(self, i):
+        base = i * POSITION_STRIDE
+        d = self.data
+        return {
+            'hex_values': list(d[base:base + NUM_HEXES]),
+            'player': d[base + POS_PLAYER],
+            'move_count': d[base + POS_MOVE_COUNT],
+            'p1_tiles': list(d[base + POS_P1_TILES:base + POS_P1_TILES + d[base + POS_P1_TILE_COUNT]]),
+            'p2_tiles': list(d[base + POS_P2_TILES:base + POS_P2_TILES + d[base + POS_P2_TILE_COUNT]]),
+        }
+
+
+# ============================================================================
+# Batches
+# ============================================================================
+
+def valid_moves(positions):
+    lib = load()
+    out = (ctypes.c_int32 * (len(positions) * MOVES_STRIDE))()
+    _check(lib.hexuki_batch_valid_moves(positions.data, len(positions), out))
+    result = []
+    for i in range(len(positions)):
+        base = i * MOVES_STRIDE
+        flat = out[base + 1:base + 1 + out[base] * 2]
+        result.append(list(zip(flat[0::2], flat[1::2])))
+    return result
+
+
+def scores(positions):
+    lib = load()
+    out = (ctypes.c_int32 * (len(positions) * SCORES_STRIDE))()
+    _check(lib.hexuki_batch_scores(positions.data, len(positions), out))
+    return [(out[i * 2], out[i * 2 + 1]) for i in range(len(positions))]
+
+
+def playouts(positions, seed=0):
+    """Random games to the end; position i uses seed + i"""
+    lib = load()
+    out = (ctypes.c_int32 * (len(positions) * PLAYOUT_STRIDE))()
+    _check(lib.hexuki_batch_playouts(positions.data, len(positions), seed & 0xFFFFFFFF, out))
+    result = []
+    for i in range(len(positions)):
+        base = i * PLAYOUT_STRIDE
+        flat = out[base + 3:base + 3 + out[base + 2] * 2]
+        result.append((out[base], out[base + 1], list(zip(flat[0::2], flat[1::2]))))
+    return result
+
+
+def _search_results(out, count):
+    results = []
+    for i in range(count):
+        r = out[i * SEARCH_STRIDE:(i + 1) * SEARCH_STRIDE]
+        results.append({
+            'hex': int(r[FIELD_HEX]), 'tile': int(r[FIELD_TILE]), 'time_ms': r[FIELD_TIME_MS],
+            'work': int(r[FIELD_WORK]), 'visits': int(r[FIELD_VISITS]), 'win_rate': r[FIELD_WIN_RATE],
+            'score': int(r[FIELD_SCORE]), 'depth': int(r[FIELD_DEPTH]),
+        })
+    return results
+
+
+def minimax(positions, depth, time_limit_ms=30000):
+    """Best move per position (positions searched in parallel); 'work' = nodes"""
+    lib = load()
+    out = (ctypes.c_double * (len(positions) * SEARCH_STRIDE))()
+    _check(lib.hexuki_batch_minimax(positions.data, len(positions), depth, time_limit_ms, out))
+    return _search_results(out, len(positions))
+
+
+def mcts(positions, simulations, seed=0):
+    """Best move per position; position i uses seed + i (0 = random); 'work' = simulations"""
+    lib = load()
+    out = (ctypes.c_double * (len(positions) * SEARCH_STRIDE))()
+    _check(lib.hexuki_batch_mcts(positions.data, len(positions), simulations, seed & 0xFFFFFFFF, out))
+    return _search_results(out, len(positions))
+
+
+# ============================================================================
+# Boards
+# ============================================================================
+
+class Board:
+    """One engine board (hexuki_board handle); usable as a context manager"""
+
+    def __init__(self, position=None):
+        self.handle = load().hexuki_board_create()
+        if not self.handle:
+            raise MemoryError('hexuki_board_create failed')
+        if position is not None:
+            self.load(position)
+
+    def close(self):
+        if self.handle:
+            _lib.hexuki_board_destroy(self.handle)
+            self.handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+    def load(self, position):
+        _check(_lib.hexuki_board_load(self.handle, position.encode()))
+
+    def save(self):
+        buffer = ctypes.create_string_buffer(256)
+        length = _check(_lib.hexuki_board_save(self.handle, buffer, len(buffer)))
+        return buffer.raw[:length].decode()
+
+    def make_move(self, hex_id, tile_value):
+        _check(_lib.hexuki_board_make_move(self.handle, hex_id, tile_value))
+
+    def undo_move(self):
+        _check(_lib.hexuki_board_undo_move(self.handle))
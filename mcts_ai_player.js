@@ -111,7 +111,10 @@ class MCTSNode {
         const simGame = this.cloneGame(this.game);
 
         // PHASE 1: Random rollout until threshold
-        while (!simGame.gameEnded) {
+        // (the WASM engine shim plays a pure random rollout in a single call)
+        const wasmScores = !useMinimaxRollouts && typeof simGame.playoutScores === 'function'
+            ? simGame.playoutScores() : null;
+        while (!wasmScores && !simGame.gameEnded) {
             const emptyHexes = simGame.board.filter(h => h.value === null).length;
 
             // Switch to minimax when <= threshold empty hexes
@@ -150,7 +153,7 @@ class MCTSNode {
         }
 
         // PHASE 3: Fallback to random evaluation (if minimax not used or game already over)
-        const scores = simGame.calculateScores();
+        const scores = wasmScores || simGame.calculateScores();
         const scoreDiff = scores.player1 - scores.player2;
 
         // Convert to normalized result: 1.0 for P1 win, 0.0 for P1 loss, 0.5 for draw